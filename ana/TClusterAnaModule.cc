@@ -20,6 +20,8 @@
 #include "TSystem.h"
 
 #include "Stntuple/loop/TStnAna.hh"
+#include "Stntuple/loop/TStnEventCache.hh"
+#include "Stntuple/obj/TStnEvent.hh"
 #include "Stntuple/obj/TStnHeaderBlock.hh"
 #include "Stntuple/alg/TStntuple.hh"
 #include "Stntuple/geom/TDisk.hh"
@@ -39,6 +41,8 @@ TClusterAnaModule::TClusterAnaModule(const char* name, const char* title):
 {
   fDiskCalorimeter = new TDiskCalorimeter();
   fMinT0           = 0;                 // do not cut on time by default
+  fNDisks          = 0;
+  fCalParEntry     = -1;
 }
 
 //-----------------------------------------------------------------------------
@@ -167,37 +171,24 @@ void TClusterAnaModule::BookHistograms() {
 }
 
 //-----------------------------------------------------------------------------
-void TClusterAnaModule::FillClusterHistograms(ClusterHist_t* Hist, TStnCluster* Cluster) {
-  int   row, col;
-  float  x, y, z, r;
+void TClusterAnaModule::FillClusterHistograms(ClusterHist_t* Hist, ClusterPar_t* Cluster) {
 
-  row = Cluster->Ix1();
-  col = Cluster->Ix2();
-
-  x   = Cluster->fX; // +3904.;
-  y   = Cluster->fY;
-  z   = Cluster->fZ;
-  r   = sqrt(x*x+y*y);
-
-  if ((row < 0) || (row > 9999)) row = -9999;
-  if ((col < 0) || (col > 9999)) col = -9999;
-
-  Hist->fDiskID->Fill(Cluster->DiskID());
-  Hist->fEnergy->Fill(Cluster->Energy());
-  Hist->fT0->Fill(Cluster->Time());
-  Hist->fRow->Fill(row);
-  Hist->fCol->Fill(col);
-  Hist->fX->Fill(x);
-  Hist->fY->Fill(y);
-  Hist->fZ->Fill(z);
-  Hist->fR->Fill(r);
+  Hist->fDiskID->Fill(Cluster->fDiskID);
+  Hist->fEnergy->Fill(Cluster->fEnergy);
+  Hist->fT0->Fill(Cluster->fTime);
+  Hist->fRow->Fill(Cluster->fRow);
+  Hist->fCol->Fill(Cluster->fCol);
+  Hist->fX->Fill(Cluster->fX);
+  Hist->fY->Fill(Cluster->fY);
+  Hist->fZ->Fill(Cluster->fZ);
+  Hist->fR->Fill(Cluster->fR);
 
   Hist->fYMean->Fill(Cluster->fYMean);
   Hist->fZMean->Fill(Cluster->fZMean);
   Hist->fSigY ->Fill(Cluster->fSigY);
   Hist->fSigZ ->Fill(Cluster->fSigZ);
   Hist->fSigR ->Fill(Cluster->fSigR);
-  Hist->fNCr0 ->Fill(Cluster->fNCrystals);
+  Hist->fNCr0 ->Fill(Cluster->fNCr0);
   Hist->fNCr1 ->Fill(Cluster->fNCr1);
   Hist->fFrE1 ->Fill(Cluster->fFrE1);
   Hist->fFrE2 ->Fill(Cluster->fFrE2);
@@ -235,11 +226,8 @@ void TClusterAnaModule::FillEventHistograms(EventHist_t* Hist, double EMin, doub
 
   double emax = -1;
 
-  TStnCluster* cluster(0);
-  if (fNClusters > 0) cluster = fClusterBlock->Cluster(0);
-
-  if (cluster) {
-    emax   = cluster->Energy();
+  if (fNClusters > 0) {
+    emax   = fClusterPar[0].fEnergy;
   }
 
   Hist->fEMax->Fill(emax);
@@ -247,7 +235,7 @@ void TClusterAnaModule::FillEventHistograms(EventHist_t* Hist, double EMin, doub
 //-----------------------------------------------------------------------------
 // calorimeter
 //-----------------------------------------------------------------------------
-  int      ndisks, nc, nh, nhh, bin;
+  int      ndisks, nc, nh, nhh, bin, idisk, ih0;
 
   int      n_hits_tot, n_hit_crystals_tot;
   int      n_hit_crystals[kNDisks], n_hits[kNDisks];
@@ -255,20 +243,17 @@ void TClusterAnaModule::FillEventHistograms(EventHist_t* Hist, double EMin, doub
 
   float    etot[kNDisks];
 
-  TCalHitData* hit;
-  TStnCrystal* cr;
+  CrystalPar_t* cr;
+  CalHitPar_t*  hit;
 
   float        ehit, r;
 
-  ndisks = fDiskCalorimeter->NDisks();
+  ndisks = fNDisks;
 
   n_hits_tot         = 0;
   n_hit_crystals_tot = 0;
 
-  for (int idisk=0; idisk<ndisks; idisk++) {
-
-    TDisk* disk = fDiskCalorimeter->Disk(idisk);
-
+  for (idisk=0; idisk<ndisks; idisk++) {
     etot          [idisk] = 0;
     n_hits        [idisk] = 0;
     n_hit_crystals[idisk] = 0;
@@ -277,43 +262,49 @@ void TClusterAnaModule::FillEventHistograms(EventHist_t* Hist, double EMin, doub
       n_hits_r        [idisk][ib] = 0;
       n_hit_crystals_r[idisk][ib] = 0;
     }
-
-    nc = disk->NCrystals();
-    for (int ic=0; ic<nc; ic++) {
-      cr   = disk->Crystal(ic);
-      r    = cr->Radius();
-      nh   = cr->NHits ();
-      ehit = cr->Energy();
-      bin  = (int) (r/10.);
+  }
+					// only crystals with hits
+  nc  = fCrystalPar.size();
+  ih0 = 0;
+  for (int ic=0; ic<nc; ic++) {
+    cr    = &fCrystalPar[ic];
+    idisk = (int) cr->fDisk;
+    r     = cr->fR;
+    nh    = (int) cr->fNHits;
+    ehit  = cr->fEnergy;
+    bin   = (int) (r/10.);
 					// total energy deposited in the disk
-      etot[idisk] += cr->Energy();
+    etot[idisk] += cr->fEnergy;
 
-      nhh = 0;
-      for (int ih=0; ih<nh; ih++) {
-	hit = cr->CalHitData(ih);
-	if ((hit->Energy() > EMin) && (hit->Time() > TMin)) {
+    nhh = 0;
+    for (int ih=ih0; ih<ih0+nh; ih++) {
+      hit = &fCalHitPar[ih];
+      if ((hit->fEnergy > EMin) && (hit->fTime > TMin)) {
 					// number of hits above the threshold (EMin)
 
-	  nhh                         += 1; // N(hits) per crystal
-	  n_hits         [idisk]      += 1; // total N(hits) in the disk
-	  n_hits_r       [idisk][bin] += 1; // total N(hits) in a given radial bin
-	}
+	nhh                         += 1; // N(hits) per crystal
+	n_hits         [idisk]      += 1; // total N(hits) in the disk
+	n_hits_r       [idisk][bin] += 1; // total N(hits) in a given radial bin
       }
+    }
+    ih0 += nh;
     
-      Hist->fECrVsR   [idisk]->Fill(r,ehit);
-      Hist->fEHitVsR  [idisk]->Fill(r,ehit);
+    Hist->fECrVsR   [idisk]->Fill(r,ehit);
+    Hist->fEHitVsR  [idisk]->Fill(r,ehit);
 
-      if (nhh > 0) {
-	n_hit_crystals  [idisk]      += 1;
-	n_hit_crystals_r[idisk][bin] += 1;
-      }
+    if (nhh > 0) {
+      n_hit_crystals  [idisk]      += 1;
+      n_hit_crystals_r[idisk][bin] += 1;
     }
+  }
+
+  for (idisk=0; idisk<ndisks; idisk++) {
     n_hit_crystals_tot += n_hit_crystals[idisk];
     n_hits_tot         += n_hits[idisk];
   }
 
   double ecalo(0);
-  for (int idisk=0; idisk<ndisks; idisk++) {
+  for (idisk=0; idisk<ndisks; idisk++) {
     ecalo += etot[idisk];
 //-----------------------------------------------------------------------------
 // fill 'per-disk' histograms
@@ -352,6 +343,8 @@ int TClusterAnaModule::BeginJob() {
 //-----------------------------------------------------------------------------
   BookHistograms();
 
+  fCalParEntry = -1;
+
   return 0;
 }
 
@@ -382,19 +375,19 @@ void TClusterAnaModule::FillHistograms() {
 //-----------------------------------------------------------------------------
 // cluster histograms
 //-----------------------------------------------------------------------------
-  TStnCluster* cl;
+  ClusterPar_t* cl;
 
   for (int i=0; i<fNClusters; ++i ) {
-    cl = fClusterBlock->Cluster(i);
+    cl = &fClusterPar[i];
 
     FillClusterHistograms(fHist.fCluster[0],cl);
 
-    if (cl->DiskID() == 0)  FillClusterHistograms(fHist.fCluster[1],cl);
-    if (cl->DiskID() == 1)  FillClusterHistograms(fHist.fCluster[2],cl);
+    if (cl->fDiskID == 0)  FillClusterHistograms(fHist.fCluster[1],cl);
+    if (cl->fDiskID == 1)  FillClusterHistograms(fHist.fCluster[2],cl);
 
-    if (cl->Energy() > 20.) FillClusterHistograms(fHist.fCluster[3],cl);
-    if (cl->Energy() > 50.) FillClusterHistograms(fHist.fCluster[4],cl);
-    if (cl->Energy() > 70.) FillClusterHistograms(fHist.fCluster[5],cl);
+    if (cl->fEnergy > 20.) FillClusterHistograms(fHist.fCluster[3],cl);
+    if (cl->fEnergy > 50.) FillClusterHistograms(fHist.fCluster[4],cl);
+    if (cl->fEnergy > 70.) FillClusterHistograms(fHist.fCluster[5],cl);
   }
 }
 
@@ -408,66 +401,141 @@ int TClusterAnaModule::BeginRun() {
 }
 
 
-//_____________________________________________________________________________
-int TClusterAnaModule::Event(int ientry) {
+//-----------------------------------------------------------------------------
+void TClusterAnaModule::InitClusterPar(TStnCluster* Cluster, ClusterPar_t* Cp) {
+  int    row, col;
+  float  x, y;
+
+  row = Cluster->Ix1();
+  col = Cluster->Ix2();
 
-  //  double                p;
-  //  TEmuLogLH::CalData_t  dat;
-  //  TStnTrack*            track;
-  //  int                   id_word;
-  TLorentzVector        mom;
+  if ((row < 0) || (row > 9999)) row = -9999;
+  if ((col < 0) || (col > 9999)) col = -9999;
 
-  TDiskCalorimeter::GeomData_t disk_geom;
+  x   = Cluster->fX; // +3904.;
+  y   = Cluster->fY;
 
-  fClusterBlock->GetEntry(ientry);
-  fCalDataBlock->GetEntry(ientry);
-  //  fGenpBlock->GetEntry(ientry);
-  //  fSimpBlock->GetEntry(ientry);
+  Cp->fDiskID = Cluster->DiskID();
+  Cp->fEnergy = Cluster->Energy();
+  Cp->fTime   = Cluster->Time();
+  Cp->fRow    = row;
+  Cp->fCol    = col;
+  Cp->fX      = x;
+  Cp->fY      = y;
+  Cp->fZ      = Cluster->fZ;
+  Cp->fR      = sqrt(x*x+y*y);
+  Cp->fYMean  = Cluster->fYMean;
+  Cp->fZMean  = Cluster->fZMean;
+  Cp->fSigY   = Cluster->fSigY;
+  Cp->fSigZ   = Cluster->fSigZ;
+  Cp->fSigR   = Cluster->fSigR;
+  Cp->fNCr0   = Cluster->fNCrystals;
+  Cp->fNCr1   = Cluster->fNCr1;
+  Cp->fFrE1   = Cluster->fFrE1;
+  Cp->fFrE2   = Cluster->fFrE2;
+  Cp->fSigE1  = Cluster->fSigE1;
+  Cp->fSigE2  = Cluster->fSigE2;
+}
 
-  fElectron = NULL;
 //-----------------------------------------------------------------------------
-// assume electron in the first particle, otherwise the logic will need to 
-// be changed
+// initializes the disk calorimeter (geometry - on the first call) and copies
+// the crystals with hits and their hits
 //-----------------------------------------------------------------------------
+void TClusterAnaModule::InitCalPar(TCalDataBlock* Block) {
+
+  TDiskCalorimeter::GeomData_t disk_geom;
+
   if (fDiskCalorimeter->Initialized() == 0) {
-    disk_geom.fNDisks = fCalDataBlock->NDisks();
+    disk_geom.fNDisks = Block->NDisks();
 
     for (int i=0; i<disk_geom.fNDisks; i++) {
-      //      disk_geom.fNCrystals[i] = fCalDataBlock->fNCrystals[i];
-      disk_geom.fRMin[i]      = fCalDataBlock->fRMin[i];
-      disk_geom.fRMax[i]      = fCalDataBlock->fRMax[i];
-      disk_geom.fZ0  [i]      = fCalDataBlock->fZ0  [i];
+      //      disk_geom.fNCrystals[i] = Block->fNCrystals[i];
+      disk_geom.fRMin[i]      = Block->fRMin[i];
+      disk_geom.fRMax[i]      = Block->fRMax[i];
+      disk_geom.fZ0  [i]      = Block->fZ0  [i];
     }
 
-    disk_geom.fHexSize          = fCalDataBlock->CrystalSize()*2;
+    disk_geom.fHexSize          = Block->CrystalSize()*2;
     // kludge , so far
-    disk_geom.fMinFraction      = 1.; // fCalDataBlock->MinFraction();
-    disk_geom.fWrapperThickness = fCalDataBlock->WrapperThickness();
-    disk_geom.fShellThickness   = fCalDataBlock->ShellThickness();
+    disk_geom.fMinFraction      = 1.; // Block->MinFraction();
+    disk_geom.fWrapperThickness = Block->WrapperThickness();
+    disk_geom.fShellThickness   = Block->ShellThickness();
 
     fDiskCalorimeter->Init(&disk_geom);
   }
 
-  //  TStnCluster* cl;
+  fDiskCalorimeter->InitEvent(Block);
+
+  fNDisks = fDiskCalorimeter->NDisks();
+
+  fCrystalPar.clear();
+  fCalHitPar.clear();
+
+  CrystalPar_t  cp;
+  CalHitPar_t   hp;
+
+  for (int idisk=0; idisk<fNDisks; idisk++) {
+    TDisk* disk = fDiskCalorimeter->Disk(idisk);
+
+    int nc = disk->NHitCrystals();
+    for (int ic=0; ic<nc; ic++) {
+      TStnCrystal* cr = disk->HitCrystal(ic);
+
+      cp.fDisk   = idisk;
+      cp.fR      = disk->GetRadius(cr->Index());
+      cp.fEnergy = cr->Energy();
+      cp.fNHits  = cr->NHits();
+      fCrystalPar.push_back(cp);
+
+      for (int ih=0; ih<cr->NHits(); ih++) {
+	TCalHitData* hit = cr->CalHitData(ih);
+	hp.fEnergy = hit->Energy();
+	hp.fTime   = hit->Time();
+	fCalHitPar.push_back(hp);
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+// the event cache calls the column functions once per column, initialize
+// the calorimeter only once per event
+//-----------------------------------------------------------------------------
+void TClusterAnaModule::CalPar(TCalDataBlock* Block) {
+
+  int entry = Block->GetEvent()->GetCurrentEntry();
+
+  if (entry != fCalParEntry) {
+    InitCalPar(Block);
+    fCalParEntry = entry;
+  }
+}
+
+//_____________________________________________________________________________
+int TClusterAnaModule::Event(int ientry) {
+
+  fClusterBlock->GetEntry(ientry);
+  fCalDataBlock->GetEntry(ientry);
+  //  fGenpBlock->GetEntry(ientry);
+  //  fSimpBlock->GetEntry(ientry);
+
+  fElectron = NULL;
+//-----------------------------------------------------------------------------
+// calorimeter: recalculate, don't rely on the entry number only
+//-----------------------------------------------------------------------------
+  fCalParEntry = -1;
+  CalPar(fCalDataBlock);
+
   fNClusters  = fClusterBlock->NClusters();
 
   if (fNClusters == 0) fCluster = 0;
   else                 fCluster = fClusterBlock->Cluster(0);
 
-//   fNCl20      = 0;
-//   fNCl50      = 0;
-//   fNCl70      = 0;
+  fClusterPar.resize(fNClusters);
   for (int i=0; i<fNClusters; ++i ) {
-    //    cl = fClusterBlock->Cluster(i);
-//     if (cl->Energy() > 20.) fNCl20 += 1;
-//     if (cl->Energy() > 50.) fNCl50 += 1;
-//     if (cl->Energy() > 70.) fNCl70 += 1;
+    InitClusterPar(fClusterBlock->Cluster(i),&fClusterPar[i]);
   }
 
-  //  fNCalHits   = fCalDataBlock->NHits();
-
-  fDiskCalorimeter->InitEvent(fCalDataBlock);
-
   FillHistograms();
 
   Debug();
@@ -475,6 +543,130 @@ int TClusterAnaModule::Event(int ientry) {
   return 0;		       
 }
 
+//-----------------------------------------------------------------------------
+// event cache
+//-----------------------------------------------------------------------------
+static const struct {
+  const char*                             fName;
+  float TClusterAnaModule::ClusterPar_t::* fPar;
+} kClusterColumn[] = {
+  { "disk_id", &TClusterAnaModule::ClusterPar_t::fDiskID },
+  { "energy" , &TClusterAnaModule::ClusterPar_t::fEnergy },
+  { "t0"     , &TClusterAnaModule::ClusterPar_t::fTime   },
+  { "row"    , &TClusterAnaModule::ClusterPar_t::fRow    },
+  { "col"    , &TClusterAnaModule::ClusterPar_t::fCol    },
+  { "x"      , &TClusterAnaModule::ClusterPar_t::fX      },
+  { "y"      , &TClusterAnaModule::ClusterPar_t::fY      },
+  { "z"      , &TClusterAnaModule::ClusterPar_t::fZ      },
+  { "r"      , &TClusterAnaModule::ClusterPar_t::fR      },
+  { "ymean"  , &TClusterAnaModule::ClusterPar_t::fYMean  },
+  { "zmean"  , &TClusterAnaModule::ClusterPar_t::fZMean  },
+  { "sigy"   , &TClusterAnaModule::ClusterPar_t::fSigY   },
+  { "sigz"   , &TClusterAnaModule::ClusterPar_t::fSigZ   },
+  { "sigr"   , &TClusterAnaModule::ClusterPar_t::fSigR   },
+  { "ncr0"   , &TClusterAnaModule::ClusterPar_t::fNCr0   },
+  { "ncr1"   , &TClusterAnaModule::ClusterPar_t::fNCr1   },
+  { "fre1"   , &TClusterAnaModule::ClusterPar_t::fFrE1   },
+  { "fre2"   , &TClusterAnaModule::ClusterPar_t::fFrE2   },
+  { "sige1"  , &TClusterAnaModule::ClusterPar_t::fSigE1  },
+  { "sige2"  , &TClusterAnaModule::ClusterPar_t::fSigE2  },
+  { 0, 0 }
+};
+
+static const struct {
+  const char*                             fName;
+  float TClusterAnaModule::CrystalPar_t::* fPar;
+} kCrystalColumn[] = {
+  { "disk"   , &TClusterAnaModule::CrystalPar_t::fDisk   },
+  { "r"      , &TClusterAnaModule::CrystalPar_t::fR      },
+  { "energy" , &TClusterAnaModule::CrystalPar_t::fEnergy },
+  { "nhits"  , &TClusterAnaModule::CrystalPar_t::fNHits  },
+  { 0, 0 }
+};
+
+static const struct {
+  const char*                            fName;
+  float TClusterAnaModule::CalHitPar_t::* fPar;
+} kCalHitColumn[] = {
+  { "energy" , &TClusterAnaModule::CalHitPar_t::fEnergy  },
+  { "time"   , &TClusterAnaModule::CalHitPar_t::fTime    },
+  { 0, 0 }
+};
+
+//-----------------------------------------------------------------------------
+int TClusterAnaModule::DefineCacheColumns(TStnEventCache* Cache) {
+
+  fClusterColumn.clear();
+  for (int i=0; kClusterColumn[i].fName; i++) {
+    float ClusterPar_t::* par = kClusterColumn[i].fPar;
+    fClusterColumn.push_back(Cache->AddArray(Form("%s.cl_%s",GetName(),kClusterColumn[i].fName),"ClusterBlock",
+      [](TStnDataBlock* B) { return ((TStnClusterBlock*) B)->NClusters(); },
+      [this,par](TStnDataBlock* B, int I) {
+	ClusterPar_t cp;
+	InitClusterPar(((TStnClusterBlock*) B)->Cluster(I),&cp);
+	return cp.*par;
+      }));
+  }
+
+  fNDisksColumn = Cache->AddScalar(Form("%s.ndisks",GetName()),"CalDataBlock",
+    [this](TStnDataBlock* B) { CalPar((TCalDataBlock*) B); return float(fNDisks); });
+
+  fCrystalColumn.clear();
+  for (int i=0; kCrystalColumn[i].fName; i++) {
+    float CrystalPar_t::* par = kCrystalColumn[i].fPar;
+    fCrystalColumn.push_back(Cache->AddArray(Form("%s.cr_%s",GetName(),kCrystalColumn[i].fName),"CalDataBlock",
+      [this](TStnDataBlock* B) { CalPar((TCalDataBlock*) B); return int(fCrystalPar.size()); },
+      [this,par](TStnDataBlock* B, int I) { return fCrystalPar[I].*par; }));
+  }
+
+  fCalHitColumn.clear();
+  for (int i=0; kCalHitColumn[i].fName; i++) {
+    float CalHitPar_t::* par = kCalHitColumn[i].fPar;
+    fCalHitColumn.push_back(Cache->AddArray(Form("%s.hit_%s",GetName(),kCalHitColumn[i].fName),"CalDataBlock",
+      [this](TStnDataBlock* B) { CalPar((TCalDataBlock*) B); return int(fCalHitPar.size()); },
+      [this,par](TStnDataBlock* B, int I) { return fCalHitPar[I].*par; }));
+  }
+
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+// same as Event, the parameters come from the event cache
+//-----------------------------------------------------------------------------
+int TClusterAnaModule::EventFromCache(TStnEventCache* Cache, int Entry) {
+
+  fElectron    = NULL;
+  fCluster     = NULL;
+  fCalParEntry = -1;
+
+  fNClusters = Cache->Size(fClusterColumn[0],Entry);
+  fClusterPar.resize(fNClusters);
+  for (int k=0; kClusterColumn[k].fName; k++) {
+    const float* x = Cache->Array(fClusterColumn[k],Entry);
+    for (int i=0; i<fNClusters; i++) fClusterPar[i].*kClusterColumn[k].fPar = x[i];
+  }
+
+  fNDisks = int(Cache->Scalar(fNDisksColumn,Entry));
+
+  int nc = Cache->Size(fCrystalColumn[0],Entry);
+  fCrystalPar.resize(nc);
+  for (int k=0; kCrystalColumn[k].fName; k++) {
+    const float* x = Cache->Array(fCrystalColumn[k],Entry);
+    for (int i=0; i<nc; i++) fCrystalPar[i].*kCrystalColumn[k].fPar = x[i];
+  }
+
+  int nh = Cache->Size(fCalHitColumn[0],Entry);
+  fCalHitPar.resize(nh);
+  for (int k=0; kCalHitColumn[k].fName; k++) {
+    const float* x = Cache->Array(fCalHitColumn[k],Entry);
+    for (int i=0; i<nh; i++) fCalHitPar[i].*kCalHitColumn[k].fPar = x[i];
+  }
+
+  FillHistograms();
+
+  return 0;
+}
+
 //-----------------------------------------------------------------------------
 void TClusterAnaModule::Debug() {
 
@@ -36,6 +36,8 @@ TCrvAnaModule::TCrvAnaModule(const char* name, const char* title):
   fPtMin  = 1.;
 
   fMinT0 = 0; // do not cut on time by default
+
+  fCrvPulseHist = NULL;
 //-----------------------------------------------------------------------------
 // MC truth: define which MC particle to consider as signal
 //-----------------------------------------------------------------------------
@@ -65,23 +67,6 @@ void TCrvAnaModule::BookCrvClusterHistograms   (CrvClusterHist_t*   Hist, const
   HBook2F(Hist->fYVsZ          ,"y_vs_z"     ,Form("%s: Y vs Z"          ,Folder), 250,   -5000,20000,200,     0,4000,Folder);  
 }
 
-//-----------------------------------------------------------------------------
-void TCrvAnaModule::BookCrvPulseHistograms   (CrvPulseHist_t*   Hist, const char* Folder){
-
-  HBook1F(Hist->fNPe       ,"npe"        ,Form("%s: N(Pe)"     ,Folder), 250,   0,   500,Folder);
-  HBook1F(Hist->fNPeHeight ,"npe_height" ,Form("%s: NPE_HEIGHT",Folder), 250,   0,   500,Folder);
-  HBook1F(Hist->fNDigis    ,"ndigis"     ,Form("%s: N(digis)"  ,Folder),  10,   0,    10,Folder);
-  HBook1F(Hist->fBar       ,"bar"        ,Form("%s: bar"       ,Folder), 600,   0,  6000,Folder);
-  HBook1F(Hist->fSipm      ,"sipm"       ,Form("%s: sipm"      ,Folder),  10,   0,    10,Folder);
-
-  HBook1F(Hist->fTime      ,"time"       ,Form("%s: time"      ,Folder), 500,   0,  2000,Folder);
-  HBook1F(Hist->fHeight    ,"height"     ,Form("%s: height"    ,Folder), 500,   0,  2000,Folder);
-  HBook1F(Hist->fWidth     ,"width"      ,Form("%s: width"     ,Folder), 500,   0,   500,Folder);
-  HBook1F(Hist->fChi2      ,"chi2"       ,Form("%s: chi2"      ,Folder), 500,   0,   500,Folder);
-  HBook1F(Hist->fLeTime    ,"le_time"    ,Form("%s: LE time"   ,Folder), 500,   0,  2000,Folder);
-  HBook1F(Hist->fDt        ,"dt"         ,Form("%s: LEt-t"     ,Folder), 100, -50,    50,Folder);
-}
-
 //-----------------------------------------------------------------------------
 void TCrvAnaModule::BookGenpHistograms(GenpHist_t* Hist, const char* Folder) {
 //   char name [200];
@@ -191,21 +176,33 @@ void TCrvAnaModule::BookHistograms() {
     }
   }
 //-----------------------------------------------------------------------------
-// book CRV pulse histograms
+// CRV pulse histograms: declarative sets, ROOT histograms are created
+// in the end of job
 //-----------------------------------------------------------------------------
-  int book_pulse_histset[kNCrvPulseHistSets];
-  for (int i=0; i<kNCrvPulseHistSets; i++) book_pulse_histset[i] = 0;
+  if (fCrvPulseHist == NULL) {
+    TStnHistSet<TCrvRecoPulse>* hs = new TStnHistSet<TCrvRecoPulse>("crvp");
 
-  book_pulse_histset[0] = 1;		// all particles
+    hs->AddVar("npe"       ,"N(Pe)"     , 250,   0,   500,[](TCrvRecoPulse* P) { return P->NPe      (); });
+    hs->AddVar("npe_height","NPE_HEIGHT", 250,   0,   500,[](TCrvRecoPulse* P) { return P->NPeHeight(); });
+    hs->AddVar("ndigis"    ,"N(digis)"  ,  10,   0,    10,[](TCrvRecoPulse* P) { return P->NDigis   (); });
+    hs->AddVar("bar"       ,"bar"       , 600,   0,  6000,[](TCrvRecoPulse* P) { return P->Bar      (); });
+    hs->AddVar("sipm"      ,"sipm"      ,  10,   0,    10,[](TCrvRecoPulse* P) { return P->Sipm     (); });
 
-  for (int i=0; i<kNCrvPulseHistSets; i++) {
-    if (book_pulse_histset[i] != 0) {
-      sprintf(folder_name,"crvp_%i",i);
-      fol = (TFolder*) hist_folder->FindObject(folder_name);
-      if (! fol) fol = hist_folder->AddFolder(folder_name,folder_name);
-      fHist.fCrvPulse[i] = new CrvPulseHist_t;
-      BookCrvPulseHistograms(fHist.fCrvPulse[i],Form("Hist/%s",folder_name));
-    }
+    hs->AddVar("time"      ,"time"      , 500,   0,  2000,[](TCrvRecoPulse* P) { return P->Time     (); });
+    hs->AddVar("height"    ,"height"    , 500,   0,  2000,[](TCrvRecoPulse* P) { return P->Height   (); });
+    hs->AddVar("width"     ,"width"     , 500,   0,   500,[](TCrvRecoPulse* P) { return P->Width    (); });
+    hs->AddVar("chi2"      ,"chi2"      , 500,   0,   500,[](TCrvRecoPulse* P) { return P->Chi2     (); });
+    hs->AddVar("le_time"   ,"LE time"   , 500,   0,  2000,[](TCrvRecoPulse* P) { return P->LeTime   (); });
+    hs->AddVar("dt"        ,"LEt-t"     , 100, -50,    50,
+	       [](TCrvRecoPulse* P) { return P->LeTime()-P->Time(); });
+
+    hs->AddSet(0);			// all pulses
+
+    fCrvPulseHist = hs;
+    AddHistSet(hs);
+  }
+  else {
+    fCrvPulseHist->Reset();
   }
 //-----------------------------------------------------------------------------
 // book CRV cluster histograms
@@ -314,24 +311,6 @@ void TCrvAnaModule::FillCrvClusterHistograms(CrvClusterHist_t* Hist, TCrvCoincid
   Hist->fYVsZ->Fill(z,y);
 }
 
-//-----------------------------------------------------------------------------
-void TCrvAnaModule::FillCrvPulseHistograms(CrvPulseHist_t* Hist, TCrvRecoPulse* Pulse) {
-
-  Hist->fNPe->Fill(Pulse->NPe());
-  Hist->fNPeHeight->Fill(Pulse->NPeHeight());
-  Hist->fNDigis->Fill(Pulse->NDigis());
-  Hist->fBar->Fill(Pulse->Bar());
-  Hist->fSipm->Fill(Pulse->Sipm());
-  Hist->fTime->Fill(Pulse->Time());
-  Hist->fHeight->Fill(Pulse->Height());
-  Hist->fWidth->Fill(Pulse->Width());
-  Hist->fChi2->Fill(Pulse->Chi2());
-  Hist->fLeTime->Fill(Pulse->LeTime());
-
-  float dt = Pulse->LeTime()-Pulse->Time();
-  Hist->fDt->Fill(dt);
-}
-
 //-----------------------------------------------------------------------------
 // register data blocks and book histograms
 //-----------------------------------------------------------------------------
@@ -399,7 +378,7 @@ void TCrvAnaModule::FillHistograms() {
 
   for (int i=0; i<np; i++) {
     TCrvRecoPulse* p = fCrvPulseBlock->Pulse(i);
-    FillCrvPulseHistograms(fHist.fCrvPulse[0],p);
+    fCrvPulseHist->Fill(p);
   }
 }
 
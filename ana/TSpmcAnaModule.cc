@@ -86,6 +86,20 @@ int TSpmcAnaModule::BeginJob() {
 // book histograms
 //-----------------------------------------------------------------------------
   BookHistograms();
+//-----------------------------------------------------------------------------
+// VD dispatch table, has to match the VD histogram sets booked above
+//-----------------------------------------------------------------------------
+  for (int i=0; i<kMaxVDetID; i++) fVDetFlags[i] = 0;
+
+  fVDetFlags[ 9] |= kVDetOwnSet;
+  fVDetFlags[13] |= kVDetOwnSet;
+
+  for (int i=1; i<=9; i++) fVDetFlags[i] |= kVDetStd | kVDetPbar;
+
+  fVDetFlags[91] |= kVDetPbar;
+  fVDetFlags[92] |= kVDetPbar;
+  fVDetFlags[98] |= kVDetStd | kVDetPbar;
+  fVDetFlags[99] |= kVDetStd | kVDetPbar;
 
 //-----------------------------------------------------------------------------
 // initialize virtual detector offsets - a convenience for histogram filling
@@ -887,6 +901,14 @@ void TSpmcAnaModule::FillHistograms() {
 
   //  int nsteps = fStepPointMCBlock->NStepPoints();
   int nsteps = fSpmcBlockVDet->NStepPoints();
+//-----------------------------------------------------------------------------
+// pbar VD hits are histogrammed for each pbar step, collect them once
+//-----------------------------------------------------------------------------
+  fPbarSteps.clear();
+  for (int i=0; i<fNVDetHits; i++) {
+    if (fSpmcBlockVDet->StepPointMC(i)->PDGCode() == -2212) fPbarSteps.push_back(i);
+  }
+
   for (int i=0; i<nsteps; i++) {
     //  spmc             = fStepPointMCBlock->StepPointMC(i);
     spmc             = fSpmcBlockVDet->StepPointMC(i);
@@ -960,17 +982,13 @@ void TSpmcAnaModule::FillHistograms() {
       TSimParticle* simp = fSimpBlock->Particle(0);
       if (simp->PDGCode() != -2212) {
 	int simp_id   = spmc->SimID();
-	simp          = fSimpBlock->FindParticle(simp_id);
-	int parent_id = simp->ParentID();
-
-	TSimParticle* parent = fSimpBlock->FindParticle(parent_id);
-	int gpid  = parent->ParentID();
-	while (gpid > 0) {
-	  TSimParticle* gp  = fSimpBlock->FindParticle(gpid);
-	  simp      = parent;
-	  parent    = gp;
-	  gpid      = gp->ParentID();
-	}
+//-----------------------------------------------------------------------------
+// chain[n-1] is the primary, the antiproton is the next one down the chain
+//-----------------------------------------------------------------------------
+	std::vector<TSimParticle*> chain;
+	int n = fSimpBlock->GetParentChain(fSimpBlock->FindParticle(simp_id),&chain);
+	if      (n >  1) simp = chain[n-2];
+	else if (n == 1) simp = chain[0];
       }
       // 
       FillSimpHistograms(fHist.fSimp[1021],simp,sd);
@@ -980,28 +998,7 @@ void TSpmcAnaModule::FillHistograms() {
 // in different detectors
 // note, that there is not 'last plane' to TGTSTOPS and such - pbars just stop 
 //-----------------------------------------------------------------------------
-      int nh = 0;
-      for (int i=0; i<fNVDetHits; i++) {
-		TStepPointMC* step = fSpmcBlockVDet->StepPointMC(i);
-	if (step->PDGCode() == -2212) {
-	  if      ((step->SimID() < 100000) && (step->VolumeID() ==  91)) {
-	    FillVDetHistograms(fHist.fVDet[3091],step);
-	    nh++;
-	  }
-	  else if (step->VolumeID() ==  92) FillVDetHistograms(fHist.fVDet[3092],step);
-	  else if (step->VolumeID() ==   1) FillVDetHistograms(fHist.fVDet[3001],step);
-	  else if (step->VolumeID() ==   2) FillVDetHistograms(fHist.fVDet[3002],step);
-	  else if (step->VolumeID() ==   3) FillVDetHistograms(fHist.fVDet[3003],step);
-	  else if (step->VolumeID() ==   4) FillVDetHistograms(fHist.fVDet[3004],step);
-	  else if (step->VolumeID() ==   5) FillVDetHistograms(fHist.fVDet[3005],step);
-	  else if (step->VolumeID() ==   6) FillVDetHistograms(fHist.fVDet[3006],step);
-	  else if (step->VolumeID() ==   7) FillVDetHistograms(fHist.fVDet[3007],step);
-	  else if (step->VolumeID() ==   8) FillVDetHistograms(fHist.fVDet[3008],step);
-	  else if (step->VolumeID() ==   9) FillVDetHistograms(fHist.fVDet[3009],step);
-	  else if (step->VolumeID() ==  98) FillVDetHistograms(fHist.fVDet[3098],step);
-	  else if (step->VolumeID() ==  99) FillVDetHistograms(fHist.fVDet[3099],step);
-	}
-      }
+      FillPbarVDetHistograms(3000);
 
       if (p > 100) { 
 	FillStepPointMCHistograms(fHist.fStepPointMC[ 22],spmc,&spmc_data);                  // pbars p > 100 MeV/c
@@ -1014,28 +1011,7 @@ void TSpmcAnaModule::FillHistograms() {
 // in different detectors
 // note, that there is not 'last plane' to TGTSTOPS and such - pbars just stop 
 //-----------------------------------------------------------------------------
-	int nh = 0;
-	for (int i=0; i<fNVDetHits; i++) {
-	  TStepPointMC* step = fSpmcBlockVDet->StepPointMC(i);
-	  if (step->PDGCode() == -2212) {
-	    if      ((step->SimID() < 100000) && (step->VolumeID() ==  91)) {
-	      FillVDetHistograms(fHist.fVDet[4091],step);
-	      nh++;
-	    }
-	    else if (step->VolumeID() ==  92) FillVDetHistograms(fHist.fVDet[4092],step);
-	    else if (step->VolumeID() ==   1) FillVDetHistograms(fHist.fVDet[4001],step);
-	    else if (step->VolumeID() ==   2) FillVDetHistograms(fHist.fVDet[4002],step);
-	    else if (step->VolumeID() ==   3) FillVDetHistograms(fHist.fVDet[4003],step);
-	    else if (step->VolumeID() ==   4) FillVDetHistograms(fHist.fVDet[4004],step);
-	    else if (step->VolumeID() ==   5) FillVDetHistograms(fHist.fVDet[4005],step);
-	    else if (step->VolumeID() ==   6) FillVDetHistograms(fHist.fVDet[4006],step);
-	    else if (step->VolumeID() ==   7) FillVDetHistograms(fHist.fVDet[4007],step);
-	    else if (step->VolumeID() ==   8) FillVDetHistograms(fHist.fVDet[4008],step);
-	    else if (step->VolumeID() ==   9) FillVDetHistograms(fHist.fVDet[4009],step);
-	    else if (step->VolumeID() ==  98) FillVDetHistograms(fHist.fVDet[4098],step);
-	    else if (step->VolumeID() ==  99) FillVDetHistograms(fHist.fVDet[4099],step);
-	  }
-	}
+	FillPbarVDetHistograms(4000);
       }
 
     }
@@ -1066,207 +1042,95 @@ void TSpmcAnaModule::FillHistograms() {
   }
   
 //-----------------------------------------------------------------------------
-// VDET histograms
+// VDET histograms: the hits are processed in batches, one VD at a time,
+// see TStepPointMCBlock::VolumeIndex
 //-----------------------------------------------------------------------------
-  for (int i=0; i<fNVDetHits; i++) {
-    TStepPointMC* step = fSpmcBlockVDet->StepPointMC(i);
-
-    if (step->VolumeID() ==  9) FillVDetHistograms(fHist.fVDet[ 9],step);
-    if (step->VolumeID() == 13) {
-      FillVDetHistograms(fHist.fVDet[13],step);
-      float x = step->Pos()->X()+3904.;
-      float y = step->Pos()->Y();
-      float r = sqrt(x*x+y*y);
-      if ((r >= 400) && (r < 800)) { 
-	FillVDetHistograms(fHist.fVDet[14],step);
-      }
-    }
+  TVolumeIndex* vi   = fSpmcBlockVDet->VolumeIndex();
+  int           nvol = vi->NVolumes();
 
-    if (step->PDGCode() == 11) {
-      if (step->VolumeID() ==  1) FillVDetHistograms(fHist.fVDet[101],step);
-      if (step->VolumeID() ==  2) FillVDetHistograms(fHist.fVDet[102],step);
-      if (step->VolumeID() ==  3) FillVDetHistograms(fHist.fVDet[103],step);
-      if (step->VolumeID() ==  4) FillVDetHistograms(fHist.fVDet[104],step);
-      if (step->VolumeID() ==  5) FillVDetHistograms(fHist.fVDet[105],step);
-      if (step->VolumeID() ==  6) FillVDetHistograms(fHist.fVDet[106],step);
-      if (step->VolumeID() ==  7) FillVDetHistograms(fHist.fVDet[107],step);
-      if (step->VolumeID() ==  8) FillVDetHistograms(fHist.fVDet[108],step);
-      if (step->VolumeID() ==  9) FillVDetHistograms(fHist.fVDet[109],step);
-      if (step->VolumeID() == 98) FillVDetHistograms(fHist.fVDet[198],step);
-      if (step->VolumeID() == 99) FillVDetHistograms(fHist.fVDet[199],step);
-    }
-    if (step->PDGCode() == -11) {
-      if (step->VolumeID() ==  1) FillVDetHistograms(fHist.fVDet[201],step);
-      if (step->VolumeID() ==  2) FillVDetHistograms(fHist.fVDet[202],step);
-      if (step->VolumeID() ==  3) FillVDetHistograms(fHist.fVDet[203],step);
-      if (step->VolumeID() ==  4) FillVDetHistograms(fHist.fVDet[204],step);
-      if (step->VolumeID() ==  5) FillVDetHistograms(fHist.fVDet[205],step);
-      if (step->VolumeID() ==  6) FillVDetHistograms(fHist.fVDet[206],step);
-      if (step->VolumeID() ==  7) FillVDetHistograms(fHist.fVDet[207],step);
-      if (step->VolumeID() ==  8) FillVDetHistograms(fHist.fVDet[208],step);
-      if (step->VolumeID() ==  9) FillVDetHistograms(fHist.fVDet[209],step);
-      if (step->VolumeID() == 98) FillVDetHistograms(fHist.fVDet[298],step);
-      if (step->VolumeID() == 99) FillVDetHistograms(fHist.fVDet[299],step);
-    }
-    if (step->PDGCode() == 13) {
-      if (step->VolumeID() ==  1) FillVDetHistograms(fHist.fVDet[301],step);
-      if (step->VolumeID() ==  2) FillVDetHistograms(fHist.fVDet[302],step);
-      if (step->VolumeID() ==  3) FillVDetHistograms(fHist.fVDet[303],step);
-      if (step->VolumeID() ==  4) FillVDetHistograms(fHist.fVDet[304],step);
-      if (step->VolumeID() ==  5) FillVDetHistograms(fHist.fVDet[305],step);
-      if (step->VolumeID() ==  6) FillVDetHistograms(fHist.fVDet[306],step);
-      if (step->VolumeID() ==  7) FillVDetHistograms(fHist.fVDet[307],step);
-      if (step->VolumeID() ==  8) FillVDetHistograms(fHist.fVDet[308],step);
-      if (step->VolumeID() ==  9) FillVDetHistograms(fHist.fVDet[309],step);
-      if (step->VolumeID() == 98) FillVDetHistograms(fHist.fVDet[398],step);
-      if (step->VolumeID() == 99) FillVDetHistograms(fHist.fVDet[399],step);
-
-      float pmu = step->Mom()->Mag();
-      if (pmu < 50) {
-	if (step->VolumeID() ==  1) FillVDetHistograms(fHist.fVDet[501],step);
-	if (step->VolumeID() ==  2) FillVDetHistograms(fHist.fVDet[502],step);
-	if (step->VolumeID() ==  3) FillVDetHistograms(fHist.fVDet[503],step);
-	if (step->VolumeID() ==  4) FillVDetHistograms(fHist.fVDet[504],step);
-	if (step->VolumeID() ==  5) FillVDetHistograms(fHist.fVDet[505],step);
-	if (step->VolumeID() ==  6) FillVDetHistograms(fHist.fVDet[506],step);
-	if (step->VolumeID() ==  7) FillVDetHistograms(fHist.fVDet[507],step);
-	if (step->VolumeID() ==  8) FillVDetHistograms(fHist.fVDet[508],step);
-	if (step->VolumeID() ==  9) FillVDetHistograms(fHist.fVDet[509],step);
-	if (step->VolumeID() == 98) FillVDetHistograms(fHist.fVDet[598],step);
-	if (step->VolumeID() == 99) FillVDetHistograms(fHist.fVDet[599],step);
+  for (int k=0; k<nvol; k++) {
+    int vid = vi->VolumeID(k);
+    if ((vid < 0) || (vid >= kMaxVDetID))                   continue;
+
+    int flags = fVDetFlags[vid];
+    if (flags == 0)                                         continue;
+
+    int nh = vi->NObjects(k);
+    for (int j=0; j<nh; j++) {
+      TStepPointMC* step = fSpmcBlockVDet->StepPointMC(vi->Object(k,j));
+      int           pdg  = step->PDGCode();
+
+      if (flags & kVDetOwnSet) {
+	FillVDetHistograms(fHist.fVDet[vid],step);
+	if (vid == 13) {
+	  float x = step->Pos()->X()+3904.;
+	  float y = step->Pos()->Y();
+	  float r = sqrt(x*x+y*y);
+	  if ((r >= 400) && (r < 800)) { 
+	    FillVDetHistograms(fHist.fVDet[14],step);
+	  }
+	}
       }
-      else {
-	if (step->VolumeID() ==  1) FillVDetHistograms(fHist.fVDet[601],step);
-	if (step->VolumeID() ==  2) FillVDetHistograms(fHist.fVDet[602],step);
-	if (step->VolumeID() ==  3) FillVDetHistograms(fHist.fVDet[603],step);
-	if (step->VolumeID() ==  4) FillVDetHistograms(fHist.fVDet[604],step);
-	if (step->VolumeID() ==  5) FillVDetHistograms(fHist.fVDet[605],step);
-	if (step->VolumeID() ==  6) FillVDetHistograms(fHist.fVDet[606],step);
-	if (step->VolumeID() ==  7) FillVDetHistograms(fHist.fVDet[607],step);
-	if (step->VolumeID() ==  8) FillVDetHistograms(fHist.fVDet[608],step);
-	if (step->VolumeID() ==  9) FillVDetHistograms(fHist.fVDet[609],step);
-	if (step->VolumeID() == 98) FillVDetHistograms(fHist.fVDet[698],step);
-	if (step->VolumeID() == 99) FillVDetHistograms(fHist.fVDet[699],step);
+
+      if (flags & kVDetStd) {
+	if      (pdg ==   11) FillVDetHistograms(fHist.fVDet[100+vid],step);
+	else if (pdg ==  -11) FillVDetHistograms(fHist.fVDet[200+vid],step);
+	else if (pdg ==   13) {
+	  FillVDetHistograms(fHist.fVDet[300+vid],step);
+	  float pmu = step->Mom()->Mag();
+	  if (pmu < 50) FillVDetHistograms(fHist.fVDet[500+vid],step);
+	  else          FillVDetHistograms(fHist.fVDet[600+vid],step);
+	}
+	else if (pdg ==  -13) FillVDetHistograms(fHist.fVDet[400+vid],step);
+//-----------------------------------------------------------------------------
+// negative and positive pions
+//-----------------------------------------------------------------------------
+	else if (pdg == -211) {
+	  FillVDetHistograms(fHist.fVDet[1000+vid],step);
+	  FillVDetHistograms(fHist.fVDet[1200+vid],step,fWeight);
+	}
+	else if (pdg ==  211) {
+	  FillVDetHistograms(fHist.fVDet[1100+vid],step);
+	  FillVDetHistograms(fHist.fVDet[1300+vid],step,fWeight);
+	}
       }
-    }
-    if (step->PDGCode() == -13) {
-      if (step->VolumeID() ==  1) FillVDetHistograms(fHist.fVDet[401],step);
-      if (step->VolumeID() ==  2) FillVDetHistograms(fHist.fVDet[402],step);
-      if (step->VolumeID() ==  3) FillVDetHistograms(fHist.fVDet[403],step);
-      if (step->VolumeID() ==  4) FillVDetHistograms(fHist.fVDet[404],step);
-      if (step->VolumeID() ==  5) FillVDetHistograms(fHist.fVDet[405],step);
-      if (step->VolumeID() ==  6) FillVDetHistograms(fHist.fVDet[406],step);
-      if (step->VolumeID() ==  7) FillVDetHistograms(fHist.fVDet[407],step);
-      if (step->VolumeID() ==  8) FillVDetHistograms(fHist.fVDet[408],step);
-      if (step->VolumeID() ==  9) FillVDetHistograms(fHist.fVDet[409],step);
-      if (step->VolumeID() == 98) FillVDetHistograms(fHist.fVDet[498],step);
-      if (step->VolumeID() == 99) FillVDetHistograms(fHist.fVDet[499],step);
-    }
 //-----------------------------------------------------------------------------
-// negative pions
-//-----------------------------------------------------------------------------
-    if (step->PDGCode() == -211) {
-      if (step->VolumeID() ==  1) FillVDetHistograms(fHist.fVDet[1001],step);
-      if (step->VolumeID() ==  2) FillVDetHistograms(fHist.fVDet[1002],step);
-      if (step->VolumeID() ==  3) FillVDetHistograms(fHist.fVDet[1003],step);
-      if (step->VolumeID() ==  4) FillVDetHistograms(fHist.fVDet[1004],step);
-      if (step->VolumeID() ==  5) FillVDetHistograms(fHist.fVDet[1005],step);
-      if (step->VolumeID() ==  6) FillVDetHistograms(fHist.fVDet[1006],step);
-      if (step->VolumeID() ==  7) FillVDetHistograms(fHist.fVDet[1007],step);
-      if (step->VolumeID() ==  8) FillVDetHistograms(fHist.fVDet[1008],step);
-      if (step->VolumeID() ==  9) FillVDetHistograms(fHist.fVDet[1009],step);
-      if (step->VolumeID() == 98) FillVDetHistograms(fHist.fVDet[1098],step);
-      if (step->VolumeID() == 99) FillVDetHistograms(fHist.fVDet[1099],step);
-
-      if (step->VolumeID() ==  1) FillVDetHistograms(fHist.fVDet[1201],step,fWeight);
-      if (step->VolumeID() ==  2) FillVDetHistograms(fHist.fVDet[1202],step,fWeight);
-      if (step->VolumeID() ==  3) FillVDetHistograms(fHist.fVDet[1203],step,fWeight);
-      if (step->VolumeID() ==  4) FillVDetHistograms(fHist.fVDet[1204],step,fWeight);
-      if (step->VolumeID() ==  5) FillVDetHistograms(fHist.fVDet[1205],step,fWeight);
-      if (step->VolumeID() ==  6) FillVDetHistograms(fHist.fVDet[1206],step,fWeight);
-      if (step->VolumeID() ==  7) FillVDetHistograms(fHist.fVDet[1207],step,fWeight);
-      if (step->VolumeID() ==  8) FillVDetHistograms(fHist.fVDet[1208],step,fWeight);
-      if (step->VolumeID() ==  9) FillVDetHistograms(fHist.fVDet[1209],step,fWeight);
-      if (step->VolumeID() == 98) FillVDetHistograms(fHist.fVDet[1298],step,fWeight);
-      if (step->VolumeID() == 99) FillVDetHistograms(fHist.fVDet[1299],step,fWeight);
-    }
+// pbars
 //-----------------------------------------------------------------------------
-// positive pions
-//-----------------------------------------------------------------------------
-    if (step->PDGCode() ==  211) {
-      if (step->VolumeID() ==  1) FillVDetHistograms(fHist.fVDet[1101],step);
-      if (step->VolumeID() ==  2) FillVDetHistograms(fHist.fVDet[1102],step);
-      if (step->VolumeID() ==  3) FillVDetHistograms(fHist.fVDet[1103],step);
-      if (step->VolumeID() ==  4) FillVDetHistograms(fHist.fVDet[1104],step);
-      if (step->VolumeID() ==  5) FillVDetHistograms(fHist.fVDet[1105],step);
-      if (step->VolumeID() ==  6) FillVDetHistograms(fHist.fVDet[1106],step);
-      if (step->VolumeID() ==  7) FillVDetHistograms(fHist.fVDet[1107],step);
-      if (step->VolumeID() ==  8) FillVDetHistograms(fHist.fVDet[1108],step);
-      if (step->VolumeID() ==  9) FillVDetHistograms(fHist.fVDet[1109],step);
-      if (step->VolumeID() == 98) FillVDetHistograms(fHist.fVDet[1198],step);
-      if (step->VolumeID() == 99) FillVDetHistograms(fHist.fVDet[1199],step);
-
-      if (step->VolumeID() ==  1) FillVDetHistograms(fHist.fVDet[1301],step,fWeight);
-      if (step->VolumeID() ==  2) FillVDetHistograms(fHist.fVDet[1302],step,fWeight);
-      if (step->VolumeID() ==  3) FillVDetHistograms(fHist.fVDet[1303],step,fWeight);
-      if (step->VolumeID() ==  4) FillVDetHistograms(fHist.fVDet[1304],step,fWeight);
-      if (step->VolumeID() ==  5) FillVDetHistograms(fHist.fVDet[1305],step,fWeight);
-      if (step->VolumeID() ==  6) FillVDetHistograms(fHist.fVDet[1306],step,fWeight);
-      if (step->VolumeID() ==  7) FillVDetHistograms(fHist.fVDet[1307],step,fWeight);
-      if (step->VolumeID() ==  8) FillVDetHistograms(fHist.fVDet[1308],step,fWeight);
-      if (step->VolumeID() ==  9) FillVDetHistograms(fHist.fVDet[1309],step,fWeight);
-      if (step->VolumeID() == 98) FillVDetHistograms(fHist.fVDet[1398],step,fWeight);
-      if (step->VolumeID() == 99) FillVDetHistograms(fHist.fVDet[1399],step,fWeight);
+      if ((flags & kVDetPbar) && (pdg == -2212)) {
+	FillVDetHistograms(fHist.fVDet[2000+vid],step);
+	FillVDetHistograms(fHist.fVDet[2200+vid],step,fWeight);
+	if (pbar_stopped_in_st) {
+	  FillVDetHistograms(fHist.fVDet[2500+vid],step,fWeight);
+	}
+      }
     }
+  }
+}
+
 //-----------------------------------------------------------------------------
-// pbars
+// pbar hits in the VDs, set <Base>+<VD ID>, for VD 91 only the hits of
+// the first stage particles are used
 //-----------------------------------------------------------------------------
-    if (step->PDGCode() == -2212) {
-      if (step->VolumeID() ==  1) FillVDetHistograms(fHist.fVDet[2001],step);
-      if (step->VolumeID() ==  2) FillVDetHistograms(fHist.fVDet[2002],step);
-      if (step->VolumeID() ==  3) FillVDetHistograms(fHist.fVDet[2003],step);
-      if (step->VolumeID() ==  4) FillVDetHistograms(fHist.fVDet[2004],step);
-      if (step->VolumeID() ==  5) FillVDetHistograms(fHist.fVDet[2005],step);
-      if (step->VolumeID() ==  6) FillVDetHistograms(fHist.fVDet[2006],step);
-      if (step->VolumeID() ==  7) FillVDetHistograms(fHist.fVDet[2007],step);
-      if (step->VolumeID() ==  8) FillVDetHistograms(fHist.fVDet[2008],step);
-      if (step->VolumeID() ==  9) FillVDetHistograms(fHist.fVDet[2009],step);
-      if (step->VolumeID() == 91) FillVDetHistograms(fHist.fVDet[2091],step);
-      if (step->VolumeID() == 92) FillVDetHistograms(fHist.fVDet[2092],step);
-      if (step->VolumeID() == 98) FillVDetHistograms(fHist.fVDet[2098],step);
-      if (step->VolumeID() == 99) FillVDetHistograms(fHist.fVDet[2099],step);
-
-      if (step->VolumeID() ==  1) FillVDetHistograms(fHist.fVDet[2201],step,fWeight);
-      if (step->VolumeID() ==  2) FillVDetHistograms(fHist.fVDet[2202],step,fWeight);
-      if (step->VolumeID() ==  3) FillVDetHistograms(fHist.fVDet[2203],step,fWeight);
-      if (step->VolumeID() ==  4) FillVDetHistograms(fHist.fVDet[2204],step,fWeight);
-      if (step->VolumeID() ==  5) FillVDetHistograms(fHist.fVDet[2205],step,fWeight);
-      if (step->VolumeID() ==  6) FillVDetHistograms(fHist.fVDet[2206],step,fWeight);
-      if (step->VolumeID() ==  7) FillVDetHistograms(fHist.fVDet[2207],step,fWeight);
-      if (step->VolumeID() ==  8) FillVDetHistograms(fHist.fVDet[2208],step,fWeight);
-      if (step->VolumeID() ==  9) FillVDetHistograms(fHist.fVDet[2209],step,fWeight);
-      if (step->VolumeID() == 91) FillVDetHistograms(fHist.fVDet[2291],step,fWeight);
-      if (step->VolumeID() == 92) FillVDetHistograms(fHist.fVDet[2292],step,fWeight);
-      if (step->VolumeID() == 98) FillVDetHistograms(fHist.fVDet[2298],step,fWeight);
-      if (step->VolumeID() == 99) FillVDetHistograms(fHist.fVDet[2299],step,fWeight);
-
-      if (pbar_stopped_in_st) {
-	if (step->VolumeID() ==  1) FillVDetHistograms(fHist.fVDet[2501],step,fWeight);
-	if (step->VolumeID() ==  2) FillVDetHistograms(fHist.fVDet[2502],step,fWeight);
-	if (step->VolumeID() ==  3) FillVDetHistograms(fHist.fVDet[2503],step,fWeight);
-	if (step->VolumeID() ==  4) FillVDetHistograms(fHist.fVDet[2504],step,fWeight);
-	if (step->VolumeID() ==  5) FillVDetHistograms(fHist.fVDet[2505],step,fWeight);
-	if (step->VolumeID() ==  6) FillVDetHistograms(fHist.fVDet[2506],step,fWeight);
-	if (step->VolumeID() ==  7) FillVDetHistograms(fHist.fVDet[2507],step,fWeight);
-	if (step->VolumeID() ==  8) FillVDetHistograms(fHist.fVDet[2508],step,fWeight);
-	if (step->VolumeID() ==  9) FillVDetHistograms(fHist.fVDet[2509],step,fWeight);
-	if (step->VolumeID() == 91) FillVDetHistograms(fHist.fVDet[2591],step,fWeight);
-	if (step->VolumeID() == 92) FillVDetHistograms(fHist.fVDet[2592],step,fWeight);
-	if (step->VolumeID() == 98) FillVDetHistograms(fHist.fVDet[2598],step,fWeight);
-	if (step->VolumeID() == 99) FillVDetHistograms(fHist.fVDet[2599],step,fWeight);
+int TSpmcAnaModule::FillPbarVDetHistograms(int Base) {
+  int nh = 0;
+
+  int np = fPbarSteps.size();
+  for (int i=0; i<np; i++) {
+    TStepPointMC* step = fSpmcBlockVDet->StepPointMC(fPbarSteps[i]);
+    int           vid  = step->VolumeID();
+
+    if (vid == 91) {
+      if (step->SimID() < 100000) {
+	FillVDetHistograms(fHist.fVDet[Base+vid],step);
+	nh++;
       }
     }
+    else if ((vid >= 0) && (vid < kMaxVDetID) && (fVDetFlags[vid] & kVDetPbar)) {
+      FillVDetHistograms(fHist.fVDet[Base+vid],step);
+    }
   }
+  return nh;
 }
 
 
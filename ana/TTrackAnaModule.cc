@@ -27,6 +27,8 @@
 // 36  : TRK_23 events with P < 80: odd misidentified muons - turned out to be DIO electrons
 // 37  : TRK_26 LLHR_CAL > 5
 ///////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
+
 #include "TF1.h"
 #include "TCanvas.h"
 #include "TPad.h"
@@ -34,6 +36,8 @@
 #include "TSystem.h"
 
 #include "Stntuple/loop/TStnAna.hh"
+#include "Stntuple/loop/TStnEventCache.hh"
+#include "Stntuple/obj/TStnEvent.hh"
 #include "Stntuple/obj/TStnHeaderBlock.hh"
 #include "Stntuple/alg/TStntuple.hh"
 #include "Stntuple/geom/TDisk.hh"
@@ -66,6 +70,8 @@ TTrackAnaModule::TTrackAnaModule(const char* name, const char* title):
   fPdgCode        = 11;
   fGeneratorCode  = 56;			// stopped mu+ decay
   fBField         = 1.0;
+
+  fTrackParEntry  = -1;
 }
 
 //-----------------------------------------------------------------------------
@@ -330,17 +336,14 @@ void TTrackAnaModule::BookHistograms() {
 //-----------------------------------------------------------------------------
 void TTrackAnaModule::FillEventHistograms(EventHist_t* Hist) {
   double            cos_th(-2), dio_wt(-1.), vx(-1.e6), vy(-1.e6), rv(-1.e6), vz(-1.e6), p(-1.);
-  //  double            e, m, r;
-  const TLorentzVector*    mom;
-
-  if (fParticle) {
-    mom = fParticle->StartMom();
-    p      = mom->P();
-    cos_th = mom->Pz()/p;
-    vx     = fParticle->StartPos()->X()+3904;
-    vy     = fParticle->StartPos()->Y();
-    rv     = sqrt(vx*vx+vy*vy);
-    vz     = fParticle->StartPos()->Z();
+
+  if (fSimpPar.fFound) {
+    p      = fSimpPar.fP;
+    cos_th = fSimpPar.fCosTh;
+    vx     = fSimpPar.fVx;
+    vy     = fSimpPar.fVy;
+    rv     = fSimpPar.fRv;
+    vz     = fSimpPar.fVz;
     dio_wt = TStntuple::DioWeightAl(p);
   }
 
@@ -355,13 +358,11 @@ void TTrackAnaModule::FillEventHistograms(EventHist_t* Hist) {
   // Hist->fNClusters->Fill(fNClusters);
   Hist->fNTracks->Fill  (fNTracks[0]);
 
-  int nsh = GetHeaderBlock()->NStrawHits();
-  Hist->fNStrawHits[0]->Fill(nsh);
-  Hist->fNStrawHits[1]->Fill(nsh);
+  Hist->fNStrawHits[0]->Fill(fNStrawHits);
+  Hist->fNStrawHits[1]->Fill(fNStrawHits);
 
-  int nch = GetHeaderBlock()->NComboHits();
-  Hist->fNComboHits[0]->Fill(nch);
-  Hist->fNComboHits[1]->Fill(nch);
+  Hist->fNComboHits[0]->Fill(fNComboHits);
+  Hist->fNComboHits[1]->Fill(fNComboHits);
 
   double emax   = -1;
   double dt     = 9999.;
@@ -376,38 +377,20 @@ void TTrackAnaModule::FillEventHistograms(EventHist_t* Hist) {
 }
 
 //-----------------------------------------------------------------------------
-void TTrackAnaModule::FillGenpHistograms(GenpHist_t* Hist, TGenParticle* Genp) {
-  int    gen_id;
-  float  p, cos_th, z0, t0, r0, x0, y0;
+void TTrackAnaModule::FillGenpHistograms(GenpHist_t* Hist, GenpPar_t* Genp) {
 
-  TLorentzVector mom, v;
-
-  Genp->Momentum(mom);
-  //  Genp->ProductionVertex(v);
-
-  p      = mom.P();
-  cos_th = mom.CosTheta();
-
-  x0     = Genp->Vx()+3904.;
-  y0     = Genp->Vy();
-
-  z0     = Genp->Vz();
-  t0     = Genp->T();
-  r0     = sqrt(x0*x0+y0*y0);
-  gen_id = Genp->GetStatusCode();
-
-  Hist->fPdgCode[0]->Fill(Genp->GetPdgCode());
-  Hist->fPdgCode[1]->Fill(Genp->GetPdgCode());
-  Hist->fGenID->Fill(gen_id);
-  Hist->fZ0->Fill(z0);
-  Hist->fT0->Fill(t0);
-  Hist->fR0->Fill(r0);
-  Hist->fP->Fill(p);
-  Hist->fCosTh->Fill(cos_th);
+  Hist->fPdgCode[0]->Fill(Genp->fPdgCode);
+  Hist->fPdgCode[1]->Fill(Genp->fPdgCode);
+  Hist->fGenID->Fill(Genp->fGenID);
+  Hist->fZ0->Fill(Genp->fZ0);
+  Hist->fT0->Fill(Genp->fT0);
+  Hist->fR0->Fill(Genp->fR0);
+  Hist->fP->Fill(Genp->fP);
+  Hist->fCosTh->Fill(Genp->fCosTh);
 }
 
 //-----------------------------------------------------------------------------
-void TTrackAnaModule::FillSimpHistograms(SimpHist_t* Hist, TSimParticle* Simp) {
+void TTrackAnaModule::FillSimpHistograms(SimpHist_t* Hist, SimpPar_t* Simp) {
 
   Hist->fPdgCode->Fill(Simp->fPdgCode);
   Hist->fMomTargetEnd->Fill(Simp->fMomTargetEnd);
@@ -418,82 +401,57 @@ void TTrackAnaModule::FillSimpHistograms(SimpHist_t* Hist, TSimParticle* Simp) {
 //-----------------------------------------------------------------------------
 // for DIO : ultimately, one would need to renormalize the distribution
 //-----------------------------------------------------------------------------
-void TTrackAnaModule::FillTrackHistograms(TrackHist_t* Hist, TStnTrack* Track) {
+void TTrackAnaModule::FillTrackHistograms(TrackHist_t* Hist, TrackPar_t* Tp) {
 
-  TLorentzVector  mom;
-  double          r;
-  int             itrk;
-  TrackPar_t*     tp;
-					// pointer to local track parameters
-  itrk = Track->Number();
-  tp   = fTrackPar+itrk;
+  TrackPar_t*     tp = Tp;
 
-  Hist->fP[0]->Fill (Track->fP);
-  Hist->fP[1]->Fill (Track->fP);
-  Hist->fP[2]->Fill (Track->fP);
-  Hist->fP0->  Fill (Track->fP0);
-  Hist->fP2->  Fill (Track->fP2);
+  Hist->fP[0]->Fill (tp->fP);
+  Hist->fP[1]->Fill (tp->fP);
+  Hist->fP[2]->Fill (tp->fP);
+  Hist->fP0->  Fill (tp->fP0);
+  Hist->fP2->  Fill (tp->fP2);
 
-  Hist->fPDio->Fill(Track->fP,tp->fDioWt);
+  Hist->fPDio->Fill(tp->fP,tp->fDioWt);
 
-  Hist->fFitMomErr->Fill(Track->fFitMomErr);
+  Hist->fFitMomErr->Fill(tp->fFitMomErr);
 
-  Hist->fPt    ->Fill(Track->fPt    );
-  Hist->fPFront->Fill(Track->fPFront);
-  Hist->fPStOut->Fill(Track->fPStOut);
+  Hist->fPt    ->Fill(tp->fPt    );
+  Hist->fPFront->Fill(tp->fPFront);
+  Hist->fPStOut->Fill(tp->fPStOut);
 					// dp: Tracker-only resolution
   Hist->fDpFront ->Fill(tp->fDpF);
   Hist->fDpFront0->Fill(tp->fDp0);
   Hist->fDpFront2->Fill(tp->fDp2);
   Hist->fDpFSt   ->Fill(tp->fDpFSt);
-  Hist->fDpFVsZ1 ->Fill(Track->fZ1,tp->fDpF);
-
-  Hist->fCosTh->Fill(Track->Momentum()->CosTheta());
-  Hist->fChi2->Fill (Track->fChi2);
-  Hist->fNDof->Fill(Track->NActive()-5.);
-  Hist->fChi2Dof->Fill(Track->fChi2/(Track->NActive()-5.));
-  Hist->fNActive->Fill(Track->NActive());
-  Hist->fT0->Fill(Track->fT0);
-  Hist->fT0Err->Fill(Track->fT0Err);
-  Hist->fQ->Fill(Track->Charge());
-  Hist->fFitCons[0]->Fill(Track->fFitCons);
-  Hist->fFitCons[1]->Fill(Track->fFitCons);
-
-  Hist->fD0->Fill(Track->fD0);
-  Hist->fZ0->Fill(Track->fZ0);
-  Hist->fTanDip->Fill(Track->fTanDip);
-  Hist->fAlgMask->Fill(Track->AlgMask());
+  Hist->fDpFVsZ1 ->Fill(tp->fZ1,tp->fDpF);
+
+  Hist->fCosTh->Fill(tp->fCosTh);
+  Hist->fChi2->Fill (tp->fChi2);
+  Hist->fNDof->Fill(tp->fNActive-5.);
+  Hist->fChi2Dof->Fill(tp->fChi2/(tp->fNActive-5.));
+  Hist->fNActive->Fill(tp->fNActive);
+  Hist->fT0->Fill(tp->fT0);
+  Hist->fT0Err->Fill(tp->fT0Err);
+  Hist->fQ->Fill(tp->fQ);
+  Hist->fFitCons[0]->Fill(tp->fFitCons);
+  Hist->fFitCons[1]->Fill(tp->fFitCons);
+
+  Hist->fD0->Fill(tp->fD0);
+  Hist->fZ0->Fill(tp->fZ0);
+  Hist->fTanDip->Fill(tp->fTanDip);
+  Hist->fAlgMask->Fill(tp->fAlgMask);
 
   Hist->fXc->Fill(tp->fXc);
   Hist->fYc->Fill(tp->fYc);
   Hist->fPhic->Fill(tp->fPhic);
 //-----------------------------------------------------------------------------
-// track-cluster matching part: 
-// - for residuals, determine intersection with the most energetic cluster
-// - for track -only parameters use intersection with lowest trajectory length
+// track-cluster matching part, see InitTrackPar
 //-----------------------------------------------------------------------------
-  TStnTrack::InterData_t*    vt = Track->fVMinS;  // track-only
-
-  if (vt) {
-    Hist->fVaneID->Fill(vt->fID  );
-    Hist->fXTrk->Fill  (vt->fXTrk);
-    Hist->fYTrk->Fill  (vt->fYTrk);
-
-    r = sqrt(vt->fXTrk*vt->fXTrk+vt->fYTrk*vt->fYTrk);
-    Hist->fRTrk->Fill  (r);
-
-    Hist->fZTrk->Fill  (vt->fZTrk);
-  }
-  else {
-//-----------------------------------------------------------------------------
-// fill histograms with numbers easy to recognize as dummy
-//-----------------------------------------------------------------------------
-    Hist->fVaneID->Fill(-1.);
-    Hist->fXTrk->Fill  (999.);
-    Hist->fYTrk->Fill  (999.);
-    Hist->fRTrk->Fill  (999.);
-    Hist->fZTrk->Fill  (-1. );
-  }
+  Hist->fVaneID->Fill(tp->fVaneID);
+  Hist->fXTrk->Fill  (tp->fXTrk);
+  Hist->fYTrk->Fill  (tp->fYTrk);
+  Hist->fRTrk->Fill  (tp->fRTrk);
+  Hist->fZTrk->Fill  (tp->fZTrk);
 //-----------------------------------------------------------------------------
 // there is an inconsistency in the SIMP block filling - in Mu2e offline 
 // the particle momentumis is kept in MeV/c, while the PDG mass  -in GeV/c^2..
@@ -501,10 +459,10 @@ void TTrackAnaModule::FillTrackHistograms(TrackHist_t* Hist, TStnTrack* Track) {
 // assign muon mass
 //-----------------------------------------------------------------------------
   double ekin(-1.);
-  if (fParticle) {
+  if (fSimpPar.fFound) {
     double p, m;
     //    p    = fSimp->fStartMom.P();
-    p = Track->fP;
+    p = tp->fP;
     m    = 105.658; // in MeV
     ekin = sqrt(p*p+m*m)-m;
   }
@@ -546,28 +504,27 @@ void TTrackAnaModule::FillTrackHistograms(TrackHist_t* Hist, TStnTrack* Track) {
   Hist->fDvVsPath->Fill(tp->fPath,tp->fDv);
   Hist->fDtVsPath->Fill(tp->fPath,tp->fDt);
 
-  Hist->fDuVsTDip->Fill(Track->fTanDip,tp->fDu);
-  Hist->fDvVsTDip->Fill(Track->fTanDip,tp->fDv);
+  Hist->fDuVsTDip->Fill(tp->fTanDip,tp->fDu);
+  Hist->fDvVsTDip->Fill(tp->fTanDip,tp->fDv);
 
-  Hist->fZ1->Fill(Track->fZ1);
+  Hist->fZ1->Fill(tp->fZ1);
 
-  int ncl = Track->NClusters();
-  Hist->fNClusters->Fill(ncl);
+  Hist->fNClusters->Fill(tp->fNClusters);
 
-  Hist->fRSlope->Fill(Track->RSlope());
-  Hist->fXSlope->Fill(Track->XSlope());
+  Hist->fRSlope->Fill(tp->fRSlope);
+  Hist->fXSlope->Fill(tp->fXSlope);
 
   double llhr_dedx, llhr_xs, llhr_cal, llhr_trk, llhr;
 
-  Hist->fEleLogLHCal->Fill(Track->EleLogLHCal());
-  Hist->fMuoLogLHCal->Fill(Track->MuoLogLHCal());
+  Hist->fEleLogLHCal->Fill(tp->fEleLogLHCal);
+  Hist->fMuoLogLHCal->Fill(tp->fMuoLogLHCal);
 
-  llhr_cal = Track->LogLHRCal();
+  llhr_cal = tp->fLogLHRCal;
   Hist->fLogLHRCal->Fill(llhr_cal);
 
-  llhr_dedx = Track->LogLHRDeDx();
-  llhr_xs   = Track->LogLHRXs();
-  llhr_trk  = Track->LogLHRTrk();
+  llhr_dedx = tp->fLogLHRDeDx;
+  llhr_xs   = tp->fLogLHRXs;
+  llhr_trk  = tp->fLogLHRTrk;
   llhr      = llhr_cal+llhr_trk;
 
   Hist->fEpVsDt->Fill(tp->fDt,tp->fEp);
@@ -576,12 +533,12 @@ void TTrackAnaModule::FillTrackHistograms(TrackHist_t* Hist, TStnTrack* Track) {
   Hist->fLogLHRTrk->Fill(llhr_trk);
   Hist->fLogLHR->Fill(llhr);
 
-  Hist->fPdgCode->Fill(Track->fPdgCode);
-  Hist->fFrGH->Fill(Track->fNGoodMcHits/(Track->NActive()+1.e-5));
+  Hist->fPdgCode->Fill(tp->fPdgCode);
+  Hist->fFrGH->Fill(tp->fFrGH);
 
   Hist->fNEPlVsNHPl->Fill(tp->fNEPl,tp->fNHPl);
   Hist->fNDPlVsNHPl->Fill(tp->fNDPl,tp->fNHPl);
-  Hist->fChi2dVsNDPl->Fill(tp->fNDPl,Track->Chi2Dof());
+  Hist->fChi2dVsNDPl->Fill(tp->fNDPl,tp->fChi2Dof);
   Hist->fDpFVsNDPl  ->Fill(tp->fNDPl,tp->fDpF);
 }
 
@@ -609,6 +566,8 @@ int TTrackAnaModule::BeginJob() {
 //-----------------------------------------------------------------------------
   fLogLH->Init("v5_7_0");
 
+  fTrackParEntry = -1;
+
   return 0;
 }
 
@@ -645,85 +604,276 @@ void TTrackAnaModule::FillHistograms() {
 //-----------------------------------------------------------------------------
 // Simp histograms
 //-----------------------------------------------------------------------------
-  if (fParticle) {
-    FillSimpHistograms(fHist.fSimp[0],fParticle);
+  if (fSimpPar.fFound) {
+    FillSimpHistograms(fHist.fSimp[0],&fSimpPar);
   }
 //-----------------------------------------------------------------------------
 // track histograms, fill them only for the downstream e- hypothesis
 //-----------------------------------------------------------------------------
-  TStnTrack*   trk;
-  //  TrackPar_t*  tp;
+  TrackPar_t*  tp;
+
+  int ntrk = std::min(fNTracks[0],int(kMaxTracks));
 
-  for (int i=0; i<fNTracks[0]; ++i ) {
-    trk = fTrackBlock->Track(i);
-    //    tp  = fTrackPar+i;
+  for (int i=0; i<ntrk; ++i ) {
+    tp  = fTrackPar+i;
 
-    FillTrackHistograms(fHist.fTrack[0],trk);
+    FillTrackHistograms(fHist.fTrack[0],tp);
 
-    if (trk->NActive() >= 20)   FillTrackHistograms(fHist.fTrack[1],trk);
-    if (trk->NActive() >= 30)   FillTrackHistograms(fHist.fTrack[2],trk);
-    if (trk->TanDip()  > 0.8) { 
-                                FillTrackHistograms(fHist.fTrack[3],trk);
-      if (trk->NActive() >= 30) FillTrackHistograms(fHist.fTrack[4],trk);
+    if (tp->fNActive >= 20)   FillTrackHistograms(fHist.fTrack[1],tp);
+    if (tp->fNActive >= 30)   FillTrackHistograms(fHist.fTrack[2],tp);
+    if (tp->fTanDip  > 0.8) { 
+                              FillTrackHistograms(fHist.fTrack[3],tp);
+      if (tp->fNActive >= 30) FillTrackHistograms(fHist.fTrack[4],tp);
     }
   }
 //-----------------------------------------------------------------------------
 // fill GENP histograms
 // GEN_0: all particles
 //-----------------------------------------------------------------------------
-  TGenParticle* genp;
   for (int i=0; i<fNGenp; i++) {
-    genp = fGenpBlock->Particle(i);
-    FillGenpHistograms(fHist.fGenp[0],genp);
+    FillGenpHistograms(fHist.fGenp[0],&fGenpPar[i]);
   }
   //  first_entry = 0;
 }
 
+//-----------------------------------------------------------------------------
+// track parameters used by the histogramming. Also sets the track ID word and
+// the likelihoods of TStnTrack
+//-----------------------------------------------------------------------------
+void TTrackAnaModule::InitTrackPar(TStnTrack* Track, TrackPar_t* Tp) {
 
+  TEmuLogLH::PidData_t  dat;
+  TStnTrack*            track = Track;
+  TrackPar_t*           tp    = Tp;
 
+  int id_word    = fTrackID->IDWord(track);
+  track->fIDWord = id_word;
+
+  tp->fIDWord    = id_word;
+  tp->fMatched   = 0;
+  if ((id_word == 0) && (track->fVMaxEp != NULL) && (fabs(track->fVMaxEp->fDt) < 2.5)) {
+    tp->fMatched = 1;
+  }
 //-----------------------------------------------------------------------------
-// 2014-04-30: it looks that reading the straw hits takes a lot of time - 
-//              turn off by default by commenting it out
+// process hit masks
 //-----------------------------------------------------------------------------
-int TTrackAnaModule::Event(int ientry) {
+  int i1, i2, n1(0) ,n2(0), ndiff(0);
+  int nbits = track->fHitMask.GetNBits();
+  for (int i=0; i<nbits; i++) {
+    i1 = track->HitMask()->GetBit(i);
+    i2 = track->ExpectedHitMask()->GetBit(i);
+    n1 += i1;
+    n2 += i2;
+    if (i1 != i2) ndiff += 1;
+  }
+//-----------------------------------------------------------------------------
+// define additional parameters
+//-----------------------------------------------------------------------------
+  tp->fNHPl = n1;
+  tp->fNEPl = n2;
+  tp->fNDPl = ndiff;
 
-  double                xs, p;
-  TEmuLogLH::PidData_t  dat;
-  TStnTrack*            track;
-  int                   id_word;
-  TLorentzVector        mom;
+  tp->fDpF   = track->fP     -track->fPFront;
+  tp->fDp0   = track->fP0    -track->fPFront;
+  tp->fDp2   = track->fP2    -track->fPFront;
+  tp->fDpFSt = track->fPFront-track->fPStOut;
+
+  double r  = track->fPt/2.9979*10/fBField;
+//-----------------------------------------------------------------------------
+// this is the Mu2e D0 sign convention 
+//-----------------------------------------------------------------------------
+  double    nx, ny;
 
-  //  TDiskCalorimeter::GeomData_t disk_geom;
+  double qu  = (-1)*track->Charge();
+  double rho = r+track->D0()*qu;
 
-  fTrackBlock->GetEntry(ientry);
-  fGenpBlock ->GetEntry(ientry);
-  fSimpBlock ->GetEntry(ientry);
+  nx        = cos(track->fPhi0);
+  ny        = sin(track->fPhi0);
+  tp->fXc   =  -rho*ny*qu;
+  tp->fYc   =   rho*nx*qu;
+
+  double phic = atan2(tp->fYc,tp->fXc);
+  if (phic < 0) phic += 2*M_PI;
+  tp->fPhic = phic;
 //-----------------------------------------------------------------------------
-// assume electron in the first particle, otherwise the logic will need to 
-// be changed
+// track residuals
 //-----------------------------------------------------------------------------
-  fNGenp    = fGenpBlock->NParticles();
-  fNSimp    = fSimpBlock->NParticles();
+  TStnTrack::InterData_t*  vr = track->fVMaxEp; 
+
+  tp->fEcl       = -1.e6;
+  tp->fEp        = -1.e6;
+
+  tp->fDu        = -1.e6;
+  tp->fDv        = -1.e6;
+  tp->fDx        = -1.e6;
+  tp->fDy        = -1.e6;
+  tp->fDz        = -1.e6;
+  tp->fDt        = -1.e6;
+
+  tp->fChi2Match = -1.e6;
+  tp->fPath      = -1.e6;
+
+  if (vr) {
+    tp->fEcl = vr->fEnergy;
+    tp->fEp  = tp->fEcl/track->fP;
+
+    tp->fDx  = vr->fDx;
+    tp->fDy  = vr->fDy;
+    tp->fDz  = vr->fDz;
+//-----------------------------------------------------------------------------
+// v4_2_4: correct by additional 0.22 ns - track propagation by 6 cm
+//-----------------------------------------------------------------------------
+    tp->fDt  = vr->fDt - 0.22; // - 1.;
+
+    nx  = vr->fNxTrk/sqrt(vr->fNxTrk*vr->fNxTrk+vr->fNyTrk*vr->fNyTrk);
+    ny  = vr->fNyTrk/sqrt(vr->fNxTrk*vr->fNxTrk+vr->fNyTrk*vr->fNyTrk);
+
+    tp->fDu        = vr->fDx*nx+vr->fDy*ny;
+    tp->fDv        = vr->fDx*ny-vr->fDy*nx;
+    tp->fChi2Match = vr->fChi2Match;
+    tp->fPath      = vr->fPath;
+  }
+//-----------------------------------------------------------------------------
+// track-only intersection: the one with the lowest trajectory length,
+// numbers easy to recognize as dummy if there is none
+//-----------------------------------------------------------------------------
+  TStnTrack::InterData_t*  vt = track->fVMinS;
+
+  if (vt) {
+    tp->fVaneID = vt->fID;
+    tp->fXTrk   = vt->fXTrk;
+    tp->fYTrk   = vt->fYTrk;
+    tp->fRTrk   = sqrt(vt->fXTrk*vt->fXTrk+vt->fYTrk*vt->fYTrk);
+    tp->fZTrk   = vt->fZTrk;
+  }
+  else {
+    tp->fVaneID = -1.;
+    tp->fXTrk   = 999.;
+    tp->fYTrk   = 999.;
+    tp->fRTrk   = 999.;
+    tp->fZTrk   = -1.;
+  }
+//-----------------------------------------------------------------------------
+// PID likelihoods
+//-----------------------------------------------------------------------------
+  dat.fDt   = tp->fDt;
+  dat.fEp   = tp->fEp;
+  dat.fPath = tp->fPath;
+      
+  track->fEleLogLHCal = fLogLH->LogLHCal(&dat,11);
+  track->fMuoLogLHCal = fLogLH->LogLHCal(&dat,13);
+  track->fLogLHRXs    = fLogLH->LogLHRXs(track->XSlope());
+//-----------------------------------------------------------------------------
+// the rest is just copied
+//-----------------------------------------------------------------------------
+  tp->fP           = track->fP;
+  tp->fP0          = track->fP0;
+  tp->fP2          = track->fP2;
+  tp->fFitMomErr   = track->fFitMomErr;
+  tp->fPt          = track->fPt;
+  tp->fPFront      = track->fPFront;
+  tp->fPStOut      = track->fPStOut;
+  tp->fZ1          = track->fZ1;
+  tp->fCosTh       = track->Momentum()->CosTheta();
+  tp->fChi2        = track->fChi2;
+  tp->fChi2Dof     = track->Chi2Dof();
+  tp->fNActive     = track->NActive();
+  tp->fT0          = track->fT0;
+  tp->fT0Err       = track->fT0Err;
+  tp->fQ           = track->Charge();
+  tp->fFitCons     = track->fFitCons;
+  tp->fD0          = track->fD0;
+  tp->fZ0          = track->fZ0;
+  tp->fTanDip      = track->fTanDip;
+  tp->fAlgMask     = track->AlgMask();
+  tp->fNClusters   = track->NClusters();
+  tp->fRSlope      = track->RSlope();
+  tp->fXSlope      = track->XSlope();
+  tp->fEleLogLHCal = track->EleLogLHCal();
+  tp->fMuoLogLHCal = track->MuoLogLHCal();
+  tp->fLogLHRCal   = track->LogLHRCal();
+  tp->fLogLHRDeDx  = track->LogLHRDeDx();
+  tp->fLogLHRXs    = track->LogLHRXs();
+  tp->fLogLHRTrk   = track->LogLHRTrk();
+  tp->fPdgCode     = track->fPdgCode;
+  tp->fFrGH        = track->fNGoodMcHits/(track->NActive()+1.e-5);
+}
 
-  TSimParticle* simp;
-  int           pdg_code, generator_code;
+//-----------------------------------------------------------------------------
+// returns the selected simulated particle, NULL if there is none
+//-----------------------------------------------------------------------------
+TSimParticle* TTrackAnaModule::InitSimpPar(TSimpBlock* Block, SimpPar_t* Sp) {
+  TSimParticle* simp(0);
 
-  fParticle = NULL;
-  for (int i=fNSimp-1; i>=0; i--) {
-    simp           = fSimpBlock->Particle(i);
-    pdg_code       = simp->PDGCode();
-    generator_code = simp->GeneratorID();
-    if ((pdg_code == fPdgCode) && (generator_code == fGeneratorCode)) {
-      fParticle = simp;
+  for (int i=Block->NParticles()-1; i>=0; i--) {
+    TSimParticle* s = Block->Particle(i);
+    if ((s->PDGCode() == fPdgCode) && (s->GeneratorID() == fGeneratorCode)) {
+      simp = s;
       break;
     }
   }
 
-  if (fParticle) p = fParticle->StartMom()->P();
-  else           p = 0.;
+  Sp->fFound           = 0;
+  Sp->fP               = -1.;
+  Sp->fCosTh           = -2.;
+  Sp->fVx              = -1.e6;
+  Sp->fVy              = -1.e6;
+  Sp->fRv              = -1.e6;
+  Sp->fVz              = -1.e6;
+  Sp->fPdgCode         = 0;
+  Sp->fMomTargetEnd    = 0;
+  Sp->fMomTrackerFront = 0;
+  Sp->fNStrawHits      = 0;
+
+  if (simp) {
+    const TLorentzVector* mom = simp->StartMom();
+    double p  = mom->P();
+    double vx = simp->StartPos()->X()+3904;
+    double vy = simp->StartPos()->Y();
+
+    Sp->fFound           = 1;
+    Sp->fP               = p;
+    Sp->fCosTh           = mom->Pz()/p;
+    Sp->fVx              = vx;
+    Sp->fVy              = vy;
+    Sp->fRv              = sqrt(vx*vx+vy*vy);
+    Sp->fVz              = simp->StartPos()->Z();
+    Sp->fPdgCode         = simp->fPdgCode;
+    Sp->fMomTargetEnd    = simp->fMomTargetEnd;
+    Sp->fMomTrackerFront = simp->fMomTrackerFront;
+    Sp->fNStrawHits      = simp->fNStrawHits;
+  }
+
+  return simp;
+}
+
+//-----------------------------------------------------------------------------
+void TTrackAnaModule::InitGenpPar(TGenParticle* Genp, GenpPar_t* Gp) {
+  TLorentzVector mom;
+
+  Genp->Momentum(mom);
+
+  double x0  = Genp->Vx()+3904.;
+  double y0  = Genp->Vy();
+
+  Gp->fPdgCode = Genp->GetPdgCode();
+  Gp->fGenID   = Genp->GetStatusCode();
+  Gp->fZ0      = Genp->Vz();
+  Gp->fT0      = Genp->T();
+  Gp->fR0      = sqrt(x0*x0+y0*y0);
+  Gp->fP       = mom.P();
+  Gp->fCosTh   = mom.CosTheta();
+}
+
+//-----------------------------------------------------------------------------
+// quantities derived from the track and simp parameters, the same for the
+// events read from the data blocks and from the event cache
+//-----------------------------------------------------------------------------
+void TTrackAnaModule::InitEventPar() {
+
+  double p = (fSimpPar.fFound) ? fSimpPar.fP : 0.;
 
   fEleE       = sqrt(p*p+0.511*0.511);
-  fNTracks[0] = fTrackBlock->NTracks();
   fNHyp       = -1;
   fBestHyp[0] = -1;
   fBestHyp[1] = -1;
@@ -731,155 +881,278 @@ int TTrackAnaModule::Event(int ientry) {
   fNGoodTracks    = 0;
   fNMatchedTracks = 0;
 
-  fNTracks[0] = fTrackBlock->NTracks();
-  if (fNTracks[0] == 0) fTrack = 0;
-  else                  fTrack = fTrackBlock->Track(0);
+  int ntrk = std::min(fNTracks[0],int(kMaxTracks));
 
-  int ntrk = fNTracks[0];
+  for (int i=0; i<ntrk; i++) {
+    TrackPar_t* tp = fTrackPar+i;
 
-  TrackPar_t*   tp;
+    if (fFillDioHist == 0) tp->fDioWt = 1.;
+    else                   tp->fDioWt = TStntuple::DioWeightAl(fEleE);
+
+    if (tp->fIDWord == 0) fNGoodTracks    += 1;
+    if (tp->fMatched    ) fNMatchedTracks += 1;
+  }
+}
 
-  for (int itrk=0; itrk<ntrk; itrk++) {
-					// assume less 20 tracks
-    tp             = fTrackPar+itrk;
-
-    track          = fTrackBlock->Track(itrk);
-    id_word        = fTrackID->IDWord(track);
-    track->fIDWord = id_word;
-    if (id_word == 0) {
-      fNGoodTracks += 1;
-      if ((track->fVMaxEp != NULL) && (fabs(track->fVMaxEp->fDt) < 2.5)) {
-	fNMatchedTracks += 1;
-      }
-    }
 //-----------------------------------------------------------------------------
-// process hit masks
+// the event cache calls the column functions once per column, compute the
+// track parameters only once per event
 //-----------------------------------------------------------------------------
-    int i1, i2, n1(0) ,n2(0), ndiff(0);
-    int nbits = track->fHitMask.GetNBits();
-    for (int i=0; i<nbits; i++) {
-      i1 = track->HitMask()->GetBit(i);
-      i2 = track->ExpectedHitMask()->GetBit(i);
-      n1 += i1;
-      n2 += i2;
-      if (i1 != i2) ndiff += 1;
-    }
+TTrackAnaModule::TrackPar_t* TTrackAnaModule::TrackPar(TStnTrackBlock* Block, int I) {
+
+  int entry = Block->GetEvent()->GetCurrentEntry();
+
+  if (entry != fTrackParEntry) {
+    int ntrk = std::min(Block->NTracks(),int(kMaxTracks));
+    for (int i=0; i<ntrk; i++) InitTrackPar(Block->Track(i),fTrackPar+i);
+    fTrackParEntry = entry;
+  }
+
+  return fTrackPar+I;
+}
+
+
 //-----------------------------------------------------------------------------
-// define additional parameters
+// 2014-04-30: it looks that reading the straw hits takes a lot of time - 
+//              turn off by default by commenting it out
 //-----------------------------------------------------------------------------
-    tp->fNHPl = n1;
-    tp->fNEPl = n2;
-    tp->fNDPl = ndiff;
-
-    tp->fDpF   = track->fP     -track->fPFront;
-    tp->fDp0   = track->fP0    -track->fPFront;
-    tp->fDp2   = track->fP2    -track->fPFront;
-    tp->fDpFSt = track->fPFront-track->fPStOut;
+int TTrackAnaModule::Event(int ientry) {
 
-    double r  = track->fPt/2.9979*10/fBField;
+  fTrackBlock->GetEntry(ientry);
+  fGenpBlock ->GetEntry(ientry);
+  fSimpBlock ->GetEntry(ientry);
 //-----------------------------------------------------------------------------
-// this is the Mu2e D0 sign convention 
+// assume electron in the first particle, otherwise the logic will need to 
+// be changed
 //-----------------------------------------------------------------------------
-    double    nx, ny;
+  fNGenp    = fGenpBlock->NParticles();
+  fNSimp    = fSimpBlock->NParticles();
 
-    double qu  = (-1)*track->Charge();
-    double rho = r+track->D0()*qu;
+  fParticle = InitSimpPar(fSimpBlock,&fSimpPar);
 
-    nx        = cos(track->fPhi0);
-    ny        = sin(track->fPhi0);
-    tp->fXc   =  -rho*ny*qu;
-    tp->fYc   =   rho*nx*qu;
-    tp->fPhic = atan2(tp->fYc,tp->fXc);
+  fNStrawHits = GetHeaderBlock()->NStrawHits();
+  fNComboHits = GetHeaderBlock()->NComboHits();
 
-    if (tp->fPhic < 0) tp->fPhic += 2*M_PI;
+  fNTracks[0] = fTrackBlock->NTracks();
+  if (fNTracks[0] == 0) fTrack = 0;
+  else                  fTrack = fTrackBlock->Track(0);
+					// recalculate, don't rely on the entry
+					// number only
+  fTrackParEntry = -1;
+  int ntrk = std::min(fNTracks[0],int(kMaxTracks));
+  if (ntrk > 0) TrackPar(fTrackBlock,0);
 
-    if (fFillDioHist == 0) tp->fDioWt = 1.;
-    else                   tp->fDioWt = TStntuple::DioWeightAl(fEleE);
-//-----------------------------------------------------------------------------
-// track residuals
-//-----------------------------------------------------------------------------
-    TStnTrack::InterData_t*  vr = track->fVMaxEp; 
+  fGenpPar.resize(fNGenp);
+  for (int i=0; i<fNGenp; i++) InitGenpPar(fGenpBlock->Particle(i),&fGenpPar[i]);
 
-    tp->fEcl       = -1.e6;
-    tp->fEp        = -1.e6;
+  InitEventPar();
 
-    tp->fDu        = -1.e6;
-    tp->fDv        = -1.e6;
-    tp->fDx        = -1.e6;
-    tp->fDy        = -1.e6;
-    tp->fDz        = -1.e6;
-    tp->fDt        = -1.e6;
+  FillHistograms();
 
-    tp->fChi2Match = -1.e6;
-    tp->fPath      = -1.e6;
+  Debug();
 
-    if (vr) {
-      tp->fEcl = vr->fEnergy;
-      tp->fEp  = tp->fEcl/track->fP;
+  return 0;		       
+}
 
-      tp->fDx  = vr->fDx;
-      tp->fDy  = vr->fDy;
-      tp->fDz  = vr->fDz;
-//-----------------------------------------------------------------------------
-// v4_2_4: correct by additional 0.22 ns - track propagation by 6 cm
 //-----------------------------------------------------------------------------
-      tp->fDt  = vr->fDt - 0.22; // - 1.;
+// event cache: the module runs from the cache unless the debug printout,
+// which needs the data blocks, is requested
+//-----------------------------------------------------------------------------
+static const struct {
+  const char*                         fName;
+  float TTrackAnaModule::TrackPar_t::* fPar;
+} kTrackColumn[] = {
+  { "nhpl"   , &TTrackAnaModule::TrackPar_t::fNHPl        },
+  { "nepl"   , &TTrackAnaModule::TrackPar_t::fNEPl        },
+  { "ndpl"   , &TTrackAnaModule::TrackPar_t::fNDPl        },
+  { "dpf"    , &TTrackAnaModule::TrackPar_t::fDpF         },
+  { "dp0"    , &TTrackAnaModule::TrackPar_t::fDp0         },
+  { "dp2"    , &TTrackAnaModule::TrackPar_t::fDp2         },
+  { "dpfst"  , &TTrackAnaModule::TrackPar_t::fDpFSt       },
+  { "xc"     , &TTrackAnaModule::TrackPar_t::fXc          },
+  { "yc"     , &TTrackAnaModule::TrackPar_t::fYc          },
+  { "phic"   , &TTrackAnaModule::TrackPar_t::fPhic        },
+  { "ecl"    , &TTrackAnaModule::TrackPar_t::fEcl         },
+  { "ep"     , &TTrackAnaModule::TrackPar_t::fEp          },
+  { "dx"     , &TTrackAnaModule::TrackPar_t::fDx          },
+  { "dy"     , &TTrackAnaModule::TrackPar_t::fDy          },
+  { "dz"     , &TTrackAnaModule::TrackPar_t::fDz          },
+  { "dt"     , &TTrackAnaModule::TrackPar_t::fDt          },
+  { "du"     , &TTrackAnaModule::TrackPar_t::fDu          },
+  { "dv"     , &TTrackAnaModule::TrackPar_t::fDv          },
+  { "chi2tcm", &TTrackAnaModule::TrackPar_t::fChi2Match   },
+  { "path"   , &TTrackAnaModule::TrackPar_t::fPath        },
+  { "p"      , &TTrackAnaModule::TrackPar_t::fP           },
+  { "p0"     , &TTrackAnaModule::TrackPar_t::fP0          },
+  { "p2"     , &TTrackAnaModule::TrackPar_t::fP2          },
+  { "momerr" , &TTrackAnaModule::TrackPar_t::fFitMomErr   },
+  { "pt"     , &TTrackAnaModule::TrackPar_t::fPt          },
+  { "pf"     , &TTrackAnaModule::TrackPar_t::fPFront      },
+  { "pstout" , &TTrackAnaModule::TrackPar_t::fPStOut      },
+  { "z1"     , &TTrackAnaModule::TrackPar_t::fZ1          },
+  { "costh"  , &TTrackAnaModule::TrackPar_t::fCosTh       },
+  { "chi2"   , &TTrackAnaModule::TrackPar_t::fChi2        },
+  { "chi2d"  , &TTrackAnaModule::TrackPar_t::fChi2Dof     },
+  { "nactv"  , &TTrackAnaModule::TrackPar_t::fNActive     },
+  { "t0"     , &TTrackAnaModule::TrackPar_t::fT0          },
+  { "t0err"  , &TTrackAnaModule::TrackPar_t::fT0Err       },
+  { "q"      , &TTrackAnaModule::TrackPar_t::fQ           },
+  { "fcon"   , &TTrackAnaModule::TrackPar_t::fFitCons     },
+  { "d0"     , &TTrackAnaModule::TrackPar_t::fD0          },
+  { "z0"     , &TTrackAnaModule::TrackPar_t::fZ0          },
+  { "tdip"   , &TTrackAnaModule::TrackPar_t::fTanDip      },
+  { "algmask", &TTrackAnaModule::TrackPar_t::fAlgMask     },
+  { "vaneid" , &TTrackAnaModule::TrackPar_t::fVaneID      },
+  { "xtrk"   , &TTrackAnaModule::TrackPar_t::fXTrk        },
+  { "ytrk"   , &TTrackAnaModule::TrackPar_t::fYTrk        },
+  { "ztrk"   , &TTrackAnaModule::TrackPar_t::fZTrk        },
+  { "rtrk"   , &TTrackAnaModule::TrackPar_t::fRTrk        },
+  { "ncl"    , &TTrackAnaModule::TrackPar_t::fNClusters   },
+  { "rslope" , &TTrackAnaModule::TrackPar_t::fRSlope      },
+  { "xslope" , &TTrackAnaModule::TrackPar_t::fXSlope      },
+  { "ellhcal", &TTrackAnaModule::TrackPar_t::fEleLogLHCal },
+  { "mllhcal", &TTrackAnaModule::TrackPar_t::fMuoLogLHCal },
+  { "llhrcal", &TTrackAnaModule::TrackPar_t::fLogLHRCal   },
+  { "llhrdedx",&TTrackAnaModule::TrackPar_t::fLogLHRDeDx  },
+  { "llhrxs" , &TTrackAnaModule::TrackPar_t::fLogLHRXs    },
+  { "llhrtrk", &TTrackAnaModule::TrackPar_t::fLogLHRTrk   },
+  { "pdg"    , &TTrackAnaModule::TrackPar_t::fPdgCode     },
+  { "frgh"   , &TTrackAnaModule::TrackPar_t::fFrGH        },
+  { "idword" , &TTrackAnaModule::TrackPar_t::fIDWord      },
+  { "matched", &TTrackAnaModule::TrackPar_t::fMatched     },
+  { 0, 0 }
+};
+
+static const struct {
+  const char*                        fName;
+  float TTrackAnaModule::SimpPar_t::* fPar;
+} kSimpColumn[] = {
+  { "found"  , &TTrackAnaModule::SimpPar_t::fFound           },
+  { "p"      , &TTrackAnaModule::SimpPar_t::fP               },
+  { "costh"  , &TTrackAnaModule::SimpPar_t::fCosTh           },
+  { "vx"     , &TTrackAnaModule::SimpPar_t::fVx              },
+  { "vy"     , &TTrackAnaModule::SimpPar_t::fVy              },
+  { "rv"     , &TTrackAnaModule::SimpPar_t::fRv              },
+  { "vz"     , &TTrackAnaModule::SimpPar_t::fVz              },
+  { "pdg"    , &TTrackAnaModule::SimpPar_t::fPdgCode         },
+  { "ptgtend", &TTrackAnaModule::SimpPar_t::fMomTargetEnd    },
+  { "ptrkfr" , &TTrackAnaModule::SimpPar_t::fMomTrackerFront },
+  { "nsh"    , &TTrackAnaModule::SimpPar_t::fNStrawHits      },
+  { 0, 0 }
+};
+
+static const struct {
+  const char*                        fName;
+  float TTrackAnaModule::GenpPar_t::* fPar;
+} kGenpColumn[] = {
+  { "pdg"    , &TTrackAnaModule::GenpPar_t::fPdgCode },
+  { "genid"  , &TTrackAnaModule::GenpPar_t::fGenID   },
+  { "z0"     , &TTrackAnaModule::GenpPar_t::fZ0      },
+  { "t0"     , &TTrackAnaModule::GenpPar_t::fT0      },
+  { "r0"     , &TTrackAnaModule::GenpPar_t::fR0      },
+  { "p"      , &TTrackAnaModule::GenpPar_t::fP       },
+  { "costh"  , &TTrackAnaModule::GenpPar_t::fCosTh   },
+  { 0, 0 }
+};
+
+//-----------------------------------------------------------------------------
+int TTrackAnaModule::DefineCacheColumns(TStnEventCache* Cache) {
+
+  if (GetDebugBit(3) || GetDebugBit(7) || GetDebugBit(8))   return 0;
+
+  const char* trk = fTrackBlockName.Data();
+
+  fEventColumn.clear();
+  fEventColumn.push_back(Cache->AddScalar(Form("%s.nsh",GetName()),"HeaderBlock",
+    [](TStnDataBlock* B) { return float(((TStnHeaderBlock*) B)->NStrawHits()); }));
+  fEventColumn.push_back(Cache->AddScalar(Form("%s.nch",GetName()),"HeaderBlock",
+    [](TStnDataBlock* B) { return float(((TStnHeaderBlock*) B)->NComboHits()); }));
+  fEventColumn.push_back(Cache->AddScalar(Form("%s.ntrk",GetName()),trk,
+    [](TStnDataBlock* B) { return float(((TStnTrackBlock*) B)->NTracks()); }));
+
+  fTrackColumn.clear();
+  for (int i=0; kTrackColumn[i].fName; i++) {
+    float TrackPar_t::* par = kTrackColumn[i].fPar;
+    fTrackColumn.push_back(Cache->AddArray(Form("%s.trk_%s",GetName(),kTrackColumn[i].fName),trk,
+      [](TStnDataBlock* B) { return std::min(((TStnTrackBlock*) B)->NTracks(),int(kMaxTracks)); },
+      [this,par](TStnDataBlock* B, int I) { return TrackPar((TStnTrackBlock*) B,I)->*par; }));
+  }
+
+  fSimpColumn.clear();
+  for (int i=0; kSimpColumn[i].fName; i++) {
+    float SimpPar_t::* par = kSimpColumn[i].fPar;
+    fSimpColumn.push_back(Cache->AddScalar(Form("%s.simp_%s",GetName(),kSimpColumn[i].fName),"SimpBlock",
+      [this,par](TStnDataBlock* B) {
+	SimpPar_t sp;
+	InitSimpPar((TSimpBlock*) B,&sp);
+	return sp.*par;
+      }));
+  }
 
-      nx  = vr->fNxTrk/sqrt(vr->fNxTrk*vr->fNxTrk+vr->fNyTrk*vr->fNyTrk);
-      ny  = vr->fNyTrk/sqrt(vr->fNxTrk*vr->fNxTrk+vr->fNyTrk*vr->fNyTrk);
+  fGenpColumn.clear();
+  for (int i=0; kGenpColumn[i].fName; i++) {
+    float GenpPar_t::* par = kGenpColumn[i].fPar;
+    fGenpColumn.push_back(Cache->AddArray(Form("%s.genp_%s",GetName(),kGenpColumn[i].fName),"GenpBlock",
+      [](TStnDataBlock* B) { return ((TGenpBlock*) B)->NParticles(); },
+      [this,par](TStnDataBlock* B, int I) {
+	GenpPar_t gp;
+	InitGenpPar(((TGenpBlock*) B)->Particle(I),&gp);
+	return gp.*par;
+      }));
+  }
+
+  return 1;
+}
 
-      tp->fDu        = vr->fDx*nx+vr->fDy*ny;
-      tp->fDv        = vr->fDx*ny-vr->fDy*nx;
-      tp->fChi2Match = vr->fChi2Match;
-      tp->fPath      = vr->fPath;
-    }
 //-----------------------------------------------------------------------------
-// PID likelihoods
+// same as Event, the parameters come from the event cache, no data blocks
+// and no debug printout
 //-----------------------------------------------------------------------------
-    dat.fDt   = tp->fDt;
-    dat.fEp   = tp->fEp;
-    dat.fPath = tp->fPath;
-      
-    xs = track->XSlope();
+int TTrackAnaModule::EventFromCache(TStnEventCache* Cache, int Entry) {
 
-    track->fEleLogLHCal = fLogLH->LogLHCal(&dat,11);
-    track->fMuoLogLHCal = fLogLH->LogLHCal(&dat,13);
+  fParticle      = NULL;
+  fTrack         = NULL;
+  fTrackParEntry = -1;
+  fNSimp         = -1;			// not cached
 
-    double llhr_cal = track->fEleLogLHCal-track->fMuoLogLHCal;
+  fNStrawHits = int(Cache->Scalar(fEventColumn[0],Entry));
+  fNComboHits = int(Cache->Scalar(fEventColumn[1],Entry));
+  fNTracks[0] = int(Cache->Scalar(fEventColumn[2],Entry));
 
-    if (GetDebugBit(7)) {
-      if ((id_word == 0) && (llhr_cal > 20)) {
-	GetHeaderBlock()->Print(Form("bit:007: dt = %10.3f ep = %10.3f",track->Dt(),tp->fEp));
-      }
-    }
+  for (int k=0; kSimpColumn[k].fName; k++) {
+    fSimpPar.*kSimpColumn[k].fPar = Cache->Scalar(fSimpColumn[k],Entry);
+  }
 
-    if (GetDebugBit(8)) {
-      if ((id_word == 0) && (llhr_cal < -20)) {
-	GetHeaderBlock()->Print(Form("bit:008: p = %10.3f dt = %10.3f ep = %10.3f",
-				     track->P(),track->Dt(),tp->fEp));
-      }
-    }
+  int ntrk = Cache->Size(fTrackColumn[0],Entry);
+  for (int k=0; kTrackColumn[k].fName; k++) {
+    const float* x = Cache->Array(fTrackColumn[k],Entry);
+    for (int i=0; i<ntrk; i++) fTrackPar[i].*kTrackColumn[k].fPar = x[i];
+  }
 
-    track->fLogLHRXs    = fLogLH->LogLHRXs(xs);
+  fNGenp = Cache->Size(fGenpColumn[0],Entry);
+  fGenpPar.resize(fNGenp);
+  for (int k=0; kGenpColumn[k].fName; k++) {
+    const float* x = Cache->Array(fGenpColumn[k],Entry);
+    for (int i=0; i<fNGenp; i++) fGenpPar[i].*kGenpColumn[k].fPar = x[i];
   }
 
-  FillHistograms();
+  InitEventPar();
 
-  Debug();
+  FillHistograms();
 
-  return 0;		       
+  return 0;
 }
 
 //-----------------------------------------------------------------------------
 void TTrackAnaModule::Debug() {
 
-  TStnTrack* trk;
-  //  TrackPar_t* tp;
-  int ntrk = fTrackBlock->NTracks();
+  TStnTrack*  trk;
+  TrackPar_t* tp;
+  int ntrk = std::min(fTrackBlock->NTracks(),int(kMaxTracks));
 
   for (int itrk=0; itrk<ntrk; itrk++) {
     trk = fTrackBlock->Track(itrk);
-    //    tp  = &fTrackPar[itrk];
+    tp  = &fTrackPar[itrk];
 //-----------------------------------------------------------------------------
 // bit 3: Set C tracks with large DX : 70mm < |DX| < 90mm
 //-----------------------------------------------------------------------------
@@ -891,6 +1164,19 @@ void TTrackAnaModule::Debug() {
 	}
       }
     }
+
+    if (GetDebugBit(7)) {
+      if ((trk->fIDWord == 0) && (trk->LogLHRCal() > 20)) {
+	GetHeaderBlock()->Print(Form("bit:007: dt = %10.3f ep = %10.3f",trk->Dt(),tp->fEp));
+      }
+    }
+
+    if (GetDebugBit(8)) {
+      if ((trk->fIDWord == 0) && (trk->LogLHRCal() < -20)) {
+	GetHeaderBlock()->Print(Form("bit:008: p = %10.3f dt = %10.3f ep = %10.3f",
+				     trk->P(),trk->Dt(),tp->fEp));
+      }
+    }
   }
 }
 
@@ -4,6 +4,8 @@
 #ifndef Stntuple_ana_TClusterAnaModule_hh
 #define Stntuple_ana_TClusterAnaModule_hh
 
+#include <vector>
+
 #include "TH1.h"
 #include "TH2.h"
 #include "TProfile.h"
@@ -29,6 +31,44 @@ class TClusterAnaModule: public TStnModule {
 public:
   enum { kNDisks = 2 } ;
 //-----------------------------------------------------------------------------
+// quantities used by the histogramming, computed from the data blocks or
+// taken from the event cache (see DefineCacheColumns)
+//-----------------------------------------------------------------------------
+  struct ClusterPar_t {
+    float    fDiskID;
+    float    fEnergy;
+    float    fTime;
+    float    fRow;			// -9999 if out of range
+    float    fCol;
+    float    fX;
+    float    fY;
+    float    fZ;
+    float    fR;
+    float    fYMean;
+    float    fZMean;
+    float    fSigY;
+    float    fSigZ;
+    float    fSigR;
+    float    fNCr0;
+    float    fNCr1;
+    float    fFrE1;
+    float    fFrE2;
+    float    fSigE1;
+    float    fSigE2;
+  };
+					// crystals with hits, ordered by disk
+  struct CrystalPar_t {
+    float    fDisk;
+    float    fR;
+    float    fEnergy;
+    float    fNHits;			// its hits follow those of the
+  };					// previous crystal in fCalHitPar
+
+  struct CalHitPar_t {
+    float    fEnergy;
+    float    fTime;
+  };
+//-----------------------------------------------------------------------------
 //  histograms
 //-----------------------------------------------------------------------------
   struct ClusterHist_t {
@@ -113,6 +153,17 @@ public:
 
   TDiskCalorimeter* fDiskCalorimeter;
 
+  std::vector<ClusterPar_t>  fClusterPar;
+  std::vector<CrystalPar_t>  fCrystalPar;
+  std::vector<CalHitPar_t>   fCalHitPar;
+  int               fNDisks;
+  int               fCalParEntry;	// event entry of the calorimeter parameters
+					// event cache column indices
+  std::vector<int>  fClusterColumn;
+  std::vector<int>  fCrystalColumn;
+  std::vector<int>  fCalHitColumn;
+  int               fNDisksColumn;
+
   double            fMinT0;
 //-----------------------------------------------------------------------------
 //  functions
@@ -137,15 +188,24 @@ public:
   int     BeginRun();
   int     Event   (int ientry);
   int     EndJob  ();
+
+  int     DefineCacheColumns(TStnEventCache* Cache);
+  int     EventFromCache    (TStnEventCache* Cache, int Entry);
 //-----------------------------------------------------------------------------
 // other methods
 //-----------------------------------------------------------------------------
   void    BookClusterHistograms (ClusterHist_t* Hist, const char* Folder);
   void    BookEventHistograms   (EventHist_t*   Hist, const char* Folder);
 
-  void    FillClusterHistograms  (ClusterHist_t* Hist, TStnCluster*  Cluster);
+  void    FillClusterHistograms  (ClusterHist_t* Hist, ClusterPar_t* Cluster);
   void    FillEventHistograms    (EventHist_t*   Hist, double        EMin , double TMin);
 
+  void    InitClusterPar         (TStnCluster*   Cluster, ClusterPar_t* Cp);
+  void    InitCalPar             (TCalDataBlock* Block);
+					// computes the calorimeter parameters
+					// once per event (event cache filling)
+  void    CalPar                 (TCalDataBlock* Block);
+
   void    BookHistograms();
   void    FillHistograms();
 
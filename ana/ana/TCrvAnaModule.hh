@@ -55,20 +55,6 @@ public:
     TH2F*    fYVsZ;
   };
 
-  struct CrvPulseHist_t {
-    TH1F*    fNPe;
-    TH1F*    fNPeHeight;
-    TH1F*    fNDigis;
-    TH1F*    fBar;
-    TH1F*    fSipm;
-    TH1F*    fTime;
-    TH1F*    fHeight;
-    TH1F*    fWidth;
-    TH1F*    fChi2;
-    TH1F*    fLeTime;
-    TH1F*    fDt;
-  };
-
   struct CrvCoincidenceHist_t {
     TH1F*    fSectorType;
     TH1F*    fNPulses;
@@ -78,7 +64,6 @@ public:
   enum { kNGenpHistSets           = 100 };
   enum { kNSimpHistSets           = 100 };
   enum { kNCrvClusterHistSets     = 100 };
-  enum { kNCrvPulseHistSets       = 100 };
   enum { kNCrvCoincidenceHistSets = 100 };
 
   struct Hist_t {
@@ -87,7 +72,6 @@ public:
     SimpHist_t*            fSimp          [kNSimpHistSets];
     CrvClusterHist_t*      fCrvCluster    [kNCrvClusterHistSets];
     CrvCoincidenceHist_t*  fCrvCoincidence[kNCrvCoincidenceHistSets];
-    CrvPulseHist_t*        fCrvPulse      [kNCrvPulseHistSets];
   };
 //-----------------------------------------------------------------------------
 //  data members
@@ -105,6 +89,8 @@ public:
   // TrackPar_t             fTrackPar[20];
 					// histograms filled
   Hist_t                 fHist;
+					// CRV pulse histograms, crvp_N folders
+  TStnHistSet<TCrvRecoPulse>* fCrvPulseHist;
 					// cut values
   double                 fPtMin;
 
@@ -151,14 +137,12 @@ public:
   void    BookGenpHistograms        (GenpHist_t*       Hist, const char* Folder);
   void    BookSimpHistograms        (SimpHist_t*       Hist, const char* Folder);
   void    BookCrvClusterHistograms  (CrvClusterHist_t* Hist, const char* Folder);
-  void    BookCrvPulseHistograms    (CrvPulseHist_t*   Hist, const char* Folder);
   void    BookEventHistograms       (EventHist_t*      Hist, const char* Folder);
 
   void    FillEventHistograms       (EventHist_t*       Hist);
   void    FillGenpHistograms        (GenpHist_t*        Hist, TGenParticle* Genp );
   void    FillSimpHistograms        (SimpHist_t*        Hist, TSimParticle* Simp );
   void    FillCrvClusterHistograms  (CrvClusterHist_t*  Hist, TCrvCoincidenceCluster* CrvCl);
-  void    FillCrvPulseHistograms    (CrvPulseHist_t*    Hist, TCrvRecoPulse* CrvCl);
 
   void    BookHistograms();
   void    FillHistograms();
@@ -4,6 +4,8 @@
 #ifndef Stntuple_ana_TSpmcAnaModule_hh
 #define Stntuple_ana_TSpmcAnaModule_hh
 
+#include <vector>
+
 #include "TH1.h"
 #include "TH2.h"
 #include "TProfile.h"
@@ -121,6 +123,16 @@ public:
   enum { kNStepPointMCHistSets  = 10000 };
   enum { kNSimpHistSets         = 10000 };
   enum { kNVDetHistSets         = 10000 };
+//-----------------------------------------------------------------------------
+// VD histogram dispatch: for a given particle type the histogram set is
+// <base>+<VD ID>, fVDetFlags[VD ID] tells which groups of sets are booked
+//-----------------------------------------------------------------------------
+  enum { kMaxVDetID = 100 };
+  enum {
+    kVDetOwnSet = 0x1,			// VD 9, 13: sets 9, 13 and 14
+    kVDetStd    = 0x2,			// VD 1-9, 98, 99
+    kVDetPbar   = 0x4			// VD 1-9, 91, 92, 98, 99: pbar sets
+  };
 
   struct Hist_t {
     EventHist_t*        fEvent      [kNEventHistSets      ];
@@ -161,6 +173,9 @@ public:
 
   SimpData_t            fSimData[kMaxNSimp];
 
+  int                   fVDetFlags[kMaxVDetID];
+  std::vector<int>      fPbarSteps;	 // VD step points of pbars, per event
+
   TStntuple*            fStnt;
   double                fWeight;         // event weight, determined by the production cross section
   double                fTMaxSimp;	 // in seconds
@@ -206,6 +221,7 @@ public:
   void    FillSimpHistograms         (HistBase_t* Hist, TSimParticle* Simp, SimpData_t* SimpData, double Weight = 1.);
   void    FillStepPointMCHistograms  (HistBase_t* Hist, TStepPointMC* Step, SpmcData_t* SpmcData, double Weight = 1.);
   void    FillVDetHistograms         (HistBase_t* Hist, TStepPointMC* Step,                       double Weight = 1.);
+  int     FillPbarVDetHistograms     (int Base);
 
   void    BookHistograms();
   void    FillHistograms();
@@ -4,6 +4,8 @@
 #ifndef Stntuple_ana_TTrackAnaModule_hh
 #define Stntuple_ana_TTrackAnaModule_hh
 
+#include <vector>
+
 #include "TH1.h"
 #include "TH2.h"
 #include "TProfile.h"
@@ -30,30 +32,102 @@ namespace stntuple {
 class TTrackAnaModule: public TStnModule {
 public:
 
+//-----------------------------------------------------------------------------
+// per-track quantities used by the histogramming, computed from TStnTrack in
+// InitTrackPar. Floats, so the same values can come from the event cache
+// (see DefineCacheColumns); fDioWt depends on the simulated particle and is
+// set separately
+//-----------------------------------------------------------------------------
+  enum { kMaxTracks = 20 };
+
   struct TrackPar_t {
-    int     fNHPl;
-    int     fNEPl;
-    int     fNDPl;
+    float   fNHPl;
+    float   fNEPl;
+    float   fNDPl;
     float   fDpF ;    // tracker-only resolution
     float   fDp0 ;
     float   fDp2 ;
     float   fDpFSt;
     double  fDioWt;
 
-    double  fXc;			// X,Y coordinates of the track helix center
-    double  fYc;
-    double  fPhic;			// phi angle defined by XXc and Yx
-
-    double  fEcl;
-    double  fEp;
-    double  fDx;
-    double  fDy;
-    double  fDz;
-    double  fDt;
-    double  fDu;			// rotated residuals
-    double  fDv;
-    double  fChi2Match;
-    double  fPath;
+    float   fXc;			// X,Y coordinates of the track helix center
+    float   fYc;
+    float   fPhic;			// phi angle defined by XXc and Yx
+
+    float   fEcl;
+    float   fEp;
+    float   fDx;
+    float   fDy;
+    float   fDz;
+    float   fDt;
+    float   fDu;			// rotated residuals
+    float   fDv;
+    float   fChi2Match;
+    float   fPath;
+					// copied from TStnTrack
+    float   fP;
+    float   fP0;
+    float   fP2;
+    float   fFitMomErr;
+    float   fPt;
+    float   fPFront;
+    float   fPStOut;
+    float   fZ1;
+    float   fCosTh;
+    float   fChi2;
+    float   fChi2Dof;
+    float   fNActive;
+    float   fT0;
+    float   fT0Err;
+    float   fQ;
+    float   fFitCons;
+    float   fD0;
+    float   fZ0;
+    float   fTanDip;
+    float   fAlgMask;
+    float   fVaneID;			// track-only intersection, dummy
+    float   fXTrk;			// values if there is none
+    float   fYTrk;
+    float   fZTrk;
+    float   fRTrk;
+    float   fNClusters;
+    float   fRSlope;
+    float   fXSlope;
+    float   fEleLogLHCal;
+    float   fMuoLogLHCal;
+    float   fLogLHRCal;
+    float   fLogLHRDeDx;
+    float   fLogLHRXs;
+    float   fLogLHRTrk;
+    float   fPdgCode;
+    float   fFrGH;
+    float   fIDWord;
+    float   fMatched;			// 1: good track matched to a cluster
+  };
+					// simulated particle selected by
+					// fPdgCode and fGeneratorCode
+  struct SimpPar_t {
+    float   fFound;			// 0: no such particle
+    float   fP;
+    float   fCosTh;
+    float   fVx;
+    float   fVy;
+    float   fRv;
+    float   fVz;
+    float   fPdgCode;
+    float   fMomTargetEnd;
+    float   fMomTrackerFront;
+    float   fNStrawHits;
+  };
+
+  struct GenpPar_t {
+    float   fPdgCode;
+    float   fGenID;
+    float   fZ0;
+    float   fT0;
+    float   fR0;
+    float   fP;
+    float   fCosTh;
   };
 
   struct EventHist_t {
@@ -232,8 +306,19 @@ public:
   TSimpBlock*            fSimpBlock;
 
   TString           fTrackBlockName;
-					// additional track parameters (assume ntracks < 20)
-  TrackPar_t        fTrackPar[20];
+					// additional track parameters, only the
+					// first kMaxTracks tracks are histogrammed
+  TrackPar_t        fTrackPar[kMaxTracks];
+  int               fTrackParEntry;	// event entry of fTrackPar, see TrackPar
+  SimpPar_t         fSimpPar;
+  std::vector<GenpPar_t> fGenpPar;
+  int               fNStrawHits;
+  int               fNComboHits;
+					// event cache column indices
+  std::vector<int>  fTrackColumn;
+  std::vector<int>  fSimpColumn;
+  std::vector<int>  fGenpColumn;
+  std::vector<int>  fEventColumn;
 					// histograms filled
   Hist_t            fHist;
 					// cut values
@@ -299,6 +384,9 @@ public:
   int     BeginRun();
   int     Event   (int ientry);
   int     EndJob  ();
+
+  int     DefineCacheColumns(TStnEventCache* Cache);
+  int     EventFromCache    (TStnEventCache* Cache, int Entry);
 //-----------------------------------------------------------------------------
 // other methods
 //-----------------------------------------------------------------------------
@@ -308,9 +396,17 @@ public:
   void    BookTrackHistograms   (TrackHist_t*   Hist, const char* Folder);
 
   void    FillEventHistograms    (EventHist_t* Hist);
-  void    FillGenpHistograms     (GenpHist_t*    Hist, TGenParticle* Genp   );
-  void    FillSimpHistograms     (SimpHist_t*    Hist, TSimParticle* Simp   );
-  void    FillTrackHistograms    (TrackHist_t*   Hist, TStnTrack*    Trk    );
+  void    FillGenpHistograms     (GenpHist_t*    Hist, GenpPar_t*    Genp   );
+  void    FillSimpHistograms     (SimpHist_t*    Hist, SimpPar_t*    Simp   );
+  void    FillTrackHistograms    (TrackHist_t*   Hist, TrackPar_t*   Tp     );
+
+  void    InitTrackPar           (TStnTrack*     Track, TrackPar_t*  Tp     );
+  TSimParticle* InitSimpPar      (TSimpBlock*    Block, SimpPar_t*   Sp     );
+  void    InitGenpPar            (TGenParticle*  Genp , GenpPar_t*   Gp     );
+  void    InitEventPar           ();
+					// parameters of track I, computed once
+					// per event (event cache filling)
+  TrackPar_t* TrackPar           (TStnTrackBlock* Block, int I);
 
   void    BookHistograms();
   void    FillHistograms();
@@ -1,8 +1,15 @@
 //-----------------------------------------------------------------------------
 //  Dec 28 2004 P.Murat: base class for STNTUPLE input module
 //-----------------------------------------------------------------------------
+#include <thread>
+#include <ctime>
+
+#include "TROOT.h"
+#include "TEnv.h"
+#include "TClass.h"
 #include "TChain.h"
 #include "TFile.h"
+#include "TBranch.h"
 #include "TSystem.h"
 #include "TRegexp.h"
 #include "TObjString.h"
@@ -34,6 +41,12 @@ TStnDataset::TStnDataset(const char* Name): TNamed(Name,Name) {
   fNGenEvents     = -1;
   fMCProcessCode  = -1;
   fPDGCode        = 0;
+
+  fNThreads         = gEnv->GetValue("Stntuple.Dataset.NThreads"     ,0 );
+  fMetadataCache    = gEnv->GetValue("Stntuple.Dataset.MetadataCache","");
+  fMetadataLoaded   = 0;
+  fMetadataModified = 0;
+  fMetadataExpiry   = gEnv->GetValue("Stntuple.Dataset.MetadataExpiry",86400);
 }
 
 //_____________________________________________________________________________
@@ -49,6 +62,13 @@ TStnDataset::TStnDataset(const char* Book,
   fListOfFiles    = new TObjArray();
   fListOfFilesets = new TObjArray();
   fListOfBadFiles = new TObjArray();
+
+  fNThreads         = gEnv->GetValue("Stntuple.Dataset.NThreads"     ,0 );
+  fMetadataCache    = gEnv->GetValue("Stntuple.Dataset.MetadataCache","");
+  fMetadataLoaded   = 0;
+  fMetadataModified = 0;
+  fMetadataExpiry   = gEnv->GetValue("Stntuple.Dataset.MetadataExpiry",86400);
+
   Init(Book,Name,MinRunNumber,MaxRunNumber,Type);
 }
 
@@ -79,6 +99,12 @@ TStnDataset::TStnDataset(const char* Book   ,
   fListOfBadFiles = new TObjArray();
   fDoneBadFiles   = 0;
 
+  fNThreads         = gEnv->GetValue("Stntuple.Dataset.NThreads"     ,0 );
+  fMetadataCache    = gEnv->GetValue("Stntuple.Dataset.MetadataCache","");
+  fMetadataLoaded   = 0;
+  fMetadataModified = 0;
+  fMetadataExpiry   = gEnv->GetValue("Stntuple.Dataset.MetadataExpiry",86400);
+
   if (strcmp(Fileset,"") != 0) {
 //-----------------------------------------------------------------------------
 // so far handle only one fileset, in  principle this can be a list of fileset 
@@ -133,6 +159,7 @@ Int_t TStnDataset::Init(const char* Book,
   }
 
   fDoneBadFiles   = 0;
+  fFileNames.clear();
 
   if ((strcmp(Book,"file") == 0) || (strcmp(Book,"dir") == 0) || (strcmp(Book,"list") == 0)) fCataloged = 0;
   else                                                                                       fCataloged = 1;
@@ -161,45 +188,298 @@ Int_t TStnDataset::AddFileset(const char* Name) {
 Int_t TStnDataset::AddFile(const char* Name) {
   // this method should be called only for non-cataloged datasets
   // make sure we're not adding the same file twice
-  // as such, assume that the file is OK
-  
-  int nev;
+
+  std::vector<TString> names(1,Name);
+
+  return (AddFiles(names) == 0) ? 0 : -1;
+}
+
+//-----------------------------------------------------------------------------
+// worker thread: a file is opened only if its metadata are not cached or
+// the file changed (size or modification time) since it was cached.
+// Remote files are stat'ed via the TSystem helper of their protocol, that
+// doesn't open them. If even that is not possible, the cached metadata
+// expire fMetadataExpiry seconds after the file has been opened
+//-----------------------------------------------------------------------------
+void TStnDataset::ProbeFiles(const std::vector<std::string>* Names ,
+			     std::vector<FileMetadata_t>*    Md    ,
+			     std::vector<int>*               Probed,
+			     std::atomic<int>*               Next  ) {
+  int nfiles = Names->size();
+
+  while (1) {
+    int i = (*Next)++;
+    if (i >= nfiles) break;
+
+    const std::string& name = (*Names)[i];
+    FileStat_t         st;
+
+    int stat_ok = (gSystem->GetPathInfo(name.data(),st) == 0);
+    if (! stat_ok) {
+      TSystem* helper = gSystem->FindHelper(name.data());
+      if (helper && (helper != gSystem)) {
+	stat_ok = (helper->GetPathInfo(name.data(),st) == 0);
+      }
+    }
+
+    Long_t now = time(0);
+
+    auto it = fMetadata.find(name);
+    if (it != fMetadata.end()) {
+      const FileMetadata_t& md = it->second;
+      if (( stat_ok && (md.fSize == st.fSize) && (md.fModTime == st.fMtime)) ||
+	  (!stat_ok && (md.fModTime == 0) && (now-md.fProbeTime < fMetadataExpiry))) {
+	(*Md)[i]     = md;
+	(*Probed)[i] = 0;
+	continue;
+      }
+    }
+
+    ProbeFile(name.data(),&(*Md)[i]);
+    if (stat_ok) {
+      (*Md)[i].fSize    = st.fSize;
+      (*Md)[i].fModTime = st.fMtime;
+    }
+    (*Md)[i].fProbeTime = now;
+    (*Probed)[i]        = 1;
+  }
+}
+
+//-----------------------------------------------------------------------------
+// duplicates (already in the chain or repeated in Names) are skipped
+//-----------------------------------------------------------------------------
+Int_t TStnDataset::AddFiles(const std::vector<TString>& Names) {
 
   if (fCataloged == 1) {
-    Error("AddFile(name)","can only be used for non-cataloged datasets");
+    Error("AddFiles","can only be used for non-cataloged datasets");
+    return -1;
+  }
+
+  if (fChain == 0) {
+    Error("AddFiles","dataset %s is not initialized",GetName());
     return -1;
   }
 
-  TObject* found = fChain->GetListOfFiles()->FindObject(Name);
+  if ((fMetadataCache != "") && (fMetadataLoaded == 0)) ReadMetadataCache();
 
-  if (! found) {
-					// create new piece of metadata
-    TFile* f    = TFile::Open(Name);
-    TTree* tree = (TTree*) f->Get("STNTUPLE");
-    nev         = int(tree->GetEntries());
-    fNEvents   += nev;
+  std::vector<std::string> names;
+  names.reserve(Names.size());
+
+  for (const TString& n : Names) {
+    if (fFileNames.insert(n.Data()).second) names.push_back(n.Data());
+  }
+
+  int nfiles = names.size();
+  if (nfiles == 0)                                           return 0;
+//-----------------------------------------------------------------------------
+// thread pool, the file opens are I/O bound
+//-----------------------------------------------------------------------------
+  std::vector<FileMetadata_t> md    (nfiles);
+  std::vector<int>            probed(nfiles,0);
+  std::atomic<int>            next  (0);
+
+  int nthreads = fNThreads;
+  if (nthreads <= 0) nthreads = std::thread::hardware_concurrency();
+  if (nthreads > nfiles) nthreads = nfiles;
+
+  if (nthreads <= 1) {
+    nthreads = 1;
+    ProbeFiles(&names,&md,&probed,&next);
+  }
+  else {
+    ROOT::EnableThreadSafety();
+
+    std::vector<std::thread> pool;
+    for (int i=0; i<nthreads; i++) {
+      pool.push_back(std::thread(&TStnDataset::ProbeFiles,this,&names,&md,&probed,&next));
+    }
+    for (std::thread& t : pool) t.join();
+  }
+//-----------------------------------------------------------------------------
+// chain the files in the requested order
+//-----------------------------------------------------------------------------
+  int nbad    = 0;
+  int nprobed = 0;
+
+  for (int i=0; i<nfiles; i++) {
+    const char*     name = names[i].data();
+    FileMetadata_t* m    = &md[i];
+
+    if (m->fStatus < 0) {
+      Error("AddFiles","can't read %s, skip it",name);
+      fFileNames.erase(names[i]);
+      nbad++;
+      continue;
+    }
+
+    if (probed[i]) {
+      fMetadata[names[i]] = *m;
+      fMetadataModified   = 1;
+      nprobed++;
+    }
 
     TCdf2Files* file = new TCdf2Files();
 
-    file->fFILE_NAME    = Name;
+    file->fFILE_NAME    = name;
     file->fFILESET_NAME = "none";
-    file->fFILE_SIZE    = f->GetSize();
-    file->fEVENT_COUNT  = nev;
-    file->fLOW_EVENT    = 0;
-    file->fHIGH_EVENT   = 100000000;
-    file->fLOW_RUN      = 0;
-    file->fHIGH_RUN     = 100000000;
+    file->fFILE_SIZE    = m->fSize;
+    file->fEVENT_COUNT  = m->fNEvents;
+    file->fLOW_EVENT    = m->fLoEvent;
+    file->fHIGH_EVENT   = m->fHiEvent;
+    file->fLOW_RUN      = m->fLoRun;
+    file->fHIGH_RUN     = m->fHiRun;
     file->fSTATUS       = 0;
 
     fListOfFiles->Add((TObject*) file);
-    
-    fChain->AddFile(Name,nev);
-    f->Close();
+
+    fChain->AddFile(name,m->fNEvents);
+    fNEvents += m->fNEvents;
+  }
+
+  if (nfiles > 1) {
+    printf(" >>> TStnDataset::AddFiles: %i files, %i opened, %i from the cache, %i bad, %i threads\n",
+	   nfiles,nprobed,nfiles-nprobed-nbad,nbad,nthreads);
   }
 
+  if ((fMetadataCache != "") && fMetadataModified) WriteMetadataCache();
+
+  return nbad;
+}
+
+//-----------------------------------------------------------------------------
+// run/event range - from the header blocks of the first and the last events,
+// the header block class is looked up by name, so the library with
+// TStnHeaderBlock doesn't have to be linked. Without it the range is not
+// defined, as for the files added before
+//-----------------------------------------------------------------------------
+Int_t TStnDataset::ProbeFile(const char* Name, FileMetadata_t* Md) {
+
+  Md->fSize      = 0;
+  Md->fModTime   = 0;
+  Md->fProbeTime = 0;
+  Md->fNEvents   = 0;
+  Md->fLoRun     = 0;
+  Md->fLoEvent   = 0;
+  Md->fHiRun     = 100000000;
+  Md->fHiEvent   = 100000000;
+  Md->fStatus    = 0;
+
+  TDirectory::TContext ctx;
+
+  TFile* f = TFile::Open(Name);
+  if ((f == 0) || f->IsZombie()) {
+    delete f;
+    Md->fStatus = -1;
+    return -1;
+  }
+
+  TTree* tree = (TTree*) f->Get("STNTUPLE");
+  if (tree == 0) {
+    delete f;
+    Md->fStatus = -2;
+    return -2;
+  }
+
+  Md->fNEvents = int(tree->GetEntries());
+  Md->fSize    = f->GetSize();
+
+  TBranch* branch = tree->GetBranch("HeaderBlock");
+  TClass*  cl     = TClass::GetClass("TStnHeaderBlock");
+
+  if (branch && cl && (Md->fNEvents > 0)) {
+    Long_t off_run = cl->GetDataMemberOffset("fRunNumber"  );
+    Long_t off_evt = cl->GetDataMemberOffset("fEventNumber");
+
+    if ((off_run > 0) && (off_evt > 0)) {
+      void* header = cl->New();
+      branch->SetAddress(&header);
+
+      if (branch->GetEntry(0) > 0) {
+	Md->fLoRun   = *(Int_t*) ((char*) header+off_run);
+	Md->fLoEvent = *(Int_t*) ((char*) header+off_evt);
+      }
+
+      if (branch->GetEntry(Md->fNEvents-1) > 0) {
+	Md->fHiRun   = *(Int_t*) ((char*) header+off_run);
+	Md->fHiEvent = *(Int_t*) ((char*) header+off_evt);
+      }
+
+      branch->ResetAddress();
+      cl->Destructor(header);
+    }
+  }
+
+  f->Close();
+  delete f;
+
   return 0;
 }
 
+//-----------------------------------------------------------------------------
+void TStnDataset::SetMetadataCache(const char* Fn) {
+  fMetadataCache  = Fn;
+  fMetadataLoaded = 0;
+}
+
+//-----------------------------------------------------------------------------
+// file names are assumed not to have blanks, as in the catalog files.
+// Lines without the probe time (written before it was added) have it set
+// to 0, that is, expired
+//-----------------------------------------------------------------------------
+Int_t TStnDataset::ReadMetadataCache() {
+  fMetadataLoaded = 1;
+
+  FILE* f = fopen(fMetadataCache.Data(),"r");
+  if (f == 0)                                                return -1;
+
+  char           line[11000], name[10000];
+  long long      size;
+  long           mtime, ptime;
+  FileMetadata_t md;
+  int            n(0);
+
+  while (fgets(line,sizeof(line),f)) {
+    ptime = 0;
+    int nw = sscanf(line,"%9999s %lld %ld %d %d %d %d %d %d %ld",name,&size,&mtime,
+		    &md.fNEvents,&md.fLoRun,&md.fLoEvent,&md.fHiRun,&md.fHiEvent,&md.fStatus,
+		    &ptime);
+    if (nw < 9) continue;
+
+    md.fSize       = size;
+    md.fModTime    = mtime;
+    md.fProbeTime  = ptime;
+    fMetadata[name] = md;
+    n++;
+  }
+
+  fclose(f);
+  return n;
+}
+
+//-----------------------------------------------------------------------------
+Int_t TStnDataset::WriteMetadataCache() {
+  TString tmp = fMetadataCache+".tmp";
+
+  FILE* f = fopen(tmp.Data(),"w");
+  if (f == 0) {
+    Error("WriteMetadataCache","can\'t open %s",tmp.Data());
+    return -1;
+  }
+
+  for (const auto& x : fMetadata) {
+    const FileMetadata_t& md = x.second;
+    fprintf(f,"%s %lld %ld %d %d %d %d %d %d %ld\n",x.first.data(),
+	    (long long) md.fSize,(long) md.fModTime,md.fNEvents,
+	    md.fLoRun,md.fLoEvent,md.fHiRun,md.fHiEvent,md.fStatus,
+	    (long) md.fProbeTime);
+  }
+
+  fclose(f);
+  fMetadataModified = 0;
+
+  return gSystem->Rename(tmp.Data(),fMetadataCache.Data());
+}
+
 
 //-----------------------------------------------------------------------------
 Int_t TStnDataset::AddFile(const char* Name, 
@@ -0,0 +1,235 @@
+///////////////////////////////////////////////////////////////////////////////
+// 2026-10-18: I/O profiles for STNTUPLE branches
+//
+// usage (ROOT prompt), compare candidate profiles on an existing STNTUPLE:
+//
+//   TObjArray* list = new TObjArray();
+//   list->Add(new TStnIOProfile("zlib1","ZLIB",1, 64000));
+//   list->Add(new TStnIOProfile("lz4" ,"LZ4" ,4, 32000));
+//   list->Add(new TStnIOProfile("zstd","ZSTD",5,256000));
+//   TStnIOProfile::Measure("nts.user.xxx.root",list,1000);
+///////////////////////////////////////////////////////////////////////////////
+#include "TFile.h"
+#include "TMemFile.h"
+#include "TTree.h"
+#include "TBranch.h"
+#include "TBranchElement.h"
+#include "TBranchObject.h"
+#include "TLeafObject.h"
+#include "TClass.h"
+#include "TStopwatch.h"
+
+#include "Stntuple/base/TStnIOProfile.hh"
+
+ClassImp(TStnIOProfile)
+
+namespace {
+  struct AlgorithmName_t {
+    int         fCode;
+    const char* fName;
+  };
+					// codes: ROOT::RCompressionSetting::EAlgorithm
+  const AlgorithmName_t  gAlgorithmName[] = {
+    { 0, ""     },
+    { 1, "ZLIB" },
+    { 2, "LZMA" },
+    { 4, "LZ4"  },
+    { 5, "ZSTD" },
+    {-1, nullptr}
+  };
+}
+
+//-----------------------------------------------------------------------------
+TStnIOProfile::TStnIOProfile(const char* Name, const char* Algorithm, int Level, 
+			     int BasketSize, int SplitLevel, Long64_t AutoFlush): 
+  TNamed(Name,Name)
+{
+  fAlgorithm  = AlgorithmCode(Algorithm);
+  if (fAlgorithm < 0) {
+    Error("TStnIOProfile","profile %s: unknown algorithm \'%s\', use ROOT default",
+	  Name,Algorithm);
+    fAlgorithm = 0;
+  }
+  fLevel      = Level;
+  fBasketSize = BasketSize;
+  fSplitLevel = SplitLevel;
+  fAutoFlush  = AutoFlush;
+}
+
+//-----------------------------------------------------------------------------
+TStnIOProfile::~TStnIOProfile() {
+}
+
+//-----------------------------------------------------------------------------
+int TStnIOProfile::AlgorithmCode(const char* Name) {
+  TString name(Name);
+  name.ToUpper();
+
+  for (int i=0; gAlgorithmName[i].fName; i++) {
+    if (name == gAlgorithmName[i].fName) return gAlgorithmName[i].fCode;
+  }
+  return -1;
+}
+
+//-----------------------------------------------------------------------------
+const char* TStnIOProfile::AlgorithmName(int Code) {
+  for (int i=0; gAlgorithmName[i].fName; i++) {
+    if (Code == gAlgorithmName[i].fCode) return gAlgorithmName[i].fName;
+  }
+  return "unknown";
+}
+
+//-----------------------------------------------------------------------------
+void TStnIOProfile::Apply(TBranch* Branch) const {
+  Branch->SetCompressionSettings(CompressionSettings());
+  if (fBasketSize > 0) Branch->SetBasketSize(fBasketSize);
+}
+
+//-----------------------------------------------------------------------------
+// FillTime, if defined, is indexed by the branch number
+//-----------------------------------------------------------------------------
+void TStnIOProfile::PrintIOStat(TTree* Tree, const double* FillTime) {
+
+  TObjArray* list = Tree->GetListOfBranches();
+  int nb          = list->GetEntriesFast();
+
+  printf("--------------------------------------------------------------------------------------------\n");
+  printf(" branch                         settings  basket   tot bytes     zip bytes   ratio  fill(MB/s)\n");
+  printf("--------------------------------------------------------------------------------------------\n");
+
+  double tot(0), zip(0);
+  for (int i=0; i<nb; i++) {
+    TBranch* b  = (TBranch*) list->UncheckedAt(i);
+    double   bt = b->GetTotBytes("*");
+    double   bz = b->GetZipBytes("*");
+    double   r  = (bz > 0) ? bt/bz : 0;
+
+    printf(" %-30s %8i %7i %12.0f  %12.0f %7.2f",
+	   b->GetName(),b->GetCompressionSettings(),b->GetBasketSize(),bt,bz,r);
+
+    if (FillTime && (FillTime[i] > 0)) printf(" %10.2f\n",bt/FillTime[i]/1.e6);
+    else                               printf(" %10s\n","-");
+    tot += bt;
+    zip += bz;
+  }
+  printf("--------------------------------------------------------------------------------------------\n");
+  printf(" %-30s %8s %7s %12.0f  %12.0f %7.2f\n","total","","",tot,zip,(zip > 0) ? tot/zip : 0.);
+}
+
+//-----------------------------------------------------------------------------
+int TStnIOProfile::Measure(const char* Filename, TObjArray* ListOfProfiles, int NEvents, 
+			   const char* BranchName) {
+
+  TFile* f = TFile::Open(Filename);
+  if ((f == nullptr) || f->IsZombie()) {
+    printf(">>> ERROR in TStnIOProfile::Measure: can\'t open %s\n",Filename);
+    return -1;
+  }
+
+  TTree* tree = (TTree*) f->Get("STNTUPLE");
+  if (tree == nullptr) {
+    printf(">>> ERROR in TStnIOProfile::Measure: no STNTUPLE tree in %s\n",Filename);
+    delete f;
+    return -2;
+  }
+
+  int nev = tree->GetEntries();
+  if ((NEvents > 0) && (NEvents < nev)) nev = NEvents;
+
+  printf("------------------------------------------------------------------------------------------\n");
+  printf(" branch                    profile     settings  basket  zip bytes   ratio  write   read\n");
+  printf("                                                                           (MB/s)  (MB/s)\n");
+  printf("------------------------------------------------------------------------------------------\n");
+
+  TObjArray* list = tree->GetListOfBranches();
+  int nb          = list->GetEntriesFast();
+  int np          = ListOfProfiles->GetEntriesFast();
+
+  for (int ib=0; ib<nb; ib++) {
+    TBranch* input_branch = (TBranch*) list->UncheckedAt(ib);
+    const char* name = input_branch->GetName();
+
+    if ((BranchName[0] != 0) && (strcmp(name,BranchName) != 0)) continue;
+
+    const char* class_name;
+    if (strcmp(input_branch->ClassName(),"TBranchElement") == 0) {
+      class_name = ((TBranchElement*) input_branch)->GetClassName();
+    }
+    else {
+      TLeafObject* leaf = (TLeafObject*) ((TBranchObject*) input_branch)->GetLeaf(name);
+      class_name = leaf->GetTypeName();
+    }
+
+    TClass* cl = TClass::GetClass(class_name);
+    if (cl == nullptr) {
+      printf(">>> WARNING: TStnIOProfile::Measure: no dictionary for %s, skip branch %s\n",
+	     class_name,name);
+      continue;
+    }
+
+    void* obj = cl->New();
+    input_branch->SetAddress(&obj);
+
+    for (int ip=0; ip<np; ip++) {
+      TStnIOProfile* p = (TStnIOProfile*) ListOfProfiles->UncheckedAt(ip);
+
+      TMemFile mf("TStnIOProfile_Measure.root","RECREATE");
+      TTree*   t  = new TTree("STNTUPLE","STNTUPLE");
+      t->SetDirectory(&mf);
+
+      int split = (p->fSplitLevel >= 0) ? p->fSplitLevel : input_branch->GetSplitLevel();
+
+      TBranch* ob = t->Branch(name,class_name,&obj,p->fBasketSize,split);
+      p->Apply(ob);
+//-----------------------------------------------------------------------------
+// write: time streaming and compression, not reading of the input
+//-----------------------------------------------------------------------------
+      TStopwatch timer;
+      timer.Reset();
+      for (int i=0; i<nev; i++) {
+	input_branch->GetEntry(i);
+	timer.Start(kFALSE);
+	ob->Fill();
+	timer.Stop();
+      }
+      timer.Start(kFALSE);
+      ob->FlushBaskets();
+      timer.Stop();
+      double twrite = timer.RealTime();
+//-----------------------------------------------------------------------------
+// read back
+//-----------------------------------------------------------------------------
+      timer.Reset();
+      timer.Start(kTRUE);
+      for (int i=0; i<nev; i++) {
+	ob->GetEntry(i);
+      }
+      timer.Stop();
+      double tread = timer.RealTime();
+
+      double tot = ob->GetTotBytes("*");
+      double zip = ob->GetZipBytes("*");
+
+      printf(" %-25s %-12s %8i %7i %10.0f %7.2f %7.1f %7.1f\n",
+	     name,p->GetName(),p->CompressionSettings(),p->fBasketSize,zip,
+	     (zip > 0) ? tot/zip : 0.,
+	     (twrite > 0) ? tot/twrite/1.e6 : 0.,
+	     (tread  > 0) ? tot/tread /1.e6 : 0.);
+
+      ob->SetAddress(nullptr);
+      delete t;
+    }
+
+    input_branch->SetAddress(nullptr);
+    cl->Destructor(obj);
+  }
+
+  delete f;
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+void TStnIOProfile::Print(Option_t* Opt) const {
+  printf(" %-20s algorithm: %-5s level: %2i basket: %8i split: %3i autoflush: %lli\n",
+	 GetName(),AlgorithmName(fAlgorithm),fLevel,fBasketSize,fSplitLevel,fAutoFlush);
+}
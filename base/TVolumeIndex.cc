@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////
+// index of objects by volume ID, see TVolumeIndex.hh
+///////////////////////////////////////////////////////////////////////////////
+#include <cstdio>
+#include <algorithm>
+
+#include "Stntuple/base/TVolumeIndex.hh"
+
+//_____________________________________________________________________________
+TVolumeIndex::TVolumeIndex() {
+  fValid = 0;
+  fMinID = 0;
+}
+
+//_____________________________________________________________________________
+TVolumeIndex::~TVolumeIndex() {
+}
+
+//-----------------------------------------------------------------------------
+// the vectors keep their capacity from event to event
+//-----------------------------------------------------------------------------
+int TVolumeIndex::Build(const int* ID, int N) {
+
+  fVolumeID.clear();
+  fOffset.clear();
+  fSlot.clear();
+  fObject.resize(N);
+  fValid = 1;
+
+  if (N == 0) {
+    fOffset.push_back(0);
+    return 0;
+  }
+
+  int vmin = ID[0];
+  int vmax = ID[0];
+  for (int i=1; i<N; i++) {
+    if      (ID[i] < vmin) vmin = ID[i];
+    else if (ID[i] > vmax) vmax = ID[i];
+  }
+  fMinID = vmin;
+
+  long range = (long) vmax-vmin+1;
+
+  if (range <= kMaxRange) {
+//-----------------------------------------------------------------------------
+// counting sort: count, prefix sum, fill using the start positions as
+// running pointers
+//-----------------------------------------------------------------------------
+    fSlot.assign(range+1,0);
+    for (int i=0; i<N; i++) fSlot[ID[i]-vmin+1] += 1;
+    for (int r=0; r<range; r++) fSlot[r+1] += fSlot[r];
+
+    for (int r=0; r<range; r++) {
+      if (fSlot[r+1] > fSlot[r]) {
+	fVolumeID.push_back(r+vmin);
+	fOffset.push_back(fSlot[r]);
+      }
+    }
+    fOffset.push_back(N);
+
+    for (int i=0; i<N; i++) fObject[fSlot[ID[i]-vmin]++] = i;
+					// turn the counters into the lookup table
+    fSlot.assign(range,-1);
+    int nv = fVolumeID.size();
+    for (int k=0; k<nv; k++) fSlot[fVolumeID[k]-vmin] = k;
+  }
+  else {
+    for (int i=0; i<N; i++) fObject[i] = i;
+    std::stable_sort(fObject.begin(),fObject.end(),
+		     [ID](int I1, int I2) { return ID[I1] < ID[I2]; });
+
+    for (int i=0; i<N; i++) {
+      int id = ID[fObject[i]];
+      if ((i == 0) || (id != fVolumeID.back())) {
+	fVolumeID.push_back(id);
+	fOffset.push_back(i);
+      }
+    }
+    fOffset.push_back(N);
+  }
+
+  return 0;
+}
+
+//_____________________________________________________________________________
+int TVolumeIndex::Find(int VolumeID) const {
+
+  if (! fSlot.empty()) {
+    int r = VolumeID-fMinID;
+    if ((r < 0) || (r >= (int) fSlot.size()))               return -1;
+    return fSlot[r];
+  }
+
+  std::vector<int>::const_iterator it = std::lower_bound(fVolumeID.begin(),fVolumeID.end(),VolumeID);
+  if ((it == fVolumeID.end()) || (*it != VolumeID))         return -1;
+  return it-fVolumeID.begin();
+}
+
+//_____________________________________________________________________________
+void TVolumeIndex::Print(const char* Opt) const {
+  printf(" ---- TVolumeIndex: valid: %i volumes: %i objects: %i\n",
+	 fValid,NVolumes(),(int) fObject.size());
+  for (int k=0; k<NVolumes(); k++) {
+    printf("   volume %8i nobj: %6i\n",VolumeID(k),NObjects(k));
+  }
+}
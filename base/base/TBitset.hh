@@ -25,8 +25,15 @@ public:
 
   Int_t         GetNBits () const { return fNBits; }
   Int_t         GetNWords() const { return fNWords; }
+  const Int_t*  GetWords () const { return fBits;   }
 
   inline Int_t  GetBit(Int_t I) const ;
+				// word-wide operations: number of set bits,
+				// is there a common bit with Mask, number of
+				// common bits
+  inline Int_t  CountBits  () const ;
+  inline Int_t  Intersects (const TBitset* Mask) const ;
+  inline Int_t  CountCommon(const TBitset* Mask) const ;
 
 				// ****** modifiers
 
@@ -49,6 +56,30 @@ inline Int_t TBitset::GetBit(Int_t I) const {
   return (fBits[iw] >> ib) & 0x1 ;
 }
 
+//_____________________________________________________________________________
+inline Int_t TBitset::CountBits() const {
+  Int_t n = 0;
+  for (int i=0; i<fNWords; i++) n += __builtin_popcount((UInt_t) fBits[i]);
+  return n;
+}
+
+//_____________________________________________________________________________
+inline Int_t TBitset::Intersects(const TBitset* Mask) const {
+  int nw = (fNWords < Mask->fNWords) ? fNWords : Mask->fNWords;
+  for (int i=0; i<nw; i++) {
+    if (fBits[i] & Mask->fBits[i]) return 1;
+  }
+  return 0;
+}
+
+//_____________________________________________________________________________
+inline Int_t TBitset::CountCommon(const TBitset* Mask) const {
+  int nw = (fNWords < Mask->fNWords) ? fNWords : Mask->fNWords;
+  Int_t n = 0;
+  for (int i=0; i<nw; i++) n += __builtin_popcount((UInt_t) (fBits[i] & Mask->fBits[i]));
+  return n;
+}
+
 //_____________________________________________________________________________
 inline void TBitset::SetBit(Int_t I) {
   // this assumes that we are setting bits just once, certainly not safe,
@@ -1,6 +1,12 @@
 #ifndef TStnDataset_hh
 #define TStnDataset_hh
 
+#include <string>
+#include <atomic>
+#include <vector>
+#include <unordered_set>
+#include <unordered_map>
+
 #include "TNamed.h"
 #include "TString.h"
 #include "TObjArray.h"
@@ -9,6 +15,21 @@ class   TChain;
 class   TCdf2Files;
 
 class TStnDataset: public TNamed {
+public:
+//-----------------------------------------------------------------------------
+// per-file metadata of a non-cataloged dataset, cached in a sidecar file
+//-----------------------------------------------------------------------------
+  struct FileMetadata_t {
+    Long64_t    fSize;
+    Long_t      fModTime;		// 0: the file can't be stat'ed
+    Long_t      fProbeTime;		// when the file was opened
+    Int_t       fNEvents;
+    Int_t       fLoRun;
+    Int_t       fLoEvent;
+    Int_t       fHiRun;
+    Int_t       fHiEvent;
+    Int_t       fStatus;		// <0: couldn't read the file
+  };
 //-----------------------------------------------------------------------------
 //  data members
 //-----------------------------------------------------------------------------
@@ -29,6 +50,14 @@ protected:
   Int_t       fNGenEvents;      // for MC, number of generated events
   Int_t       fMCProcessCode;   // MC: process code
   Int_t       fPDGCode;         // PDG code of teh signal particle
+
+  std::unordered_set<std::string> fFileNames;  //! files in the chain, non-cataloged
+  Int_t       fNThreads;        // AddFiles: 0 - all cores
+  TString     fMetadataCache;   // sidecar file name, "": no cache
+  Int_t       fMetadataLoaded;
+  Int_t       fMetadataModified;
+  Long_t      fMetadataExpiry;  // sec, for the files which can't be stat'ed
+  std::unordered_map<std::string,FileMetadata_t> fMetadata; //! sidecar cache content
 //-----------------------------------------------------------------------------
 //  functions
 //-----------------------------------------------------------------------------
@@ -73,6 +102,9 @@ public:
   int         GetMCProcessCode() { return fMCProcessCode; }
   int         GetNGenEvents   () { return fNGenEvents;    }
   int         GetPDGCode      () { return fPDGCode; }
+  int         GetNThreads     () { return fNThreads; }
+  const char* GetMetadataCache() { return fMetadataCache.Data(); }
+  Long_t      GetMetadataExpiry() { return fMetadataExpiry; }
 
 				// this is list of TCdf2Files structures
 
@@ -93,6 +125,9 @@ public:
   void  SetNGenEvents   (int   N    ) { fNGenEvents    = N    ; }
   void  SetMCProcessCode(int   Code ) { fMCProcessCode = Code ; }
   void  SetPDGCode      (int   Code ) { fPDGCode       = Code ; }
+  void  SetNThreads      (int   N    ) { fNThreads      = N    ; }
+  void  SetMetadataCache (const char* Fn);
+  void  SetMetadataExpiry(Long_t Sec ) { fMetadataExpiry = Sec  ; }
 
   void  SetDoneBadFiles  (Int_t Flag = 1) { fDoneBadFiles = Flag;   }
 //-----------------------------------------------------------------------------
@@ -100,6 +135,12 @@ public:
 //-----------------------------------------------------------------------------
   Int_t AddFile      (const char* Name);
 //-----------------------------------------------------------------------------
+// bulk version: the files not found in the metadata cache are opened on
+// a thread pool, the files are added to the chain in the order of Names.
+// Returns the number of files which couldn't be read
+//-----------------------------------------------------------------------------
+  Int_t AddFiles     (const std::vector<TString>& Names);
+//-----------------------------------------------------------------------------
 // add file to a cataloged dataset, assume list of bad files to be read 
 // in from the very beginning
 //-----------------------------------------------------------------------------
@@ -113,6 +154,14 @@ public:
 
   // skip this file when chaining the dataset
   Int_t AddBadFile   (const char* Name);
+//-----------------------------------------------------------------------------
+// sidecar metadata cache, one line per file:
+// "name size mtime nevents lorun loevent hirun hievent status probe_time"
+//-----------------------------------------------------------------------------
+  Int_t ReadMetadataCache ();
+  Int_t WriteMetadataCache();
+
+  static Int_t ProbeFile(const char* Name, FileMetadata_t* Md);
 
 //-----------------------------------------------------------------------------
 // overloaded methods of TObject
@@ -120,6 +169,13 @@ public:
   void  Clear(Option_t* Opt = "");
   void  Print(Option_t* Opt = "") const ;
 
+protected:
+					// AddFiles worker thread
+  void  ProbeFiles(const std::vector<std::string>* Names ,
+		   std::vector<FileMetadata_t>*    Md    ,
+		   std::vector<int>*               Probed,
+		   std::atomic<int>*               Next  );
+
   ClassDef(TStnDataset,0)
 };
 
@@ -0,0 +1,77 @@
+#ifndef TStnIOProfile_hh
+#define TStnIOProfile_hh
+///////////////////////////////////////////////////////////////////////////////
+// I/O profile of a STNTUPLE branch: compression algorithm and level, 
+// basket size, split level and auto-flush cadence
+//
+// Algorithm: "ZLIB", "LZMA", "LZ4", "ZSTD" or "" (ROOT default)
+// SplitLevel = -1 and AutoFlush = 0 : use the defaults of the caller
+///////////////////////////////////////////////////////////////////////////////
+#include "TNamed.h"
+#include "TObjArray.h"
+
+class TTree;
+class TBranch;
+
+class TStnIOProfile : public TNamed {
+public:
+  Int_t     fAlgorithm;			// ROOT::RCompressionSetting::EAlgorithm
+  Int_t     fLevel;			// compression level, 0-9
+  Int_t     fBasketSize;		// in bytes
+  Int_t     fSplitLevel;		// -1: don't redefine
+  Long64_t  fAutoFlush;			// TTree::SetAutoFlush parameter, 0: don't redefine
+//-----------------------------------------------------------------------------
+// functions
+//-----------------------------------------------------------------------------
+public:
+  TStnIOProfile(const char* Name       = "default", 
+		const char* Algorithm  = ""       , 
+		int         Level      = 1        , 
+		int         BasketSize = 64000    , 
+		int         SplitLevel = -1       , 
+		Long64_t    AutoFlush  = 0        );
+
+  ~TStnIOProfile();
+//-----------------------------------------------------------------------------
+// accessors
+//-----------------------------------------------------------------------------
+  Int_t     Algorithm () const { return fAlgorithm;  }
+  Int_t     Level     () const { return fLevel;      }
+  Int_t     BasketSize() const { return fBasketSize; }
+  Int_t     SplitLevel() const { return fSplitLevel; }
+  Long64_t  AutoFlush () const { return fAutoFlush;  }
+
+					// algorithm*100+level, as used by 
+					// TBranch::SetCompressionSettings
+  Int_t     CompressionSettings() const { return fAlgorithm*100+fLevel; }
+
+					// -1 if the name is not known
+  static int         AlgorithmCode(const char* Name);
+  static const char* AlgorithmName(int         Code);
+//-----------------------------------------------------------------------------
+// apply compression settings and basket size to an existing branch 
+//-----------------------------------------------------------------------------
+  void      Apply(TBranch* Branch) const ;
+//-----------------------------------------------------------------------------
+// measurements
+// PrintIOStat: per-branch compressed/uncompressed sizes of a tree
+// Measure    : for each top-level branch of the STNTUPLE tree in 'Filename' 
+//              and each profile from the list, rewrite the first NEvents 
+//              entries of the branch into a memory file and read them back,
+//              report compressed size and write/read throughput
+//-----------------------------------------------------------------------------
+  static void  PrintIOStat(TTree* Tree, const double* FillTime = nullptr);
+
+  static int   Measure(const char* Filename, 
+		       TObjArray*  ListOfProfiles, 
+		       int         NEvents = 1000, 
+		       const char* BranchName = "");
+//-----------------------------------------------------------------------------
+// overloaded methods of TObject
+//-----------------------------------------------------------------------------
+  void      Print(Option_t* Opt = "") const ;
+
+  ClassDef(TStnIOProfile,0)
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef Stntuple_base_TVolumeIndex_hh
+#define Stntuple_base_TVolumeIndex_hh
+//-----------------------------------------------------------------------------
+// per-event index of objects (step points, virtual detector hits) by the
+// volume ID. Objects of the K-th volume (volumes go in increasing ID order)
+// are Object(K,0) .. Object(K,NObjects(K)-1), within a volume the original
+// order is preserved.
+// If the ID range is not too wide, the index is built by a counting sort and
+// Find(VolumeID) is a table lookup, otherwise - std::stable_sort and a
+// binary search
+//-----------------------------------------------------------------------------
+#include <vector>
+
+class TVolumeIndex {
+public:
+  enum { kMaxRange = 100000 };
+protected:
+  int               fValid;
+  int               fMinID;
+  std::vector<int>  fVolumeID;		// distinct volume IDs, increasing
+  std::vector<int>  fOffset;		// NVolumes()+1 elements
+  std::vector<int>  fObject;		// object indices grouped by volume
+  std::vector<int>  fSlot;		// ID-fMinID --> volume number or -1,
+					// empty for the sparse IDs
+public:
+  TVolumeIndex();
+  ~TVolumeIndex();
+					// ID[i]: volume ID of the i-th object
+  int   Build(const int* ID, int N);
+
+  int   Valid     () const { return fValid; }
+  void  Invalidate()       { fValid = 0;    }
+
+  int   NVolumes  ()             const { return fVolumeID.size(); }
+  int   VolumeID  (int K)        const { return fVolumeID[K]; }
+  int   NObjects  (int K)        const { return fOffset[K+1]-fOffset[K]; }
+  int   Object    (int K, int I) const { return fObject[fOffset[K]+I]; }
+					// volume number, -1 if no objects
+  int   Find      (int VolumeID) const;
+
+  void  Print(const char* Opt = "") const;
+};
+
+#endif
@@ -26,6 +26,7 @@
 
 #include "Stntuple/geom/TDisk.hh"
 #include "Stntuple/geom/TStnCrystal.hh"
+#include "Stntuple/obj/TCalHitData.hh"
 
 ClassImp(TDisk)
 
@@ -80,16 +81,109 @@ TDisk::~TDisk() {
 void TDisk::Clear(Option_t* Opt) {
 
   TStnCrystal  *cr;
-  
-  int nc = NCrystals();
-  for (int i=0; i<nc; i++) {
-    cr     = (TStnCrystal*) fListOfCrystals->UncheckedAt(i);
-    cr->Clear();
+
+  if (strcmp(Opt,"all") == 0) {
+    int nc = NCrystals();
+    for (int i=0; i<nc; i++) {
+      cr     = (TStnCrystal*) fListOfCrystals->UncheckedAt(i);
+      cr->Clear();
+    }
+    fNCrystalHits.assign(fNCrystalHits.size(),0);
+  }
+  else {
+//-----------------------------------------------------------------------------
+// only crystals with hits have been modified
+//-----------------------------------------------------------------------------
+    for (int i : fHitCrystal) {
+      cr     = (TStnCrystal*) fListOfCrystals->UncheckedAt(i);
+      cr->Clear();
+      fNCrystalHits[i] = 0;
+    }
   }
 
+  fHitCrystal.clear();
+  fHit.clear();
   fEnergy = 0;
 }
 
+//-----------------------------------------------------------------------------
+// hit bookkeeping, pass 1: count hits per crystal
+//-----------------------------------------------------------------------------
+void TDisk::CountHit(int I) {
+  if (fNCrystalHits.empty()) {
+    int nc = NCrystals();
+    fNCrystalHits.assign(nc,0);
+    fFirstHit.assign(nc,0);
+  }
+
+  if (fNCrystalHits[I] == 0) fHitCrystal.push_back(I);
+  fNCrystalHits[I] += 1;
+}
+
+//-----------------------------------------------------------------------------
+// define offsets of the crystal hit lists, counters are reused by AddHit
+//-----------------------------------------------------------------------------
+void TDisk::BookHits() {
+  int n(0);
+  for (int i : fHitCrystal) {
+    fFirstHit    [i]  = n;
+    n                += fNCrystalHits[i];
+    fNCrystalHits[i]  = 0;
+  }
+  fHit.resize(n);
+}
+
+//-----------------------------------------------------------------------------
+// pass 2: store the hit
+//-----------------------------------------------------------------------------
+void TDisk::AddHit(int I, TCalHitData* Hit) {
+  fHit[fFirstHit[I]+fNCrystalHits[I]] = Hit;
+  fNCrystalHits[I] += 1;
+  fEnergy          += Hit->Energy();
+}
+
+//-----------------------------------------------------------------------------
+// the hit array is not reallocated any more, give crystals their hits
+//-----------------------------------------------------------------------------
+void TDisk::FillCrystals() {
+  for (int i : fHitCrystal) {
+    Crystal(i)->SetHits(&fHit[fFirstHit[i]],fNCrystalHits[i]);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// geometry queries: 'I' - sequential number of the crystal in the disk,
+// for I, the crystal map returns precomputed values
+//-----------------------------------------------------------------------------
+int TDisk::GetRing(int I) {
+  return fCrystalMap->GetRing(I);
+}
+
+//-----------------------------------------------------------------------------
+int TDisk::GetRing(TDiskIndex* Index) {
+  return fCrystalMap->GetRing(Index);
+}
+
+//-----------------------------------------------------------------------------
+void TDisk::GetPosition(int I, TVector2* Pos) {
+  fCrystalMap->GetPosition(I,Pos);
+}
+
+//-----------------------------------------------------------------------------
+void TDisk::GetPosition(TDiskIndex* Index, TVector2* Pos) {
+  fCrystalMap->GetPosition(Index,Pos);
+}
+
+//-----------------------------------------------------------------------------
+double TDisk::GetRadius(int I) {
+  return fCrystalMap->GetRadius(I);
+}
+
+//-----------------------------------------------------------------------------
+double TDisk::GetRadius(TDiskIndex* Index) {
+  return fCrystalMap->GetRadius(Index);
+}
+
 //-----------------------------------------------------------------------------
 void TDisk::Print(Option_t* Opt) const {
   printf("------------------------------------------------------------------------\n");
@@ -165,8 +259,13 @@ int TDisk::InitSsqCrystals() {
     fCrystalMap->GetPosition(index,&pos);
     crystal = new TStnCrystal(index,pos.X(),pos.Y(),fZ0,fNEdges,fSize);
     crystal->SetDisk(this);
+    crystal->SetIndex(ic);
     fListOfCrystals->AddAt(crystal,ic);
   }
+//-----------------------------------------------------------------------------
+// precompute positions, radii, rings and neighbour lists
+//-----------------------------------------------------------------------------
+  fCrystalMap->InitTables();
 
   return 0;
 }
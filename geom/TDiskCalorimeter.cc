@@ -125,6 +125,13 @@ double TDiskCalorimeter::CrystalRadius(int HitID) {
   return r;
 }
 
+//-----------------------------------------------------------------------------
+int TDiskCalorimeter::NHitCrystals() {
+  int n(0);
+  for (int i=0; i<fNDisks; i++) n += fDisk[i]->NHitCrystals();
+  return n;
+}
+
 //-----------------------------------------------------------------------------
 int TDiskCalorimeter::InitEvent(TCalDataBlock* CalDataBlock) {
 
@@ -132,7 +139,6 @@ int TDiskCalorimeter::InitEvent(TCalDataBlock* CalDataBlock) {
   TStnCrystal*      crystal;
   TCalHitData*      hit;
   TDisk*            disk;
-  double            edisk[2];
 
 //-----------------------------------------------------------------------------
 // handle case of non-initialized calirimeter gently - don't want jobs to crash
@@ -141,41 +147,61 @@ int TDiskCalorimeter::InitEvent(TCalDataBlock* CalDataBlock) {
 
   Clear();
 
-  edisk[0] = 0;
-  edisk[1] = 0;
   nhits    = CalDataBlock->NHits();
-  
+  fHitLoc.resize(nhits);
+//-----------------------------------------------------------------------------
+// pass 1: find crystals and count hits per crystal
+//-----------------------------------------------------------------------------
   for (int i=0; i<nhits; i++) {
     hit     = CalDataBlock->CalHitData(i);
     hit_id  = hit->ID();
 
     dn      = DiskNumber(hit_id);
-    disk    = Disk(dn);
-    loc     = hit_id-disk->FirstChanOffset();
-    crystal = disk->Crystal(loc);
+    crystal = NULL;
+    if (dn >= 0) {
+      disk    = Disk(dn);
+      loc     = hit_id-disk->FirstChanOffset();
+      crystal = disk->Crystal(loc);
+    }
 
     if (crystal != NULL) {
-      crystal->AddHit(hit);
-      edisk[dn] += hit->Energy();
+      disk->CountHit(loc);
+      fHitLoc[i] = loc;
     }
     else {
       printf(">>> ERROR in TDiskCalorimeter::InitEvent : hit_id=%5i not assigned\n",hit_id);
+      fHitLoc[i] = -1;
       rc = -1;
     }
   }
+//-----------------------------------------------------------------------------
+// pass 2: store hits grouped by crystal
+//-----------------------------------------------------------------------------
+  for (int i=0; i<fNDisks; i++) fDisk[i]->BookHits();
 
-  fDisk[0]->SetEnergy(edisk[0]);
-  fDisk[1]->SetEnergy(edisk[1]);
+  for (int i=0; i<nhits; i++) {
+    loc = fHitLoc[i];
+    if (loc < 0) continue;
+    hit = CalDataBlock->CalHitData(i);
+    dn  = DiskNumber(hit->ID());
+    fDisk[dn]->AddHit(loc,hit);
+  }
 
-  fEnergy = edisk[0]+edisk[1];
+  fEnergy = 0;
+  for (int i=0; i<fNDisks; i++) {
+    fDisk[i]->FillCrystals();
+    fEnergy += fDisk[i]->Energy();
+  }
 
   return rc;
 }
 
+//-----------------------------------------------------------------------------
+// by default only crystals with hits are reset, Opt="all" resets all of them
 //-----------------------------------------------------------------------------
 void TDiskCalorimeter::Clear(Option_t* Opt) {
   for (int i=0; i<fNDisks; i++) {
-    fDisk[i]->Clear();
+    fDisk[i]->Clear(Opt);
   }
 
   fEnergy = 0;
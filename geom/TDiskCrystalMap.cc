@@ -1,5 +1,7 @@
 //
 
+#include "TVector2.h"
+
 #include "Stntuple/geom/TDiskCrystalMap.hh"
 
 //-----------------------------------------------------------------------------
@@ -15,6 +17,9 @@ TDiskCrystalMap::TDiskCrystalMap() {
   fIndex        = NULL;
   fIndexMap     = NULL;
   fNInside      = NULL;
+
+  fTablesInitialized = 0;
+  fMaxLK             = -1;
 }
 
 
@@ -29,6 +34,9 @@ TDiskCrystalMap::TDiskCrystalMap(double Size, double RMin, double RMax) {
   fIndex        = NULL;
   fIndexMap     = NULL;
   fNInside      = NULL;
+
+  fTablesInitialized = 0;
+  fMaxLK             = -1;
 }
 
 //-----------------------------------------------------------------------------
@@ -39,6 +47,83 @@ TDiskCrystalMap::~TDiskCrystalMap() {
 }
 
 
+//-----------------------------------------------------------------------------
+// geometry doesn't change, compute positions, radii, rings and neighbours 
+// once, after that all the per-crystal queries are table reads
+//-----------------------------------------------------------------------------
+int TDiskCrystalMap::InitTables() {
+
+  TVector2    pos;
+  TDiskIndex* di;
+  TDiskIndex  dd;
+
+  if (fTablesInitialized)                                   return 0;
+  if (fIndexMap == NULL) {
+    printf(">>> TDiskCrystalMap::InitTables ERROR: index map not defined\n");
+    return -1;
+  }
+
+  int nc = GetNInsideTotal();
+
+  fCrX.resize(nc);
+  fCrY.resize(nc);
+  fCrR.resize(nc);
+  fCrRing.resize(nc);
+//-----------------------------------------------------------------------------
+// (L,K) -> sequential number lookup table
+//-----------------------------------------------------------------------------
+  fMaxLK = 0;
+  for (int i=0; i<nc; i++) {
+    di = GetDiskIndex(GetIndexMap(i));
+    if (abs(di->fL) > fMaxLK) fMaxLK = abs(di->fL);
+    if (abs(di->fK) > fMaxLK) fMaxLK = abs(di->fK);
+  }
+
+  int nlk = 2*fMaxLK+1;
+  fLookup.assign(nlk*nlk,-1);
+
+  for (int i=0; i<nc; i++) {
+    di = GetDiskIndex(GetIndexMap(i));
+    fLookup[(di->fL+fMaxLK)*nlk+di->fK+fMaxLK] = i;
+
+    GetPosition(di,&pos);
+    fCrX   [i] = pos.X();
+    fCrY   [i] = pos.Y();
+    fCrR   [i] = pos.Mod();
+    fCrRing[i] = GetRing(di);
+  }
+//-----------------------------------------------------------------------------
+// neighbours: lattice distance of the offset (GetRing) = 1 or 2
+//-----------------------------------------------------------------------------
+  for (int order=0; order<2; order++) {
+    fNbOffset[order].resize(nc+1);
+    fNb      [order].clear();
+  }
+
+  for (int i=0; i<nc; i++) {
+    di = GetDiskIndex(GetIndexMap(i));
+    fNbOffset[0][i] = fNb[0].size();
+    fNbOffset[1][i] = fNb[1].size();
+
+    for (int dl=-2; dl<=2; dl++) {
+      for (int dk=-2; dk<=2; dk++) {
+	dd.Set(dl,dk);
+	int dist = GetRing(&dd);
+	if ((dist < 1) || (dist > 2))                     continue;
+	int j = GetCrystalNumber(di->fL+dl,di->fK+dk);
+	if (j < 0)                                          continue;
+	fNb[dist-1].push_back(j);
+      }
+    }
+  }
+
+  fNbOffset[0][nc] = fNb[0].size();
+  fNbOffset[1][nc] = fNb[1].size();
+
+  fTablesInitialized = 1;
+  return 0;
+}
+
 //-----------------------------------------------------------------------------
 void TDiskCrystalMap::Print(Option_t* Opt) const {
   int ip;
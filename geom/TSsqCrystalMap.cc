@@ -3,6 +3,7 @@
 #include "Stntuple/geom/TSsqCrystalMap.hh"
 #include "TVector2.h"
 #include "math.h"
+#include <algorithm>
 
 
 int TSsqCrystalMap::fgStep[12] = {
@@ -159,14 +160,25 @@ TSsqCrystalMap::~TSsqCrystalMap() {
 }
 
 
+//-----------------------------------------------------------------------------
+// 'I' : sequential crystal number in (compressed) IndexMap
 //-----------------------------------------------------------------------------
 int TSsqCrystalMap::GetRing(int I) {
-  return -1;
+  if (fTablesInitialized) return fCrRing[I];
+
+  return GetRing(GetDiskIndex(GetIndexMap(I)));
 }
 
+//-----------------------------------------------------------------------------
+// lattice steps are (1,1), (0,1), (1,0) and the opposite ones, ring ir starts 
+// from (0,-ir), see the constructor
 //-----------------------------------------------------------------------------
 int TSsqCrystalMap::GetRing(TDiskIndex* Index) {
-  return -1;
+  int l = Index->fL;
+  int k = Index->fK;
+
+  if (l*k >= 0) return std::max(std::abs(l),std::abs(k));
+  else          return std::abs(l)+std::abs(k);
 }
 
 
@@ -174,6 +186,11 @@ int TSsqCrystalMap::GetRing(TDiskIndex* Index) {
 // 'I' : sequential crystal number in (compressed) IndexMap
 //-----------------------------------------------------------------------------
 void TSsqCrystalMap::GetPosition(int I, TVector2* Pos) {
+  if (fTablesInitialized) {
+    Pos->Set(fCrX[I],fCrY[I]);
+    return;
+  }
+
   int loc = GetIndexMap(I);
   TDiskIndex* di = GetDiskIndex(loc);
   GetPosition(di,Pos);
@@ -188,12 +205,16 @@ void TSsqCrystalMap::GetPosition(TDiskIndex* Index, TVector2* Pos) {
 
 //-----------------------------------------------------------------------------
 double TSsqCrystalMap::GetRadius(TDiskIndex* Index) {
-  return -1.;
+  TVector2 pos;
+  GetPosition(Index,&pos);
+  return pos.Mod();
 }
 
 //-----------------------------------------------------------------------------
 double TSsqCrystalMap::GetRadius(int I) {
-  return -1.;
+  if (fTablesInitialized) return fCrR[I];
+
+  return GetRadius(GetDiskIndex(GetIndexMap(I)));
 }
 
 //-----------------------------------------------------------------------------
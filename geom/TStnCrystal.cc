@@ -50,14 +50,14 @@ TStnCrystal::TStnCrystal(TDiskIndex* Index,
   fShape->SetFillStyle(0);
 
   //  fDisk       = Disk;
-  fListOfHits = new TObjArray(10);
+  fIndex      = -1;
+  fHit        = nullptr;
   fNHits      = 0;
+  fEnergy     = 0;
 }
 
 //-----------------------------------------------------------------------------
 TStnCrystal::~TStnCrystal() {
-  fListOfHits->Clear();
-  delete fListOfHits;
 }
 
 //-----------------------------------------------------------------------------
@@ -122,8 +122,7 @@ void TStnCrystal::Clear(Option_t* Opt) {
   SetLineColor(1);
   fNHits     = 0;
   fEnergy    = 0.;
-
-  fListOfHits->Clear();
+  fHit       = nullptr;
 }
 
 
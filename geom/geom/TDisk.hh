@@ -15,6 +15,7 @@
 
 // C++ includes.
 #include <iostream>
+#include <vector>
 #include <math.h>
 
 #include "TMath.h"
@@ -28,6 +29,7 @@
 #include "Stntuple/geom/TDiskCrystalMap.hh"
 
 class TStnCrystal;
+class TCalHitData;
 
 namespace mu2e {
   class Disk;
@@ -53,6 +55,14 @@ public:
 
   double             fEnergy;           // total energy deposited in the disk
 //-----------------------------------------------------------------------------
+// per-event hit bookkeeping is sparse: only crystals with hits are touched.
+// hits are stored contiguously, grouped by crystal
+//-----------------------------------------------------------------------------
+  std::vector<int>          fHitCrystal;   // ! indices of crystals with hits
+  std::vector<TCalHitData*> fHit;	   // ! hits, grouped by crystal
+  std::vector<int>          fNCrystalHits; // ! per crystal, N(hits)
+  std::vector<int>          fFirstHit;	   // ! per crystal, index of the first hit in fHit
+//-----------------------------------------------------------------------------
 // methods
 //-----------------------------------------------------------------------------
   TDisk();
@@ -89,6 +99,12 @@ public:
   void           GetPosition(TDiskIndex* Index, TVector2* Pos);
 
   double         Energy() { return fEnergy; }
+					// iteration over crystals with hits
+  int            NHitCrystals()    { return fHitCrystal.size(); }
+  int            HitCrystalIndex(int I) { return fHitCrystal[I]; }
+  TStnCrystal*   HitCrystal(int I) { return Crystal(fHitCrystal[I]); }
+  int            NHits()           { return fHit.size(); }
+  TCalHitData*   Hit(int I)        { return fHit[I]; }
 
   int            GetNCrystalsPerRing(int Ring) const { return fCrystalMap->GetNCrystalsPerRing(Ring); }
   //  int            GetNInside         (int Ring) const { return fCrystalMap->fNInside         [Ring]; }
@@ -98,6 +114,14 @@ public:
 
   double         GetRadius(int I);
   double         GetRadius(TDiskIndex* Index);
+					// neighbours of crystal I, precomputed by 
+					// the crystal map. Order=1: first, 2: second
+  int            NNeighbours(int I, int Order = 1) { 
+    return fCrystalMap->GetNNeighbours(I,Order); 
+  }
+  TStnCrystal*   Neighbour  (int I, int J, int Order = 1) { 
+    return Crystal(fCrystalMap->GetNeighbour(I,J,Order)); 
+  }
 
   double         GetCrystalArea() { return  fSize*fSize*sqrt(3.)/2.; }
 
@@ -115,9 +139,19 @@ public:
 
   void           SetEnergy(double E) { fEnergy = E; }
 //-----------------------------------------------------------------------------
+// filling hits, in this order: CountHit for all hits of the event, then 
+// BookHits, then AddHit for the same hits, then FillCrystals
+//-----------------------------------------------------------------------------
+  void           CountHit    (int I);
+  void           BookHits    ();
+  void           AddHit      (int I, TCalHitData* Hit);
+  void           FillCrystals();
+//-----------------------------------------------------------------------------
 // overloaded functions of TObject
 //-----------------------------------------------------------------------------
   virtual void   Paint(Option_t* Opt = "");
+					// Opt="all": reset all crystals, 
+					// by default - only the ones with hits
   virtual void   Clear(Option_t* Opt = "") ;
   virtual void   Print(Option_t* Opt = "") const ;
 
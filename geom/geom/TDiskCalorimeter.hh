@@ -15,6 +15,7 @@
 
 // C++ includes.
 #include <iostream>
+#include <vector>
 
 #include "TString.h"
 #include "TFolder.h"
@@ -46,6 +47,8 @@ public:
   TDisk*   fDisk[2];
 
   double   fEnergy; // total energy in the calorimeter
+
+  std::vector<int> fHitLoc;		// ! per hit, crystal index within the disk
 //-----------------------------------------------------------------------------
 // methods
 //-----------------------------------------------------------------------------
@@ -63,6 +66,8 @@ public:
   int     DiskNumber   (int HitID);
   double  CrystalRadius(int HitID);
   double  Energy()     { return fEnergy; }
+					// crystals with hits: see TDisk::NHitCrystals
+  int     NHitCrystals();
 //-----------------------------------------------------------------------------
 // other methods
 //-----------------------------------------------------------------------------
@@ -1,6 +1,9 @@
 #ifndef Stntuple_base_TDiskCrystalMap_hh
 #define Stntuple_base_TDiskCrystalMap_hh
 
+#include <vector>
+#include <cstdlib>
+
 #include "Stntuple/base/TStnArrayI.hh"
 #include "Stntuple/geom/TDiskIndex.hh"
 
@@ -26,6 +29,23 @@ protected:
 					// fIndexMap is non-sparse, runs from 0 to N-1, where N is the total 
 					// number of crystals _inside_ the disk
   int*           fNInside ;
+//-----------------------------------------------------------------------------
+// per-crystal tables, filled once by InitTables. Index: sequential number 
+// of the crystal inside the disk, same as for fIndexMap
+//-----------------------------------------------------------------------------
+  int                  fTablesInitialized;
+  std::vector<double>  fCrX;
+  std::vector<double>  fCrY;
+  std::vector<double>  fCrR;
+  std::vector<int>     fCrRing;
+					// neighbours, compressed: neighbours of 
+					// crystal I are fNb[fNbOffset[I]..fNbOffset[I+1]-1]
+					// [0]: first, [1]: second neighbours
+  std::vector<int>     fNbOffset[2];
+  std::vector<int>     fNb      [2];
+					// (L,K) -> sequential number, -1 if outside
+  int                  fMaxLK;
+  std::vector<int>     fLookup;
 
 public:
 
@@ -64,6 +84,31 @@ public:
 
   virtual int    InsideCode(TDiskIndex* Index, double* Fraction) = 0;
 
+//-----------------------------------------------------------------------------
+// precomputed tables, 'I' - sequential crystal number. InitTables uses 
+// the virtual GetPosition(TDiskIndex*) and GetRing(TDiskIndex*), the latter
+// defines the lattice distance
+//-----------------------------------------------------------------------------
+  int    InitTables();
+  int    TablesInitialized() const { return fTablesInitialized; }
+
+  double CrystalX     (int I) const { return fCrX   [I]; }
+  double CrystalY     (int I) const { return fCrY   [I]; }
+  double CrystalRadius(int I) const { return fCrR   [I]; }
+  int    CrystalRing  (int I) const { return fCrRing[I]; }
+					// Order=1: first, Order=2: second neighbours
+  int    GetNNeighbours(int I, int Order = 1) const { 
+    return fNbOffset[Order-1][I+1]-fNbOffset[Order-1][I]; 
+  }
+  int    GetNeighbour  (int I, int J, int Order = 1) const { 
+    return fNb[Order-1][fNbOffset[Order-1][I]+J]; 
+  }
+					// -1 if the crystal is not inside the disk
+  int    GetCrystalNumber(int L, int K) const {
+    if ((abs(L) > fMaxLK) || (abs(K) > fMaxLK)) return -1;
+    return fLookup[(L+fMaxLK)*(2*fMaxLK+1)+K+fMaxLK];
+  }
+
   virtual void   Print(Option_t* Opt = "") const ;
 };
 
@@ -27,7 +27,8 @@ protected:
   TVector3              fCenter;
   double                fSize;
 
-  TObjArray*            fListOfHits;    // keeps [not-owned] pointers to TCalDataBlock
+  TCalHitData**         fHit;           // ! [not-owned] hits of this crystal, points into 
+					// the flat hit array of the disk
 					// display in XY view
   TStnShape*            fShape;
 
@@ -51,8 +52,7 @@ public:
 //-----------------------------------------------------------------------------
 // accessors
 //-----------------------------------------------------------------------------
-  TObjArray*     ListOfHits   () { return fListOfHits; }
-  TCalHitData*   CalHitData(int I) { return (TCalHitData*) fListOfHits->UncheckedAt(I); }
+  TCalHitData*   CalHitData(int I) { return fHit[I]; }
   TVector3*      Center       () { return &fCenter   ; }
   int            Index        () { return fIndex     ; }
   int            NHits        () { return fNHits; }
@@ -71,11 +71,13 @@ public:
   void  SetFillColor(int Color) { fShape->fFillColor = Color; }
   void  SetLineColor(int Color) { fShape->fLineColor = Color; }
   void  SetDisk     (TDisk* Disk) { fDisk = Disk; }
+  void  SetIndex    (int Index  ) { fIndex = Index; }
 
-  void   AddHit(TCalHitData* CalHit) { 
-    fListOfHits->Add(CalHit); 
-    fEnergy += CalHit->Energy();
-    fNHits++;
+					// called by TDisk, hits are contiguous
+  void   SetHits(TCalHitData** Hit, int NHits) { 
+    fHit   = Hit;
+    fNHits = NHits;
+    for (int i=0; i<NHits; i++) fEnergy += Hit[i]->Energy();
   }
 					// use for rad damage estimates
 
@@ -72,7 +72,10 @@ TCalVisNode::TCalVisNode(const char* Name, const mu2e::Disk* Disk, int SectionID
     cr     = &Disk->crystal(i);
     evd_cr = new TEvdCrystal(cr,nedges,crystal_size,Disk);
     fListOfEvdCrystals->Add(evd_cr);
+    fCrystalGrid.Add(evd_cr->X0(),evd_cr->Y0());
   }
+					// crystals don't move, build once
+  fCrystalGrid.Build();
 }
 
 //_____________________________________________________________________________
@@ -339,27 +342,20 @@ Int_t TCalVisNode::DistancetoPrimitiveXY(Int_t px, Int_t py) {
   static TVector3 global;
   static TVector3 local;
 
-  int             px0, py0;
-  int             dist, min_dist(9999);
+  int             min_dist(9999);
 
   TObject* closest(nullptr);
 
   global.SetXYZ(gPad->AbsPixeltoX(px),gPad->AbsPixeltoY(py),0);
 
-  int ncr = fListOfEvdCrystals->GetEntries();
+  double sx = 1./(gPad->AbsPixeltoX(px+1)-gPad->AbsPixeltoX(px));
+  double sy = 1./(gPad->AbsPixeltoY(py+1)-gPad->AbsPixeltoY(py));
+  double d;
 
-  for (int icr=0; icr<ncr; icr++) {
-    TEvdCrystal* cr = EvdCrystal(icr);
-    
-    px0 = gPad->XtoAbsPixel(cr->X0());
-    py0 = gPad->YtoAbsPixel(cr->Y0());
-
-    dist = sqrt((px0-px)*(px0-px) + (py0-py)*(py0-py));
-
-    if (dist < min_dist) {
-      min_dist = dist;
-      closest  = cr;
-    }
+  int icr = fCrystalGrid.FindClosest(global.X(),global.Y(),sx,sy,min_dist,&d);
+  if (icr >= 0) {
+    min_dist = (int) d;
+    closest  = EvdCrystal(icr);
   }
 
   SetClosestObject(closest,min_dist);
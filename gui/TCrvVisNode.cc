@@ -187,6 +187,25 @@ TCrvVisNode::TCrvVisNode(const char* Name, int SectionID) : TStnVisNode(Name) {
     Warning("TCrvVisNode", Form("Unknown SectionID %i", SectionID));
     break;
   }
+
+  BuildBarIndex();
+}
+
+//-----------------------------------------------------------------------------
+// bars are defined once, index them by the bar index and by position
+//-----------------------------------------------------------------------------
+void TCrvVisNode::BuildBarIndex() {
+  fBarIndex.clear();
+  fBarGridXY.Clear();
+
+  int nbars = NBars();
+  for (int i=0; i<nbars; i++) {
+    TEvdCrvBar* bar = EvdBar(i);
+    fBarIndex[bar->Bar().asInt()] = i;
+    fBarGridXY.Add(bar->X0(),bar->Y0());
+  }
+
+  fBarGridXY.Build();
 }
 
 //-----------------------------------------------------------------------------
@@ -325,26 +344,18 @@ Int_t TCrvVisNode::DistancetoPrimitiveXY(Int_t px, Int_t py) {
   double gx = global.X();
   double gy = global.Y();
   
-  int          nbar;
-  TEvdCrvBar  *evd_bar;
-  
-  nbar = NBars();
-  double gx0, gy0;
-  
-  printf("gx: %f , gy %f \n", gx, gy);
-  for (int ibar = 0; ibar<nbar; ibar++) {
-    evd_bar = EvdBar(ibar);
-    
-    //px0 = gPad->XtoAbsPixel(evd_bar->X0());
-    //py0 = gPad->YtoAbsPixel(evd_bar->Y0());
-    gx0 = evd_bar->X0();
-    gy0 = evd_bar->Y0();
-    
-    dist = sqrt(pow((gx0 - gx),2) + pow((gy0 - gy),2)); //actual distance
-    if (dist < min_dist) {
-      min_dist = dist;
-      fClosestObject = evd_bar;
-      printf("Found bar: %i (%f, %f) to be closest at (%f, %f) dist= %f \n", evd_bar->Bar().asInt(), gx0, gy0, gx, gy, dist);
+  if (DebugLevel() > 0) printf("gx: %f , gy %f \n", gx, gy);
+//-----------------------------------------------------------------------------
+// distance in world coordinates
+//-----------------------------------------------------------------------------
+  int i = fBarGridXY.FindClosest(gx,gy,1.,1.,min_dist,&dist);
+  if (i >= 0) {
+    TEvdCrvBar* evd_bar = EvdBar(i);
+    min_dist       = dist;
+    fClosestObject = evd_bar;
+    if (DebugLevel() > 0) {
+      printf("Found bar: %i (%f, %f) to be closest at (%f, %f) dist= %f \n", 
+	     evd_bar->Bar().asInt(), evd_bar->X0(), evd_bar->Y0(), gx, gy, dist);
     }
   }
   return min_dist;
@@ -376,17 +387,11 @@ void TCrvVisNode::Print(Option_t* Opt) const {
 
 //-----------------------------------------------------------------------------
 TEvdCrvBar*  TCrvVisNode::EvdBarWithIndex(int barIndex) {
-  TEvdCrvBar* tempBarPtr = 0;
-
+  auto it = fBarIndex.find(barIndex);
+  if (it != fBarIndex.end()) return EvdBar(it->second);
+					// as before: the last bar if not found
   int nbars = NBars();
-  for (int i = 0; i<nbars; i++) {
-    tempBarPtr = EvdBar(i);
-    if (tempBarPtr->Bar().asInt() == barIndex) {
-      return tempBarPtr;
-    }
-  }
-  
-  return tempBarPtr; //If it makes it through the loop without returning
+  return (nbars > 0) ? EvdBar(nbars-1) : 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////
+// uniform grid for picking, see comments in TEvdGridIndex.hh
+///////////////////////////////////////////////////////////////////////////////
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+#include "Stntuple/gui/TEvdGridIndex.hh"
+
+namespace stntuple {
+
+//-----------------------------------------------------------------------------
+TEvdGridIndex::TEvdGridIndex() {
+  fNx   = 0;
+  fNy   = 0;
+  fXMin = 0;
+  fYMin = 0;
+  fDx   = 1;
+  fDy   = 1;
+}
+
+//-----------------------------------------------------------------------------
+TEvdGridIndex::~TEvdGridIndex() {
+}
+
+//-----------------------------------------------------------------------------
+void TEvdGridIndex::Clear() {
+  fX.clear();
+  fY.clear();
+  fCellOffset.clear();
+  fItem.clear();
+  fNx = 0;
+  fNy = 0;
+}
+
+//-----------------------------------------------------------------------------
+// choose the grid size such that on average there are NPerCell points per cell,
+// then sort the points by cell (counting sort)
+//-----------------------------------------------------------------------------
+void TEvdGridIndex::Build(int NPerCell) {
+  int n = fX.size();
+
+  fCellOffset.clear();
+  fItem.clear();
+
+  if (n == 0) {
+    fNx = 0;
+    fNy = 0;
+    return;
+  }
+
+  double xmin = *std::min_element(fX.begin(),fX.end());
+  double xmax = *std::max_element(fX.begin(),fX.end());
+  double ymin = *std::min_element(fY.begin(),fY.end());
+  double ymax = *std::max_element(fY.begin(),fY.end());
+
+  int nc = std::max(1,(int) sqrt(double(n)/NPerCell));
+
+  fNx   = nc;
+  fNy   = nc;
+  fXMin = xmin;
+  fYMin = ymin;
+					// avoid zero-size cells
+  fDx   = (xmax > xmin) ? (xmax-xmin)/fNx*(1+1.e-6) : 1.;
+  fDy   = (ymax > ymin) ? (ymax-ymin)/fNy*(1+1.e-6) : 1.;
+
+  std::vector<int> cell(n);
+  fCellOffset.assign(fNx*fNy+1,0);
+
+  for (int i=0; i<n; i++) {
+    int ix  = std::min(fNx-1,(int) ((fX[i]-fXMin)/fDx));
+    int iy  = std::min(fNy-1,(int) ((fY[i]-fYMin)/fDy));
+    cell[i] = ix*fNy+iy;
+    fCellOffset[cell[i]+1] += 1;
+  }
+
+  for (int i=0; i<fNx*fNy; i++) fCellOffset[i+1] += fCellOffset[i];
+
+  std::vector<int> pos(fCellOffset.begin(),fCellOffset.end()-1);
+  fItem.resize(n);
+  for (int i=0; i<n; i++) {
+    fItem[pos[cell[i]]++] = i;
+  }
+}
+
+//-----------------------------------------------------------------------------
+// scan rings of cells around the cell of (X,Y), stop when the next ring
+// can't have a point closer than the closest one found
+//-----------------------------------------------------------------------------
+int TEvdGridIndex::FindClosest(double X, double Y, double ScaleX, double ScaleY,
+			       double MaxDist, double* Dist) const {
+  int    closest(-1);
+  double min_dist(MaxDist);
+
+  *Dist = MaxDist;
+  if (fNx == 0)                                             return -1;
+
+  int ix0 = (int) floor((X-fXMin)/fDx);
+  int iy0 = (int) floor((Y-fYMin)/fDy);
+
+  ix0 = std::max(0,std::min(fNx-1,ix0));
+  iy0 = std::max(0,std::min(fNy-1,iy0));
+
+  double step  = std::min(fDx*fabs(ScaleX),fDy*fabs(ScaleY));
+  int    nrmax = std::max(fNx,fNy);
+
+  for (int ir=0; ir<nrmax; ir++) {
+    for (int ix=ix0-ir; ix<=ix0+ir; ix++) {
+      if ((ix < 0) || (ix >= fNx))                          continue;
+      for (int iy=iy0-ir; iy<=iy0+ir; iy++) {
+	if ((iy < 0) || (iy >= fNy))                        continue;
+					// only the ring itself
+	if ((abs(ix-ix0) != ir) && (abs(iy-iy0) != ir))     continue;
+
+	int cell = ix*fNy+iy;
+	for (int k=fCellOffset[cell]; k<fCellOffset[cell+1]; k++) {
+	  int    i  = fItem[k];
+	  double dx = (fX[i]-X)*ScaleX;
+	  double dy = (fY[i]-Y)*ScaleY;
+	  double d  = sqrt(dx*dx+dy*dy);
+	  if (d < min_dist) {
+	    min_dist = d;
+	    closest  = i;
+	  }
+	}
+      }
+    }
+					// points in the next rings are
+					// at least ir*step away
+    if (ir*step >= min_dist)                                break;
+  }
+
+  *Dist = min_dist;
+  return closest;
+}
+
+}
@@ -0,0 +1,195 @@
+///////////////////////////////////////////////////////////////////////////////
+// batched hit painting, see comments in TEvdHitPainter.hh
+///////////////////////////////////////////////////////////////////////////////
+#include "TPad.h"
+#include "TLine.h"
+#include "TMarker.h"
+#include "TStyle.h"
+#include "TAttLine.h"
+#include "TAttFill.h"
+#include "TAttMarker.h"
+
+#include "Stntuple/gui/TEvdHitPainter.hh"
+
+namespace stntuple {
+
+//-----------------------------------------------------------------------------
+TEvdHitPainter::TEvdHitPainter(int MaxDetailedHits, int NDensityBins) {
+  fMaxDetailedHits = MaxDetailedHits;
+  fNDensityBins    = NDensityBins;
+  fNVisible        = 0;
+  fXMin            = 0;
+  fXMax            = 0;
+  fYMin            = 0;
+  fYMax            = 0;
+}
+
+//-----------------------------------------------------------------------------
+TEvdHitPainter::~TEvdHitPainter() {
+}
+
+//-----------------------------------------------------------------------------
+// keep the batches - and their allocated memory - from one paint to another
+//-----------------------------------------------------------------------------
+void TEvdHitPainter::BeginPaint() {
+  fXMin = gPad->GetUxmin();
+  fXMax = gPad->GetUxmax();
+  fYMin = gPad->GetUymin();
+  fYMax = gPad->GetUymax();
+
+  for (LineBatch_t& b : fLines) {
+    b.fX1.clear(); b.fY1.clear(); b.fX2.clear(); b.fY2.clear();
+  }
+
+  for (MarkerBatch_t& b : fMarkers) {
+    b.fX.clear(); b.fY.clear();
+  }
+
+  fNVisible = 0;
+}
+
+//-----------------------------------------------------------------------------
+TEvdHitPainter::LineBatch_t* TEvdHitPainter::GetLineBatch(Color_t Color, Style_t Style, Width_t Width) {
+  for (LineBatch_t& b : fLines) {
+    if ((b.fColor == Color) && (b.fStyle == Style) && (b.fWidth == Width)) return &b;
+  }
+
+  fLines.push_back(LineBatch_t());
+  LineBatch_t* b = &fLines.back();
+  b->fColor = Color;
+  b->fStyle = Style;
+  b->fWidth = Width;
+  return b;
+}
+
+//-----------------------------------------------------------------------------
+TEvdHitPainter::MarkerBatch_t* TEvdHitPainter::GetMarkerBatch(Color_t Color, Style_t Style, Size_t Size) {
+  for (MarkerBatch_t& b : fMarkers) {
+    if ((b.fColor == Color) && (b.fStyle == Style) && (b.fSize == Size)) return &b;
+  }
+
+  fMarkers.push_back(MarkerBatch_t());
+  MarkerBatch_t* b = &fMarkers.back();
+  b->fColor = Color;
+  b->fStyle = Style;
+  b->fSize  = Size;
+  return b;
+}
+
+//-----------------------------------------------------------------------------
+// a line is dropped if both its ends are on the same side outside the range
+//-----------------------------------------------------------------------------
+void TEvdHitPainter::AddLine(const TLine* Line) {
+  double x1 = gPad->XtoPad(Line->GetX1());
+  double y1 = gPad->YtoPad(Line->GetY1());
+  double x2 = gPad->XtoPad(Line->GetX2());
+  double y2 = gPad->YtoPad(Line->GetY2());
+
+  if ((x1 < fXMin) && (x2 < fXMin))                         return;
+  if ((x1 > fXMax) && (x2 > fXMax))                         return;
+  if ((y1 < fYMin) && (y2 < fYMin))                         return;
+  if ((y1 > fYMax) && (y2 > fYMax))                         return;
+
+  LineBatch_t* b = GetLineBatch(Line->GetLineColor(),Line->GetLineStyle(),Line->GetLineWidth());
+  b->fX1.push_back(x1);
+  b->fY1.push_back(y1);
+  b->fX2.push_back(x2);
+  b->fY2.push_back(y2);
+
+  fNVisible += 1;
+}
+
+//-----------------------------------------------------------------------------
+void TEvdHitPainter::AddMarker(const TMarker* Marker) {
+  double x = gPad->XtoPad(Marker->GetX());
+  double y = gPad->YtoPad(Marker->GetY());
+
+  if ((x < fXMin) || (x > fXMax) || (y < fYMin) || (y > fYMax)) return;
+
+  MarkerBatch_t* b = GetMarkerBatch(Marker->GetMarkerColor(),Marker->GetMarkerStyle(),
+				    Marker->GetMarkerSize());
+  b->fX.push_back(x);
+  b->fY.push_back(y);
+
+  fNVisible += 1;
+}
+
+//-----------------------------------------------------------------------------
+void TEvdHitPainter::EndPaint() {
+
+  if (fNVisible > fMaxDetailedHits) {
+    PaintDensity();
+    return;
+  }
+
+  for (LineBatch_t& b : fLines) {
+    int n = b.fX1.size();
+    if (n == 0)                                             continue;
+
+    TAttLine att(b.fColor,b.fStyle,b.fWidth);
+    att.Modify();
+    for (int i=0; i<n; i++) {
+      gPad->PaintLine(b.fX1[i],b.fY1[i],b.fX2[i],b.fY2[i]);
+    }
+  }
+
+  for (MarkerBatch_t& b : fMarkers) {
+    int n = b.fX.size();
+    if (n == 0)                                             continue;
+
+    TAttMarker att(b.fColor,b.fStyle,b.fSize);
+    att.Modify();
+    gPad->PaintPolyMarker(n,b.fX.data(),b.fY.data());
+  }
+}
+
+//-----------------------------------------------------------------------------
+// hit density: line centers and markers binned in the pad range,
+// colored by the current palette
+//-----------------------------------------------------------------------------
+void TEvdHitPainter::PaintDensity() {
+  int    nb = fNDensityBins;
+  double dx = (fXMax-fXMin)/nb;
+  double dy = (fYMax-fYMin)/nb;
+
+  if ((dx <= 0) || (dy <= 0))                               return;
+
+  std::vector<int> count(nb*nb,0);
+
+  auto fill = [&](double X, double Y) {
+    int ix = (int) ((X-fXMin)/dx);
+    int iy = (int) ((Y-fYMin)/dy);
+    if ((ix < 0) || (ix >= nb) || (iy < 0) || (iy >= nb)) return;
+    count[ix*nb+iy] += 1;
+  };
+
+  for (LineBatch_t& b : fLines) {
+    int n = b.fX1.size();
+    for (int i=0; i<n; i++) fill((b.fX1[i]+b.fX2[i])/2,(b.fY1[i]+b.fY2[i])/2);
+  }
+
+  for (MarkerBatch_t& b : fMarkers) {
+    int n = b.fX.size();
+    for (int i=0; i<n; i++) fill(b.fX[i],b.fY[i]);
+  }
+
+  int nmax = 0;
+  for (int c : count) if (c > nmax) nmax = c;
+  if (nmax == 0)                                            return;
+
+  int ncol = gStyle->GetNumberOfColors();
+
+  for (int ix=0; ix<nb; ix++) {
+    for (int iy=0; iy<nb; iy++) {
+      int c = count[ix*nb+iy];
+      if (c == 0)                                           continue;
+
+      int ic = (ncol > 1) ? (int) (double(c)/nmax*(ncol-1)) : 0;
+      TAttFill att(gStyle->GetColorPalette(ic),1001);
+      att.Modify();
+      gPad->PaintBox(fXMin+ix*dx,fYMin+iy*dy,fXMin+(ix+1)*dx,fYMin+(iy+1)*dy);
+    }
+  }
+}
+
+}
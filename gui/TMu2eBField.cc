@@ -1,6 +1,17 @@
 ///////////////////////////////////////////////////////////////////////////////
 //
 ///////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 #include "Stntuple/gui/TMu2eBField.hh"
 #include "Stntuple/val/stntuple_val_functions.hh"
 
@@ -10,24 +21,124 @@
 #include "Offline/GeometryService/inc/BFieldConfigMaker.hh"
 #include "Offline/GeometryService/inc/BeamlineMaker.hh"
 #include "Offline/BeamlineGeom/inc/Beamline.hh"
+#include "Offline/BFieldGeom/inc/BFieldConfig.hh"
+#include "Offline/ConfigTools/inc/ConfigFileLookupPolicy.hh"
 #include "CLHEP/Vector/ThreeVector.h"
 
 #include "TBranch.h"
 #include "TNtuple.h"
+#include "TEnv.h"
+#include "TError.h"
+#include "TString.h"
+#include "TRandom3.h"
 
 ClassImp(stntuple::TMu2eBField)
 
+namespace {
+  const int kGridMagic   = 0x4d324246;	// "M2BF"
+  const int kGridVersion = 2;
+//-----------------------------------------------------------------------------
+// FNV-1a, add the name, size and modification time of a file
+//-----------------------------------------------------------------------------
+  void HashFile(unsigned long long& Hash, const std::string& Name) {
+    struct stat st;
+    std::string path;
+    try {
+      mu2e::ConfigFileLookupPolicy find_file;
+      path = find_file(Name);
+    }
+    catch (...) {
+      path = Name;
+    }
+
+    std::string s(Name);
+    if (stat(path.data(),&st) == 0) {
+      s += Form(":%lld:%lld;",(long long) st.st_size,(long long) st.st_mtime);
+    }
+    else {
+      s += ":-1:-1;";
+    }
+
+    for (unsigned char c : s) {
+      Hash ^= c;
+      Hash *= 0x100000001b3ULL;
+    }
+  }
+}
+
 namespace stntuple {
 //-----------------------------------------------------------------------------
 TMu2eBField::TMu2eBField(): TEveMagField() {
 
+  fGeomFile  = "Mu2eG4/test/geom_01.txt";
+
+  fBeamline  = nullptr;
+  fBfc       = nullptr;
+  fBfmm      = nullptr;
+  fBmgr      = nullptr;
+
+  fMap       = nullptr;
+  fMapSize   = 0;
+  fGrid      = nullptr;
+//-----------------------------------------------------------------------------
+// default grid: tracker and calorimeter, Mu2e coordinates, cm
+//-----------------------------------------------------------------------------
+  fCacheFile = gEnv->GetValue("mu2e.BField.CacheFile",".TMu2eBField.cache");
+  fXMin      = gEnv->GetValue("mu2e.BField.Grid.XMin",-470.);
+  fXMax      = gEnv->GetValue("mu2e.BField.Grid.XMax",-310.);
+  fYMin      = gEnv->GetValue("mu2e.BField.Grid.YMin", -80.);
+  fYMax      = gEnv->GetValue("mu2e.BField.Grid.YMax",  80.);
+  fZMin      = gEnv->GetValue("mu2e.BField.Grid.ZMin", 800.);
+  fZMax      = gEnv->GetValue("mu2e.BField.Grid.ZMax",1400.);
+  fStep      = gEnv->GetValue("mu2e.BField.Grid.Step",   2.);
+  fTolerance = gEnv->GetValue("mu2e.BField.Tolerance",1.e-3);
+
+  fNx        = (int) ((fXMax-fXMin)/fStep+0.5)+1;
+  fNy        = (int) ((fYMax-fYMin)/fStep+0.5)+1;
+  fNz        = (int) ((fZMax-fZMin)/fStep+0.5)+1;
+					// make the range a multiple of the step
+  fXMax      = fXMin+(fNx-1)*fStep;
+  fYMax      = fYMin+(fNy-1)*fStep;
+  fZMax      = fZMin+(fNz-1)*fStep;
+
+  fSourceHash = SourceHash();
+
+  if (LoadGrid() == 0)                                      return;
+
+  if (BuildGrid() == 0) {
+    if (LoadGrid() == 0) {
+      int nbad = Check();
+      if (nbad > 0) {
+	Warning("TMu2eBField","field grid %s: %i points outside tolerance %g T\n",
+		fCacheFile.data(),nbad,fTolerance);
+      }
+    }
+  }
+
+  if (fGrid == nullptr) {
+    Warning("TMu2eBField","no field grid, use full field manager everywhere\n");
+  }
+}
+
+//-----------------------------------------------------------------------------
+TMu2eBField::~TMu2eBField() {
+  UnloadGrid();
+  delete fBeamline;
+  delete fBfc;
+  delete fBfmm;
+  delete fBmgr;
+}
+
+//-----------------------------------------------------------------------------
+int TMu2eBField::InitConfig() const {
+
+  if (fBfc) return 0;
+
   bool _allowReplacement    (true);
   bool _messageOnReplacement(false);
   bool _messageOnDefault    (false);
 
-  std::string input_file = "Mu2eG4/test/geom_01.txt";
-
-  mu2e::SimpleConfig* _config = new mu2e::SimpleConfig(input_file,
+  mu2e::SimpleConfig* _config = new mu2e::SimpleConfig(fGeomFile,
 						       _allowReplacement,
 						       _messageOnReplacement,
 						       _messageOnDefault );
@@ -40,18 +151,201 @@ TMu2eBField::TMu2eBField(): TEveMagField() {
   fBfc      = bfc.get();
   bfc.release();
 
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+int TMu2eBField::InitManager() const {
+
+  if (fBmgr) return 0;
+
+  InitConfig();
+
   fBfmm     = new mu2e::BFieldManagerMaker(*fBfc);
   std::unique_ptr<mu2e::BFieldManager> bfm = fBfmm->getBFieldManager();
   fBmgr     = bfm.get();
   bfm.release();
+
+  return 0;
 }
 
 //-----------------------------------------------------------------------------
-TMu2eBField::~TMu2eBField() {
-  delete fBeamline;
-  delete fBfc;
-  delete fBfmm;
-  delete fBmgr;
+unsigned long long TMu2eBField::SourceHash() const {
+
+  InitConfig();
+
+  unsigned long long hash = 0xcbf29ce484222325ULL;
+
+  HashFile(hash,fGeomFile);
+  for (const std::string& fn : fBfc->innerMapFiles()) HashFile(hash,fn);
+  for (const std::string& fn : fBfc->outerMapFiles()) HashFile(hash,fn);
+
+  return hash;
+}
+
+//-----------------------------------------------------------------------------
+void TMu2eBField::GetFullField(double X, double Y, double Z, double* B) const {
+  InitManager();
+
+  CLHEP::Hep3Vector field = fBmgr->getBField(CLHEP::Hep3Vector(X*10,Y*10,Z*10));
+
+  B[0] = field.x();
+  B[1] = field.y();
+  B[2] = field.z();
+}
+
+//-----------------------------------------------------------------------------
+// sample the full manager in the grid nodes and write the cache file,
+// write to a temporary file first, so a concurrent reader never sees
+// a partially written grid
+//-----------------------------------------------------------------------------
+int TMu2eBField::BuildGrid() {
+
+  InitManager();
+
+  GridHeader_t h;
+  memset(&h,0,sizeof(h));
+  h.fMagic   = kGridMagic;
+  h.fVersion = kGridVersion;
+  h.fNx      = fNx;
+  h.fNy      = fNy;
+  h.fNz      = fNz;
+  h.fXMin    = fXMin;
+  h.fYMin    = fYMin;
+  h.fZMin    = fZMin;
+  h.fStep    = fStep;
+  strncpy(h.fGeomFile,fGeomFile.data(),sizeof(h.fGeomFile)-1);
+  h.fSourceHash = fSourceHash;
+
+  printf("TMu2eBField::BuildGrid: sampling field in %i x %i x %i nodes, step = %.2f cm\n",
+	 fNx,fNy,fNz,fStep);
+
+  std::vector<float> data(3*fNx*fNy*fNz);
+  double b[3];
+
+  for (int ix=0; ix<fNx; ix++) {
+    double x = fXMin+ix*fStep;
+    for (int iy=0; iy<fNy; iy++) {
+      double y = fYMin+iy*fStep;
+      for (int iz=0; iz<fNz; iz++) {
+	double z = fZMin+iz*fStep;
+	GetFullField(x,y,z,b);
+	int loc = 3*((ix*fNy+iy)*fNz+iz);
+	data[loc  ] = b[0];
+	data[loc+1] = b[1];
+	data[loc+2] = b[2];
+      }
+    }
+  }
+
+  std::string tmp_fn = fCacheFile+Form(".tmp.%i",getpid());
+
+  FILE* f = fopen(tmp_fn.data(),"w");
+  if (f == nullptr) {
+    Error("BuildGrid","can't open %s for writing\n",tmp_fn.data());
+    return -1;
+  }
+
+  int ok = (fwrite(&h,sizeof(h),1,f) == 1);
+  if (ok) ok = (fwrite(data.data(),sizeof(float),data.size(),f) == data.size());
+  ok = (fclose(f) == 0) && ok;
+
+  if ((! ok) || (rename(tmp_fn.data(),fCacheFile.data()) != 0)) {
+    Error("BuildGrid","failed to write %s\n",fCacheFile.data());
+    unlink(tmp_fn.data());
+    return -2;
+  }
+
+  printf("TMu2eBField::BuildGrid: field grid written to %s\n",fCacheFile.data());
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+// a cache file with different grid parameters or built from a different
+// geometry file or from field maps which changed since is not used
+//-----------------------------------------------------------------------------
+int TMu2eBField::LoadGrid() {
+
+  UnloadGrid();
+
+  int fd = open(fCacheFile.data(),O_RDONLY);
+  if (fd < 0)                                               return -1;
+
+  struct stat st;
+  size_t nbytes = sizeof(GridHeader_t)+3*sizeof(float)*fNx*fNy*fNz;
+
+  if ((fstat(fd,&st) != 0) || (size_t(st.st_size) != nbytes)) {
+    close(fd);
+    return -2;
+  }
+
+  void* map = mmap(nullptr,nbytes,PROT_READ,MAP_SHARED,fd,0);
+  close(fd);
+  if (map == MAP_FAILED)                                    return -3;
+
+  const GridHeader_t* h = (const GridHeader_t*) map;
+
+  if ((h->fMagic   != kGridMagic  ) || (h->fVersion != kGridVersion) ||
+      (h->fNx      != fNx         ) || (h->fNy      != fNy         ) ||
+      (h->fNz      != fNz         ) || (h->fStep    != fStep       ) ||
+      (h->fXMin    != fXMin       ) || (h->fYMin    != fYMin       ) ||
+      (h->fZMin    != fZMin       ) ||
+      (strncmp(h->fGeomFile,fGeomFile.data(),sizeof(h->fGeomFile)) != 0) ||
+      (h->fSourceHash != fSourceHash)) {
+    munmap(map,nbytes);
+    return -4;
+  }
+
+  fMap     = map;
+  fMapSize = nbytes;
+  fGrid    = (const float*) ((const char*) map+sizeof(GridHeader_t));
+
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+void TMu2eBField::UnloadGrid() {
+  if (fMap) munmap(fMap,fMapSize);
+  fMap     = nullptr;
+  fMapSize = 0;
+  fGrid    = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+int TMu2eBField::Check(int NPoints, double Tolerance) const {
+
+  if (fGrid == nullptr) {
+    Error("Check","field grid not loaded\n");
+    return -1;
+  }
+
+  double tol = (Tolerance < 0) ? fTolerance : Tolerance;
+
+  TRandom3 rn(1234);
+  double   b[3], dmax(0);
+  int      nbad(0);
+
+  for (int i=0; i<NPoints; i++) {
+    float x = fXMin+rn.Rndm()*(fXMax-fXMin);
+    float y = fYMin+rn.Rndm()*(fYMax-fYMin);
+    float z = fZMin+rn.Rndm()*(fZMax-fZMin);
+
+    TEveVector bg = GetField(x,y,z);
+    GetFullField(x,y,z,b);
+					// GetField returns inverted field
+    double dx = bg.fX+b[0];
+    double dy = bg.fY+b[1];
+    double dz = bg.fZ+b[2];
+    double d  = sqrt(dx*dx+dy*dy+dz*dz);
+
+    if (d > dmax) dmax = d;
+    if (d > tol ) nbad += 1;
+  }
+
+  printf("TMu2eBField::Check: N(points) = %i, max |dB| = %10.3e T, N(|dB| > %g T) = %i\n",
+	 NPoints,dmax,tol,nbad);
+
+  return nbad;
 }
 
 //-----------------------------------------------------------------------------
@@ -61,11 +355,56 @@ TMu2eBField::~TMu2eBField() {
 TEveVector TMu2eBField::GetField(float X, float Y, float Z) const {
 
   double bx(0), by(0), bz(0);
-  CLHEP::Hep3Vector field = fBmgr->getBField(CLHEP::Hep3Vector(X*10,Y*10,Z*10));
 
-  bx = field.x();
-  by = field.y();
-  bz = field.z();
+  if (fGrid && (X >= fXMin) && (X < fXMax) && (Y >= fYMin) && (Y < fYMax) &&
+      (Z >= fZMin) && (Z < fZMax)) {
+//-----------------------------------------------------------------------------
+// trilinear interpolation
+//-----------------------------------------------------------------------------
+    float fx = (X-fXMin)/fStep;
+    float fy = (Y-fYMin)/fStep;
+    float fz = (Z-fZMin)/fStep;
+
+    int   ix = std::min((int) fx,fNx-2);
+    int   iy = std::min((int) fy,fNy-2);
+    int   iz = std::min((int) fz,fNz-2);
+
+    float tx = fx-ix;
+    float ty = fy-iy;
+    float tz = fz-iz;
+
+    int   sz = 3;
+    int   sy = 3*fNz;
+    int   sx = 3*fNz*fNy;
+
+    const float* p = fGrid+ix*sx+iy*sy+iz*sz;
+
+    float b[3];
+    for (int k=0; k<3; k++) {
+      float b00 = p[k      ]*(1-tz)+p[k      +sz]*tz;
+      float b01 = p[k   +sy]*(1-tz)+p[k   +sy+sz]*tz;
+      float b10 = p[k+sx   ]*(1-tz)+p[k+sx   +sz]*tz;
+      float b11 = p[k+sx+sy]*(1-tz)+p[k+sx+sy+sz]*tz;
+
+      float b0  = b00*(1-ty)+b01*ty;
+      float b1  = b10*(1-ty)+b11*ty;
+
+      b[k]      = b0*(1-tx)+b1*tx;
+    }
+
+    bx = b[0];
+    by = b[1];
+    bz = b[2];
+  }
+  else {
+    double b[3];
+    GetFullField(X,Y,Z,b);
+
+    bx = b[0];
+    by = b[1];
+    bz = b[2];
+  }
+
   return TEveVector(-bx,-by,-bz);
 }
 }
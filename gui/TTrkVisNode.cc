@@ -444,9 +444,48 @@ int TTrkVisNode::InitEvent() {
     }
   }
 
+  BuildPickIndex();
+
   return 0;
 }
 
+//-----------------------------------------------------------------------------
+// hit positions for picking, in world coordinates, so the index doesn't 
+// depend on the view range
+//-----------------------------------------------------------------------------
+void TTrkVisNode::BuildPickIndex() {
+
+  fStrawHitIndexXY.Clear();
+  fComboHitIndexXY.Clear();
+  fComboHitIndexTZ.Clear();
+  fComboHitIndexPhiZ.Clear();
+
+  int nsh = fListOfStrawHits->GetEntriesFast();
+  for (int i=0; i<nsh; i++) {
+    stntuple::TEvdStrawHit* hit = GetEvdStrawHit(i);
+    fStrawHitIndexXY.Add(hit->Pos()->X(),hit->Pos()->Y());
+  }
+
+  int nch = fListOfComboHits->GetEntriesFast();
+  for (int i=0; i<nch; i++) {
+    stntuple::TEvdComboHit* hit = GetEvdComboHit(i);
+    fComboHitIndexXY.Add  (hit->Pos()->X(),hit->Pos()->Y());
+    fComboHitIndexTZ.Add  (hit->Z()       ,hit->correctedTime());
+    fComboHitIndexPhiZ.Add(hit->Z()       ,hit->Pos()->Phi());
+  }
+
+  fStrawHitIndexXY.Build();
+  fComboHitIndexXY.Build();
+  fComboHitIndexTZ.Build();
+  fComboHitIndexPhiZ.Build();
+}
+
+//-----------------------------------------------------------------------------
+void TTrkVisNode::GetPixelScale(Int_t px, Int_t py, double* ScaleX, double* ScaleY) {
+  *ScaleX = 1./(gPad->AbsPixeltoX(px+1)-gPad->AbsPixeltoX(px));
+  *ScaleY = 1./(gPad->AbsPixeltoY(py+1)-gPad->AbsPixeltoY(py));
+}
+
 //-----------------------------------------------------------------------------
 // check if a hit with 'Index' in the fShColl collection belongs to the time cluster
 // time cluster is made out of ComboHit's
@@ -519,6 +558,8 @@ void TTrkVisNode::PaintXY(Option_t* Option) {
     }
   }
   
+  fHitPainter.BeginPaint();
+
   if (vm->DisplayStrawHitsXY()) {
 //-----------------------------------------------------------------------------
 // display straw hits
@@ -555,7 +596,10 @@ void TTrkVisNode::PaintXY(Option_t* Option) {
 	    if (etcl and vm->DisplayOnlyTCHits()) { 
 	      ok = TCHit(etcl->TimeCluster(),sch->index());
 	    }
-	    if (ok  ) evd_sh->PaintXY(Option);
+	    if (ok  ) {
+	      fHitPainter.AddLine(evd_sh->LineW());
+	      fHitPainter.AddLine(evd_sh->LineR());
+	    }
 	  }
 	}
       }
@@ -598,12 +642,17 @@ void TTrkVisNode::PaintXY(Option_t* Option) {
             if (etcl and vm->DisplayOnlyTCHits()) { 
               ok = TCHit(etcl->TimeCluster(),ch->index(0));
             }
-            if (ok  ) evd_ch->PaintXY(Option);
+            if (ok  ) {
+	      fHitPainter.AddLine(evd_ch->LineW());
+	      fHitPainter.AddLine(evd_ch->LineR());
+	    }
           }
         }
       }
     }
   }
+					// paint hits before tracks
+  fHitPainter.EndPaint();
 //-----------------------------------------------------------------------------
 // now - tracks
 //-----------------------------------------------------------------------------
@@ -774,6 +823,8 @@ void TTrkVisNode::PaintTZ(Option_t* Option) {
     tmax = etcl->TMax(); // FIXME!
   }
 
+  fHitPainter.BeginPaint();
+
   int nhits = fListOfComboHits->GetEntries();
   if (nhits > 0) {
     // const mu2e::ComboHit* ch0 = &fChColl->at(0);
@@ -800,10 +851,12 @@ void TTrkVisNode::PaintTZ(Option_t* Option) {
         if (etcl and vm->DisplayOnlyTCHits()) { 
           ok = TCHit(etcl->TimeCluster(),ech->ComboHit()->index(0));
         }
-        if (ok) ech->PaintTZ(Option);
+        if (ok) fHitPainter.AddMarker(ech->TZMarker());
       }
     }
   }
+
+  fHitPainter.EndPaint();
 //-----------------------------------------------------------------------------
 // SimParticle's
 //-----------------------------------------------------------------------------
@@ -852,6 +905,8 @@ void TTrkVisNode::PaintPhiZ(Option_t* Option) {
     tmax = etcl->TMax(); // FIXME!
   }
 
+  fHitPainter.BeginPaint();
+
   int nhits = fListOfComboHits->GetEntries();
   if (nhits > 0) {
     // const mu2e::ComboHit* ch0 = &fChColl->at(0);
@@ -887,12 +942,14 @@ void TTrkVisNode::PaintPhiZ(Option_t* Option) {
             if (etcl and vm->DisplayOnlyTCHits()) { 
               ok = TCHit(etcl->TimeCluster(),ech->ComboHit()->index(0));
             }
-            if (ok) ech->PaintPhiZ(Option);
+            if (ok) fHitPainter.AddMarker(ech->PhiZMarker());
           }
         }
       }
     }
   }
+
+  fHitPainter.EndPaint();
 //-----------------------------------------------------------------------------
 // SimParticle's
 //-----------------------------------------------------------------------------
@@ -934,41 +991,26 @@ int TTrkVisNode::DistancetoPrimitiveXY(Int_t px, Int_t py) {
 
   TObject* closest(nullptr);
 
-  int  x1, y1, dx1, dy1, min_dist(9999), dist;
+  int  min_dist(9999), dist;
   TStnVisManager* vm = TStnVisManager::Instance();
 
+  double sx, sy, d;
+  GetPixelScale(px,py,&sx,&sy);
+//-----------------------------------------------------------------------------
+// hits: use the grid index, only the hits closer than min_dist are of interest
+//-----------------------------------------------------------------------------
   if (vm->DisplayStrawHitsXY() == 1) {
-    int nhits = fListOfStrawHits->GetEntries();
-    for (int i=0; i<nhits; i++) {
-      stntuple::TEvdStrawHit* hit = GetEvdStrawHit(i);
-
-      x1  = gPad->XtoAbsPixel(hit->Pos()->X());
-      y1  = gPad->YtoAbsPixel(hit->Pos()->Y());
-      dx1 = px-x1;
-      dy1 = py-y1;
-
-      dist  = (int) sqrt(dx1*dx1+dy1*dy1);
-      if (dist < min_dist) {
-	min_dist = dist;
-	closest  = hit;
-      }
+    int i = fStrawHitIndexXY.FindClosest(global.X(),global.Y(),sx,sy,min_dist,&d);
+    if (i >= 0) {
+      min_dist = (int) d;
+      closest  = GetEvdStrawHit(i);
     }
   }
   else {
-    int nhits = fListOfComboHits->GetEntries();
-    for (int i=0; i<nhits; i++) {
-      stntuple::TEvdComboHit* hit = GetEvdComboHit(i);
-
-      x1  = gPad->XtoAbsPixel(hit->Pos()->X());
-      y1  = gPad->YtoAbsPixel(hit->Pos()->Y());
-      dx1 = px-x1;
-      dy1 = py-y1;
-
-      dist  = (int) sqrt(dx1*dx1+dy1*dy1);
-      if (dist < min_dist) {
-	min_dist = dist;
-	closest  = hit;
-      }
+    int i = fComboHitIndexXY.FindClosest(global.X(),global.Y(),sx,sy,min_dist,&d);
+    if (i >= 0) {
+      min_dist = (int) d;
+      closest  = GetEvdComboHit(i);
     }
   }
 
@@ -1028,23 +1070,18 @@ Int_t TTrkVisNode::DistancetoPrimitiveTZ(Int_t px, Int_t py) {
 
   TObject* closest(nullptr);
 
-  int  x1, y1, dx1, dy1, min_dist(9999), dist;
+  int  min_dist(9999), dist;
 
   TStnVisManager* vm = TStnVisManager::Instance();
 
-  int nhits = fListOfComboHits->GetEntries();
-  for (int i=0; i<nhits; i++) {
-    stntuple::TEvdComboHit* hit = (stntuple::TEvdComboHit*) fListOfComboHits->At(i);
-    x1  = gPad->XtoAbsPixel(hit->Z());
-    y1  = gPad->YtoAbsPixel(hit->correctedTime());
-    dx1 = px-x1;
-    dy1 = py-y1;
-
-    dist  = (int) sqrt(dx1*dx1+dy1*dy1);
-    if (dist < min_dist) {
-      min_dist = dist;
-      closest  = hit;
-    }
+  double sx, sy, d;
+  GetPixelScale(px,py,&sx,&sy);
+
+  int ih = fComboHitIndexTZ.FindClosest(gPad->AbsPixeltoX(px),gPad->AbsPixeltoY(py),
+					sx,sy,min_dist,&d);
+  if (ih >= 0) {
+    min_dist = (int) d;
+    closest  = GetEvdComboHit(ih);
   }
 //-----------------------------------------------------------------------------
 // simparticles are represented by lines
@@ -1081,23 +1118,18 @@ Int_t TTrkVisNode::DistancetoPrimitivePhiZ(Int_t px, Int_t py) {
 
   TObject* closest(nullptr);
 
-  int  x1, y1, dx1, dy1, min_dist(9999), dist;
+  int  min_dist(9999), dist;
 
   TStnVisManager* vm = TStnVisManager::Instance();
 
-  int nhits = fListOfComboHits->GetEntries();
-  for (int i=0; i<nhits; i++) {
-    stntuple::TEvdComboHit* hit = (stntuple::TEvdComboHit*) fListOfComboHits->At(i);
-    x1  = gPad->XtoAbsPixel(hit->Z());
-    y1  = gPad->YtoAbsPixel(hit->Pos()->Phi());
-    dx1 = px-x1;
-    dy1 = py-y1;
-
-    dist  = (int) sqrt(dx1*dx1+dy1*dy1);
-    if (dist < min_dist) {
-      min_dist = dist;
-      closest  = hit;
-    }
+  double sx, sy, d;
+  GetPixelScale(px,py,&sx,&sy);
+
+  int ih = fComboHitIndexPhiZ.FindClosest(gPad->AbsPixeltoX(px),gPad->AbsPixeltoY(py),
+					  sx,sy,min_dist,&d);
+  if (ih >= 0) {
+    min_dist = (int) d;
+    closest  = GetEvdComboHit(ih);
   }
 //-----------------------------------------------------------------------------
 // simparticles are represented by lines
@@ -11,6 +11,7 @@
 
 #include "Stntuple/gui/TStnVisNode.hh"
 #include "Stntuple/gui/TEvdCluster.hh"
+#include "Stntuple/gui/TEvdGridIndex.hh"
 
 #ifndef __CINT__
 
@@ -56,6 +57,7 @@ protected:
   TObjArray*         fListOfEvdClusters;
   int                fNClusters;
   TObjArray*         fListOfEvdCrystals;
+  stntuple::TEvdGridIndex fCrystalGrid;  //! crystal centers, for picking
 
   Int_t              fDisplayHits;
   Int_t              fPickMode;
@@ -4,6 +4,8 @@
 #ifndef Stntuple_gui_TCrvVisNode_hh
 #define Stntuple_gui_TCrvVisNode_hh
 
+#include <unordered_map>
+
 #include "Gtypes.h"
 #include "TClonesArray.h"
 #include "TH1.h"	
@@ -12,6 +14,7 @@
 
 #include "Stntuple/gui/TStnVisNode.hh"
 #include "Stntuple/gui/TEvdCrvBar.hh"
+#include "Stntuple/gui/TEvdGridIndex.hh"
 
 #ifndef __CINT__
 
@@ -45,6 +48,10 @@ protected:
 
   int		fSectionID;
   TObjArray*	fListOfBars;
+					// bar geometry doesn't change: 
+					// bar index -> position in fListOfBars
+  std::unordered_map<int,int> fBarIndex;   //!
+  stntuple::TEvdGridIndex     fBarGridXY;  //! bar centers, for picking
 
   float		fMinPulsePEs;
   float		ftimeLow;
@@ -60,6 +67,8 @@ public:
   TCrvVisNode(const char* Name, /*const mu2e::CosmicRayShield* CRV,*/ int SectionID);
 
   virtual ~TCrvVisNode();
+
+  void          BuildBarIndex();
 //-----------------------------------------------------------------------------
 // Accessors
 //-----------------------------------------------------------------------------
@@ -108,6 +108,8 @@ public:
   float                  correctedTime() { return fHit->correctedTime(); }
   TLine*                 LineW()         { return &fLineW ; }
   TLine*                 LineR()         { return &fLineR ; }
+  TMarker*               TZMarker()      { return &fTZMarker  ; }
+  TMarker*               PhiZMarker()    { return &fPhiZMarker; }
 //-----------------------------------------------------------------------------
 // modifiers
 //-----------------------------------------------------------------------------
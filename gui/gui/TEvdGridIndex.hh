@@ -0,0 +1,53 @@
+///////////////////////////////////////////////////////////////////////////////
+// uniform 2D grid over a set of points in world coordinates, used by the vis
+// nodes to find the object closest to the cursor without looping over all
+// of them on every mouse move.
+//
+// points are added in the order of the objects in the node lists, the grid
+// returns that sequential number. The grid is rebuilt when the event changes,
+// the view range doesn't matter: the distance scale is passed to FindClosest
+///////////////////////////////////////////////////////////////////////////////
+#ifndef Stntuple_gui_TEvdGridIndex_hh
+#define Stntuple_gui_TEvdGridIndex_hh
+
+#include <vector>
+
+namespace stntuple {
+
+class TEvdGridIndex {
+protected:
+  int                  fNx;
+  int                  fNy;
+  double               fXMin;
+  double               fYMin;
+  double               fDx;		// cell size
+  double               fDy;
+
+  std::vector<double>  fX;		// point coordinates
+  std::vector<double>  fY;
+					// points of cell I (=ix*fNy+iy) are
+					// fItem[fCellOffset[I]..fCellOffset[I+1]-1]
+  std::vector<int>     fCellOffset;
+  std::vector<int>     fItem;
+
+public:
+  TEvdGridIndex();
+  ~TEvdGridIndex();
+
+  int    NItems() const { return fX.size(); }
+
+  void   Clear();
+  void   Add  (double X, double Y) { fX.push_back(X); fY.push_back(Y); }
+					// call after all points are added
+  void   Build(int NPerCell = 4);
+//-----------------------------------------------------------------------------
+// returns sequential number of the point closest to (X,Y), -1 if there is
+// no point within MaxDist. The distance is calculated as
+// sqrt((dx*ScaleX)^2+(dy*ScaleY)^2), ScaleX,Y: pixels per world unit
+//-----------------------------------------------------------------------------
+  int    FindClosest(double X, double Y, double ScaleX, double ScaleY,
+		     double MaxDist, double* Dist) const;
+};
+
+}
+#endif
@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////
+// batched painting of many small primitives (hits) in one pad
+//
+// between BeginPaint and EndPaint the vis node adds lines and markers of its
+// hits, the painter
+// - drops the primitives outside the current pad range
+// - groups the rest by attributes (color, style, width/size) and paints each
+//   group with one attribute setting
+// - if the number of primitives in the pad range exceeds fMaxDetailedHits,
+//   paints hit density (colored boxes) instead, zooming in brings the details
+//   back
+///////////////////////////////////////////////////////////////////////////////
+#ifndef Stntuple_gui_TEvdHitPainter_hh
+#define Stntuple_gui_TEvdHitPainter_hh
+
+#include <vector>
+
+#include "Gtypes.h"
+
+class TLine;
+class TMarker;
+
+namespace stntuple {
+
+class TEvdHitPainter {
+public:
+  struct LineBatch_t {
+    Color_t              fColor;
+    Style_t              fStyle;
+    Width_t              fWidth;
+    std::vector<double>  fX1;
+    std::vector<double>  fY1;
+    std::vector<double>  fX2;
+    std::vector<double>  fY2;
+  };
+
+  struct MarkerBatch_t {
+    Color_t              fColor;
+    Style_t              fStyle;
+    Size_t               fSize;
+    std::vector<double>  fX;
+    std::vector<double>  fY;
+  };
+
+protected:
+  std::vector<LineBatch_t>    fLines;
+  std::vector<MarkerBatch_t>  fMarkers;
+					// pad range, pad coordinates
+  double                      fXMin;
+  double                      fXMax;
+  double                      fYMin;
+  double                      fYMax;
+
+  int                         fNVisible;	// N(primitives) in the pad range
+  int                         fMaxDetailedHits;
+  int                         fNDensityBins;	// per axis
+
+public:
+  TEvdHitPainter(int MaxDetailedHits = 10000, int NDensityBins = 100);
+  ~TEvdHitPainter();
+
+  int    NVisible       () const { return fNVisible; }
+  int    MaxDetailedHits() const { return fMaxDetailedHits; }
+
+  void   SetMaxDetailedHits(int N) { fMaxDetailedHits = N; }
+  void   SetNDensityBins   (int N) { fNDensityBins    = N; }
+					// to be called from Paint, gPad defined
+  void   BeginPaint();
+  void   AddLine  (const TLine*   Line  );
+  void   AddMarker(const TMarker* Marker);
+  void   EndPaint ();
+
+protected:
+  LineBatch_t*   GetLineBatch  (Color_t Color, Style_t Style, Width_t Width);
+  MarkerBatch_t* GetMarkerBatch(Color_t Color, Style_t Style, Size_t  Size );
+
+  void           PaintDensity();
+};
+
+}
+#endif
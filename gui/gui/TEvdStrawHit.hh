@@ -78,6 +78,8 @@ public:
 // accessors
 //-----------------------------------------------------------------------------
   TVector3*                    Pos()         { return &fPos; }
+  TLine*                       LineW()       { return &fLineW; }
+  TLine*                       LineR()       { return &fLineR; }
   TVector2*                    Dir()         { return &fDir; }
   const mu2e::ComboHit*        StrawHit()    { return fHit;  }
   const mu2e::StrawDigiMC*     StrawDigiMC() { return fStrawDigiMC; }
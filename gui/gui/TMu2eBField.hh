@@ -1,9 +1,26 @@
 //-----------------------------------------------------------------------------
 // apparenty , the field is in Tesla, not in Gauss
+//
+// in the tracker/calorimeter region the field is taken from a regular grid
+// (trilinear interpolation), the grid is cached in a local binary file,
+// written on the first use and mmap'ed afterwards. The full BFieldManager
+// is built only when the cache has to be (re)created, or when the field is
+// requested outside the grid, or by Check
+//
+// grid parameters (.rootrc), coordinates in cm:
+//
+// mu2e.BField.CacheFile: .TMu2eBField.cache
+// mu2e.BField.Grid.XMin: -470    mu2e.BField.Grid.XMax: -310
+// mu2e.BField.Grid.YMin:  -80    mu2e.BField.Grid.YMax:   80
+// mu2e.BField.Grid.ZMin:  800    mu2e.BField.Grid.ZMax: 1400
+// mu2e.BField.Grid.Step:    2
+// mu2e.BField.Tolerance: 1.e-3   (T) , used by Check
 //-----------------------------------------------------------------------------
 #ifndef Stntuple_ana_TMu2eBField
 #define Stntuple_ana_TMu2eBField
 
+#include <string>
+
 #include "TObject.h"
 #include "TEveTrackPropagator.h"
 #include "TEveVector.h"
@@ -18,19 +35,86 @@ namespace mu2e {
 namespace stntuple {
 
 class TMu2eBField: public TEveMagField {
+public:
+					// cache file header, followed by
+					// fNx*fNy*fNz*3 floats
+  struct GridHeader_t {
+    int    fMagic;
+    int    fVersion;
+    int    fNx;
+    int    fNy;
+    int    fNz;
+    float  fXMin;
+    float  fYMin;
+    float  fZMin;
+    float  fStep;
+    char   fGeomFile[256];
+    unsigned long long fSourceHash;	// geometry file and field maps: 
+					// names, sizes, mtimes
+  };
+
 protected:
-  mu2e::Beamline*           fBeamline;
-  mu2e::BFieldConfig*       fBfc;
-  mu2e::BFieldManagerMaker* fBfmm;
-  mu2e::BFieldManager*      fBmgr;
-  
+  std::string               fGeomFile;
+					// built on request only
+  mutable mu2e::Beamline*           fBeamline;
+  mutable mu2e::BFieldConfig*       fBfc;
+  mutable mu2e::BFieldManagerMaker* fBfmm;
+  mutable mu2e::BFieldManager*      fBmgr;
+
+  std::string               fCacheFile;
+  unsigned long long        fSourceHash;
+  float                     fXMin;
+  float                     fXMax;
+  float                     fYMin;
+  float                     fYMax;
+  float                     fZMin;
+  float                     fZMax;
+  float                     fStep;
+  int                       fNx;
+  int                       fNy;
+  int                       fNz;
+  double                    fTolerance;	// T
+
+  void*                     fMap;	// mmap'ed cache file
+  size_t                    fMapSize;
+  const float*              fGrid;	// (bx,by,bz) of node (ix,iy,iz) at
+					// 3*((ix*fNy+iy)*fNz+iz)
 public:
   TMu2eBField();
   ~TMu2eBField();
-  
+
   virtual Float_t    GetMaxFieldMag() const { return 5. ; }
   virtual TEveVector GetField(float X, float Y, float Z) const ;
 
+  const char* CacheFile() const { return fCacheFile.data(); }
+  double      Tolerance() const { return fTolerance;        }
+  int         GridLoaded() const { return (fGrid != nullptr); }
+
+  void        SetTolerance(double Tol) { fTolerance = Tol; }
+//-----------------------------------------------------------------------------
+// field (T) from the full manager, coordinates in cm, no inversion
+//-----------------------------------------------------------------------------
+  void        GetFullField(double X, double Y, double Z, double* B) const;
+
+					// config and beamline only, the field
+					// maps are not read
+  int         InitConfig () const;
+  int         InitManager() const;
+//-----------------------------------------------------------------------------
+// hash of the names, sizes and modification times of the geometry file and 
+// of the field map files, a cache built from different sources is rebuilt
+//-----------------------------------------------------------------------------
+  unsigned long long SourceHash() const;
+  int         LoadGrid   ();
+  int         BuildGrid  ();
+  void        UnloadGrid ();
+//-----------------------------------------------------------------------------
+// compare interpolated field with the full manager in NPoints random points
+// in the grid volume, returns number of points with |dB| > Tolerance,
+// Tolerance < 0: use fTolerance
+//-----------------------------------------------------------------------------
+  int         Check(int NPoints = 1000, double Tolerance = -1.) const;
+
   ClassDef(TMu2eBField, 0);
 };
 }
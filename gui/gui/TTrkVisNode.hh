@@ -18,6 +18,8 @@
 #include "Offline/MCDataProducts/inc/StepPointMC.hh"
 
 #include "Stntuple/gui/TStnVisNode.hh"
+#include "Stntuple/gui/TEvdGridIndex.hh"
+#include "Stntuple/gui/TEvdHitPainter.hh"
 
 class TStnTrackBlock;
 class TSimpBlock;
@@ -87,6 +89,15 @@ protected:
   TObjArray*                fListOfStrawHits;
   TObjArray*                fListOfTracks;
   TObjArray*                fListOfSimParticles;
+					// picking: hit positions in different
+					// views, rebuilt in InitEvent
+  stntuple::TEvdGridIndex   fStrawHitIndexXY;   //!
+  stntuple::TEvdGridIndex   fComboHitIndexXY;   //!
+  stntuple::TEvdGridIndex   fComboHitIndexTZ;   //!
+  stntuple::TEvdGridIndex   fComboHitIndexPhiZ; //!
+					// batched hit painting, with culling and
+					// density mode for crowded views
+  stntuple::TEvdHitPainter  fHitPainter;        //!
 
   TSimpBlock*               fSimpBlock;
 public:
@@ -164,9 +175,15 @@ public:
   }
 
   void  SetPickMode   (Int_t Mode) { fPickMode    = Mode; }
+					// above N visible hits paint hit density
+  void  SetMaxDetailedHits(int N) { fHitPainter.SetMaxDetailedHits(N); }
 
 					// Index - in fShColl
   int   TCHit(const mu2e::TimeCluster* TimeCluster, int Index);
+
+  void  BuildPickIndex();
+					// pixels per world unit in the current pad
+  static void GetPixelScale(Int_t px, Int_t py, double* ScaleX, double* ScaleY);
 //-----------------------------------------------------------------------------
 // overloaded methods of TVisNode
 //-----------------------------------------------------------------------------
@@ -9,19 +9,39 @@
 // fExecCommands =  1 : execute move command
 //               = 10 : execute cataloging command
 //               = 11 : execute both commands
+//
+// if the file has a summary record (TStnFileSummary, written by FillStntuple),
+// the catalog information is taken from it and the events are not looked at.
+// Run as a module, TStnAna still reads the header of each event - the module
+// doesn't stop the loop, which may have other modules in it. CatalogFile and
+// CatalogFiles are the path without the event loop, they read the summary
+// only (or the header branch, for the files without a summary):
+//
+//   TDFCModule m;
+//   m.SetDataSet("cnvs0b0s5r0000","mu2e","");
+//   std::vector<TString> files = { ... };
+//   m.CatalogFiles(files);
 ///////////////////////////////////////////////////////////////////////////////
 #include "iostream"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
+#include "TROOT.h"
 #include "TSystem.h"
 #include "TF1.h"
 #include "TCanvas.h"
 #include "TPad.h"
 #include "TText.h"
 #include "TChain.h"
+#include "TFile.h"
+#include "TTree.h"
+#include "TBranch.h"
 
 #include "Stntuple/loop/TStnAna.hh"
 #include "Stntuple/loop/TStnInputModule.hh"
 #include "Stntuple/obj/TStnHeaderBlock.hh"
+#include "Stntuple/obj/TStnFileSummary.hh"
 
 #include "Stntuple/loop/TDFCModule.hh"
 
@@ -45,7 +65,9 @@ TDFCModule::TDFCModule(const char* name, const char* title):
   fMaxRunNumber     = -1;
   fMaxEventNumber   = -1;
   fFile             = 0;
+  fFullName         = "";
   fFileSize         = 0.;
+  fFileBytes        = 0;
   fFileDate         = TString("");
   fNewFile          = 0;
   fNEvents          = 0;
@@ -56,6 +78,7 @@ TDFCModule::TDFCModule(const char* name, const char* title):
   fOutputDir        = 0;
   fCurrentRunRecord = 0;
   fRunRecord.clear();
+  fSource           = kEventLoop;
 }
 
 //_____________________________________________________________________________
@@ -78,15 +101,25 @@ int TDFCModule::BeginJob()
   fFile         = chain->GetFile();
   fNEvents      = 0;
 
-  char cmd[200],fn[200]="";
-  sprintf(cmd,"echo %s |  awk -F / ' {print $NF}'",fFile->GetName());
-  FILE* f = gSystem->OpenPipe(cmd,"r");
-  fscanf(f,"%s",fn);
-  fclose(f);
-
-  fFileName = fn;
-  fFileSize = fFile->GetSize()/1000000.;
-  fFileDate = TString(fFile->GetModificationDate().AsSQLString());
+  fFullName  = fFile->GetName();
+  fFileName  = gSystem->BaseName(fFile->GetName());
+  fFileBytes = fFile->GetSize();
+  fFileSize  = fFileBytes/1000000.;
+  fFileDate  = TString(fFile->GetModificationDate().AsSQLString());
+//-----------------------------------------------------------------------------
+// file has a summary: the events don't need to be looked at, Event() 
+// returns right away. The event loop itself goes on (TStnAna reads the 
+// headers), use CatalogFile(s) to avoid it
+//-----------------------------------------------------------------------------
+  TStnFileSummary* summary = TStnFileSummary::Read(fFile);
+  if (summary) {
+    FillFromSummary(summary);
+    delete summary;
+    fSource = kSummary;
+  }
+  else {
+    fSource = kEventLoop;
+  }
 
   return 0;
 }
@@ -94,56 +127,64 @@ int TDFCModule::BeginJob()
 
 //_____________________________________________________________________________
 int TDFCModule::BeginRun() {
-//---------------------------------------------------------------------------
+  if (fSource == kSummary) return 0;
+
+  fCurrentRunRecord = GetRunRecord(GetHeaderBlock()->RunNumber());
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
 // Figure out whether we know this run, otherwise install a new record
-// Try to find this run in our filing system
-//---------------------------------------------------------------------------
-  int  iRun  = GetHeaderBlock()->RunNumber();
-  bool found = false;
+//-----------------------------------------------------------------------------
+TDFCModule::RunRecord_t* TDFCModule::GetRunRecord(int Run) {
   int nr = fRunRecord.size();
   for (int i=0; i<nr; i++) {
-    if (fRunRecord[i]->fNumber == iRun) {
-      // Okay this is our run
-      fCurrentRunRecord = fRunRecord[i];
-      found = true;
-    }
+    if (fRunRecord[i]->fNumber == Run) return fRunRecord[i];
   }
-  // This run was not yet found.... create new record
-  if (! found) {
+					// new run
+  RunRecord_t* r = new RunRecord_t;
+  r->fNumber         = Run;
+  r->fNEvents        =  0;
+  r->fLoEvent        = -1;
+  r->fHiEvent        = -1;
+  r->fListOfRunSections.clear();
 
-    fCurrentRunRecord = new RunRecord_t;
-    fCurrentRunRecord->fNumber         = -1;
-    fCurrentRunRecord->fNEvents        =  0;
-    fCurrentRunRecord->fLoEvent        = -1;
-    fCurrentRunRecord->fHiEvent        = -1;
-    fCurrentRunRecord->fListOfRunSections.clear();
+  fRunRecord.push_back(r);
 
-    fRunRecord.push_back(fCurrentRunRecord);
-  }
-
-  return 0;
+  return r;
 }
 
 //_____________________________________________________________________________
 int TDFCModule::Event(int ientry)
 {
+  if (fSource == kSummary) return 0;
+
   TStnHeaderBlock* header = GetHeaderBlock();
 
-  int rn = header->RunNumber    ();
-  int ev = header->EventNumber  ();
-  int rs = header->SectionNumber();
+  AddEvent(header->RunNumber(),header->SectionNumber(),header->EventNumber());
+
+  return 0;
+}
+
+//_____________________________________________________________________________
+void TDFCModule::AddEvent(int rn, int rs, int ev) {
+
+  RunRecord_t* r = fCurrentRunRecord;
+  if ((r == 0) || (r->fNumber != rn)) {
+    r = GetRunRecord(rn);
+    fCurrentRunRecord = r;
+  }
 
-  if (fCurrentRunRecord->fNumber < 0) {
-    fCurrentRunRecord->fNumber  = rn;
-    fCurrentRunRecord->fLoEvent = ev;
-    fCurrentRunRecord->fHiEvent = ev;
+  if (r->fNEvents == 0) {
+    r->fLoEvent = ev;
+    r->fHiEvent = ev;
   }
-  else if (ev > fCurrentRunRecord->fHiEvent)
-    fCurrentRunRecord->fHiEvent = ev;
-  else if (ev < fCurrentRunRecord->fLoEvent)
-    fCurrentRunRecord->fLoEvent = ev;
+  else if (ev > r->fHiEvent)
+    r->fHiEvent = ev;
+  else if (ev < r->fLoEvent)
+    r->fLoEvent = ev;
 
-  fCurrentRunRecord->fNEvents++;
+  r->fNEvents++;
   
   if (rn < fMinRunNumber) {
     fMinRunNumber     = rn;
@@ -152,7 +193,6 @@ int TDFCModule::Event(int ientry)
   }
 
   if (rn == fMinRunNumber) {
-    rs = header->SectionNumber();
     if (rs < fMinSectionNumber)
       fMinSectionNumber = rs;
     if (ev < fMinEventNumber  )
@@ -167,48 +207,264 @@ int TDFCModule::Event(int ientry)
     if (ev > fMaxEventNumber)
       fMaxEventNumber = ev;
   }
+					// run sections
+  r->fListOfRunSections.insert(rs);
+  
+  fNEvents++;
+}
+
 //-----------------------------------------------------------------------------
-//  run sections
+// same information as the event loop would collect, run by run
 //-----------------------------------------------------------------------------
-  int ns = fCurrentRunRecord->fListOfRunSections.size();
+int TDFCModule::FillFromSummary(const TStnFileSummary* Summary) {
+
+  int nr = Summary->NRuns();
+
+  for (int i=0; i<nr; i++) {
+    int rn = Summary->RunNumber(i);
+    int lo = Summary->LoEvent  (i);
+    int hi = Summary->HiEvent  (i);
+
+    RunRecord_t* r = GetRunRecord(rn);
+
+    if ((r->fNEvents == 0) || (lo < r->fLoEvent)) r->fLoEvent = lo;
+    if ((r->fNEvents == 0) || (hi > r->fHiEvent)) r->fHiEvent = hi;
+    r->fNEvents += Summary->RunNEvents(i);
+
+    int nranges = Summary->NRanges(i);
+    for (int j=0; j<nranges; j++) {
+      int hs = Summary->HiSection(i,j);
+      for (int rs=Summary->LoSection(i,j); rs<=hs; rs++) {
+	r->fListOfRunSections.insert(rs);
+      }
+    }
+
+    if (rn < fMinRunNumber) {
+      fMinRunNumber     = rn;
+      fMinSectionNumber = (nranges > 0) ? Summary->LoSection(i,0) : 1000000;
+      fMinEventNumber   = lo;
+    }
 
-  int found = 0;
-  for (int i=0; i<ns; i++) {
-    int rss = fCurrentRunRecord->fListOfRunSections[i];
-    if (rs == rss) {
-      found = 1;
-      break;
+    if (rn > fMaxRunNumber) {
+      fMaxRunNumber   = rn;
+      fMaxEventNumber = hi;
     }
   }
 
-  if (found == 0) {
-    fCurrentRunRecord->fListOfRunSections.push_back(rs);
+  fNEvents += Summary->NEvents();
+
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+// legacy files: read the header block branch only
+//-----------------------------------------------------------------------------
+int TDFCModule::ScanHeaders(TFile* File) {
+
+  TTree* tree = (TTree*) File->Get("STNTUPLE");
+  if (tree == 0)                                             return -1;
+
+  TBranch* branch = tree->GetBranch("HeaderBlock");
+  if (branch == 0)                                           return -2;
+
+  tree->SetCacheSize(10000000);
+  tree->AddBranchToCache(branch);
+
+  TStnHeaderBlock* header = new TStnHeaderBlock();
+  branch->SetAddress(&header);
+
+  int nev = tree->GetEntries();
+  for (int i=0; i<nev; i++) {
+    if (branch->GetEntry(i) <= 0) {
+      branch->ResetAddress();
+      delete header;
+      return -3;
+    }
+    AddEvent(header->RunNumber(),header->SectionNumber(),header->EventNumber());
   }
-  
-  fNEvents++;
+
+  branch->ResetAddress();
+  delete header;
 
   return 0;
 }
 
+//_____________________________________________________________________________
+int TDFCModule::CatalogFile(const char* Filename) {
+
+  TDirectory::TContext ctx;
+
+  TFile* f = TFile::Open(Filename);
+  if ((f == 0) || f->IsZombie()) {
+    delete f;
+    printf(" >>> ERROR TDFCModule::CatalogFile: can't open %s\n",Filename);
+    fReturnCode = -1;
+    return -1;
+  }
+
+  fFullName  = Filename;
+  fFileName  = gSystem->BaseName(Filename);
+  fFileBytes = f->GetSize();
+  fFileSize  = fFileBytes/1000000.;
+  fFileDate  = TString(f->GetModificationDate().AsSQLString());
+
+  int rc = 0;
+
+  TStnFileSummary* summary = TStnFileSummary::Read(f);
+  if (summary) {
+    rc      = FillFromSummary(summary);
+    fSource = kSummary;
+    delete summary;
+  }
+  else {
+    rc      = ScanHeaders(f);
+    fSource = kHeaderScan;
+  }
+
+  f->Close();
+  delete f;
+
+  if (rc < 0) {
+    printf(" >>> ERROR TDFCModule::CatalogFile: can't read %s, rc = %i\n",Filename,rc);
+    fReturnCode = rc;
+  }
+
+  return rc;
+}
 
 //_____________________________________________________________________________
-int TDFCModule::EndJob() {
+void TDFCModule::CopySettings(const TDFCModule* Module) {
+  fDatasetID    = Module->fDatasetID;
+  fBook         = Module->fBook;
+  fDbID         = Module->fDbID;
+  fPrintOpt     = Module->fPrintOpt;
+  fNFileset     = Module->fNFileset;
+  fExecCommands = Module->fExecCommands;
+  fPrintLevel   = Module->fPrintLevel;
 
-  char  filename[200];
-  char  id[200];
+  delete fOutputDir;
+  fOutputDir    = (Module->fOutputDir) ? new TUrl(*Module->fOutputDir) : 0;
+}
 
 //-----------------------------------------------------------------------------
-// form new filename (Mu2e naming conventions
+// per-file state, the settings are kept
 //-----------------------------------------------------------------------------
-  strncpy(id,fDatasetID.Data(),50);
+void TDFCModule::ResetFile() {
+  int nr = fRunRecord.size();
+  for (int i=0; i<nr; i++) {
+    delete fRunRecord[i];
+  }
+  fRunRecord.clear();
+  fCurrentRunRecord = 0;
 
-  //  sprintf(filename,"%s.%06i_%08i",fDatasetID.Data(),fMinRunNumber,fMinSectionNumber);
+  fMinRunNumber     = 1000000;
+  fMinSectionNumber = 1000000;
+  fMinEventNumber   = 100000000;
+  fMaxRunNumber     = -1;
+  fMaxEventNumber   = -1;
+  fNEvents          = 0;
+  fReturnCode       = 0;
+  fSource           = kEventLoop;
+  fFullName         = "";
+  fFileName         = "";
+  fFileDate         = "";
+  fFileSize         = 0.;
+  fFileBytes        = 0;
+  fNewFileName      = "";
+}
 
-  TString user = gSystem->Getenv("USER");
-  if (user == "mu2epro") user = "mu2e";
+//-----------------------------------------------------------------------------
+// worker thread: one module per worker, reused for all files the worker
+// takes. The output of file I goes out after that of file I-1, so a worker
+// which is ahead waits for its turn before taking the next file
+//-----------------------------------------------------------------------------
+void TDFCModule::CatalogFilesWorker(const std::vector<TString>* Files, CatalogStat_t* Stat) {
+  int nfiles = Files->size();
 
-  sprintf(filename,"nts.%s.%s.%s.%06i_%08i.stn",user.Data(),fDatasetID.Data(),fBook.Data(),fMinRunNumber,fMinSectionNumber);
-  fNewFileName = TString(filename);
+  TDFCModule* m = new TDFCModule(GetName(),GetTitle());
+  m->CopySettings(this);
+
+  while (1) {
+    int i = Stat->fNext++;
+    if (i >= nfiles) break;
+
+    m->ResetFile();
+    m->CatalogFile((*Files)[i].Data());
+
+    std::unique_lock<std::mutex> lock(Stat->fMutex);
+    Stat->fCondition.wait(lock,[Stat,i]{ return Stat->fNextOutput == i; });
+
+    if (m->fReturnCode == 0) {
+      if (m->fSource == kSummary) Stat->fNSummary++;
+
+      m->MakeNewFileName();
+
+      if (m->PrintLevel() > 0) {
+	TString opt = "data";
+	if (i == 0       ) opt += ",banner";
+	if (i == nfiles-1) opt += ",foot";
+	m->PrintCatalog(opt.Data());
+      }
+
+      if (m->fExecCommands) m->ExecCommands();
+    }
+
+    if (m->fReturnCode != 0) Stat->fNBad++;
+
+    Stat->fNextOutput++;
+    lock.unlock();
+    Stat->fCondition.notify_all();
+  }
+
+  delete m;
+}
+
+//-----------------------------------------------------------------------------
+// the files are read in parallel, the printout and the commands - serially,
+// in the order of Files, as soon as the file and all files before it are done
+//-----------------------------------------------------------------------------
+int TDFCModule::CatalogFiles(const std::vector<TString>& Files, int NThreads) {
+
+  int nfiles = Files.size();
+  if (nfiles == 0)                                           return 0;
+
+  int nthreads = NThreads;
+  if (nthreads <= 0) nthreads = std::thread::hardware_concurrency();
+  if (nthreads > nfiles) nthreads = nfiles;
+
+  CatalogStat_t stat;
+  stat.fNext       = 0;
+  stat.fNextOutput = 0;
+  stat.fNBad       = 0;
+  stat.fNSummary   = 0;
+
+  if (nthreads <= 1) {
+    nthreads = 1;
+    CatalogFilesWorker(&Files,&stat);
+  }
+  else {
+    ROOT::EnableThreadSafety();
+
+    std::vector<std::thread> pool;
+    for (int i=0; i<nthreads; i++) {
+      pool.push_back(std::thread(&TDFCModule::CatalogFilesWorker,this,&Files,&stat));
+    }
+    for (std::thread& t : pool) t.join();
+  }
+
+  if (PrintLevel() > 10) {
+    printf(" >>> TDFCModule::CatalogFiles: %i files, %i from summaries, %i failed, %i threads\n",
+	   nfiles,stat.fNSummary,stat.fNBad,nthreads);
+  }
+
+  return stat.fNBad;
+}
+
+
+//_____________________________________________________________________________
+int TDFCModule::EndJob() {
+
+  MakeNewFileName();
 
   //if (PrintLevel() > 0) 
   //  printf(" TDFCModule::EndJob - Number of events processed: %d\n",fNEvents);
@@ -233,6 +489,22 @@ int TDFCModule::EndJob() {
   return fReturnCode;
 }
 
+//-----------------------------------------------------------------------------
+// form new filename (Mu2e naming conventions)
+//-----------------------------------------------------------------------------
+void TDFCModule::MakeNewFileName() {
+
+  char  filename[200];
+
+  //  sprintf(filename,"%s.%06i_%08i",fDatasetID.Data(),fMinRunNumber,fMinSectionNumber);
+
+  TString user = gSystem->Getenv("USER");
+  if (user == "mu2epro") user = "mu2e";
+
+  sprintf(filename,"nts.%s.%s.%s.%06i_%08i.stn",user.Data(),fDatasetID.Data(),fBook.Data(),fMinRunNumber,fMinSectionNumber);
+  fNewFileName = TString(filename);
+}
+
 //_____________________________________________________________________________
 int TDFCModule::GetNewFileName(TString& Name) {
   Name = fNewFileName;
@@ -258,7 +530,7 @@ int TDFCModule::GetMvCommand(TString& Command) {
   else if (strcmp(fOutputDir->GetHost(),"") == 0) {
 					// local directory
     Command  = Form("mv %s  %s/%s ",
-		    fFile->GetName(),
+		    fFullName.Data(),
 		    fOutputDir->GetFile(),
 		    fNewFileName.Data());
   }
@@ -273,7 +545,7 @@ int TDFCModule::GetMvCommand(TString& Command) {
     fscanf(pipe,"%s",local_host);
     gSystem->ClosePipe(pipe);
     
-    TUrl file(fFile->GetName());
+    TUrl file(fFullName.Data());
 
     if ((strcmp(file.GetHost(),"") == 0) || 
 	 strcmp(local_host,file.GetHost()) == 0) {
@@ -287,7 +559,7 @@ int TDFCModule::GetMvCommand(TString& Command) {
 	remote_copy = "scp";
 
       Command = Form("mv %s %s ; %s %s %s@%s:%s ; if [ $? == 0 ] ; then rm %s ; fi",
-		      fFile->GetName(), 
+		      fFullName.Data(), 
 		      fNewFileName.Data(),
                       remote_copy.Data(),
 		      fNewFileName.Data(),
@@ -304,7 +576,7 @@ int TDFCModule::GetMvCommand(TString& Command) {
       Command += Form("%s\n",fOutputDir->GetUser());
       Command += Form("cd %s\n",fOutputDir->GetFile());
       Command += Form("rename %s %s\n",
-		      gSystem->BaseName(fFile->GetName()),fNewFileName.Data());
+		      fFileName.Data(),fNewFileName.Data());
     }
 
   }
@@ -319,7 +591,7 @@ void TDFCModule::PrintFilename()
   printf("new filename: %s \n",fNewFileName.Data());
   printf("run_min, event_min : %8i %8i \n",fMinRunNumber,fMinEventNumber);
   printf("run_max, event_max : %8i %8i \n",fMaxRunNumber,fMaxEventNumber);
-  float fsize = fFile->GetSize()/1000000.;
+  float fsize = fFileBytes/1000000.;
   printf("file size          : %10.5f  \n",fsize);
 
   TString move, dfc;
@@ -332,11 +604,7 @@ void TDFCModule::PrintFilename()
 int TDFCModule::GetDfcCommand(TString& Cmd) {
 
   // DatasetID is 6 characters long
-  float fsize = 0;
-  if (fNewFile)
-    fsize = fNewFile->GetSize()/1000000.;
-  else 
-    fsize = fFile   ->GetSize()/1000000.;
+  float fsize = fFileBytes/1000000.;
 
   Cmd  = Form("DFCFileTool -create -db %s -book %s ",
 	      fDbID.Data(),fBook.Data());
@@ -365,13 +633,31 @@ void TDFCModule::ExecCommands() {
     //    i2  = (fExecCommands/10) % 10 ;
     
     if (i1 == 1) {
-      GetMvCommand(move);
-      printf(" **** executing move command: %s\n",move.Data());
-      fReturnCode = gSystem->Exec(move.Data());
-      if (fReturnCode == 0)
-	fNewFile = new TFile(TString(TString(fOutputDir->GetFile())+
-				     TString("/")+
-				     fNewFileName.Data()));
+//-----------------------------------------------------------------------------
+// local move: rename the file directly, use the shell only if that fails
+// (destination on a different file system) or the destination is remote
+//-----------------------------------------------------------------------------
+      TString src, dst;
+      if (fOutputDir == NULL) {
+	src = fFileName;
+	dst = fNewFileName;
+      }
+      else if (strcmp(fOutputDir->GetHost(),"") == 0) {
+	src = fFullName;
+	dst = Form("%s/%s",fOutputDir->GetFile(),fNewFileName.Data());
+      }
+
+      fReturnCode = -1;
+      if (src != "") {
+	printf(" **** renaming %s to %s\n",src.Data(),dst.Data());
+	fReturnCode = gSystem->Rename(src.Data(),dst.Data());
+      }
+
+      if (fReturnCode != 0) {
+	GetMvCommand(move);
+	printf(" **** executing move command: %s\n",move.Data());
+	fReturnCode = gSystem->Exec(move.Data());
+      }
     }
 
 //     if ((fReturnCode == 0) && (i2 == 1)) {
@@ -392,8 +678,6 @@ void TDFCModule::SetDataSet(const char* id, const char* book, const char* db) {
 //_____________________________________________________________________________
 void TDFCModule::PrintCatalog(const char* Opt) {
   // filename size date nevents low_run low_event high_run high_event
-  char  cmd[1000], fn[1000];
-
   if ((strcmp(Opt,"") == 0) || (strstr(Opt,"banner") != nullptr)) {
     printf("----------------------------------------------------------------");
     printf("------------------------------------------------------------\n");
@@ -405,10 +689,7 @@ void TDFCModule::PrintCatalog(const char* Opt) {
 
   if ((strcmp(Opt,"") == 0) || (strstr(Opt,"data") != nullptr)) {
 
-    sprintf(cmd,"echo %s | awk -F / '{print $NF}'",fFileName.Data());
-    FILE* f = gSystem->OpenPipe(cmd,"r");
-    fscanf(f,"%s",fn);
-    fclose(f);
+    const char* fn = gSystem->BaseName(fFileName.Data());
 
     //if (fFile)
       printf("%s.%04d %-20s %10.3f %20s %6i %7i %9i %7i %9i\n",
@@ -465,7 +746,7 @@ void TDFCModule::PrintCatalog(const char* Opt) {
 //-----------------------------------------------------------------------------
     printf("<getfileinfo>\n");
     printf("name           : %-s\n",fFileName.Data());
-    printf("size           : %lld \n",fFile->GetSize());
+    printf("size           : %lld \n",fFileBytes);
     printf("First run/event: %6i / %7i \n", fMinRunNumber,fMinEventNumber);
     printf("Last  run/event: %6i / %7i \n", fMaxRunNumber,fMaxEventNumber);
     printf("events         : %6i \n",fNEvents);
@@ -474,49 +755,29 @@ void TDFCModule::PrintCatalog(const char* Opt) {
     for (int i=0; i<nr; i++) {
       RunRecord_t *r = fRunRecord[i];
       //      printf("run number: %i\n",r->fNumber);
-      int ns = r->fListOfRunSections.size();
 //-----------------------------------------------------------------------------
-// order the runsections
+// run sections are ordered, make ranges
 //-----------------------------------------------------------------------------
-      int* a    = new int[ns];
-      int* rr   = new int[2*ns];
+      std::vector<int> rr;
 
-      for (int i=0; i<ns; i++) {
-	a[i] = r->fListOfRunSections[i];
-	for (int j=i+1; j<ns; j++) {
-	  int aj = r->fListOfRunSections[j];
-	  if (aj < a[i]) {
-	    r->fListOfRunSections[j] = a[i];
-	    a[i]   = aj;
-	  }
-	}
-	//	printf("sec number: %i\n",a[i]);
-      }
-//-----------------------------------------------------------------------------
-// run sections ordered, make ranges
-//-----------------------------------------------------------------------------
-      int nr    = 0;
-      
-      for (int i=0; i<ns; i++) {
-	if ((nr > 0) && (a[i] - rr[2*nr-1] == 1)) {
+      for (int rs : r->fListOfRunSections) {
+	if ((rr.size() > 0) && (rs - rr.back() == 1)) {
 				// extend the existing range
-	  rr[2*nr-1] = a[i];
+	  rr.back() = rs;
 	}
 	else {
 				// new range
-	  nr        += 1;
-	  rr[2*nr-2] = a[i];
-	  rr[2*nr-1] = a[i];
+	  rr.push_back(rs);
+	  rr.push_back(rs);
 	}
       }
+      int nr = rr.size()/2;
 //-----------------------------------------------------------------------------
 //  print run section ranges
 //-----------------------------------------------------------------------------
       for (int i=0; i<nr; i++) {
 	printf("%6i/%i:%i ",r->fNumber,rr[2*i],rr[2*i+1]);
       }
-      delete [] a;
-      delete [] rr;
     }
     printf("\n");
     printf("</getfileinfo>\n");
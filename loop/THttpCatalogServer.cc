@@ -442,11 +442,15 @@ int THttpCatalogServer::InitDataset(TStnDataset*     Dataset,
     cmd = Form("ls -al %s | grep %s | awk '{print $9}'",dir,pattern);
     pipe = gSystem->OpenPipe(cmd,"r");
 
+    std::vector<TString> names;
     while (fgets(buf,10000,pipe)) { 
       sscanf(buf,"%s",fn);
       sprintf(fs,"%s/%s",dir,fn);
-      Dataset->AddFile(fs);
+      names.push_back(fs);
     }
+    gSystem->ClosePipe(pipe);
+					// files are probed in parallel
+    Dataset->AddFiles(names);
     return 0;
   }
   else if (strcmp(book,"list") == 0) {
@@ -457,11 +461,15 @@ int THttpCatalogServer::InitDataset(TStnDataset*     Dataset,
     cmd = Form("cat %s | awk '{if (substr($0,1,1) != \"#\") print $1}'",File);
     pipe = gSystem->OpenPipe(cmd,"r");
 
+    std::vector<TString> names;
     while (fgets(buf,10000,pipe)) { 
       sscanf(buf,"%s",fn);
       printf("fn = %s\n",fn);
-      Dataset->AddFile(fn);
+      names.push_back(fn);
     }
+    gSystem->ClosePipe(pipe);
+
+    Dataset->AddFiles(names);
     return 0;
   }
 //-----------------------------------------------------------------------------
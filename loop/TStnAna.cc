@@ -25,6 +25,9 @@
 #include "TFolder.h"
 #include "TH1.h"
 #include "TEventList.h"
+#include "TChainElement.h"
+#include "TTreeFormula.h"
+#include "TFile.h"
 
 #include "Stntuple/base/TStnDataset.hh"
 
@@ -35,6 +38,9 @@
 #include "Stntuple/obj/TStnDBManager.hh"
 #include "Stntuple/obj/TStnRunSummary.hh"
 #include "Stntuple/obj/TStnGoodRunList.hh"
+#include "Stntuple/obj/TStnTriggerBlock.hh"
+#include "Stntuple/obj/TStnTriggerTable.hh"
+#include "Stntuple/base/TBitset.hh"
 
 #include "Stntuple/loop/TStnAna.hh"
 #include "Stntuple/loop/TStnModule.hh"
@@ -43,6 +49,8 @@
 // #include "Stntuple/loop/TStnSamInputModule.hh"
 // #endif
 #include "Stntuple/loop/TStnOutputModule.hh"
+#include "Stntuple/loop/TStnProfiler.hh"
+#include "Stntuple/loop/TStnEventCache.hh"
 
 ClassImp(TStnAna)
 //_____________________________________________________________________________
@@ -170,6 +178,22 @@ int TStnAna::Init() {
   fMcFlag         = 0;
 
   fEventList      = 0;
+  fProfiler       = 0;
+  fProfileTree    = 0;
+  fEventCache     = 0;
+  fCachedPass     = 0;
+
+  fTriggerPattern   = "";
+  fTriggerBlock     = 0;
+  fTriggerMask      = 0;
+  fTriggerMaskValid = 0;
+  fTriggerTableName = "";
+  fTriggerTableTag  = -1;
+  fNTriggerRejected = 0;
+
+  fTagSelection     = "";
+  fNTagSelected     = 0;
+  fNTagRejected     = 0;
 
   return 0;
 }
@@ -207,6 +231,11 @@ TStnAna::~TStnAna()
   //printf(" TStnAna: eventlist.\n"); fflush(stdout); fflush(stderr);
   delete fEventList;
 
+  delete fProfiler;
+  delete fProfileTree;
+  delete fEventCache;
+  delete fTriggerMask;
+
 
   // TStnAna doesn't create the good run list, it is not its job to delete it
   //printf(" TStnAna: goodruns.\n"); fflush(stdout); fflush(stderr);
@@ -407,6 +436,8 @@ int TStnAna::BeginRun() {
     olddir->cd();
   }
 
+  if (fTriggerBlock) InitTriggerFilter();
+
   TStnRunSummary* new_rs = (TStnRunSummary*) fDBManager->GetTable("RunSummary");
 //-----------------------------------------------------------------------------
 // if use good run list and the run is marked as bad, return...
@@ -460,7 +491,7 @@ int TStnAna::ProcessEventList(TEventList* EventList) {
   for (int i=0; i<n; i++) {
     ientry = EventList->GetEntry(i);
     rc = ProcessEntry(ientry);
-    if(rc!=0 && rc!=-2 && rc!=-3) return rc;
+    if(rc!=0 && rc!=-2 && rc!=-3 && rc!=-5 && rc!=-6) return rc;
   }
 
   return 0;
@@ -500,8 +531,206 @@ void TStnAna::SetEventList(Int_t* EventList) {
 
 }
 
+//_____________________________________________________________________________
+void TStnAna::SetProfiling(Int_t Sampling) {
+  if (Sampling <= 0) {
+    delete fProfiler;
+    fProfiler = 0;
+    return;
+  }
+
+  if (fProfiler == 0) fProfiler = new TStnProfiler("StnAnaProfiler",Sampling);
+  else                fProfiler->SetSampling(Sampling);
+}
+
+//_____________________________________________________________________________
+void TStnAna::UseEventCache(const char* Filename) {
+  if (Filename == 0) {
+    delete fEventCache;
+    fEventCache = 0;
+    fCachedPass = 0;
+    return;
+  }
+
+  if (fEventCache == 0) fEventCache = new TStnEventCache(Filename);
+  else                  fEventCache->SetFilename(Filename);
+}
+
+//_____________________________________________________________________________
+void TStnAna::SetTriggerFilter(const char* Pattern) {
+  fTriggerPattern   = (Pattern) ? Pattern : "";
+  fTriggerTableName = "";
+  fTriggerTableTag  = -1;
+  fTriggerMaskValid = 0;
+  if (fTriggerMask == 0) fTriggerMask = new TBitset();
+}
+
+//-----------------------------------------------------------------------------
+// the selection can be changed between the calls to Continue: after BeginJob
+// it is re-initialized right away, the cached passes are not used with it
+//-----------------------------------------------------------------------------
+void TStnAna::SetTagSelection(const char* Expr) {
+  fTagSelection = (Expr) ? Expr : "";
+  fTagPass.clear();
+
+  if (fInitialized) {
+    InitTagSelection();
+    if (fTagPass.size() > 0) fCachedPass = 0;
+  }
+}
+
+//-----------------------------------------------------------------------------
+// called in BeginJob: nothing is read here, the selection is evaluated
+// per file of the input chain, when the event loop enters the file 
+// (see EvalTagSelection), so a short Continue(N) doesn't pay for the whole
+// chain. All entries start as kTagUnknown
+//-----------------------------------------------------------------------------
+int TStnAna::InitTagSelection() {
+
+  fTagPass.clear();
+  fNTagSelected = 0;
+  fNTagRejected = 0;
+
+  if (fTagSelection == "")                                  return 0;
+
+  TChain* chain = fInputModule->GetChain();
+  if (chain == 0) {
+    Warning("InitTagSelection","no input chain, tag pre-selection is OFF");
+    return -1;
+  }
+					// the file boundaries have to be known
+  Long64_t  nentries = (Long64_t) fInputModule->GetEntries();
+  Long64_t* offset   = chain->GetTreeOffset();
+  int       ntrees   = chain->GetNtrees();
+
+  if ((offset == 0) || (offset[ntrees] != nentries)) {
+    Warning("InitTagSelection","file boundaries of the chain unknown, tag pre-selection is OFF");
+    return -1;
+  }
+
+  fTagPass.assign(nentries,kTagUnknown);
+
+  printf(" >>> TStnAna::InitTagSelection: \"%s\", evaluated per file\n",
+	 fTagSelection.Data());
+
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+// evaluate the tag selection for all entries of the file containing Entry in
+// one pass over its STNTAG tree. The tag branches are small, so the pass
+// reads only a small fraction of the data. 
+// The tag tree has to be present and have one entry per STNTUPLE entry, 
+// otherwise all events of the file are accepted
+//-----------------------------------------------------------------------------
+int TStnAna::EvalTagSelection(Long64_t Entry) {
+
+  TChain*   chain  = fInputModule->GetChain();
+  Long64_t* offset = chain->GetTreeOffset();
+  int       ntrees = chain->GetNtrees();
+
+  int ifile = 0;
+  while ((ifile < ntrees-1) && (offset[ifile+1] <= Entry)) ifile++;
+
+  Long64_t first = offset[ifile];
+  Long64_t last  = offset[ifile+1];
+					// accept all, unless evaluated
+  for (Long64_t i=first; i<last; i++) fTagPass[i] = 1;
+
+  TChainElement* el = (TChainElement*) chain->GetListOfFiles()->At(ifile);
+
+  TDirectory* dir = gDirectory;
+  TFile* f = TFile::Open(el->GetTitle());
+  dir->cd();
+
+  TTree* tags = (f) ? (TTree*) f->Get("STNTAG") : 0;
+
+  if ((tags == 0) || (tags->GetEntries() != last-first)) {
+    Warning("EvalTagSelection","%s: no STNTAG tree or wrong number of entries, all events accepted",
+	    el->GetTitle());
+    delete f;
+    return -1;
+  }
+
+  tags->SetCacheSize(10*1024*1024);
+  tags->AddBranchToCache("*",kTRUE);
+
+  TTreeFormula* sel = new TTreeFormula("tag_selection",fTagSelection.Data(),tags);
+  if (sel->GetNdim() == 0) {
+    Error("EvalTagSelection","can't compile \"%s\", all events of %s accepted",
+	  fTagSelection.Data(),el->GetTitle());
+    delete sel;
+    delete f;
+    return -1;
+  }
+
+  for (Long64_t i=first; i<last; i++) {
+    if (tags->LoadTree(i-first) < 0) continue;
+    sel->GetNdata();
+    fTagPass[i]    = (sel->EvalInstance(0) != 0);
+    fNTagSelected += fTagPass[i];
+  }
+
+  delete sel;
+  delete f;
+
+  if (fPrintLevel > 0) {
+    printf(" >>> TStnAna::EvalTagSelection: %s: %lld events evaluated\n",
+	   el->GetTitle(),last-first);
+  }
+
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+// called in BeginRun, the mask is recompiled only if the trigger table changed
+//-----------------------------------------------------------------------------
+int TStnAna::InitTriggerFilter() {
+  TStnTriggerTable* table = (TStnTriggerTable*) fDBManager->GetTable("TriggerTable");
+
+  if ((table == 0) || (table->NTriggers() == 0)) {
+    if (fTriggerMaskValid || (fTriggerTableTag == -1)) {
+      Warning("InitTriggerFilter","run %i: no trigger table, trigger pre-selection is OFF",
+	      fRunNumber);
+    }
+    fTriggerMaskValid = 0;
+    fTriggerTableTag  = -2;
+    return -1;
+  }
+
+  if (fTriggerMaskValid                                 &&
+      (table->GetTableTag() == fTriggerTableTag)        &&
+      (fTriggerTableName    == table->GetTableName())     ) return 0;
+
+  int n = table->MakeMask(fTriggerPattern.Data(),fTriggerMask);
+
+  fTriggerTableName = table->GetTableName();
+  fTriggerTableTag  = table->GetTableTag();
+  fTriggerMaskValid = 1;
+
+  printf(" >>> TStnAna::InitTriggerFilter: run %i table %s: %i triggers match \"%s\"\n",
+	 fRunNumber,fTriggerTableName.Data(),n,fTriggerPattern.Data());
+
+  if (n == 0) Warning("InitTriggerFilter","no triggers match, all events will be rejected");
+
+  return 0;
+}
+
 //_____________________________________________________________________________
 int TStnAna::ProcessEntry(int Entry) {
+  // profiling wrapper, see ProcessEntryInternal
+
+  if (fProfiler == 0) return ProcessEntryInternal(Entry);
+
+  fProfiler->BeginEvent();
+  int rc = ProcessEntryInternal(Entry);
+  fProfiler->EndEvent();
+
+  return rc;
+}
+
+//_____________________________________________________________________________
+int TStnAna::ProcessEntryInternal(int Entry) {
   // process one event - `Entry' (!!!) in the chain
   // normally RunMin = -1, in this case process all the events
   // if RunMin > 0 and RunMax = -1, process only RunMin
@@ -518,13 +747,27 @@ int TStnAna::ProcessEntry(int Entry) {
   }
 
   fEntry = Entry;
+//-----------------------------------------------------------------------------
+// tag pre-selection: nothing is read for the rejected events
+//-----------------------------------------------------------------------------
+  if (Entry < (int) fTagPass.size()) {
+    if (fTagPass[Entry] == kTagUnknown) EvalTagSelection(Entry);
+    if (fTagPass[Entry] == 0) {
+      fNTagRejected++;
+      return -6;
+    }
+  }
+
+  if (fProfiler) fProfiler->Begin(fInputModule->GetName(),fProfiler->EventScope());
   Int_t tree_entry = fInputModule->NextEvent(int(fEntry));
+  if (fProfiler) fProfiler->End();
 
   if (tree_entry < 0) {
 //-----------------------------------------------------------------------------
 // end of the chain...
 //-----------------------------------------------------------------------------
     Warning("ProcessEntry","End of chain reached.");
+    if (fEventCache && (fEventCache->NEntries() == Entry)) fEventCache->SetComplete(1);
     return -1;
   }
 //-----------------------------------------------------------------------------
@@ -547,6 +790,15 @@ int TStnAna::ProcessEntry(int Entry) {
   fHeaderBlock->GetEvent()->SetEventNumber(rn,ev,rsn);
   passed = 1;
 //-----------------------------------------------------------------------------
+// record the event in the cache before any selection, the cached passes
+// apply the same selections. With the tag pre-selection the entries are not
+// sequential and the cache is not filled
+//-----------------------------------------------------------------------------
+  if (fEventCache && (fTagPass.size() == 0)) {
+    fEventCache->Fill(Entry,tree_entry,rn,rsn,ev);
+    if (fEventCache->NEntries() >= fInputModule->GetEntries()) fEventCache->SetComplete(1);
+  }
+//-----------------------------------------------------------------------------
 //  if event list is specified
 //-----------------------------------------------------------------------------
   if (fEventList != 0) {
@@ -587,6 +839,16 @@ int TStnAna::ProcessEntry(int Entry) {
     //}
   if (fGoodRun <= 0)                                        return -3;
 //-----------------------------------------------------------------------------
+// trigger pre-selection, the rejected events are not counted as processed
+//-----------------------------------------------------------------------------
+  if (fTriggerBlock && fTriggerMaskValid) {
+    fTriggerBlock->GetEntry(tree_entry);
+    if (fTriggerBlock->Passed(fTriggerMask) == 0) {
+      fNTriggerRejected++;
+                                                            return -5;
+    }
+  }
+//-----------------------------------------------------------------------------
 // each module is supposed to talk to an input chain and request the data 
 // (branches) it needs
 //-----------------------------------------------------------------------------
@@ -603,7 +865,9 @@ int TStnAna::ProcessEntry(int Entry) {
 
       if (fHeaderBlock->RunNumber() != m->GetLastRun()) {
 	m->EndRun();
+	if (fProfiler) fProfiler->Begin(m->GetName(),fProfiler->BeginRunScope());
 	m->BeginRun();
+	if (fProfiler) fProfiler->End();
 	m->SetLastRun(fHeaderBlock->RunNumber());
       }
 					// now it is safe to call the 
@@ -614,7 +878,11 @@ int TStnAna::ProcessEntry(int Entry) {
 //-----------------------------------------------------------------------------
 // handle fatal errors detected by the modules
 //-----------------------------------------------------------------------------
+      int nlookups = fEvent->NNameLookups();
+      if (fProfiler) fProfiler->Begin(m->GetName(),fProfiler->EventScope());
       rc = m->Event(tree_entry);
+      if (fProfiler) fProfiler->End();
+      m->AddNameLookups(fEvent->NNameLookups()-nlookups);
       if (rc < 0) {
 	fHeaderBlock->Print(Form("%s rc=%i detected by %s, skip event",
 				 "TStnaAna::ProcessEntry: FATAL ERROR ",
@@ -641,7 +909,9 @@ int TStnAna::ProcessEntry(int Entry) {
 	  fOutputModule->BeginRun();
 	}
 
+	if (fProfiler) fProfiler->Begin(fOutputModule->GetName(),fProfiler->EventScope());
 	fOutputModule->Event(tree_entry);
+	if (fProfiler) fProfiler->End();
       }
     }
   }
@@ -795,6 +1065,16 @@ int TStnAna::BeginJob()
 // always read in the header block
 //-----------------------------------------------------------------------------
   RegisterDataBlock("HeaderBlock",&fHeaderBlock);
+
+  if (fTriggerPattern != "") {
+    RegisterDataBlock("TriggerBlock","TStnTriggerBlock",&fTriggerBlock);
+  }
+  else fTriggerBlock = 0;
+
+  fNTriggerRejected = 0;
+
+  InitTagSelection();
+
   TIter it(fModuleList);
 				// initialization
   
@@ -852,8 +1132,8 @@ int TStnAna::BeginJob()
       
       // Add this node to the file
       if (! fEvent->GetListOfNodes()->FindObject(node))
-	fEvent->GetListOfNodes()->Add(node);
-      fEvent->GetListOfOutputNodes()->Add(node);
+	fEvent->AddNode(node);
+      fEvent->AddOutputNode(node);
 
     NEXT_BRANCH:;
     }
@@ -881,6 +1161,35 @@ int TStnAna::BeginJob()
   // fFolder->Add(fIntLumiTev);
   // fFolder->Add(fIntLumiLive);
   // fFolder->Add(fIntLumiOffl);
+//-----------------------------------------------------------------------------
+// preallocate the block objects: "Stnana.<BranchName>.Reserve: N" constructs
+// N objects in each TClonesArray of the block, take N from the high water
+// marks reported by PrintAllocations
+//-----------------------------------------------------------------------------
+  TIter itr(fEvent->GetListOfNodes());
+  while (TStnNode* node = (TStnNode*) itr.Next()) {
+    int n = gEnv->GetValue(Form("Stnana.%s.Reserve",node->GetName()),0);
+    if ((n > 0) && node->GetDataBlock()) node->GetDataBlock()->Reserve(n);
+  }
+//-----------------------------------------------------------------------------
+// event cache: collect the column definitions, the cached passes are possible
+// only if all enabled modules support them and nothing is written out
+//-----------------------------------------------------------------------------
+  if (fEventCache) {
+    fCachedPass = 1;
+    TIter itc(fModuleList);
+    while (TStnModule* m = (TStnModule*) itc.Next()) {
+      if (m->GetEnabled() && (m->DefineCacheColumns(fEventCache) == 0)) {
+	fCachedPass = 0;
+      }
+    }
+    if (fOutputModule && fOutputModule->GetEnabled())        fCachedPass = 0;
+					// the trigger block is not cached
+    if (fTriggerBlock)                                        fCachedPass = 0;
+    if (fTagPass.size() > 0)                                  fCachedPass = 0;
+
+    if (fEventCache->Init(fEvent,fInputModule) < 0)           fCachedPass = 0;
+  }
 				// visualization hook
   SetTitleNode();
 
@@ -948,6 +1257,7 @@ int TStnAna::EndJob() {
   while (TStnModule* m = (TStnModule*) itt.Next()) {
     if (m->GetEnabled()) {
       m->EndRun();
+      m->MakeHistSetHistograms();
       m->EndJob();
     }
   }
@@ -960,6 +1270,54 @@ int TStnAna::EndJob() {
     printf(" >>> TStnAna::EndJob: processed %10i events, passed %10i events\n",
 	   fNProcessedEvents,fNPassedEvents);
 
+  if (fTriggerBlock && (fPrintLevel > -2))
+    printf(" >>> TStnAna::EndJob: %10i events rejected by the trigger pre-selection \"%s\"\n",
+	   fNTriggerRejected,fTriggerPattern.Data());
+
+  if ((fTagPass.size() > 0) && (fPrintLevel > -2))
+    printf(" >>> TStnAna::EndJob: %10i events rejected by the tag pre-selection \"%s\"\n",
+	   fNTagRejected,fTagSelection.Data());
+//-----------------------------------------------------------------------------
+// report modules looking up data blocks by name on every event, 
+// fEvent->SetDebugNameLookups(1) enables the counting
+//-----------------------------------------------------------------------------
+  if (fEvent && fEvent->GetDebugNameLookups()) {
+    TIter itl(fModuleList);
+    while (TStnModule* m = (TStnModule*) itl.Next()) {
+      if (m->NNameLookups() > 0) {
+	printf(" >>> TStnAna::EndJob: module %-20s : %10i data block lookups by name",
+	       m->GetName(),m->NNameLookups());
+	printf(" in %10i events, use TStnEvent::GetBlockHandle in BeginJob\n",fNProcessedEvents);
+      }
+    }
+  }
+
+  if (fPrintLevel > 0) PrintAllocations();
+
+//-----------------------------------------------------------------------------
+// profiling report, the summary tree goes into the "Ana" folder and is saved
+// by SaveHist along with the histograms
+//-----------------------------------------------------------------------------
+  if (fProfiler) {
+    fProfiler->Print();
+    fProfiler->WriteCollapsedStacks();
+    printf(" >>> TStnAna::EndJob: collapsed stacks written to %s\n",fProfiler->StackFile());
+
+    if (fProfileTree) {
+      fFolder->Remove(fProfileTree);
+      delete fProfileTree;
+    }
+    fProfileTree = fProfiler->MakeSummaryTree();
+    fFolder->Add(fProfileTree);
+  }
+
+  if (fEventCache) {
+    if (fPrintLevel > -2) fEventCache->Print();
+    if (fEventCache->Modified() && (fEventCache->Filename()[0] != 0)) {
+      fEventCache->Save();
+    }
+  }
+
   if (fEventList) {
     printf(" >>>  strip summary:-\n");
     for (int i=0; fEventList[i].fRun>0; i++) {
@@ -1005,7 +1363,12 @@ int TStnAna::Run(int NEvents, Int_t MinRunNumber, Int_t MaxRunNumber,
   fNPassedEvents    = 0;
   fEntry            = StartEntry-1;
 
-  Continue(int(nentries));
+  if (fEventCache && fCachedPass && (fEventList == 0) && (StartEntry < fEventCache->NEntries())) {
+    ContinueFromCache(int(nentries));
+  }
+  else {
+    Continue(int(nentries));
+  }
 
   EndJob();
 
@@ -1041,7 +1404,7 @@ int TStnAna::ProcessRun(int RunMin, int RunMax) {
 // ProcessEntry increments fEntry
 //-----------------------------------------------------------------------------
     rc = ProcessEntry(i);
-    if (rc!=0 && rc!=-2 && rc!=-3) break;
+    if (rc!=0 && rc!=-2 && rc!=-3 && rc!=-5 && rc!=-6) break;
   }
 
   EndJob();
@@ -1068,9 +1431,11 @@ int TStnAna::Continue(int nev) {
 // rc = -1 : problem with reading the Header, most probably - end of file
 // rc = -2 : run outside the requested limits
 // rc = -3 : bad run according to the good run list used
+// rc = -5 : event rejected by the trigger pre-selection
+// rc = -6 : event rejected by the tag pre-selection
 //-----------------------------------------------------------------------------
     rc = ProcessEntry(int(i0+ientry));
-    if (rc!=0 && rc!=-2 && rc!=-3) {
+    if (rc!=0 && rc!=-2 && rc!=-3 && rc!=-5 && rc!=-6) {
       break;
     }
     ientry ++;
@@ -1079,6 +1444,128 @@ int TStnAna::Continue(int nev) {
       if (i >= nev) break;
     }
   }
+					// make the histograms of the 
+					// declarative sets up to date
+  MakeHistSetHistograms();
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+// same as Continue, but the events are served from the event cache. If the
+// cache is incomplete and runs out, continue reading the input files - that
+// also extends the cache
+//-----------------------------------------------------------------------------
+int TStnAna::ContinueFromCache(int nev) {
+  int rc;
+  int i     = 0;
+  int entry = int(fEntry)+1;
+
+  while (entry < fEventCache->NEntries()) {
+    if (fProfiler) fProfiler->BeginEvent();
+    rc = ProcessCachedEntry(entry);
+    if (fProfiler) fProfiler->EndEvent();
+
+    entry++;
+    if (rc == 0) {
+      i++;
+      if (i >= nev) break;
+    }
+  }
+
+  if ((i < nev) && (! fEventCache->Complete())) Continue(nev-i);
+  else                                          MakeHistSetHistograms();
+
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+// the declarative histogram sets are filled into flat arrays, the ROOT 
+// histograms are created (updated) on demand
+//-----------------------------------------------------------------------------
+int TStnAna::MakeHistSetHistograms() {
+  TIter it(fModuleList);
+  while (TStnModule* m = (TStnModule*) it.Next()) {
+    if (m->GetEnabled()) m->MakeHistSetHistograms();
+  }
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+// cached version of ProcessEntryInternal: run/subrun/event numbers come from
+// the cache and are copied into the header block, no data blocks are read.
+// There is no run-dependent DB in the cached passes
+//-----------------------------------------------------------------------------
+int TStnAna::ProcessCachedEntry(int Entry) {
+  int passed, rn, rsn, ev, rc;
+
+  fEntry = Entry;
+
+  rn  = fEventCache->RunNumber    (Entry);
+  rsn = fEventCache->SectionNumber(Entry);
+  ev  = fEventCache->EventNumber  (Entry);
+
+  fHeaderBlock->fRunNumber     = rn;
+  fHeaderBlock->fSectionNumber = rsn;
+  fHeaderBlock->fEventNumber   = ev;
+  fEvent->SetEventNumber(rn,ev,rsn);
+
+  if (( rn < fMinRunNumber) || (rn > fMaxRunNumber ))       return -2;
+
+  if (rn != fRunNumber) {
+    fRunNumber     = rn;
+    fSectionNumber = rsn;
+  }
+
+  if (fGoodRunList != 0) fGoodRun = fGoodRunList->GoodRun(rn,rsn,ev);
+  else                   fGoodRun = 1;
+  if (fGoodRun <= 0)                                        return -3;
+
+  passed = 1;
+
+  TListIter it(fModuleList);
+  while (TStnModule* m = (TStnModule*) it.Next()) {
+    if (m->GetEnabled()) {
+      if (! m->GetInitialized()) {
+	m->BeginJob();
+	m->SetInitialized(1);
+      }
+
+      if (rn != m->GetLastRun()) {
+	m->EndRun();
+	if (fProfiler) fProfiler->Begin(m->GetName(),fProfiler->BeginRunScope());
+	m->BeginRun();
+	if (fProfiler) fProfiler->End();
+	m->SetLastRun(rn);
+      }
+
+      if (fProfiler) fProfiler->Begin(m->GetName(),fProfiler->EventScope());
+      rc = m->EventFromCache(fEventCache,Entry);
+      if (fProfiler) fProfiler->End();
+
+      if (rc < 0) {
+	fHeaderBlock->Print(Form("%s rc=%i detected by %s, skip event",
+				 "TStnaAna::ProcessCachedEntry: FATAL ERROR ",
+				 rc,m->GetName()));
+	passed = 0;
+      }
+      else {
+	passed = m->GetPassed();
+      }
+      if (! passed) break;
+    }
+  }
+
+  if (passed) fNPassedEvents++;
+
+  fNProcessedEvents++;
+
+  if (fPrintLevel == 0) {
+    if (fNProcessedEvents % fNEventsToReport == 0) {
+      fHeaderBlock->Print(Form(" >>> TStnAna: Processed %10i events (cached)",
+			       fNProcessedEvents));
+    }
+  }
+
   return 0;
 }
 
@@ -1099,10 +1586,10 @@ void* TStnAna::RegisterDataBlock(const char*     BranchName,
 				// make sure we're not adding the same branch
 				// twice
 
-    exists =  (TStnNode*) fEvent->GetListOfNodes()->FindObject(BranchName);
+    exists = fEvent->FindNode(BranchName);
 
     if (exists) node = exists;
-    else fEvent->GetListOfNodes()->Add(node);
+    else fEvent->AddNode(node);
 
     block = node->GetDataBlock();
     block->SetNode(node);
@@ -1143,10 +1630,10 @@ void TStnAna::RegisterDataBlock(const char* BranchName, void* DataBlock)
 //-----------------------------------------------------------------------------
 // make sure we're not adding the same branch twice
 //-----------------------------------------------------------------------------
-    exists =  (TStnNode*) fEvent->GetListOfNodes()->FindObject(BranchName);
+    exists = fEvent->FindNode(BranchName);
 
     if (exists) node = exists;
-    else fEvent->GetListOfNodes()->Add(node);
+    else fEvent->AddNode(node);
 
     (*block) = node->GetDataBlock();
     (*block)->SetNode(node);
@@ -1183,10 +1670,10 @@ void TStnAna::RegisterDataBlock(const char* BranchName,
 //-----------------------------------------------------------------------------
 // make sure we're not adding the same branch twice
 //-----------------------------------------------------------------------------
-    exists =  (TStnNode*) fEvent->GetListOfNodes()->FindObject(BranchName);
+    exists = fEvent->FindNode(BranchName);
 
     if (exists) node = exists;
-    else fEvent->GetListOfNodes()->Add(node);
+    else fEvent->AddNode(node);
 
     (*block) = node->GetDataBlock();
     (*block)->SetNode(node);
@@ -1349,6 +1836,8 @@ void TStnAna::SaveHist(const char* Filename, Int_t Mode)
   // Mode = 1: save folders
   // Mode = 2: save directories
 
+  MakeHistSetHistograms();
+
   TFile* f = new TFile(Filename,"recreate");
 
   if (Mode == 1) {
@@ -1363,6 +1852,26 @@ void TStnAna::SaveHist(const char* Filename, Int_t Mode)
   delete f;
 }
 
+//_____________________________________________________________________________
+void TStnAna::PrintAllocations() {
+  // in the steady state the number of allocated objects doesn't grow:
+  // the objects are reused, new ones are constructed only when the event
+  // has more objects than any of the previous ones
+
+  printf(" >>> TStnAna::PrintAllocations: %i events processed\n",fNProcessedEvents);
+  printf("   branch                           allocated  high water marks\n");
+
+  TIter it(fEvent->GetListOfNodes());
+  while (TStnNode* node = (TStnNode*) it.Next()) {
+    TStnDataBlock* block = node->GetDataBlock();
+    if ((block == 0) || (block->NArrays() == 0)) continue;
+
+    printf("   %-30s %10i ",node->GetName(),block->NAllocated());
+    for (int i=0; i<block->NArrays(); i++) printf(" %8i",block->HighWaterMark(i));
+    printf("\n");
+  }
+}
+
 //_____________________________________________________________________________
 void TStnAna::PrintStat(Int_t nevents, const char* BranchName) 
 {
@@ -1406,7 +1915,7 @@ void TStnAna::PrintStat(Int_t nevents, const char* BranchName)
       node         = new TStnNode(branch->GetName(),cl,event);
       branch->SetAddress(node->GetDataBlockAddress());
       branch->SetAutoDelete(kFALSE);
-      event->GetListOfNodes()->Add(node);
+      event->AddNode(node);
       //    printf("%s\n",branch->GetName());
       stat[ibb].fBranch = branch;
       stat[ibb].fN      = 0;
@@ -0,0 +1,446 @@
+//-----------------------------------------------------------------------------
+// STNTUPLE data block I/O benchmark, see comments in TStnBlockBenchmark.hh
+//-----------------------------------------------------------------------------
+#include <cmath>
+#include <cstdio>
+
+#include "TClass.h"
+#include "TFile.h"
+#include "TTree.h"
+#include "TBranch.h"
+#include "TBufferFile.h"
+#include "TRandom3.h"
+#include "TSystem.h"
+
+#include "Stntuple/obj/TStnNode.hh"
+#include "Stntuple/obj/TStnDataBlock.hh"
+#include "Stntuple/obj/TStnHeaderBlock.hh"
+#include "Stntuple/obj/TStnTrackBlock.hh"
+#include "Stntuple/obj/TCalDataBlock.hh"
+#include "Stntuple/obj/TSimpBlock.hh"
+#include "Stntuple/obj/TStrawHitBlock.hh"
+#include "Stntuple/obj/TCrvPulseBlock.hh"
+
+#include "Stntuple/loop/TStnProfiler.hh"
+#include "Stntuple/loop/TStnBlockBenchmark.hh"
+
+ClassImp(TStnBlockBenchmark)
+
+//_____________________________________________________________________________
+TStnBlockBenchmark::TStnBlockBenchmark(const char* Dir, int NEvents, int Seed):
+  TNamed("StnBlockBenchmark","STNTUPLE data block I/O benchmark")
+{
+  fDir         = Dir;
+  fNEvents     = NEvents;
+  fSeed        = Seed;
+  fCompression = 1;
+  fBasketSize  = 64000;
+  fSplitLevel  = -1;			// StntupleMaker default
+  fKeepFiles   = 0;
+//-----------------------------------------------------------------------------
+// mean multiplicities: signal MC with the nominal pileup
+//-----------------------------------------------------------------------------
+  AddBlock("HeaderBlock"     ,"TStnHeaderBlock",FillHeaderBlock    ,    1.);
+  AddBlock("TrackBlock"      ,"TStnTrackBlock" ,FillTrackBlock     ,    2.);
+  AddBlock("CalDataBlock"    ,"TCalDataBlock"  ,FillCalDataBlock   ,  300.);
+  AddBlock("SimpBlock"       ,"TSimpBlock"     ,FillSimpBlock      ,   50.);
+  AddBlock("StrawHitBlock"   ,"TStrawHitBlock" ,FillStrawHitBlock  , 2000.);
+  AddBlock("StrawHitWfBlock" ,"TStrawHitBlock" ,FillStrawHitWfBlock, 2000.);
+  AddBlock("CrvPulseBlock"   ,"TCrvPulseBlock" ,FillCrvPulseBlock  ,  100.);
+}
+
+//_____________________________________________________________________________
+TStnBlockBenchmark::~TStnBlockBenchmark() {
+}
+
+//_____________________________________________________________________________
+void TStnBlockBenchmark::AddBlock(const char* BranchName, const char* ClassName,
+				  Filler_t    Filler    , double      Mean) {
+  for (Block_t& b : fBlock) {
+    if (b.fBranchName == BranchName) {
+      b.fClassName = ClassName;
+      b.fFiller    = Filler;
+      b.fMean      = Mean;
+      return;
+    }
+  }
+
+  Block_t b;
+  b.fBranchName = BranchName;
+  b.fClassName  = ClassName;
+  b.fFiller     = Filler;
+  b.fMean       = Mean;
+  fBlock.push_back(b);
+}
+
+//_____________________________________________________________________________
+int TStnBlockBenchmark::SetMultiplicity(const char* BranchName, double Mean) {
+  for (Block_t& b : fBlock) {
+    if (b.fBranchName == BranchName) {
+      b.fMean = Mean;
+      return 0;
+    }
+  }
+  Error("SetMultiplicity","unknown block %s",BranchName);
+  return -1;
+}
+
+//_____________________________________________________________________________
+void TStnBlockBenchmark::Clear(Option_t* Opt) {
+  fResult.clear();
+}
+
+//_____________________________________________________________________________
+int TStnBlockBenchmark::Run(const char* BranchName) {
+  int nfailed(0), nrun(0);
+
+  for (const Block_t& b : fBlock) {
+    if ((strcmp(BranchName,"all") != 0) && (b.fBranchName != BranchName)) continue;
+    nrun += 1;
+    if (RunBlock(&b) != 0) nfailed += 1;
+  }
+
+  if (nrun == 0) {
+    Error("Run","no block %s defined",BranchName);
+    return -1;
+  }
+
+  Print();
+  return nfailed;
+}
+
+//-----------------------------------------------------------------------------
+// the same random sequence is used for all the phases, so the in-memory
+// and the file measurements see the same events
+//-----------------------------------------------------------------------------
+int TStnBlockBenchmark::RunBlock(const Block_t* Block) {
+
+  TClass* cl = TClass::GetClass(Block->fClassName.Data());
+  if ((cl == nullptr) || (! cl->InheritsFrom("TStnDataBlock"))) {
+    Error("RunBlock","%s is not a data block class",Block->fClassName.Data());
+    return -1;
+  }
+
+  Result_t r;
+  r.fBranchName    = Block->fBranchName;
+  r.fClassName     = Block->fClassName;
+  r.fNEvents       = fNEvents;
+  r.fMeanMult      = 0;
+  r.fBytes         = 0;
+  r.fZipBytes      = 0;
+  r.fStreamerWrite = 0;
+  r.fStreamerRead  = 0;
+  r.fClear         = 0;
+  r.fFill          = 0;
+  r.fGetEntry      = 0;
+  r.fGetEntryWall  = 0;
+
+  TStnDataBlock* block = (TStnDataBlock*) cl->New();
+  TStnDataBlock* copy  = (TStnDataBlock*) cl->New();
+  TRandom3       rn;
+  double         t0;
+//-----------------------------------------------------------------------------
+// 1. streamers, in memory
+//-----------------------------------------------------------------------------
+  rn.SetSeed(fSeed);
+  TBufferFile wbuf(TBuffer::kWrite,1024*1024);
+
+  for (int i=0; i<fNEvents; i++) {
+    block->Clear();
+    r.fMeanMult += Block->fFiller(block,&rn,Block->fMean);
+
+    wbuf.Reset();
+    t0 = TStnProfiler::CpuTime();
+    block->Streamer(wbuf);
+    r.fStreamerWrite += TStnProfiler::CpuTime()-t0;
+    r.fBytes         += wbuf.Length();
+
+    TBufferFile rbuf(TBuffer::kRead,wbuf.Length(),wbuf.Buffer(),kFALSE);
+    copy->Clear();
+    t0 = TStnProfiler::CpuTime();
+    copy->Streamer(rbuf);
+    r.fStreamerRead += TStnProfiler::CpuTime()-t0;
+  }
+//-----------------------------------------------------------------------------
+// 2. write the file
+//-----------------------------------------------------------------------------
+  TString fn = Form("%s/block_benchmark_%s.root",fDir.Data(),Block->fBranchName.Data());
+
+  TDirectory* dir = gDirectory;
+  TFile* f = new TFile(fn.Data(),"recreate");
+  if (f->IsZombie()) {
+    Error("RunBlock","can't open %s",fn.Data());
+    delete f;
+    dir->cd();
+    delete block;
+    delete copy;
+    return -2;
+  }
+
+  TTree* t = new TTree("STNTUPLE","STNTUPLE block benchmark");
+  TBranch* br = t->Branch(Block->fBranchName.Data(),Block->fClassName.Data(),
+			  &block,fBasketSize,fSplitLevel);
+  br->SetCompressionLevel(fCompression);
+
+  rn.SetSeed(fSeed);
+  for (int i=0; i<fNEvents; i++) {
+    block->Clear();
+    Block->fFiller(block,&rn,Block->fMean);
+
+    t0 = TStnProfiler::CpuTime();
+    t->Fill();
+    r.fFill += TStnProfiler::CpuTime()-t0;
+  }
+
+  t->Write();
+  r.fZipBytes = br->GetZipBytes();
+  f->Close();
+  delete f;
+//-----------------------------------------------------------------------------
+// 3. read it back the way TStnAna does: Clear, then TStnNode::GetEntry
+//-----------------------------------------------------------------------------
+  f = new TFile(fn.Data());
+  t = (TTree*) f->Get("STNTUPLE");
+  br = t->GetBranch(Block->fBranchName.Data());
+
+  TStnNode* node = new TStnNode(br,cl,nullptr);
+  br->SetAddress(node->GetDataBlockAddress());
+
+  for (int i=0; i<fNEvents; i++) {
+    t0 = TStnProfiler::CpuTime();
+    node->GetDataBlock()->Clear();
+    r.fClear += TStnProfiler::CpuTime()-t0;
+
+    double w0 = TStnProfiler::WallTime();
+    t0        = TStnProfiler::CpuTime();
+    node->GetEntry(i);
+    r.fGetEntry     += TStnProfiler::CpuTime ()-t0;
+    r.fGetEntryWall += TStnProfiler::WallTime()-w0;
+  }
+
+  br->ResetAddress();
+  delete node;
+  f->Close();
+  delete f;
+  dir->cd();
+
+  if (! fKeepFiles) gSystem->Unlink(fn.Data());
+//-----------------------------------------------------------------------------
+// normalize: per event, times in microseconds
+//-----------------------------------------------------------------------------
+  double n = (fNEvents > 0) ? fNEvents : 1;
+
+  r.fMeanMult      /= n;
+  r.fBytes         /= n;
+  r.fZipBytes      /= n;
+  r.fStreamerWrite *= 1.e6/n;
+  r.fStreamerRead  *= 1.e6/n;
+  r.fClear         *= 1.e6/n;
+  r.fFill          *= 1.e6/n;
+  r.fGetEntry      *= 1.e6/n;
+  r.fGetEntryWall  *= 1.e6/n;
+
+  fResult.push_back(r);
+
+  delete block;
+  delete copy;
+  return 0;
+}
+
+//_____________________________________________________________________________
+int TStnBlockBenchmark::WriteResults(const char* Filename) const {
+  FILE* f = fopen(Filename,"w");
+  if (f == nullptr) {
+    Error("WriteResults","can't open %s",Filename);
+    return -1;
+  }
+
+  fprintf(f,"block,class,nevents,seed,mult,bytes,zip_bytes,streamer_write_us,");
+  fprintf(f,"streamer_read_us,clear_us,fill_us,getentry_us,getentry_wall_us\n");
+
+  for (const Result_t& r : fResult) {
+    fprintf(f,"%s,%s,%i,%i,%.3f,%.1f,%.1f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+	    r.fBranchName.Data(),r.fClassName.Data(),r.fNEvents,fSeed,
+	    r.fMeanMult,r.fBytes,r.fZipBytes,
+	    r.fStreamerWrite,r.fStreamerRead,r.fClear,r.fFill,
+	    r.fGetEntry,r.fGetEntryWall);
+  }
+
+  fclose(f);
+  return 0;
+}
+
+//_____________________________________________________________________________
+void TStnBlockBenchmark::Print(Option_t* Opt) const {
+  printf(" >>> TStnBlockBenchmark: N(events) = %i, seed = %i, compression = %i\n",
+	 fNEvents,fSeed,fCompression);
+  printf("-----------------------------------------------------------------------------");
+  printf("--------------------------------\n");
+  printf(" block              mult   bytes/ev  zip/ev    ---------------- us/event");
+  printf(" ----------------------------\n");
+  printf("                                                str_wr   str_rd    clear");
+  printf("     fill getentry  (wall)\n");
+  printf("-----------------------------------------------------------------------------");
+  printf("--------------------------------\n");
+
+  for (const Result_t& r : fResult) {
+    printf(" %-15s %7.1f %10.0f %8.0f %9.2f %8.2f %8.2f %8.2f %8.2f %8.2f\n",
+	   r.fBranchName.Data(),r.fMeanMult,r.fBytes,r.fZipBytes,
+	   r.fStreamerWrite,r.fStreamerRead,r.fClear,r.fFill,
+	   r.fGetEntry,r.fGetEntryWall);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// fillers, return number of objects added to the block
+//-----------------------------------------------------------------------------
+int TStnBlockBenchmark::FillHeaderBlock(TStnDataBlock* Block, TRandom3* Rn, double Mean) {
+  TStnHeaderBlock* b = (TStnHeaderBlock*) Block;
+
+  b->fEventNumber   = Rn->Integer(1000000);
+  b->fRunNumber     = 1000;
+  b->fSectionNumber = b->fEventNumber/1000;
+  b->fMcFlag        = 1;
+  b->fNTracks       = Rn->Poisson(2);
+  b->fNStrawHits    = Rn->Poisson(2000);
+  b->fNCaloHits     = Rn->Poisson(300);
+  b->fNCRVHits      = Rn->Poisson(100);
+  b->fNComboHits    = Rn->Poisson(1000);
+  b->fInstLum       = Rn->Gaus(3.9e7,1.e6);
+  b->fMeanLum       = 3.9e7;
+
+  return 1;
+}
+
+//_____________________________________________________________________________
+int TStnBlockBenchmark::FillTrackBlock(TStnDataBlock* Block, TRandom3* Rn, double Mean) {
+  TStnTrackBlock* b = (TStnTrackBlock*) Block;
+
+  int n = Rn->Poisson(Mean);
+  for (int i=0; i<n; i++) {
+    TStnTrack* t = b->NewTrack();
+    double p     = Rn->Gaus(104.,1.);
+    double tdip  = Rn->Uniform(0.5,1.0);
+    double phi   = Rn->Uniform(-M_PI,M_PI);
+    double pt    = p/sqrt(1+tdip*tdip);
+
+    t->fMomentum.SetXYZM(pt*cos(phi),pt*sin(phi),pt*tdip,0.511);
+    t->fP        = p;
+    t->fPt       = pt;
+    t->fTanDip   = tdip;
+    t->fCharge   = -1;
+    t->fChi2     = Rn->Gaus(40.,10.);
+    t->fT0       = Rn->Uniform(500.,1700.);
+    t->fT0Err    = Rn->Gaus(0.5,0.1);
+    t->fFitMomErr= Rn->Gaus(0.2,0.05);
+    t->fD0       = Rn->Gaus(0.,30.);
+    t->fZ0       = Rn->Gaus(0.,300.);
+    t->fFitCons  = Rn->Rndm();
+    t->fTrkQual  = Rn->Rndm();
+    t->fNActive  = Rn->Poisson(30);
+    t->fNHits    = t->fNActive+Rn->Poisson(2);
+  }
+
+  return n;
+}
+
+//_____________________________________________________________________________
+int TStnBlockBenchmark::FillCalDataBlock(TStnDataBlock* Block, TRandom3* Rn, double Mean) {
+  TCalDataBlock* b = (TCalDataBlock*) Block;
+
+  int n = Rn->Poisson(Mean);
+  for (int i=0; i<n; i++) {
+    TCalHitData* hit = b->NewCalHitData();
+    hit->Set(Rn->Integer(1348),2,Rn->Uniform(0.,1700.),Rn->Exp(2.));
+  }
+
+  return n;
+}
+
+//_____________________________________________________________________________
+int TStnBlockBenchmark::FillSimpBlock(TStnDataBlock* Block, TRandom3* Rn, double Mean) {
+  TSimpBlock* b = (TSimpBlock*) Block;
+
+  int n = Rn->Poisson(Mean);
+  for (int i=0; i<n; i++) {
+    int pdg = (Rn->Rndm() < 0.5) ? 11 : 22;
+    TSimParticle* p = b->NewParticle(i+1,(i > 0) ? Rn->Integer(i)+1 : 0,pdg,
+				     Rn->Integer(100),Rn->Integer(100),
+				     Rn->Integer(5000),Rn->Integer(5000),0);
+    double x = Rn->Gaus(-3904.,100.);
+    double y = Rn->Gaus(0.,100.);
+    double z = Rn->Uniform(4000.,14000.);
+    double e = Rn->Exp(5.);
+    p->SetStartPos(x,y,z,Rn->Uniform(0.,1700.));
+    p->SetStartMom(Rn->Gaus(0.,e),Rn->Gaus(0.,e),Rn->Gaus(0.,e),e);
+    p->SetEndPos  (x,y,z+Rn->Exp(100.),Rn->Uniform(0.,1700.));
+    p->SetEndMom  (0.,0.,0.,0.);
+    p->SetNStrawHits(Rn->Poisson(5));
+  }
+
+  return n;
+}
+
+//_____________________________________________________________________________
+int TStnBlockBenchmark::FillStrawHitBlock(TStnDataBlock* Block, TRandom3* Rn, double Mean) {
+  TStrawHitBlock* b = (TStrawHitBlock*) Block;
+
+  float time[2], tot[2];
+
+  int n = Rn->Poisson(Mean);
+  for (int i=0; i<n; i++) {
+    TStrawHit* hit = b->NewHit(i);
+    time[0] = Rn->Uniform(0.,1700.);
+    time[1] = time[0]+Rn->Gaus(0.,1.);
+    tot [0] = Rn->Uniform(0.,64.);
+    tot [1] = Rn->Uniform(0.,64.);
+    hit->Set(Rn->Integer(TStrawHit::_maxval),time,tot,
+	     0,Rn->Integer(100),11,0,Rn->Exp(0.003),Rn->Exp(10.));
+  }
+
+  return n;
+}
+
+//-----------------------------------------------------------------------------
+// hits with digitizer waveforms: pedestal + noise, a pulse in ~1/3 of them
+//-----------------------------------------------------------------------------
+int TStnBlockBenchmark::FillStrawHitWfBlock(TStnDataBlock* Block, TRandom3* Rn, double Mean) {
+  TStrawHitBlock* b = (TStrawHitBlock*) Block;
+
+  const int nsamples = 15;
+  ushort    adc[nsamples];
+
+  int n = FillStrawHitBlock(Block,Rn,Mean);
+
+  for (int i=0; i<n; i++) {
+    double ped = Rn->Gaus(1800.,20.);
+    double amp = (Rn->Rndm() < 0.3) ? Rn->Exp(200.) : 0;
+    int    t0  = Rn->Integer(nsamples);
+
+    for (int k=0; k<nsamples; k++) {
+      double x = ped+Rn->Gaus(0.,3.);
+      if (k >= t0) x += amp*(k-t0)*exp(-(k-t0)/2.)/(2*exp(-1.));
+      adc[k] = (ushort) (x+0.5);
+    }
+
+    b->NewWaveform(i)->Set(nsamples,adc);
+  }
+
+  return n;
+}
+
+//_____________________________________________________________________________
+int TStnBlockBenchmark::FillCrvPulseBlock(TStnDataBlock* Block, TRandom3* Rn, double Mean) {
+  TCrvPulseBlock* b = (TCrvPulseBlock*) Block;
+
+  int n = Rn->Poisson(Mean);
+  for (int i=0; i<n; i++) {
+    TCrvRecoPulse* p = b->NewPulse();
+    int npe = Rn->Poisson(20);
+    p->Set(i,npe,npe,Rn->Poisson(3)+1,Rn->Integer(5504),Rn->Integer(4),
+	   Rn->Uniform(0.,1700.),Rn->Exp(100.),Rn->Gaus(10.,1.),Rn->Exp(1.),
+	   Rn->Uniform(0.,1700.));
+  }
+
+  return n;
+}
@@ -0,0 +1,385 @@
+//-----------------------------------------------------------------------------
+// columnar event cache, see comments in TStnEventCache.hh
+//
+// cache file layout (native byte order):
+//   header : magic, version, key length, key, N(entries), complete flag,
+//            N(columns)
+//   run, subrun, event numbers  : N(entries) ints each
+//   per column: name, branch name (length + chars), array flag,
+//               N(values), values (floats), arrays: N(entries)+1 offsets
+//-----------------------------------------------------------------------------
+#include <cmath>
+#include <cstdio>
+
+#include "TSystem.h"
+#include "TMD5.h"
+#include "TClass.h"
+
+#include "Stntuple/obj/TStnEvent.hh"
+#include "Stntuple/obj/TStnNode.hh"
+#include "Stntuple/obj/TStnDataBlock.hh"
+
+#include "Stntuple/loop/TStnInputModule.hh"
+#include "Stntuple/loop/TStnEventCache.hh"
+
+ClassImp(TStnEventCache)
+
+namespace {
+  int WriteString(FILE* F, const TString& S) {
+    int len = S.Length();
+    if (fwrite(&len,sizeof(int),1,F) != 1)                  return -1;
+    if (fwrite(S.Data(),1,len,F) != (size_t) len)            return -1;
+    return 0;
+  }
+
+  int ReadString(FILE* F, TString& S) {
+    int len;
+    if (fread(&len,sizeof(int),1,F) != 1)                    return -1;
+    if ((len < 0) || (len > 100000))                         return -1;
+    std::vector<char> buf(len+1,0);
+    if (fread(buf.data(),1,len,F) != (size_t) len)           return -1;
+    S = buf.data();
+    return 0;
+  }
+
+  template <class T> int WriteVector(FILE* F, const std::vector<T>& V, int N) {
+    if (N == 0)                                              return 0;
+    return (fwrite(V.data(),sizeof(T),N,F) == (size_t) N) ? 0 : -1;
+  }
+
+  template <class T> int ReadVector(FILE* F, std::vector<T>& V, int N) {
+    V.resize(N);
+    if (N == 0)                                              return 0;
+    return (fread(V.data(),sizeof(T),N,F) == (size_t) N) ? 0 : -1;
+  }
+}
+
+//_____________________________________________________________________________
+TStnEventCache::TStnEventCache(const char* Filename) :
+  TNamed("StnAnaEventCache","STNTUPLE columnar event cache") {
+  fFilename    = Filename;
+  fNEntries    = 0;
+  fComplete    = 0;
+  fModified    = 0;
+  fNFillErrors = 0;
+}
+
+//_____________________________________________________________________________
+TStnEventCache::~TStnEventCache() {
+}
+
+//_____________________________________________________________________________
+int TStnEventCache::ColumnIndex(const char* Name) const {
+  int nc = fColumn.size();
+  for (int i=0; i<nc; i++) {
+    if (fColumn[i].fName == Name) return i;
+  }
+  return -1;
+}
+
+//-----------------------------------------------------------------------------
+// a column redefined with a different block invalidates the cached data,
+// Init takes care of that via the key
+//-----------------------------------------------------------------------------
+int TStnEventCache::AddScalar(const char* Name, const char* BranchName, Scalar_t F) {
+  int ic = ColumnIndex(Name);
+  if (ic < 0) {
+    fColumn.push_back(Column_t());
+    ic = fColumn.size()-1;
+  }
+
+  Column_t* c = &fColumn[ic];
+  c->fName       = Name;
+  c->fBranchName = BranchName;
+  c->fArray      = 0;
+  c->fScalar     = F;
+  c->fCount      = nullptr;
+  c->fElement    = nullptr;
+  c->fNode       = 0;
+
+  return ic;
+}
+
+//_____________________________________________________________________________
+int TStnEventCache::AddArray(const char* Name, const char* BranchName,
+			     Count_t N, Element_t F) {
+  int ic = ColumnIndex(Name);
+  if (ic < 0) {
+    fColumn.push_back(Column_t());
+    ic = fColumn.size()-1;
+  }
+
+  Column_t* c = &fColumn[ic];
+  c->fName       = Name;
+  c->fBranchName = BranchName;
+  c->fArray      = 1;
+  c->fScalar     = nullptr;
+  c->fCount      = N;
+  c->fElement    = F;
+  c->fNode       = 0;
+
+  return ic;
+}
+
+//-----------------------------------------------------------------------------
+// computing real checksums would mean reading all the input files, which is
+// what the cache is supposed to avoid. The input module describes the input
+// instead (TStnInputModule::CacheKey: name, size and modification time of
+// each file, for remote files - just the name and the number of entries)
+//-----------------------------------------------------------------------------
+TString TStnEventCache::MakeKey(TStnInputModule* Input) const {
+  TString   key = Input->CacheKey();
+
+  for (const Column_t& c : fColumn) {
+    key += Form("%s:%s:%i",c.fName.Data(),c.fBranchName.Data(),c.fArray);
+    if (c.fNode) {
+      TClass* cl = c.fNode->GetDataBlock()->IsA();
+      key += Form(":%s:%i",cl->GetName(),cl->GetClassVersion());
+    }
+    key += ";";
+  }
+
+  TMD5 md5;
+  md5.Update((const UChar_t*) key.Data(),key.Length());
+  md5.Final();
+
+  return TString(md5.AsString());
+}
+
+//_____________________________________________________________________________
+int TStnEventCache::Init(TStnEvent* Event, TStnInputModule* Input) {
+  int rc = 0;
+
+  for (Column_t& c : fColumn) {
+    c.fNode = Event->GetBlockNode(c.fBranchName.Data());
+    if (c.fNode == 0) {
+      Error("Init","column %s: branch %s not registered",
+	    c.fName.Data(),c.fBranchName.Data());
+      rc = -1;
+    }
+  }
+
+  TString key = MakeKey(Input);
+
+  if (key != fKey) {
+    if (fNEntries > 0) {
+      printf(" >>> TStnEventCache::Init: input or column definitions changed, drop %i cached entries\n",
+	     fNEntries);
+    }
+    Clear();
+    fKey = key;
+  }
+
+  if ((fNEntries == 0) && (fFilename != "")) {
+    if (gSystem->AccessPathName(fFilename.Data()) == 0) Load();
+  }
+
+  return rc;
+}
+
+//_____________________________________________________________________________
+int TStnEventCache::Fill(int Entry, int TreeEntry, int Run, int Subrun, int Ev) {
+  if (fComplete || (Entry != fNEntries))                     return 0;
+
+  fRunNumber    .push_back(Run);
+  fSectionNumber.push_back(Subrun);
+  fEventNumber  .push_back(Ev);
+
+  for (Column_t& c : fColumn) {
+    TStnDataBlock* block = (c.fNode) ? c.fNode->GetDataBlock() : 0;
+    if (block) block->GetEntry(TreeEntry);
+
+    if (c.fArray == 0) {
+      float x = (block) ? c.fScalar(block) : NAN;
+      c.fData.push_back(x);
+    }
+    else {
+      if (c.fOffset.empty()) c.fOffset.push_back(0);
+
+      int n = (block) ? c.fCount(block) : 0;
+      for (int i=0; i<n; i++) c.fData.push_back(c.fElement(block,i));
+      c.fOffset.push_back(c.fData.size());
+    }
+
+    if (block == 0) fNFillErrors++;
+  }
+
+  fNEntries++;
+  fModified = 1;
+
+  return 1;
+}
+
+//_____________________________________________________________________________
+int TStnEventCache::Save(const char* Filename) {
+  TString fn = (Filename) ? Filename : fFilename.Data();
+  if (fn == "")                                              return -1;
+//-----------------------------------------------------------------------------
+// write into a temporary file and rename, a crashed job doesn't leave
+// a truncated cache behind
+//-----------------------------------------------------------------------------
+  TString tmp = fn+".tmp";
+  FILE* f = fopen(tmp.Data(),"w");
+  if (f == 0) {
+    Error("Save","can\'t open %s",tmp.Data());
+    return -1;
+  }
+
+  int magic(kMagic), version(kVersion), nc(fColumn.size());
+  int rc = 0;
+
+  if (fwrite(&magic   ,sizeof(int),1,f) != 1) rc = -1;
+  if (fwrite(&version ,sizeof(int),1,f) != 1) rc = -1;
+  if (WriteString(f,fKey)                < 0) rc = -1;
+  if (fwrite(&fNEntries,sizeof(int),1,f) != 1) rc = -1;
+  if (fwrite(&fComplete,sizeof(int),1,f) != 1) rc = -1;
+  if (fwrite(&nc       ,sizeof(int),1,f) != 1) rc = -1;
+
+  if (WriteVector(f,fRunNumber    ,fNEntries) < 0) rc = -1;
+  if (WriteVector(f,fSectionNumber,fNEntries) < 0) rc = -1;
+  if (WriteVector(f,fEventNumber  ,fNEntries) < 0) rc = -1;
+
+  for (const Column_t& c : fColumn) {
+    int nv = c.fData.size();
+    if (WriteString(f,c.fName)                  < 0) rc = -1;
+    if (WriteString(f,c.fBranchName)            < 0) rc = -1;
+    if (fwrite(&c.fArray,sizeof(int),1,f)      != 1) rc = -1;
+    if (fwrite(&nv      ,sizeof(int),1,f)      != 1) rc = -1;
+    if (WriteVector(f,c.fData,nv)               < 0) rc = -1;
+    if (c.fArray && (WriteVector(f,c.fOffset,fNEntries+1) < 0)) rc = -1;
+  }
+
+  fclose(f);
+
+  if (rc == 0) rc = gSystem->Rename(tmp.Data(),fn.Data());
+
+  if (rc != 0) {
+    Error("Save","failed to write %s",fn.Data());
+    gSystem->Unlink(tmp.Data());
+    return -1;
+  }
+
+  printf(" >>> TStnEventCache::Save: %i entries, %i columns written to %s\n",
+	 fNEntries,nc,fn.Data());
+
+  fModified = 0;
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+// the cache file is accepted only if its key matches the current one, the
+// key includes the column definitions, so the columns are the same
+//-----------------------------------------------------------------------------
+int TStnEventCache::Load(const char* Filename) {
+  TString fn = (Filename) ? Filename : fFilename.Data();
+
+  FILE* f = fopen(fn.Data(),"r");
+  if (f == 0)                                                return -1;
+
+  int     magic(0), version(0), nentries(0), complete(0), nc(0);
+  TString key;
+  int     rc = 0;
+
+  if (fread(&magic  ,sizeof(int),1,f) != 1) rc = -1;
+  if (fread(&version,sizeof(int),1,f) != 1) rc = -1;
+
+  if ((rc < 0) || (magic != kMagic) || (version != kVersion)) {
+    Warning("Load","%s is not a cache file or has a wrong version, ignore",fn.Data());
+    fclose(f);
+    return -1;
+  }
+
+  if (ReadString(f,key)                   < 0) rc = -1;
+  if (fread(&nentries,sizeof(int),1,f)   != 1) rc = -1;
+  if (fread(&complete,sizeof(int),1,f)   != 1) rc = -1;
+  if (fread(&nc      ,sizeof(int),1,f)   != 1) rc = -1;
+
+  if ((rc < 0) || (key != fKey) || (nc != (int) fColumn.size())) {
+    printf(" >>> TStnEventCache::Load: %s is out of date, ignore\n",fn.Data());
+    fclose(f);
+    return -1;
+  }
+
+  if (ReadVector(f,fRunNumber    ,nentries) < 0) rc = -1;
+  if (ReadVector(f,fSectionNumber,nentries) < 0) rc = -1;
+  if (ReadVector(f,fEventNumber  ,nentries) < 0) rc = -1;
+
+  for (Column_t& c : fColumn) {
+    TString name, branch;
+    int     array(0), nv(0);
+
+    if (ReadString(f,name)                    < 0) rc = -1;
+    if (ReadString(f,branch)                  < 0) rc = -1;
+    if (fread(&array,sizeof(int),1,f)        != 1) rc = -1;
+    if (fread(&nv   ,sizeof(int),1,f)        != 1) rc = -1;
+
+    if ((rc < 0) || (name != c.fName) || (array != c.fArray) || (nv < 0)) {
+      rc = -1;
+      break;
+    }
+
+    if (ReadVector(f,c.fData,nv) < 0) rc = -1;
+    if (c.fArray) {
+      if (ReadVector(f,c.fOffset,nentries+1) < 0) rc = -1;
+    }
+    else if (nv != nentries) rc = -1;
+
+    if (rc < 0) break;
+  }
+
+  fclose(f);
+
+  if (rc < 0) {
+    Error("Load","%s is corrupted, ignore",fn.Data());
+    TString k = fKey;
+    Clear();
+    fKey = k;
+    return -1;
+  }
+
+  fNEntries = nentries;
+  fComplete = complete;
+  fModified = 0;
+
+  printf(" >>> TStnEventCache::Load: %i entries, %i columns read from %s\n",
+	 fNEntries,nc,fn.Data());
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+// drop the data, keep the column definitions
+//-----------------------------------------------------------------------------
+void TStnEventCache::Clear(Option_t* Opt) {
+  fRunNumber    .clear();
+  fSectionNumber.clear();
+  fEventNumber  .clear();
+
+  for (Column_t& c : fColumn) {
+    c.fData  .clear();
+    c.fOffset.clear();
+  }
+
+  fKey         = "";
+  fNEntries    = 0;
+  fComplete    = 0;
+  fModified    = 0;
+  fNFillErrors = 0;
+}
+
+//_____________________________________________________________________________
+void TStnEventCache::Print(Option_t* Opt) const {
+  double nbytes = 3*sizeof(int)*fNEntries;
+
+  printf(" ---- TStnEventCache: key %s entries: %i complete: %i file: %s\n",
+	 fKey.Data(),fNEntries,fComplete,fFilename.Data());
+  printf(" column               branch               type   N(values)\n");
+
+  for (const Column_t& c : fColumn) {
+    printf(" %-20s %-20s %-6s %10zu\n",
+	   c.fName.Data(),c.fBranchName.Data(),c.fArray ? "array" : "scalar",
+	   c.fData.size());
+    nbytes += c.fData.size()*sizeof(float)+c.fOffset.size()*sizeof(int);
+  }
+
+  printf(" total size: %10.3f MB, fill errors: %i\n",nbytes/1.e6,fNFillErrors);
+}
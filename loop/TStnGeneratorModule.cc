@@ -84,7 +84,7 @@ TStnNode* TStnGeneratorModule::GetNode(const char* BranchName,
   }
 
   node = new TStnNode(BranchName,cl,ev,func);
-  ev->GetListOfNodes()->Add(node);
+  ev->AddNode(node);
   return node;
 }
 
@@ -0,0 +1,196 @@
+//-----------------------------------------------------------------------------
+// flat-storage histogram sets, see comments in TStnHistSet.hh
+//-----------------------------------------------------------------------------
+#include <cmath>
+#include <cstdio>
+
+#include "TFolder.h"
+#include "TH1.h"
+#include "TH2.h"
+
+#include "Stntuple/loop/TStnHistSet.hh"
+
+//_____________________________________________________________________________
+TStnHistSetBase::TStnHistSetBase(const char* Prefix) {
+  fPrefix    = Prefix;
+  fSetSize   = 0;
+  fAllocated = 0;
+}
+
+//_____________________________________________________________________________
+TStnHistSetBase::~TStnHistSetBase() {
+}
+
+//_____________________________________________________________________________
+int TStnHistSetBase::Book1D(const char* Name, const char* Title,
+			    int Nx, double XMin, double XMax, int VarX) {
+  return Book2D(Name,Title,Nx,XMin,XMax,0,0,0,VarX,-1);
+}
+
+//-----------------------------------------------------------------------------
+// histograms can't be added after the first Fill
+//-----------------------------------------------------------------------------
+int TStnHistSetBase::Book2D(const char* Name, const char* Title,
+			    int Nx, double XMin, double XMax,
+			    int Ny, double YMin, double YMax, int VarX, int VarY) {
+  if (fAllocated) {
+    printf(" >>> ERROR TStnHistSet::Book: %s/%s booked after the first fill, ignore\n",
+	   fPrefix.Data(),Name);
+    return -1;
+  }
+
+  Hist_t h;
+  h.fName   = Name;
+  h.fTitle  = Title;
+  h.fDim    = (VarY < 0) ? 1 : 2;
+  h.fNx     = Nx;
+  h.fXMin   = XMin;
+  h.fXMax   = XMax;
+  h.fXScale = Nx/(XMax-XMin);
+  h.fNy     = Ny;
+  h.fYMin   = YMin;
+  h.fYMax   = YMax;
+  h.fYScale = (h.fDim == 2) ? Ny/(YMax-YMin) : 0;
+  h.fVarX   = VarX;
+  h.fVarY   = VarY;
+  h.fOffset = 0;
+  h.fSize   = kNStat + ((h.fDim == 1) ? (Nx+2) : (Nx+2)*(Ny+2));
+
+  fHist.push_back(h);
+  return fHist.size()-1;
+}
+
+//_____________________________________________________________________________
+int TStnHistSetBase::AddSetDefinition(int Index, const char* Comment) {
+  if (fAllocated) {
+    printf(" >>> ERROR TStnHistSet::AddSet: %s_%i defined after the first fill, ignore\n",
+	   fPrefix.Data(),Index);
+    return -1;
+  }
+
+  Set_t s;
+  s.fIndex   = Index;
+  s.fFolder  = Form("%s_%i",fPrefix.Data(),Index);
+  s.fComment = Comment;
+  s.fOffset  = 0;
+
+  fSet.push_back(s);
+  return fSet.size()-1;
+}
+
+//_____________________________________________________________________________
+void TStnHistSetBase::Allocate() {
+  fSetSize = 0;
+  for (Hist_t& h : fHist) {
+    h.fOffset  = fSetSize;
+    fSetSize  += h.fSize;
+  }
+
+  int ns = fSet.size();
+  for (int i=0; i<ns; i++) fSet[i].fOffset = i*fSetSize;
+
+  fData.assign(ns*fSetSize,0);
+  fValue.assign(fVarName.size(),0);
+
+  fAllocated = 1;
+}
+
+//_____________________________________________________________________________
+void TStnHistSetBase::Reset() {
+  fData.assign(fData.size(),0);
+}
+
+//-----------------------------------------------------------------------------
+// same binning as TAxis::FindBin for the fixed bins, statistics - only for
+// the values within the histogram range, as TH1::Fill does
+//-----------------------------------------------------------------------------
+void TStnHistSetBase::FillSet(int ISet) {
+  double* data = &fData[fSet[ISet].fOffset];
+
+  for (const Hist_t& h : fHist) {
+    double* d = data+h.fOffset;
+    double  x = fValue[h.fVarX];
+
+    if (std::isnan(x))                                      continue;
+    if ((h.fDim == 2) && std::isnan(fValue[h.fVarY]))       continue;
+
+    int ix;
+    if      (x <  h.fXMin) ix = 0;
+    else if (x >= h.fXMax) ix = h.fNx+1;
+    else                   ix = 1+(int) ((x-h.fXMin)*h.fXScale);
+
+    d[0] += 1;				// entries
+
+    if (h.fDim == 1) {
+      d[kNStat+ix] += 1;
+      if ((ix > 0) && (ix <= h.fNx)) {
+	d[1] += 1;  d[2] += 1;
+	d[3] += x;  d[4] += x*x;
+      }
+    }
+    else {
+      double y = fValue[h.fVarY];
+
+      int iy;
+      if      (y <  h.fYMin) iy = 0;
+      else if (y >= h.fYMax) iy = h.fNy+1;
+      else                   iy = 1+(int) ((y-h.fYMin)*h.fYScale);
+
+      d[kNStat+ix+(h.fNx+2)*iy] += 1;
+      if ((ix > 0) && (ix <= h.fNx) && (iy > 0) && (iy <= h.fNy)) {
+	d[1] += 1;  d[2] += 1;
+	d[3] += x;  d[4] += x*x;
+	d[5] += y;  d[6] += y*y;
+	d[7] += x*y;
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+// existing histograms (a second call, for example after Continue) are reset
+// and refilled
+//-----------------------------------------------------------------------------
+int TStnHistSetBase::MakeHistograms(TFolder* HistFolder) {
+  if (! fAllocated) Allocate();
+
+  for (const Set_t& s : fSet) {
+    TFolder* fol = (TFolder*) HistFolder->FindObject(s.fFolder.Data());
+    if (! fol) fol = HistFolder->AddFolder(s.fFolder.Data(),s.fFolder.Data());
+
+    const double* data = &fData[s.fOffset];
+
+    for (const Hist_t& h : fHist) {
+      const double* d = data+h.fOffset;
+
+      TH1* hist = (TH1*) fol->FindObject(h.fName.Data());
+      if (hist == nullptr) {
+	TString title = Form("Hist/%s: %s",s.fFolder.Data(),h.fTitle.Data());
+	if (h.fDim == 1) {
+	  hist = new TH1F(h.fName.Data(),title.Data(),h.fNx,h.fXMin,h.fXMax);
+	}
+	else {
+	  hist = new TH2F(h.fName.Data(),title.Data(),
+			  h.fNx,h.fXMin,h.fXMax,h.fNy,h.fYMin,h.fYMax);
+	}
+	fol->Add(hist);
+      }
+      else {
+	hist->Reset();
+      }
+
+      int nbins = h.fSize-kNStat;
+      for (int i=0; i<nbins; i++) {
+	if (d[kNStat+i] != 0) hist->SetBinContent(i,d[kNStat+i]);
+      }
+
+      double stats[7];
+      for (int i=0; i<7; i++) stats[i] = d[i+1];
+
+      hist->SetEntries(d[0]);
+      hist->PutStats(stats);
+    }
+  }
+
+  return 0;
+}
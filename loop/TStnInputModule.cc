@@ -163,6 +163,31 @@ int TStnInputModule::NextEvent(Int_t IEntry) {
   return LoadEntry(IEntry);
 }
 
+//-----------------------------------------------------------------------------
+// file names, sizes, modification times (local files only) and numbers of
+// entries of the chained files
+//-----------------------------------------------------------------------------
+TString TStnInputModule::CacheKey() {
+  TString   key;
+  Long_t    id, flags, mtime;
+  Long64_t  size;
+
+  if (fChain) {
+    TObjArrayIter it(fChain->GetListOfFiles());
+    while (TChainElement* ce = (TChainElement*) it.Next()) {
+      key += ce->GetTitle();
+      if (gSystem->GetPathInfo(ce->GetTitle(),&id,&size,&flags,&mtime) == 0) {
+	key += Form(":%lld:%ld",size,mtime);
+      }
+      key += Form(":%lld;",ce->GetEntries());
+    }
+  }
+
+  key += Form("entries:%.0f;",GetEntries());
+
+  return key;
+}
+
 //_____________________________________________________________________________
 int TStnInputModule::FindEvent(Int_t Run, Int_t Event) {
   return 0;
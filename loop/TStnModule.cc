@@ -38,6 +38,7 @@ TStnModule::TStnModule()
   fPassed            =  1;
   fFolder            =  0;
   fListOfL3TrigNames =  0;
+  fNNameLookups      =  0;
   for (int i=0; i<kNDebugBits; i++) fDebugBit[i] = 0;
 }
 
@@ -75,6 +76,7 @@ TStnModule::TStnModule(const char* name, const char* title):TNamed(name,title)
 
   fListOfL3TrigNames = new TObjArray();
   fListOfL3Triggers  = new TObjArray();
+  fNNameLookups      = 0;
 
   for (int i=0; i<kNDebugBits; i++) fDebugBit[i] = 0;
 }
@@ -85,6 +87,7 @@ TStnModule::~TStnModule() {
   // added to it... derived classes should not delete objecs added to fFolder
 
   delete fFolder;
+  for (TStnHistSetBase* hs : fListOfHistSets) delete hs;
   fListOfL3TrigNames->Delete();
   delete fListOfL3TrigNames;
   fListOfL3Triggers->Delete();
@@ -203,6 +206,16 @@ int TStnModule::EndJob() {
   return 0;
 }
 
+//_____________________________________________________________________________
+int TStnModule::DefineCacheColumns(TStnEventCache* Cache) {
+  return 0;
+}
+
+//_____________________________________________________________________________
+int TStnModule::EventFromCache(TStnEventCache* Cache, Int_t Entry) {
+  return 0;
+}
+
 //_____________________________________________________________________________
 TCanvas* TStnModule::NewSlide(const char* name, 
 			      const char* title, 
@@ -264,6 +277,22 @@ void     TStnModule::AddHistogram(TObject* hist, const char* FolderName) {
   fol->Add(hist); 
 }
 
+//_____________________________________________________________________________
+int TStnModule::MakeHistSetHistograms() {
+  if (fListOfHistSets.size() == 0)                          return 0;
+
+  TFolder* hist_folder = (TFolder*) fFolder->FindObject("Hist");
+  if (hist_folder == 0) {
+    Error("MakeHistSetHistograms","module %s: no \"Hist\" folder",GetName());
+    return -1;
+  }
+
+  for (TStnHistSetBase* hs : fListOfHistSets) {
+    hs->MakeHistograms(hist_folder);
+  }
+  return 0;
+}
+
 //_____________________________________________________________________________
 void TStnModule::HBook1F(TH1F*& Hist, const char* Name, const char* Title,
 			 Int_t Nx, Double_t XMin, Double_t XMax,
@@ -6,6 +6,9 @@
 #include "TObjString.h"
 #include "TChain.h"
 #include "TFile.h"
+#include "TTree.h"
+
+#include "Stntuple/base/TStnIOProfile.hh"
 
 #include "Stntuple/obj/TStnEvent.hh"
 #include "Stntuple/obj/TStnNode.hh"
@@ -28,6 +31,15 @@ TStnOutputModule::TStnOutputModule(const char* FileName):
   fDropList     = new TObjArray(10);
   fKeepList     = new TObjArray(10);
   fTree         = 0; 
+
+  fListOfIOProfiles      = new TObjArray(10);
+  fListOfBlockIOProfiles = new TObjArray(10);
+  fIOMeasurement         = 0;
+
+  fCopyMode              = kRestream;
+  fNFastCopied           = 0;
+  fNSlowCopied           = 0;
+
   TTree::SetMaxTreeSize(8000000000LL);
 }
 
@@ -39,6 +51,10 @@ TStnOutputModule::~TStnOutputModule()
   delete fDropList;
   fKeepList->Delete();
   delete fKeepList;
+  fListOfIOProfiles->Delete();
+  delete fListOfIOProfiles;
+  fListOfBlockIOProfiles->Delete();
+  delete fListOfBlockIOProfiles;
   //delete fTree;   // Pasha could you explain this to me?
   if (fFile)
     fFile->Close();
@@ -58,46 +74,66 @@ int TStnOutputModule::OpenNewFile(const char* Filename)
   fFile = new TFile(Filename,"recreate");
 
   if (fFile->IsOpen()) {
+    if (fCopyMode == kFastCopy) {
+					// the output tree is cloned from 
+					// the first copied input one
+      fTree = nullptr;
+    }
+    else {
 				// clone input tree
-    fTree = new TTree("STNTUPLE","STNTUPLE");
+      fTree = new TTree("STNTUPLE","STNTUPLE");
 					// now need to loop over all the 
 					// branches of the input tree and
 					// register the corresponding blocks
-    TObjArray* list = GetAna()->GetEvent()->GetListOfOutputNodes();
-    TIter it(list);
+      TObjArray* list = GetAna()->GetEvent()->GetListOfOutputNodes();
+      TIter it(list);
 
-    TBranch*          input_branch;
-    TBranch*          output_branch;
-    TStnNode*         node;
-    const char*       class_name;
-    const char*       branch_name;
-    Int_t             basket_size, comp_level;
+      TBranch*          input_branch;
+      TBranch*          output_branch;
+      TStnNode*         node;
+      const char*       class_name;
+      const char*       branch_name;
+      Int_t             basket_size, comp_settings;
+      TStnIOProfile*    profile;
 
-    while ((node = (TStnNode*) it.Next())) {
-      branch_name  = node->GetName();
-      input_branch = node->GetBranch();
-      class_name   = node->GetDataBlock()->ClassName();
+      while ((node = (TStnNode*) it.Next())) {
+	branch_name  = node->GetName();
+	input_branch = node->GetBranch();
+	class_name   = node->GetDataBlock()->ClassName();
 
 					// take split parameter from the input
 					// at a time of the 1st implementation
 					// this was not possible
-      if (input_branch) {
-	basket_size = input_branch->GetBasketSize();
-	comp_level  = input_branch->GetCompressionLevel();
-	split_level = input_branch->GetSplitLevel();
-      }
-      else {
+	if (input_branch) {
+	  basket_size   = input_branch->GetBasketSize();
+	  comp_settings = input_branch->GetCompressionSettings();
+	  split_level   = input_branch->GetSplitLevel();
+	}
+	else {
 					// non-split by default....
-	basket_size = 64000;
-	comp_level  =  1;
-	split_level = -1;
+	  basket_size   = 64000;
+	  comp_settings =  1;
+	  split_level   = -1;
+	}
+					// I/O profile, if defined, has priority
+	profile = GetBlockIOProfile(branch_name);
+	if (profile) {
+	  if (profile->BasketSize() >  0) basket_size = profile->BasketSize();
+	  if (profile->SplitLevel() >= 0) split_level = profile->SplitLevel();
+	  comp_settings = profile->CompressionSettings();
+	}
+
+	output_branch = fTree->Branch(branch_name,class_name,
+				      node->GetDataBlockAddress(),
+				      basket_size,
+				      split_level);
+	output_branch->SetCompressionSettings(comp_settings);
+	output_branch->SetAutoDelete(kFALSE);
       }
-      output_branch = fTree->Branch(branch_name,class_name,
-				    node->GetDataBlockAddress(),
-				    basket_size,
-				    split_level);
-      output_branch->SetCompressionLevel(comp_level);
-      output_branch->SetAutoDelete(kFALSE);
+					// auto-flush is a tree parameter, 
+					// take it from the default profile
+      profile = GetBlockIOProfile("*");
+      if (profile && (profile->AutoFlush() != 0)) fTree->SetAutoFlush(profile->AutoFlush());
     }
 					// create DB area
     fFile->mkdir("db");
@@ -134,6 +170,13 @@ int TStnOutputModule::BeginJob()
     printf(" ============ %s \n",GetName());
     printf(" maxfilesize = %i\n",fMaxFileSize);
   }
+//-----------------------------------------------------------------------------
+// fast copy needs the input files, the MC generator input module has none
+//-----------------------------------------------------------------------------
+  if ((fCopyMode == kFastCopy) && (GetAna()->GetInputModule()->GetChain() == nullptr)) {
+    Warning("BeginJob","no input chain, kFastCopy mode not possible, use kRestream");
+    fCopyMode = kRestream;
+  }
 
   return OpenNewFile(fFileName.Data());
 }
@@ -177,6 +220,22 @@ int TStnOutputModule::Event(Int_t I) {
 
   int rc = 0;
 //-----------------------------------------------------------------------------
+// kFastCopy: don't read the event, just remember the entry number. Copy 
+// the selected entries of the previous input file when the file changes
+//-----------------------------------------------------------------------------
+  if (fCopyMode == kFastCopy) {
+    const char* fn = GetAna()->GetInputModule()->GetChain()->GetFile()->GetName();
+    if (fInputFileName != fn) {
+      rc = CopyInputFile();
+      fInputFileName = fn;
+      if (fFile->GetBytesWritten()/1000000 >= fMaxFileSize) {
+	rc = OpenNextFile();
+      }
+    }
+    fSelectedEntries.push_back(I);
+    return rc;
+  }
+//-----------------------------------------------------------------------------
 // This place looks very kludgy - and I don't like it very much...
 // assume that the header block has already been read in, such that 
 // TStnEvent::fCurentEntry is set correctly. make sure we read the whole event
@@ -187,28 +246,112 @@ int TStnOutputModule::Event(Int_t I) {
   if (mbytes_written >= fMaxFileSize) {
 					// file is ALREADY too large, close it
 					// event "I" goes into the next file
-    fFile->Write();
-    fFile->Close();
-    delete fFile;
+    rc = OpenNextFile();
+  }
+					// and, finally, write out the event
+  fTree->Fill();
+
+  return rc;
+}
+
+//_____________________________________________________________________________
+int TStnOutputModule::OpenNextFile() {
+  int rc;
+
+  fFile->Write();
+  fFile->Close();
+  delete fFile;
 				// rename the old file into x.00
-    if (fFileNumber == 0) {
-      gSystem->Exec(Form("mv %s %s.00",fFileName.Data(),fFileName.Data()));
-    }
+  if (fFileNumber == 0) {
+    gSystem->Exec(Form("mv %s %s.00",fFileName.Data(),fFileName.Data()));
+  }
 
-    fFileNumber++;
+  fFileNumber++;
 					// now open the new file
 
-    rc = OpenNewFile(Form("%s.%02i",fFileName.Data(),fFileNumber));
+  rc = OpenNewFile(Form("%s.%02i",fFileName.Data(),fFileNumber));
 
 					// create proper DB subdirectory
-    BeginRun();
-  }
-					// and, finally, write out the event
-  fTree->Fill();
+  BeginRun();
 
   return rc;
 }
 
+//_____________________________________________________________________________
+int TStnOutputModule::CopyInputFile() {
+  // kFastCopy mode: copy selected entries of fInputFileName into the output 
+  // tree. The output tree is created as an empty clone of the first copied 
+  // input tree, so its branches have the input basket sizes. CloneTree 
+  // resets the compression to the output file default, so the per-branch 
+  // settings of the input (or of the I/O profile) are set again
+
+  Long64_t nsel = fSelectedEntries.size();
+  if (nsel == 0)                                            return 0;
+
+  TDirectory* dir = gDirectory;
+
+  TFile* f = TFile::Open(fInputFileName.Data());
+  TTree* t = f ? (TTree*) f->Get("STNTUPLE") : nullptr;
+
+  if (t == nullptr) {
+    Error("CopyInputFile","can't read STNTUPLE from %s, %lli events lost",
+	  fInputFileName.Data(),nsel);
+    fSelectedEntries.clear();
+    if (f) delete f;
+    dir->cd();
+    return -1;
+  }
+//-----------------------------------------------------------------------------
+// copy only the branches of the output nodes (drop/keep lists)
+//-----------------------------------------------------------------------------
+  t->SetBranchStatus("*",0);
+  TIter it(GetAna()->GetEvent()->GetListOfOutputNodes());
+  while (TStnNode* node = (TStnNode*) it.Next()) {
+    if (t->GetBranch(node->GetName())) t->SetBranchStatus(node->GetName(),1);
+  }
+
+  fFile->cd();
+  if (fTree == nullptr) {
+    fTree = t->CloneTree(0);
+    fTree->SetDirectory(fFile);
+					// the input tree is deleted below
+    if (t->GetListOfClones()) t->GetListOfClones()->Remove(fTree);
+
+    TIter ib(fTree->GetListOfBranches());
+    while (TBranch* output_branch = (TBranch*) ib.Next()) {
+      TBranch*       input_branch = t->GetBranch(output_branch->GetName());
+      TStnIOProfile* profile      = GetBlockIOProfile(output_branch->GetName());
+      if      (profile     ) output_branch->SetCompressionSettings(profile->CompressionSettings());
+      else if (input_branch) output_branch->SetCompressionSettings(input_branch->GetCompressionSettings());
+    }
+  }
+//-----------------------------------------------------------------------------
+// the whole file selected: copy compressed baskets, no unzipping/streaming
+// otherwise copy the selected entries one by one
+//-----------------------------------------------------------------------------
+  if (nsel == t->GetEntries()) {
+    fTree->CopyEntries(t,-1,"fast");
+    fNFastCopied += nsel;
+  }
+  else {
+    t->GetEntry(fSelectedEntries[0]);
+    t->CopyAddresses(fTree);
+    for (Long64_t entry : fSelectedEntries) {
+      t->GetEntry(entry);
+      fTree->Fill();
+    }
+    t->CopyAddresses(fTree,kTRUE);
+    fNSlowCopied += nsel;
+  }
+
+  fTree->ResetBranchAddresses();
+  delete f;
+
+  fSelectedEntries.clear();
+  dir->cd();
+  return 0;
+}
+
 //_____________________________________________________________________________
 int TStnOutputModule::EndRun()
 {
@@ -218,6 +361,17 @@ int TStnOutputModule::EndRun()
 //_____________________________________________________________________________
 int TStnOutputModule::EndJob()
 {
+  if (fCopyMode == kFastCopy) {
+    CopyInputFile();
+    printf(" TStnOutputModule::EndJob: entries copied fast: %lli, entry by entry: %lli\n",
+	   fNFastCopied,fNSlowCopied);
+  }
+
+  if (fIOMeasurement && fTree) {
+    printf(" TStnOutputModule::EndJob: I/O statistics for %s\n",fFile->GetName());
+    TStnIOProfile::PrintIOStat(fTree);
+  }
+
   fFile->Write();
   fFile->Close();
   return 0;
@@ -232,3 +386,38 @@ void TStnOutputModule::DropDataBlock(const char* name) {
 void TStnOutputModule::KeepDataBlock(const char* name) {
   fKeepList->Add(new TObjString(name));
 }
+
+//_____________________________________________________________________________
+void TStnOutputModule::AddIOProfile(TStnIOProfile* Profile) {
+  if (GetIOProfile(Profile->GetName())) {
+    Error("AddIOProfile","profile %s already defined, ignore",Profile->GetName());
+    delete Profile;
+    return;
+  }
+  fListOfIOProfiles->Add(Profile);
+}
+
+//_____________________________________________________________________________
+void TStnOutputModule::SetBlockIOProfile(const char* BlockName, const char* ProfileName) {
+  TNamed* n = (TNamed*) fListOfBlockIOProfiles->FindObject(BlockName);
+  if (n) n->SetTitle(ProfileName);
+  else   fListOfBlockIOProfiles->Add(new TNamed(BlockName,ProfileName));
+}
+
+//_____________________________________________________________________________
+TStnIOProfile* TStnOutputModule::GetIOProfile(const char* ProfileName) {
+  return (TStnIOProfile*) fListOfIOProfiles->FindObject(ProfileName);
+}
+
+//_____________________________________________________________________________
+TStnIOProfile* TStnOutputModule::GetBlockIOProfile(const char* BlockName) {
+  TNamed* n = (TNamed*) fListOfBlockIOProfiles->FindObject(BlockName);
+  if (n == 0) n = (TNamed*) fListOfBlockIOProfiles->FindObject("*");
+  if (n == 0) return 0;
+
+  TStnIOProfile* p = GetIOProfile(n->GetTitle());
+  if (p == 0) {
+    Warning("GetBlockIOProfile","block %s: profile %s not defined",BlockName,n->GetTitle());
+  }
+  return p;
+}
@@ -0,0 +1,351 @@
+//-----------------------------------------------------------------------------
+// TStnAna profiler, see comments in TStnProfiler.hh
+//-----------------------------------------------------------------------------
+#include <ctime>
+#include <cstdio>
+#include <unistd.h>
+
+#include "TTree.h"
+
+#include "Stntuple/obj/TStnNode.hh"
+#include "Stntuple/loop/TStnProfiler.hh"
+
+ClassImp(TStnProfiler)
+
+TStnProfiler* TStnProfiler::fgActive = nullptr;
+
+//_____________________________________________________________________________
+TStnProfiler::TStnProfiler(const char* Name, int Sampling):
+  TNamed(Name,"TStnAna profiler")
+{
+  fSampling   = (Sampling > 0) ? Sampling : 1;
+  fMeasureRss = 1;
+  fPageSize   = sysconf(_SC_PAGESIZE);
+  fStackFile  = "stnana_profile.folded";
+
+  Clear();
+}
+
+//_____________________________________________________________________________
+TStnProfiler::~TStnProfiler() {
+  if (fgActive == this) {
+    fgActive = nullptr;
+    TStnNode::SetReadMonitor(nullptr);
+  }
+}
+
+//_____________________________________________________________________________
+void TStnProfiler::Clear(Option_t* Opt) {
+  fScope.clear();
+  fStack.clear();
+  fNEvents   = 0;
+  fNSampled  = 0;
+  fActive    = 0;
+					// scope 0: root
+  Scope_t root;
+  root.fName   = "TStnAna";
+  root.fParent = -1;
+  root.fDepth  = 0;
+  root.fNCalls = 0;
+  root.fCpu    = 0;
+  root.fWall   = 0;
+  root.fBytes  = 0;
+  root.fRss    = 0;
+  fScope.push_back(root);
+
+  fEventScope    = FindScope("Event"   ,0);
+  fBeginRunScope = FindScope("BeginRun",0);
+}
+
+//_____________________________________________________________________________
+double TStnProfiler::CpuTime() {
+  timespec ts;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID,&ts);
+  return ts.tv_sec+ts.tv_nsec*1.e-9;
+}
+
+//_____________________________________________________________________________
+double TStnProfiler::WallTime() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC,&ts);
+  return ts.tv_sec+ts.tv_nsec*1.e-9;
+}
+
+//-----------------------------------------------------------------------------
+// resident set size, bytes
+//-----------------------------------------------------------------------------
+long TStnProfiler::Rss() const {
+  long size(0), rss(0);
+
+  FILE* f = fopen("/proc/self/statm","r");
+  if (f == nullptr)                                         return 0;
+  if (fscanf(f,"%ld %ld",&size,&rss) != 2) rss = 0;
+  fclose(f);
+
+  return rss*fPageSize;
+}
+
+//_____________________________________________________________________________
+int TStnProfiler::FindScope(const char* Name, int Parent) {
+
+  Scope_t* p = &fScope[Parent];
+
+  auto it = p->fChild.find(Name);
+  if (it != p->fChild.end()) return it->second;
+
+  int index = fScope.size();
+  p->fChild[Name] = index;
+
+  Scope_t s;
+  s.fName   = Name;
+  s.fParent = Parent;
+  s.fDepth  = p->fDepth+1;
+  s.fNCalls = 0;
+  s.fCpu    = 0;
+  s.fWall   = 0;
+  s.fBytes  = 0;
+  s.fRss    = 0;
+					// invalidates p
+  fScope.push_back(s);
+
+  return index;
+}
+
+//-----------------------------------------------------------------------------
+// the data block read monitor is installed only for the sampled events,
+// so the non-sampled events are not slowed down
+//-----------------------------------------------------------------------------
+int TStnProfiler::BeginEvent() {
+  fNEvents += 1;
+  fActive   = ((fNEvents-1) % fSampling == 0);
+
+  if (fActive) {
+    fNSampled += 1;
+    fgActive   = this;
+    TStnNode::SetReadMonitor(TStnProfiler::ReadMonitor);
+  }
+
+  return fActive;
+}
+
+//_____________________________________________________________________________
+void TStnProfiler::EndEvent() {
+  if (! fActive)                                            return;
+					// close scopes left open by an
+					// early return
+  while (fStack.size() > 0) End();
+
+  TStnNode::SetReadMonitor(nullptr);
+  fgActive = nullptr;
+  fActive  = 0;
+}
+
+//_____________________________________________________________________________
+void TStnProfiler::Begin(int Scope) {
+  if (! fActive)                                            return;
+
+  Frame_t f;
+  f.fScope = Scope;
+  f.fRss0  = fMeasureRss ? Rss() : 0;
+  f.fCpu0  = CpuTime ();
+  f.fWall0 = WallTime();
+
+  fStack.push_back(f);
+}
+
+//_____________________________________________________________________________
+void TStnProfiler::End() {
+  if ((! fActive) || (fStack.size() == 0))                  return;
+
+  double cpu  = CpuTime ();
+  double wall = WallTime();
+
+  Frame_t& f  = fStack.back();
+  Scope_t& s  = fScope[f.fScope];
+
+  s.fNCalls  += 1;
+  s.fCpu     += cpu -f.fCpu0;
+  s.fWall    += wall-f.fWall0;
+  if (fMeasureRss) s.fRss += Rss()-f.fRss0;
+
+  fStack.pop_back();
+}
+
+//-----------------------------------------------------------------------------
+// NBytes < 0: before the read, otherwise - after, NBytes = N(bytes) read
+// data block reads don't measure RSS, that would cost more than the read
+// reads outside of any module (event header) go to the "Event" scope
+//-----------------------------------------------------------------------------
+void TStnProfiler::ReadMonitor(TStnNode* Node, Int_t NBytes) {
+  TStnProfiler* p = fgActive;
+  if (p == nullptr)                                         return;
+
+  if (NBytes < 0) {
+    int parent = (p->fStack.size() > 0) ? p->fStack.back().fScope : p->fEventScope;
+
+    auto it = p->fScope[parent].fNodeChild.find(Node);
+    int  index;
+    if (it != p->fScope[parent].fNodeChild.end()) index = it->second;
+    else {
+      index = p->FindScope(Node->GetName(),parent);
+      p->fScope[parent].fNodeChild[Node] = index;
+    }
+
+    Frame_t f;
+    f.fScope = index;
+    f.fRss0  = 0;
+    f.fCpu0  = CpuTime ();
+    f.fWall0 = WallTime();
+    p->fStack.push_back(f);
+  }
+  else {
+    if (p->fStack.size() == 0)                              return;
+
+    Frame_t& f = p->fStack.back();
+    Scope_t& s = p->fScope[f.fScope];
+
+    s.fNCalls += 1;
+    s.fCpu    += CpuTime ()-f.fCpu0;
+    s.fWall   += WallTime()-f.fWall0;
+    s.fBytes  += NBytes;
+
+    p->fStack.pop_back();
+  }
+}
+
+//-----------------------------------------------------------------------------
+// self time: time of the scope minus time of its children. Root and the
+// top level scopes (Event, BeginRun) are not timed themselves, only
+// their children
+//-----------------------------------------------------------------------------
+double TStnProfiler::SelfCpu(int I) const {
+  const Scope_t& s = fScope[I];
+  if (s.fNCalls == 0)                                       return 0;
+
+  double t = s.fCpu;
+  for (auto& c : s.fChild) t -= fScope[c.second].fCpu;
+  return (t > 0) ? t : 0;
+}
+
+//_____________________________________________________________________________
+double TStnProfiler::SelfWall(int I) const {
+  const Scope_t& s = fScope[I];
+  if (s.fNCalls == 0)                                       return 0;
+
+  double t = s.fWall;
+  for (auto& c : s.fChild) t -= fScope[c.second].fWall;
+  return (t > 0) ? t : 0;
+}
+
+//_____________________________________________________________________________
+std::string TStnProfiler::Path(int I) const {
+  std::string path = fScope[I].fName;
+  for (int i=fScope[I].fParent; i>=0; i=fScope[i].fParent) {
+    path = fScope[i].fName+";"+path;
+  }
+  return path;
+}
+
+//-----------------------------------------------------------------------------
+// one line per scope: "TStnAna;Event;Module;Block <self wall time, us>"
+//-----------------------------------------------------------------------------
+int TStnProfiler::WriteCollapsedStacks(const char* Filename) const {
+  const char* fn = (Filename) ? Filename : fStackFile.Data();
+
+  FILE* f = fopen(fn,"w");
+  if (f == nullptr) {
+    Error("WriteCollapsedStacks","can't open %s",fn);
+    return -1;
+  }
+
+  int ns = fScope.size();
+  for (int i=1; i<ns; i++) {
+    long us = (long) (SelfWall(i)*1.e6+0.5);
+    if (us > 0) fprintf(f,"%s %ld\n",Path(i).data(),us);
+  }
+
+  fclose(f);
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+// the tree is not attached to any file, the caller owns it
+//-----------------------------------------------------------------------------
+TTree* TStnProfiler::MakeSummaryTree(const char* Name) const {
+  char    name[1000];
+  Int_t   parent, depth, ncalls;
+  Float_t cpu, wall, self_cpu, self_wall, mbytes, rss_mb;
+
+  TTree* t = new TTree(Name,"TStnAna profile");
+  t->SetDirectory(0);
+
+  t->Branch("name"     ,name      ,"name/C"     );
+  t->Branch("parent"   ,&parent   ,"parent/I"   );
+  t->Branch("depth"    ,&depth    ,"depth/I"    );
+  t->Branch("ncalls"   ,&ncalls   ,"ncalls/I"   );
+  t->Branch("cpu"      ,&cpu      ,"cpu/F"      );
+  t->Branch("wall"     ,&wall     ,"wall/F"     );
+  t->Branch("self_cpu" ,&self_cpu ,"self_cpu/F" );
+  t->Branch("self_wall",&self_wall,"self_wall/F");
+  t->Branch("mbytes"   ,&mbytes   ,"mbytes/F"   );
+  t->Branch("rss_mb"   ,&rss_mb   ,"rss_mb/F"   );
+
+  int ns = fScope.size();
+  for (int i=0; i<ns; i++) {
+    const Scope_t& s = fScope[i];
+    snprintf(name,sizeof(name),"%s",Path(i).data());
+    parent    = s.fParent;
+    depth     = s.fDepth;
+    ncalls    = s.fNCalls;
+    cpu       = s.fCpu;
+    wall      = s.fWall;
+    self_cpu  = SelfCpu (i);
+    self_wall = SelfWall(i);
+    mbytes    = s.fBytes/1.e6;
+    rss_mb    = s.fRss/1.e6;
+    t->Fill();
+  }
+
+  return t;
+}
+
+//_____________________________________________________________________________
+void TStnProfiler::Print(Option_t* Opt) const {
+
+  printf(" >>> TStnProfiler: N(events) = %i, N(sampled) = %i, sampling = 1/%i\n",
+	 fNEvents,fNSampled,fSampling);
+  printf("-----------------------------------------------------------------------------");
+  printf("---------------------------------------\n");
+  printf(" scope                               ncalls  cpu/call(ms) wall/call(ms)");
+  printf("  cpu(s)  wall(s) self(s)  MB read   dRSS(MB)\n");
+  printf("-----------------------------------------------------------------------------");
+  printf("---------------------------------------\n");
+//-----------------------------------------------------------------------------
+// depth-first, children in the order of their names
+//-----------------------------------------------------------------------------
+  std::vector<int> stack;
+  stack.push_back(0);
+
+  while (stack.size() > 0) {
+    int i = stack.back();
+    stack.pop_back();
+
+    const Scope_t& s = fScope[i];
+    for (auto it=s.fChild.rbegin(); it!=s.fChild.rend(); ++it) stack.push_back(it->second);
+
+    if (i == 0)                                             continue;
+
+    std::string name = std::string(2*(s.fDepth-1),' ')+s.fName;
+    if (s.fNCalls == 0) {
+      printf(" %-34s\n",name.data());
+      continue;
+    }
+
+    printf(" %-34s %8i %12.4f %12.4f %8.2f %8.2f %7.2f %9.2f %9.2f\n",
+	   name.data(),s.fNCalls,
+	   s.fCpu/s.fNCalls*1.e3,s.fWall/s.fNCalls*1.e3,
+	   s.fCpu,s.fWall,SelfWall(i),s.fBytes/1.e6,s.fRss/1.e6);
+  }
+  printf("-----------------------------------------------------------------------------");
+  printf("---------------------------------------\n");
+}
@@ -127,7 +127,7 @@ TStnNode* TStnRun2InputModule::GetNode(const char* BranchName,
 				// 
 
   node         = new TStnNode(BranchName,cl,ev);
-  ev->GetListOfNodes()->Add(node);
+  ev->AddNode(node);
   return node;
 }
 
@@ -258,6 +258,23 @@ int TStnRun2InputModule::BeginJob() {
   return 0;
 }
 
+//-----------------------------------------------------------------------------
+// the chain is rebuilt from the datasets in BeginJob: add the dataset names
+// and the split, the chained files alone don't tell which job this is
+//-----------------------------------------------------------------------------
+TString TStnRun2InputModule::CacheKey() {
+  TString key = TStnInputModule::CacheKey();
+
+  TListIter it(fDatasetList);
+  while (TStnDataset* ds = (TStnDataset*) it.Next()) {
+    key += Form("dataset:%s;",ds->GetName());
+  }
+
+  key += Form("split:%i/%i;",fSplitInd,fSplitTot);
+
+  return key;
+}
+
 //_____________________________________________________________________________
 int TStnRun2InputModule::BeginRun() {
   return 0;
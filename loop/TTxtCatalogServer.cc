@@ -277,11 +277,15 @@ int TTxtCatalogServer::InitDataset(TStnDataset*     Dataset,
     cmd = Form("ls -al %s | grep %s | awk '{print $9}'",dir,File);
     pipe = gSystem->OpenPipe(cmd,"r");
 
+    std::vector<TString> names;
     while (fgets(buf,10000,pipe)) { 
       sscanf(buf,"%s",fn);
       sprintf(fs,"%s/%s",dir,fn);
-      Dataset->AddFile(fs);
+      names.push_back(fs);
     }
+    gSystem->ClosePipe(pipe);
+					// files are probed in parallel
+    Dataset->AddFiles(names);
     return 0;
   }
 
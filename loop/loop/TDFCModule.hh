@@ -1,11 +1,16 @@
 #ifndef TDFCModule_hh
 #define TDFCModule_hh
 
+#include <set>
 #include <vector>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include "TUrl.h"
 #include "Stntuple/loop/TStnModule.hh"
 
 class TFile;
+class TStnFileSummary;
 
 class TDFCModule: public TStnModule {
   // everything is public, it is communism
@@ -16,7 +21,23 @@ public:
     Int_t       fNEvents;               // number of events
     Int_t       fLoEvent;	        // low event number
     Int_t       fHiEvent;	        // high event number
-    std::vector<int> fListOfRunSections;     // run section ranges
+    std::set<int> fListOfRunSections;   // run sections, ordered
+  };
+					// CatalogFiles bookkeeping, shared by
+					// the worker threads
+  struct CatalogStat_t {
+    std::atomic<int>         fNext;		// next file to catalog
+    int                      fNextOutput;	// next file to print, under fMutex
+    int                      fNBad;
+    int                      fNSummary;
+    std::mutex               fMutex;
+    std::condition_variable  fCondition;
+  };
+					// where the catalog information came from
+  enum {
+    kEventLoop  = 0,
+    kSummary    = 1,
+    kHeaderScan = 2
   };
 
   Int_t         fMinRunNumber;
@@ -36,12 +57,15 @@ public:
   std::vector<RunRecord_t*>
                 fRunRecord;
   Int_t         fReturnCode;
+  Int_t         fSource;        // kEventLoop, kSummary or kHeaderScan
 
 private:
   TFile*        fFile;
+  TString       fFullName;      // name the file was opened with
   TString       fFileName;
   TString       fFileDate;
   Float_t       fFileSize;
+  Long64_t      fFileBytes;
   TFile*        fNewFile;
   TString       fNewFileName;
 
@@ -77,6 +101,25 @@ public:
   void      PrintFilename  ();
   void      PrintCatalog   (const char* Opt="");
   void      ExecCommands   ();
+  void      MakeNewFileName();
+//-----------------------------------------------------------------------------
+// cataloging without the event loop: the run/section/event information is
+// taken from the file summary written by FillStntuple; for the files
+// written before the summary was introduced, only the header block branch
+// is read. CatalogFiles processes Files on NThreads threads (0: all cores),
+// the printout and the commands follow the settings of this module and the
+// order of Files. Returns the number of files which couldn't be cataloged
+//-----------------------------------------------------------------------------
+  int       CatalogFile    (const char* Filename);
+  int       CatalogFiles   (const std::vector<TString>& Files, int NThreads = 0);
+
+  int       FillFromSummary(const TStnFileSummary* Summary);
+  int       ScanHeaders    (TFile* File);
+  void      AddEvent       (int Run, int Section, int Event);
+  RunRecord_t* GetRunRecord(int Run);
+  void      CopySettings   (const TDFCModule* Module);
+					// clear the per-file information
+  void      ResetFile      ();
 //-----------------------------------------------------------------------------
 // overloaded methods of TStnModule
 //-----------------------------------------------------------------------------
@@ -85,6 +128,9 @@ public:
   int       Event          (int ientry);
   int       EndJob         ();
 
+protected:
+  void      CatalogFilesWorker(const std::vector<TString>* Files, CatalogStat_t* Stat);
+
   ClassDef(TDFCModule,0)
 };
 #endif
@@ -13,6 +13,8 @@
 #include "TFolder.h"
 #include "TProfile.h"
 
+#include <vector>
+
 class TStnNode;
 class TStnEvent;
 class TStnModule;
@@ -26,6 +28,11 @@ class TEventList;
 class TStnDataset;
 class TStnRunSummary;
 class TVisManager;
+class TStnProfiler;
+class TStnEventCache;
+class TStnTriggerBlock;
+class TBitset;
+class TTree;
 
 class TStnAna : public TNamed {
 
@@ -78,6 +85,40 @@ protected:
 
   EventList_t*      fEventList;	        // ! list of events to be processed
 //-----------------------------------------------------------------------------
+// profiling, NULL by default, see TStnProfiler.hh
+//-----------------------------------------------------------------------------
+  TStnProfiler*     fProfiler;		// !
+  TTree*            fProfileTree;	// ! summary, saved with the histograms
+//-----------------------------------------------------------------------------
+// columnar event cache, NULL by default, see TStnEventCache.hh
+//-----------------------------------------------------------------------------
+  TStnEventCache*   fEventCache;	// ! owned
+  Int_t             fCachedPass;	// ! 1: all modules can run from the cache
+//-----------------------------------------------------------------------------
+// trigger pre-selection: only the header and the trigger blocks are read
+// for the events which don't pass any of the selected trigger paths.
+// The mask is recompiled when the trigger table changes
+//-----------------------------------------------------------------------------
+  TString           fTriggerPattern;	// ! "": no pre-selection
+  TStnTriggerBlock* fTriggerBlock;	// !
+  TBitset*          fTriggerMask;	// ! owned
+  Int_t             fTriggerMaskValid;	// ! 0: no trigger table, accept all
+  TString           fTriggerTableName;	// ! table the mask was compiled for
+  Int_t             fTriggerTableTag;	// !
+  Int_t             fNTriggerRejected;	// !
+//-----------------------------------------------------------------------------
+// tag pre-selection: the expression is evaluated over the STNTAG trees
+// (see TStnTagTree.hh) one file at a time, when the event loop enters it,
+// nothing is read for the events which don't pass it
+//-----------------------------------------------------------------------------
+  enum { kTagUnknown = 2 };		// file not evaluated yet
+
+  TString           fTagSelection;	// ! "": no tag pre-selection
+  std::vector<char> fTagPass;		// ! per chain entry: 0, 1 or kTagUnknown,
+					// empty: accept all
+  Int_t             fNTagSelected;	// !
+  Int_t             fNTagRejected;	// !
+//-----------------------------------------------------------------------------
 // visualization hook
 //-----------------------------------------------------------------------------
   TVisManager*      fVisManager;	// vis. manager. default - NULL
@@ -155,9 +196,13 @@ public:
   TList*            GetListOfModules() { return fModuleList;   }
   TStnDBManager*    GetDBManager    () { return fDBManager;    }
   TVisManager*      GetVisManager   () { return fVisManager;   }
+  TStnProfiler*     GetProfiler     () { return fProfiler;     }
+  TStnEventCache*   GetEventCache   () { return fEventCache;   }
 
   Int_t             NProcessedEvents() { return fNProcessedEvents; }
   Int_t             NPassedEvents   () { return fNPassedEvents;    }
+  Int_t             NTriggerRejected() { return fNTriggerRejected; }
+  Int_t             NTagRejected    () { return fNTagRejected;     }
 
   TStnModule* GetModule   (const char* name) {
     return (TStnModule*) fModuleList->FindObject(name);
@@ -195,6 +240,19 @@ public:
   void  SetPrintLevel     (Int_t             L  ) { fPrintLevel      = L;   }
   Int_t SetOutputFile     (const char* Filename );
   void  SetEventList      (Int_t*      EventList);
+					// Sampling=N: profile every N-th
+					// event, 0: disable profiling
+  void  SetProfiling      (Int_t       Sampling = 1);
+					// Filename="": memory only,
+					// Filename=0 : disable the cache
+  void  UseEventCache     (const char* Filename = "");
+					// see TStnTriggerTable::MakeMask,
+					// "": no trigger pre-selection
+  void  SetTriggerFilter  (const char* Pattern);
+					// TTreeFormula expression in terms of
+					// the STNTAG columns, "": no selection,
+					// takes effect also after BeginJob
+  void  SetTagSelection   (const char* Expr);
 //-----------------------------------------------------------------------------
 // set callback routines
 //-----------------------------------------------------------------------------
@@ -212,8 +270,14 @@ public:
 //-----------------------------------------------------------------------------
   void          Help           (const char* Item  = 0);
   void          PrintStat      (Int_t       NEvents    , const char* BranchName = "");
+					// per-block object allocation counts,
+					// see TStnDataBlock::NAllocated
+  void          PrintAllocations();
   static int    SaveFolder     (TFolder*    Folder     , TDirectory* Dir);
   void          SaveHist       (const char* Filename   , Int_t Mode = 2);
+					// create/update the ROOT histograms of
+					// the declarative histogram sets
+  int           MakeHistSetHistograms();
   Int_t         MergeHistograms(const char* ListOfFiles, const char* OutputFile);
 //-----------------------------------------------------------------------------
 // visualization
@@ -239,6 +303,15 @@ public:
   
 protected:
 
+  virtual int ProcessEntryInternal(Int_t Ientry);
+					// cached passes
+  virtual int ProcessCachedEntry  (Int_t Ientry);
+  int         ContinueFromCache   (Int_t Nev   );
+
+  int         InitTriggerFilter   ();
+  int         InitTagSelection    ();
+  int         EvalTagSelection    (Long64_t Entry);
+
   Int_t  NBytesRead(TBranch* Branch, Double_t& TotBytes, Double_t& ZipBytes);
   Int_t  AddFolders(TFolder*   Fol1, TFolder*   Fol2);
   Int_t  AddArrays (TObjArray* A1  , TObjArray* A2  );
@@ -0,0 +1,117 @@
+#ifndef STNTUPLE_TStnBlockBenchmark_hh
+#define STNTUPLE_TStnBlockBenchmark_hh
+//-----------------------------------------------------------------------------
+// read/write throughput benchmark for STNTUPLE data blocks
+//
+// for each block the benchmark generates NEvents synthetic events (Poisson
+// multiplicities, fixed seed - results are reproducible), writes them into
+// a separate file using the same branch layout as StntupleMaker and
+// TStnOutputModule, reads them back through TStnNode::GetEntry and measures
+// per event:
+//
+//   streamer write/read : Streamer to/from an in-memory buffer, no I/O
+//   clear               : TStnDataBlock::Clear
+//   fill                : TTree::Fill (streamer + compression + I/O)
+//   getentry            : TStnNode::GetEntry (I/O + decompression + streamer)
+//
+// results are printed and written to a CSV file, one line per block
+//
+// usage (ROOT prompt):
+//   TStnBlockBenchmark b("/tmp",1000);
+//   b.Run();                           // all known blocks
+//   b.Run("StrawHitBlock");            // one block
+//   b.WriteResults("block_benchmark.csv");
+//-----------------------------------------------------------------------------
+#include <vector>
+
+#include "TNamed.h"
+#include "TString.h"
+
+class TRandom3;
+class TStnDataBlock;
+
+class TStnBlockBenchmark : public TNamed {
+public:
+					// fills block with one synthetic
+					// event, Mean: mean multiplicity
+  typedef int (*Filler_t)(TStnDataBlock* Block, TRandom3* Rn, double Mean);
+
+  struct Block_t {
+    TString    fBranchName;
+    TString    fClassName;
+    Filler_t   fFiller;
+    double     fMean;
+  };
+
+  struct Result_t {
+    TString    fBranchName;
+    TString    fClassName;
+    int        fNEvents;
+    double     fMeanMult;		// mean N(objects) per event
+    double     fBytes;			// per event, uncompressed
+    double     fZipBytes;		// per event, compressed
+    double     fStreamerWrite;		// all times: microseconds per event
+    double     fStreamerRead;
+    double     fClear;
+    double     fFill;
+    double     fGetEntry;		// CPU
+    double     fGetEntryWall;
+  };
+
+protected:
+  TString                fDir;		// where the files are written
+  int                    fNEvents;
+  int                    fSeed;
+  int                    fCompression;
+  int                    fBasketSize;
+  int                    fSplitLevel;
+  int                    fKeepFiles;
+
+  std::vector<Block_t>   fBlock;
+  std::vector<Result_t>  fResult;
+//-----------------------------------------------------------------------------
+// functions
+//-----------------------------------------------------------------------------
+public:
+  TStnBlockBenchmark(const char* Dir = ".", int NEvents = 1000, int Seed = 4357);
+  virtual ~TStnBlockBenchmark();
+
+  int             NBlocks ()      const { return fBlock.size();  }
+  int             NResults()      const { return fResult.size(); }
+  const Result_t* GetResult(int I) const { return &fResult[I];   }
+
+  void  SetNEvents    (int N) { fNEvents     = N; }
+  void  SetSeed       (int S) { fSeed        = S; }
+  void  SetCompression(int C) { fCompression = C; }
+  void  SetBasketSize (int S) { fBasketSize  = S; }
+  void  SetSplitLevel (int S) { fSplitLevel  = S; }
+  void  SetKeepFiles  (int K) { fKeepFiles   = K; }
+					// add/redefine a block
+  void  AddBlock        (const char* BranchName, const char* ClassName,
+			 Filler_t    Filler    , double      Mean);
+  int   SetMultiplicity (const char* BranchName, double Mean);
+//-----------------------------------------------------------------------------
+// BranchName = "all": run all blocks, returns number of failed blocks
+//-----------------------------------------------------------------------------
+  int   Run             (const char* BranchName = "all");
+  int   RunBlock        (const Block_t* Block);
+
+  int   WriteResults    (const char* Filename = "block_benchmark.csv") const;
+
+  void  Clear(Option_t* Opt = "");
+  void  Print(Option_t* Opt = "") const;
+//-----------------------------------------------------------------------------
+// fillers for the standard blocks
+//-----------------------------------------------------------------------------
+  static int FillHeaderBlock  (TStnDataBlock* Block, TRandom3* Rn, double Mean);
+  static int FillTrackBlock   (TStnDataBlock* Block, TRandom3* Rn, double Mean);
+  static int FillCalDataBlock (TStnDataBlock* Block, TRandom3* Rn, double Mean);
+  static int FillSimpBlock    (TStnDataBlock* Block, TRandom3* Rn, double Mean);
+  static int FillStrawHitBlock(TStnDataBlock* Block, TRandom3* Rn, double Mean);
+  static int FillStrawHitWfBlock(TStnDataBlock* Block, TRandom3* Rn, double Mean);
+  static int FillCrvPulseBlock(TStnDataBlock* Block, TRandom3* Rn, double Mean);
+
+  ClassDef(TStnBlockBenchmark,0)
+};
+
+#endif
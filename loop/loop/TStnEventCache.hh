@@ -0,0 +1,155 @@
+#ifndef STNTUPLE_TStnEventCache_hh
+#define STNTUPLE_TStnEventCache_hh
+//-----------------------------------------------------------------------------
+// columnar cache of selected per-event quantities for repeated passes over
+// the same chain in an interactive stnana session
+//
+// the modules define the columns they need in DefineCacheColumns, which
+// TStnAna calls in BeginJob:
+//
+//   int TMyModule::DefineCacheColumns(TStnEventCache* Cache) {
+//     Cache->AddScalar("ntrk","TrackBlock",
+//                      [](TStnDataBlock* B) { return ((TStnTrackBlock*) B)->NTracks(); });
+//     Cache->AddArray ("trk_p","TrackBlock",
+//                      [](TStnDataBlock* B)        { return ((TStnTrackBlock*) B)->NTracks(); },
+//                      [](TStnDataBlock* B, int I) { return ((TStnTrackBlock*) B)->Track(I)->P(); });
+//     fIP = Cache->ColumnIndex("trk_p");
+//     return 1;                            // module can run from the cache
+//   }
+//
+//   int TMyModule::EventFromCache(TStnEventCache* Cache, int Entry) {
+//     int n = Cache->Size(fIP,Entry);
+//     const float* p = Cache->Array(fIP,Entry);
+//     ...
+//   }
+//
+// stntuple::TTrackAnaModule and stntuple::TClusterAnaModule support the
+// cache, the histograms filled in the cached passes are the same
+//
+// the first pass (TStnAna::Run) reads the data blocks as usual and records
+// the columns for each chain entry, run/subrun/event numbers are always
+// recorded. If all enabled modules can run from the cache, later calls to
+// TStnAna::Run are served from memory, no data blocks are read.
+//
+// the cache is keyed on the input (TStnInputModule::CacheKey: files with
+// their sizes and modification times, the number of entries, the datasets
+// and the split), the column definitions and the class versions of the
+// data blocks; the data are dropped when the key changes. With a file name
+// specified, the cache is also saved to (and loaded from) a binary file,
+// so it survives the session
+//
+// usage:
+//   TStnAna x(...);
+//   x.UseEventCache("ana.stncache");    // "": memory only
+//   x.Run();                             // reads data blocks, fills the cache
+//   x.Run();                             // served from the cache
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <functional>
+
+#include "TNamed.h"
+#include "TString.h"
+
+class TStnEvent;
+class TStnNode;
+class TStnDataBlock;
+class TStnInputModule;
+
+class TStnEventCache : public TNamed {
+public:
+  typedef std::function<float(TStnDataBlock*)>        Scalar_t;
+  typedef std::function<int  (TStnDataBlock*)>        Count_t;
+  typedef std::function<float(TStnDataBlock*, int)>   Element_t;
+
+  enum { kMagic = 0x53434e45, kVersion = 1 };
+
+  struct Column_t {
+    TString             fName;
+    TString             fBranchName;
+    int                 fArray;		// 0: scalar, 1: array
+    Scalar_t            fScalar;
+    Count_t             fCount;
+    Element_t           fElement;
+    TStnNode*           fNode;		// resolved in Init
+    std::vector<float>  fData;
+    std::vector<int>    fOffset;	// arrays: entry I - [fOffset[I],fOffset[I+1])
+  };
+
+protected:
+  TString                 fFilename;	// "": don't save
+  TString                 fKey;		// MD5 of the key string
+  std::vector<Column_t>   fColumn;
+  std::vector<int>        fRunNumber;
+  std::vector<int>        fSectionNumber;
+  std::vector<int>        fEventNumber;
+  int                     fNEntries;	// entries [0,fNEntries) are cached
+  int                     fComplete;	// 1: all entries of the chain cached
+  int                     fModified;	// 1: filled since the last Save/Load
+  int                     fNFillErrors;
+//-----------------------------------------------------------------------------
+// functions
+//-----------------------------------------------------------------------------
+public:
+  TStnEventCache(const char* Filename = "");
+  virtual ~TStnEventCache();
+
+  const char* Key        () const { return fKey.Data();      }
+  const char* Filename   () const { return fFilename.Data(); }
+  int         NEntries   () const { return fNEntries;        }
+  int         NColumns   () const { return fColumn.size();   }
+  int         Complete   () const { return fComplete;        }
+  int         Modified   () const { return fModified;        }
+
+  const Column_t* GetColumn(int I) const { return &fColumn[I]; }
+  int         ColumnIndex(const char* Name) const;
+
+  void        SetFilename(const char* Fn) { fFilename = Fn; }
+  void        SetComplete(int Flag)       { fComplete = Flag; }
+//-----------------------------------------------------------------------------
+// column definitions, redefinition of an existing column replaces its
+// functions, returns the column index
+//-----------------------------------------------------------------------------
+  int         AddScalar  (const char* Name, const char* BranchName, Scalar_t F);
+  int         AddArray   (const char* Name, const char* BranchName,
+			  Count_t N, Element_t F);
+//-----------------------------------------------------------------------------
+// accessors for the cached data
+//-----------------------------------------------------------------------------
+  int          RunNumber    (int Entry) const { return fRunNumber    [Entry]; }
+  int          SectionNumber(int Entry) const { return fSectionNumber[Entry]; }
+  int          EventNumber  (int Entry) const { return fEventNumber  [Entry]; }
+
+  float        Scalar(int Col, int Entry) const { return fColumn[Col].fData[Entry]; }
+
+  int          Size  (int Col, int Entry) const {
+    const Column_t* c = &fColumn[Col];
+    return c->fOffset[Entry+1]-c->fOffset[Entry];
+  }
+
+  const float* Array (int Col, int Entry) const {
+    const Column_t* c = &fColumn[Col];
+    return c->fData.data()+c->fOffset[Entry];
+  }
+//-----------------------------------------------------------------------------
+// TStnAna interface
+// Init: resolve the block nodes, compute the key, drop the data if the key
+//       changed, load the cache file if nothing is in memory
+// Fill: record entry Entry (chain entry number), entries are recorded only
+//       in sequence, starting from 0; the header block has to be read
+//-----------------------------------------------------------------------------
+  int         Init       (TStnEvent* Event, TStnInputModule* Input);
+  int         Fill       (int Entry, int TreeEntry, int Run, int Subrun, int Ev);
+
+  int         Save       (const char* Filename = 0);
+  int         Load       (const char* Filename = 0);
+
+  void        Clear(Option_t* Opt = "");
+  void        Print(Option_t* Opt = "") const;
+
+protected:
+  TString     MakeKey    (TStnInputModule* Input) const;
+
+  ClassDef(TStnEventCache,0)
+};
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef STNTUPLE_TStnHistSet_hh
+#define STNTUPLE_TStnHistSet_hh
+//-----------------------------------------------------------------------------
+// declarative histogram sets for objects of type T (tracks, clusters, pulses)
+//
+// variables and selections are defined once, at booking time:
+//
+//   TStnHistSet<TCrvRecoPulse>* hs = new TStnHistSet<TCrvRecoPulse>("crvp");
+//   int inpe = hs->AddVar("npe" ,"N(Pe)",250,0,500,[](TCrvRecoPulse* P) { return P->NPe (); });
+//   int it   = hs->AddVar("time","time" ,500,0,2000,[](TCrvRecoPulse* P) { return P->Time(); });
+//   hs->Book2D("time_vs_npe","time vs NPe",250,0,500,500,0,2000,inpe,it);
+//   hs->AddSet(0);                                                    // all pulses
+//   hs->AddSet(1,[](TCrvRecoPulse* P) { return P->NPe() > 10; });     // NPe > 10
+//   AddHistSet(hs);                                                   // TStnModule
+//
+// and per event each object is passed once: hs->Fill(pulse). The variables
+// are evaluated once per object, then all sets with passed selection are
+// filled. Set I goes into folder Hist/<prefix>_I, same as the hand-booked
+// sets.
+//
+// the histograms are stored in one contiguous array (per histogram: entries,
+// statistics, bins including under/overflows), ROOT histograms are created
+// only when the module calls MakeHistograms (TStnAna::EndJob does it before
+// calling the module EndJob)
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <functional>
+
+#include "TString.h"
+
+class TFolder;
+
+class TStnHistSetBase {
+public:
+  enum { kNStat = 8 };			// entries, sumw, sumw2, sumwx, sumwx2,
+					// sumwy, sumwy2, sumwxy
+
+  struct Hist_t {
+    TString    fName;
+    TString    fTitle;
+    int        fDim;
+    int        fNx;
+    double     fXMin;
+    double     fXMax;
+    double     fXScale;			// nx/(xmax-xmin)
+    int        fNy;
+    double     fYMin;
+    double     fYMax;
+    double     fYScale;
+    int        fVarX;			// variable indices
+    int        fVarY;
+    int        fOffset;			// in the set
+    int        fSize;
+  };
+
+  struct Set_t {
+    int        fIndex;
+    TString    fFolder;
+    TString    fComment;
+    int        fOffset;			// in fData
+  };
+
+protected:
+  TString                 fPrefix;
+  std::vector<TString>    fVarName;
+  std::vector<Hist_t>     fHist;
+  std::vector<Set_t>      fSet;
+  std::vector<double>     fValue;	// variable values for the current object
+  std::vector<double>     fData;	// all sets, all histograms
+  int                     fSetSize;	// N(doubles) per set
+  int                     fAllocated;
+
+public:
+  TStnHistSetBase(const char* Prefix);
+  virtual ~TStnHistSetBase();
+
+  const char* Prefix () const { return fPrefix.Data(); }
+  int         NVars  () const { return fVarName.size(); }
+  int         NHists () const { return fHist.size();    }
+  int         NSets  () const { return fSet.size();     }
+
+  int   Book1D(const char* Name, const char* Title,
+	       int Nx, double XMin, double XMax, int VarX);
+
+  int   Book2D(const char* Name, const char* Title,
+	       int Nx, double XMin, double XMax,
+	       int Ny, double YMin, double YMax, int VarX, int VarY);
+//-----------------------------------------------------------------------------
+// create (or update) ROOT histograms in the subfolders of HistFolder
+//-----------------------------------------------------------------------------
+  int   MakeHistograms(TFolder* HistFolder);
+  void  Reset();
+
+protected:
+  int   AddSetDefinition(int Index, const char* Comment);
+  void  Allocate();
+					// fill set with the values in fValue
+  void  FillSet(int ISet);
+};
+
+//-----------------------------------------------------------------------------
+template <class T> class TStnHistSet : public TStnHistSetBase {
+public:
+  typedef std::function<double(T*)> Var_t;
+  typedef std::function<bool  (T*)> Sel_t;
+
+protected:
+  std::vector<Var_t>   fVar;
+  std::vector<Sel_t>   fSel;
+
+public:
+  TStnHistSet(const char* Prefix) : TStnHistSetBase(Prefix) {}
+  virtual ~TStnHistSet() {}
+//-----------------------------------------------------------------------------
+// variable without a histogram (for 2D histograms), returns variable index
+//-----------------------------------------------------------------------------
+  int DefineVar(const char* Name, Var_t F) {
+    fVar.push_back(F);
+    fVarName.push_back(Name);
+    return fVar.size()-1;
+  }
+					// variable and its 1D histogram
+  int AddVar(const char* Name, const char* Title,
+	     int Nx, double XMin, double XMax, Var_t F) {
+    int iv = DefineVar(Name,F);
+    Book1D(Name,Title,Nx,XMin,XMax,iv);
+    return iv;
+  }
+					// Sel = nullptr: accept all
+  int AddSet(int Index, Sel_t Sel = nullptr, const char* Comment = "") {
+    fSel.push_back(Sel);
+    return AddSetDefinition(Index,Comment);
+  }
+
+  void Fill(T* Obj) {
+    if (! fAllocated) Allocate();
+
+    int nv = fVar.size();
+    for (int i=0; i<nv; i++) fValue[i] = fVar[i](Obj);
+
+    int ns = fSel.size();
+    for (int i=0; i<ns; i++) {
+      if ((fSel[i] == nullptr) || fSel[i](Obj)) FillSet(i);
+    }
+  }
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define TStnInputModule_hh
 
 #include "TList.h"
+#include "TString.h"
 #include "TStnModule.hh"
 #include "TList.h"
 
@@ -55,6 +56,9 @@ public:
   TStnDataset*      GetDataset (int i) { return (TStnDataset*) fDatasetList->At(i); }
 
   TChain*           GetChain   () { return fChain; }
+					// description of the input used as a
+					// part of the TStnEventCache key
+  virtual TString   CacheKey   ();
 
 					// returns pointer to TStnDataBlock,
 					// but don't want to do type casting
@@ -1,6 +1,8 @@
 #ifndef STNTUPLE_TStnModule_hh
 #define STNTUPLE_TStnModule_hh
 
+#include <vector>
+
 #include "TNamed.h"
 #include "TObjArray.h"
 #include "TObjString.h"
@@ -9,6 +11,8 @@
 #include "TH2.h"
 #include "TProfile.h"
 
+#include "Stntuple/loop/TStnHistSet.hh"
+
 class TStnAna;
 class TCanvas;
 class TStnHeaderBlock;
@@ -16,6 +20,7 @@ class TStnDataBlock;
 class TStnNode;
 class TStnEvent;
 class TStnGoodRunList;
+class TStnEventCache;
 
 class TStnModule: public TNamed {
 public:
@@ -41,6 +46,8 @@ protected:
   TObjArray*       fListOfL3TrigNames;     // ! list of L3 trigger names
   TObjArray*       fListOfL3Triggers;      // ! list of passed L3 triggers
   int              fDebugBit[kNDebugBits]; // ! hopefully, it will be enough
+  Int_t            fNNameLookups;          // ! data block lookups by name from Event()
+  std::vector<TStnHistSetBase*> fListOfHistSets; //! owned, see TStnHistSet.hh
 public:
   TStnModule();
   TStnModule(const char* name, const char* title);
@@ -52,6 +59,13 @@ public:
   virtual int EndRun      ();
   virtual int EndJob      ();
 //-----------------------------------------------------------------------------
+// columnar event cache, see TStnEventCache.hh. DefineCacheColumns returns 1
+// if the module can process events from the cache, EventFromCache replaces
+// Event in the cached passes. The defaults: no cache support
+//-----------------------------------------------------------------------------
+  virtual int DefineCacheColumns(TStnEventCache* Cache);
+  virtual int EventFromCache    (TStnEventCache* Cache, Int_t Entry);
+//-----------------------------------------------------------------------------
 // accessors
 //-----------------------------------------------------------------------------
   int              GetInitialized     () { return fInitialized;   }
@@ -59,6 +73,7 @@ public:
   int              GetEnabled         () { return fEnabled;       }
   int              GetLastRun         () { return fLastRun;       }
   int              GetDebugBit   (int I) { return fDebugBit[I];   }
+  Int_t            NNameLookups       () { return fNNameLookups;  }
 
   // TObjArray*       GetListOfHistograms() { 
   //   Warning("GetListOfHistograms",Form(" from %s\n",GetName()));
@@ -99,6 +114,7 @@ public:
   void     SetMyronFlag    (int      flag   ) { fMyronFlag     = flag;    }
   void     SetPassed       (Int_t    Passed ) { fPassed        = Passed;  }
   void     SetDebugBit     (int I, int Value) { fDebugBit[I]   = Value;   }
+  void     AddNameLookups  (Int_t    N      ) { fNNameLookups += N;       }
 
   void    AddL3TriggerName    (const char* L3Path) {
     fListOfL3TrigNames->Add(new TObjString(L3Path)); 
@@ -110,6 +126,15 @@ public:
   void  DeleteHistograms(TFolder* Folder = (TFolder*) -1);
 
   void  AddHistogram(TObject* hist, const char* FolderName = "Hist");
+//-----------------------------------------------------------------------------
+// declarative histogram sets: the module owns the added sets,
+// MakeHistSetHistograms converts them into ROOT histograms in the "Hist"
+// folder (or updates the existing ones). TStnAna calls it at the end of 
+// Continue, in SaveHist and before the module EndJob, interactively use
+// TStnAna::MakeHistSetHistograms
+//-----------------------------------------------------------------------------
+  void  AddHistSet           (TStnHistSetBase* Set) { fListOfHistSets.push_back(Set); }
+  int   MakeHistSetHistograms();
 
   void  HBook1F(TH1F*& Hist, const char* Name, const char* Title,
 		Int_t Nx, Double_t XMin, Double_t XMax,
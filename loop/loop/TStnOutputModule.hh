@@ -8,18 +8,37 @@
 // 2) If the keep list contains one or more elements the drop list is
 //    ignored (even if it has something in it) and all blocks except
 //    the one mentioned in the keep list ared dropped.
+//
+// Copy modes
+// ----------
+// kRestream (default): each selected event is read into the data blocks 
+//    and written out by their streamers, the blocks may be modified 
+//    by the upstream modules
+// kFastCopy: the module only records the selected entries of the current 
+//    input file and copies them when the input file changes (or at the end
+//    of the job). If all entries of an input file are selected, compressed 
+//    baskets are copied as they are (TTree::CopyEntries(...,"fast")) and
+//    keep the input compression whatever the branch settings are, 
+//    otherwise the selected entries are copied via TTree::GetEntry/Fill,
+//    bypassing TStnEvent. The output reflects the input data as they are 
+//    on disk - modifications made by the analysis modules are not saved
 //------------------------------------------------------------------------------
 #ifndef TStnOutputModule_hh
 #define TStnOutputModule_hh
 
+#include <vector>
+
 #include "TStnModule.hh"
 
 class TStnEvent;
 class TStnNode;
 class TTree;
 class TFile;
+class TStnIOProfile;
 
 class TStnOutputModule: public TStnModule {
+public:
+  enum { kRestream = 0, kFastCopy = 1 };
 //-----------------------------------------------------------------------------
 //  data members
 //-----------------------------------------------------------------------------
@@ -31,6 +50,16 @@ protected:
   Int_t                 fMaxFileSize;	// max file size in MBytes
   TObjArray*            fDropList;	// list of data blocks (names) to drop
   TObjArray*            fKeepList;	// list of data blocks (names) to keep
+  TObjArray*            fListOfIOProfiles;      // list of TStnIOProfile's (owned)
+  TObjArray*            fListOfBlockIOProfiles; // TNamed: name=block, title=profile, "*": default
+  Int_t                 fIOMeasurement;	// 1: print per-block I/O statistics at end job
+  Int_t                 fCopyMode;	// kRestream or kFastCopy
+					// kFastCopy: current input file and 
+					// selected entries in it
+  TString               fInputFileName;
+  std::vector<Long64_t> fSelectedEntries;  //!
+  Long64_t              fNFastCopied;	// N(entries) copied basket by basket
+  Long64_t              fNSlowCopied;	// N(entries) copied entry by entry
 //-----------------------------------------------------------------------------
 //  functions
 //-----------------------------------------------------------------------------
@@ -51,6 +80,12 @@ public:
   Int_t       GetMaxFileSize() { return fMaxFileSize; }
   TObjArray*  GetDropList   () { return fDropList; }
   TObjArray*  GetKeepList   () { return fKeepList; }
+  Int_t       GetIOMeasurement() { return fIOMeasurement; }
+  Int_t       GetCopyMode     () { return fCopyMode; }
+
+					// nullptr if not defined
+  TStnIOProfile* GetIOProfile     (const char* ProfileName);
+  TStnIOProfile* GetBlockIOProfile(const char* BlockName  );
 //-----------------------------------------------------------------------------
 // modifiers
 //-----------------------------------------------------------------------------
@@ -58,9 +93,24 @@ public:
   void        DropDataBlock (const char* Name);
   void        KeepDataBlock (const char* Name);
 //-----------------------------------------------------------------------------
+// I/O profiles: by default the output branches inherit compression settings
+// and basket size of the input ones, a profile redefines them. In kFastCopy
+// mode the output tree is a clone of the input one, the compression 
+// settings are set again after cloning, as TTree::CloneTree resets them
+//-----------------------------------------------------------------------------
+  void        AddIOProfile     (TStnIOProfile* Profile);
+  void        SetBlockIOProfile(const char* BlockName, const char* ProfileName);
+  void        SetIOMeasurement (Int_t Flag) { fIOMeasurement = Flag; }
+  void        SetCopyMode      (Int_t Mode) { fCopyMode      = Mode; }
+//-----------------------------------------------------------------------------
 // other methods
 //-----------------------------------------------------------------------------
   Int_t       OpenNewFile   (const char* Filename );
+					// close current output file, open the next one
+  Int_t       OpenNextFile  ();
+					// kFastCopy mode: copy selected entries 
+					// of the current input file
+  Int_t       CopyInputFile ();
 
   ClassDef(TStnOutputModule,0)
 };
@@ -0,0 +1,143 @@
+#ifndef STNTUPLE_TStnProfiler_hh
+#define STNTUPLE_TStnProfiler_hh
+//-----------------------------------------------------------------------------
+// per-module and per-data-block profiling of the TStnAna event loop
+//
+// the profiler keeps a tree of scopes, each scope accumulates number of
+// calls, CPU and wall time, number of bytes read and RSS change.
+// TStnAna opens the scopes around the module entry points:
+//
+//   Event    - header block read, module Event entry points, output module
+//   BeginRun - module BeginRun entry points
+//
+// data block reads (TStnNode::GetEntry) are attributed to the scope open
+// at the time of the read, so a block read by a module shows up as a child
+// of the module scope
+//
+// profiling is done for every N-th event (SetSampling(N), N=1: every event)
+// in the end of job the profiler prints a table, writes a collapsed-stack
+// file (input for flamegraph.pl, self time in microseconds) and fills
+// a summary tree which TStnAna saves along with the histograms
+//
+// usage:
+//   TStnAna x(...);
+//   x.SetProfiling(1);
+//   ...
+//   x.Run();
+//   x.SaveHist("hist.root");
+//-----------------------------------------------------------------------------
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+
+#include "TNamed.h"
+
+class TTree;
+class TStnNode;
+
+class TStnProfiler : public TNamed {
+public:
+
+  struct Scope_t {
+    std::string  fName;
+    int          fParent;
+    int          fDepth;
+    int          fNCalls;
+    double       fCpu;			// seconds
+    double       fWall;			// seconds
+    double       fBytes;		// bytes read (uncompressed)
+    double       fRss;			// RSS change, bytes
+					// children
+    std::map<std::string,int>              fChild;
+    std::unordered_map<const TStnNode*,int> fNodeChild;
+  };
+
+  struct Frame_t {
+    int          fScope;
+    double       fCpu0;
+    double       fWall0;
+    long         fRss0;
+  };
+
+protected:
+  std::vector<Scope_t>  fScope;
+  std::vector<Frame_t>  fStack;
+  int                   fEventScope;
+  int                   fBeginRunScope;
+
+  int                   fSampling;	// profile each fSampling-th event
+  int                   fMeasureRss;
+  int                   fNEvents;
+  int                   fNSampled;
+  int                   fActive;	// 1 during a sampled event
+  long                  fPageSize;
+
+  TString               fStackFile;	// collapsed stacks output file
+
+  static TStnProfiler*  fgActive;	// receives data block reads
+//-----------------------------------------------------------------------------
+// functions
+//-----------------------------------------------------------------------------
+public:
+  TStnProfiler(const char* Name = "StnAnaProfiler", int Sampling = 1);
+  virtual ~TStnProfiler();
+
+  int         Sampling   () const { return fSampling;   }
+  int         NSampled   () const { return fNSampled;   }
+  int         Active     () const { return fActive;     }
+  int         EventScope () const { return fEventScope; }
+  int         BeginRunScope() const { return fBeginRunScope; }
+  const char* StackFile  () const { return fStackFile.Data(); }
+
+  int         NScopes    () const { return fScope.size(); }
+  const Scope_t* GetScope(int I) const { return &fScope[I]; }
+
+  void        SetSampling  (int N          ) { fSampling   = (N > 0) ? N : 1; }
+  void        SetMeasureRss(int Flag       ) { fMeasureRss = Flag;            }
+  void        SetStackFile (const char* Fn ) { fStackFile  = Fn;              }
+//-----------------------------------------------------------------------------
+// returns index of the child scope of Parent, creates it if needed
+//-----------------------------------------------------------------------------
+  int         FindScope  (const char* Name, int Parent);
+//-----------------------------------------------------------------------------
+// BeginEvent returns 1 if the event is sampled, the caller has to call
+// EndEvent after processing the event in any case. Begin/End are no-ops
+// if the event is not sampled
+//-----------------------------------------------------------------------------
+  int         BeginEvent ();
+  void        EndEvent   ();
+
+  void        Begin      (int Scope);
+  void        Begin      (const char* Name, int Parent) {
+    if (fActive) Begin(FindScope(Name,Parent));
+  }
+  void        End        ();
+					// called by TStnNode::GetEntry
+  static void ReadMonitor(TStnNode* Node, Int_t NBytes);
+
+					// process CPU and monotonic wall
+					// clock, seconds
+  static double CpuTime  ();
+  static double WallTime ();
+
+  double      SelfCpu    (int I) const;
+  double      SelfWall   (int I) const;
+//-----------------------------------------------------------------------------
+// end of job
+//-----------------------------------------------------------------------------
+  int         WriteCollapsedStacks(const char* Filename = 0) const;
+  TTree*      MakeSummaryTree     (const char* Name = "StnAnaProfile") const;
+
+  void        Clear(Option_t* Opt = "");
+  void        Print(Option_t* Opt = "") const;
+
+protected:
+  long          Rss     () const;
+
+  std::string   Path    (int I) const;
+
+  ClassDef(TStnProfiler,0)
+};
+
+#endif
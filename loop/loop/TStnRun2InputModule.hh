@@ -37,6 +37,7 @@ public:
 // overloaded methods of TStnInputModule
 //-----------------------------------------------------------------------------
   virtual Int_t     RegisterInputBranches(TStnEvent* Event);
+  virtual TString   CacheKey();
 //-----------------------------------------------------------------------------
 // overloaded methods of TStnModule
 //-----------------------------------------------------------------------------
@@ -14,14 +14,23 @@
 #include "TBranchObject.h"
 #include "TLeafObject.h"
 #include "TSystem.h"
+#include "TStopwatch.h"
+#include "TROOT.h"
+
+#include <vector>
 
 #include <Stntuple/obj/TStnNode.hh>
 #include <Stntuple/obj/TStnEvent.hh>
 #include <Stntuple/obj/TStnDataBlock.hh>
 #include <Stntuple/obj/TStnDBManager.hh>
 #include <Stntuple/obj/TStnHeaderBlock.hh>
+#include <Stntuple/obj/TStnFileSummary.hh>
+#include <Stntuple/obj/TStnTagTree.hh>
 
+#include "Stntuple/base/TStnIOProfile.hh"
 #include "Stntuple/mod/StntupleModule.hh"
+#include "Stntuple/mod/StntupleFileWriter.hh"
+#include "Stntuple/mod/StntupleEventPool.hh"
 
 namespace mu2e {
 
@@ -31,6 +40,24 @@ class FillStntuple : public StntupleModule {
 //------------------------------------------------------------------------------
 protected:
   Int_t             fLastRun;		// last run with events
+					// I/O measurement mode: per-branch 
+					// fill time, indexed by the branch number
+  std::vector<double> fFillTime;
+					// file rotation: background writer 
+					// (nullptr if asyncFileRotation = 0)
+					// the next file is opened when the 
+					// current one is that full
+  static constexpr double kPrepareFraction = 0.9;
+  StntupleFileWriter*  fWriter;
+  int                  fNRotations;
+  double               fRotationStallTime;
+					// summary of the current output file
+  TStnFileSummary*     fSummary;
+					// run section of the last committed
+					// event
+  int                  fLastSection;
+					// events not initialized by InitStntuple
+  int                  fNLost;
 //------------------------------------------------------------------------------
 // function members
 //------------------------------------------------------------------------------
@@ -44,11 +71,16 @@ public:
 // functions of the module
 //-----------------------------------------------------------------------------
   int     ProcessNewRun      (int RunNumber);
+  int     FillTree           ();
+  int     CommitEvent        (TStnEvent* Ev);
+  int     CommitEvents       (int Flush);
+  int     WriteSummary       (TFile* File);
 //-----------------------------------------------------------------------------
 // overloaded virtual functions of EDFilter
 //-----------------------------------------------------------------------------
   virtual void beginRun(const art::Run&   r);
   virtual void endRun  (const art::Run&   r);
+  virtual void endJob  ();
   virtual void analyze (const AbsEvent&   e);
 
   //  ClassDef(FillStntuple,0)
@@ -64,10 +96,29 @@ FillStntuple::FillStntuple(fhicl::ParameterSet const& PSet):
 {
   fLastRun = -1;
   TTree::SetMaxTreeSize(8000000000LL);
+//-----------------------------------------------------------------------------
+// asyncFileRotation != 0 (opt-in): the next file is opened in a background 
+// thread once the current one is kPrepareFraction full, and the full file 
+// is written out and closed in the same thread. ROOT has to be made 
+// thread-safe before that. The old file is handed to the writer only after 
+// all THistModules have been moved to the new one
+//-----------------------------------------------------------------------------
+  fWriter            = nullptr;
+  fNRotations        = 0;
+  fRotationStallTime = 0;
+  fSummary           = new TStnFileSummary();
+  fLastSection       = -1;
+  fNLost             = 0;
+  if (PSet.get<int>("asyncFileRotation",0) != 0) {
+    ROOT::EnableThreadSafety();
+    fWriter = new StntupleFileWriter();
+  }
 }
 
 //------------------------------------------------------------------------------
 FillStntuple::~FillStntuple() {
+  if (fWriter) delete fWriter;
+  delete fSummary;
 }
 
 //------------------------------------------------------------------------------
@@ -95,6 +146,85 @@ void FillStntuple::endRun(const art::Run &  Rn) {
   THistModule::afterEndRun (Rn);
 }
 
+//------------------------------------------------------------------------------
+void FillStntuple::endJob() {
+					// events still waiting for the commit
+  CommitEvents(1);
+
+  const StntupleEventPool::Stat_t* stat = fgEventPool->GetStat();
+  if ((fgEventPool->NSlots() > 1) || (stat->fNDropped > 0) || (stat->fNUnordered > 0) || (fNLost > 0)) {
+    fgEventPool->Print();
+    if (fNLost > 0) printf(" FillStntuple::endJob: events not initialized by InitStntuple: %i\n",fNLost);
+  }
+					// the last file is written out later
+  if (fgFile) WriteSummary(fgFile);
+
+
+  if (StntupleModule::IOMeasurement() && fgTree) {
+    printf(" FillStntuple::endJob: I/O statistics for the last file\n");
+    TStnIOProfile::PrintIOStat(fgTree,fFillTime.empty() ? nullptr : fFillTime.data());
+  }
+//-----------------------------------------------------------------------------
+// the last file is closed by THistModule, make sure the previous ones are 
+// closed before that, and report the rotation statistics
+//-----------------------------------------------------------------------------
+  if (fWriter) {
+    fWriter->Wait();
+    fWriter->DiscardNext();
+    fWriter->AddStallTime(fRotationStallTime);
+    if (fNRotations > 0) fWriter->Print();
+  }
+  else if (fNRotations > 0) {
+    printf(" FillStntuple::endJob: file rotations: %5i, event loop stall time: %10.3f s\n",
+	   fNRotations,fRotationStallTime);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// in the I/O measurement mode, fill branches one by one and time them
+// (streaming + compression of the full baskets); the auto-flush logic of 
+// TTree::Fill is bypassed in this mode
+//-----------------------------------------------------------------------------
+int FillStntuple::FillTree() {
+  int nbytes = 0;
+
+  if (StntupleModule::IOMeasurement() == 0) {
+    nbytes = fgTree->Fill();
+  }
+  else {
+    TObjArray* list = fgTree->GetListOfBranches();
+    int nb          = list->GetEntriesFast();
+
+    if ((int) fFillTime.size() != nb) fFillTime.assign(nb,0.);
+
+    TStopwatch timer;
+    for (int i=0; i<nb; i++) {
+      TBranch* b = (TBranch*) list->UncheckedAt(i);
+      timer.Start(kTRUE);
+      nbytes += b->Fill();
+      timer.Stop();
+      fFillTime[i] += timer.RealTime();
+    }
+    fgTree->SetEntries(fgTree->GetEntries()+1);
+  }
+  return nbytes;
+}
+
+//-----------------------------------------------------------------------------
+// the summary goes into the top directory of the file, it covers the events
+// written into this file only
+//-----------------------------------------------------------------------------
+int FillStntuple::WriteSummary(TFile* File) {
+  TDirectory* olddir = gDirectory;
+
+  File->cd();
+  fSummary->Write("FileSummary",TObject::kOverwrite);
+  fSummary->Clear();
+
+  olddir->cd();
+  return 0;
+}
+
 //------------------------------------------------------------------------------
   Int_t FillStntuple::ProcessNewRun(int RunNumber)  {
   // create subdirectory with the name run_xxxxxxxx to store database-type
@@ -134,26 +264,172 @@ void FillStntuple::endRun(const art::Run &  Rn) {
   return 0;
 }
 
-//------------------------------------------------------------------------------
-void FillStntuple::analyze(const AbsEvent& anEvent) {
-  // it only fills the tree
+//-----------------------------------------------------------------------------
+// commit one event: the decision to switch to a new file is taken per 
+// committed event, the new file is opened at a run section boundary
+//-----------------------------------------------------------------------------
+int FillStntuple::CommitEvent(TStnEvent* Ev) {
 
   TTree* tree;
-  //  TFile* file;
   TFile* old_file;
 
   char line[100];
 
-  int rc, run_section;
+  int run         = Ev->RunNumber();
+  int run_section = Ev->SectionNumber();
+//-----------------------------------------------------------------------------
+// if we need to close a file and to write a new one, make such a decision here
+// fgOpenNextFile will be reset by FillStntuple after it writes the file
+//-----------------------------------------------------------------------------
+  int mbytes_written = (int) (fgFile->GetBytesWritten()/1000000);
+  if (mbytes_written >= fgMaxFileSize) {
+    if (run_section != fLastSection) {
+      THistModule::fgOpenNextFile = 1;
+    }
+  }
+  else if (fWriter && (mbytes_written >= kPrepareFraction*fgMaxFileSize)) {
+//-----------------------------------------------------------------------------
+// the file is almost full, open the next one in the background
+//-----------------------------------------------------------------------------
+    sprintf(line,"_%i",THistModule::fgFileNumber+1);
+    TString fn = THistModule::fgFileName;
+    fn += line;
+    fWriter->Prepare(fn.Data());
+  }
+//-----------------------------------------------------------------------------
+// now fill the tree, however before doing it check if the output file is not
+// too large and it is time to switch to writing a new file
+//-----------------------------------------------------------------------------
+  if (THistModule::fgOpenNextFile) {
+    TStopwatch timer;
+    timer.Start();
+					// open the new file
+    THistModule::fgFileNumber++;
+    sprintf(line,"_%i",THistModule::fgFileNumber);
+
+    TString fn = THistModule::fgFileName;
+    fn += line;
 
-  THistModule::beforeEvent(anEvent);
+    old_file = THistModule::fgFile;
+    WriteSummary(old_file);
+					// take the file opened ahead of time, 
+					// if any, otherwise open it now
+    TFile* new_file = nullptr;
+    if (fWriter) {
+      fWriter->Prepare(fn.Data());
+      new_file = fWriter->TakeNext();
+    }
+    if (new_file == nullptr) new_file = new TFile(fn.Data(),"RECREATE");
+//-----------------------------------------------------------------------------
+// move all THistModules, including this one, and gDirectory to the new file,
+// after that nothing refers to the old file any more
+//-----------------------------------------------------------------------------
+    THistModule::MoveToFile(new_file);
+    THistModule::fgFile->cd();
+					// the old tag tree is written out
+					// with the old file
+    if (fgTagTree) fgTagTree->MakeTree(THistModule::fgFile);
+//-----------------------------------------------------------------------------
+// clone the layout of still opened fgTree: branches, their addresses and 
+// basket sizes, into the new file. CloneTree resets the compression to the 
+// new file default, so restore the per-branch settings (I/O profiles or 
+// the module compression level) from the old tree.
+// the old tree is about to be written out in a different thread, so detach 
+// the clone from it
+//-----------------------------------------------------------------------------
+    tree = fgTree->CloneTree(0);
+    if (fgTree->GetListOfClones()) fgTree->GetListOfClones()->Remove(tree);
+
+    TIter it(tree->GetListOfBranches());
+    while (TBranch* output_branch = (TBranch*) it.Next()) {
+      TBranch* input_branch = fgTree->GetBranch(output_branch->GetName());
+      if (input_branch) output_branch->SetCompressionSettings(input_branch->GetCompressionSettings());
+      output_branch->SetAutoDelete(kFALSE);
+					// and also redefine branch in the node
+      TStnNode* node = fgEvent->FindNode(output_branch->GetName());
+      node->SetBranch(output_branch);
+    }
+					// store calib consts for the last event
+    ProcessNewRun(run);
+//-----------------------------------------------------------------------------
+// close the old file: in the background or synchronously
+//-----------------------------------------------------------------------------
+    if (fWriter) {
+      fWriter->Submit(old_file);
+    }
+    else {
+      old_file->Write();
+      delete old_file;
+    }
+					// redefine the static variables
+    THistModule::fgTree = tree;
+
+    THistModule::fgOpenNextFile = 0;
+					// I/O statistics is per file
+    fFillTime.assign(fFillTime.size(),0.);
+
+    timer.Stop();
+    fRotationStallTime += timer.RealTime();
+    fNRotations        += 1;
+  }
+					// and finally fill the tree
+					// this is the first entry in the 
+					// new file
+  fgEventPool->Attach(Ev);
+  FillTree();
+  fgEventPool->Detach();
+
+  fSummary->AddEvent(run,run_section,Ev->EventNumber());
+//-----------------------------------------------------------------------------
+// tag tree: one entry per STNTUPLE entry, the tree is created in the
+// current output file on the first event
+//-----------------------------------------------------------------------------
+  if (fgTagTree) {
+    if (fgTagTree->GetTree() == nullptr) fgTagTree->MakeTree(fgFile);
+    fgTagTree->Fill(Ev);
+  }
+  fLastSection = run_section;
+
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+// commit the ready events in the order they have been initialized,
+// Flush != 0: drop the events which are not ready
+//-----------------------------------------------------------------------------
+int FillStntuple::CommitEvents(int Flush) {
+  int n = 0;
+  while (TStnEvent* ev = fgEventPool->NextCommit(Flush)) {
+    CommitEvent(ev);
+    fgEventPool->Release(ev);
+    n++;
+  }
+  return n;
+}
+
+//------------------------------------------------------------------------------
+void FillStntuple::analyze(const AbsEvent& anEvent) {
+  // it only fills the tree
+
+  int rc;
 
-  static int old_rs = -1;
+  THistModule::beforeEvent(anEvent);
+//-----------------------------------------------------------------------------
+// block set filled by InitStntuple for this event
+//-----------------------------------------------------------------------------
+  TStnEvent* ev = fgEventPool->Find(anEvent.run(),anEvent.subRun(),anEvent.event());
+  if (ev == nullptr) {
+    printf(" FillStntuple::analyze: ERROR: event %i:%i:%i not initialized by InitStntuple, skip it\n",
+	   (int) anEvent.run(),(int) anEvent.subRun(),(int) anEvent.event());
+    fNLost++;
+    THistModule::afterEvent(anEvent);
+    return;
+  }
 //-----------------------------------------------------------------------------
 // at this point, all individual blocks are filled
 // initialize information cross-linking the blocks
 //-----------------------------------------------------------------------------
-  TIter it(Event()->GetListOfNodes());
+  TIter it(ev->GetListOfNodes());
 
   unsigned long rtime = (unsigned long)(gSystem->Now());
   while(TStnNode* node = (TStnNode*) it.Next()) {
@@ -175,7 +451,7 @@ void FillStntuple::analyze(const AbsEvent& anEvent) {
   rtime = (unsigned long)(gSystem->Now()) - rtime;
   // add processing time to that from InitStntuple
   TStnHeaderBlock* fHeaderBlock = 
-    (TStnHeaderBlock*) Event()->GetDataBlock("HeaderBlock");
+    (TStnHeaderBlock*) ev->GetDataBlock("HeaderBlock");
   if(fHeaderBlock) {
     float t = fHeaderBlock->CpuTime(); // in s
     t += float(rtime)/1000.0;
@@ -184,96 +460,14 @@ void FillStntuple::analyze(const AbsEvent& anEvent) {
     int speed = (fHeaderBlock->fCpu & 0xFF);
     fHeaderBlock->fCpu = (it<<8 | speed);
   }
-
-//-----------------------------------------------------------------------------
-// if we need to close a file and to write a new one, make such a decision here
-// fgOpenNextFile will be reset by FillStntuple after it writes the file
-//-----------------------------------------------------------------------------
-  run_section = anEvent.subRun();
-
-  int mbytes_written = (int) (fgFile->GetBytesWritten()/1000000);
-  if (mbytes_written >= fgMaxFileSize) {
-    if (run_section != old_rs) {
-      THistModule::fgOpenNextFile = 1;
-    }
-  }
 //-----------------------------------------------------------------------------
-// now fill the tree, however before doing it check if the output file is not
-// too large and it is time to switch to writing a new file
+// with a single schedule the event is committed right away, otherwise it may
+// have to wait for the events initialized before it
 //-----------------------------------------------------------------------------
-  if (THistModule::fgOpenNextFile) {
-					// open the new file
-    THistModule::fgFileNumber++;
-    sprintf(line,"_%i",THistModule::fgFileNumber);
-
-    TString fn = THistModule::fgFileName;
-    fn += line;
-					// open new file 
-
-    old_file = THistModule::fgFile;
-    THistModule::fgFile = new TFile(fn.Data(),"RECREATE");
-
-					// and create the tree in it
-
-    tree = new TTree ("STNTUPLE","STNTUPLE");
-
-					// loop over the branches of still
-					// opened fgTree and duplicate them
-					// in `tree'
-
-    TObjArray* list = fgTree->GetListOfBranches();
-    TIter it(list);
-
-    TBranch*      input_branch;
-    TBranch*      output_branch;
-    TLeafObject*  leaf;
-
-    const char* class_name;
-    const char* input_branch_name;
-
-    while ((input_branch = (TBranch*) it.Next())) {
-      input_branch_name = input_branch->GetName();
-
-      if (strcmp(input_branch->ClassName(),"TBranchElement") == 0) {
-	class_name = ((TBranchElement*)input_branch)->GetClassName();
-      }
-      else {
-	leaf = (TLeafObject*) ((TBranchObject*)input_branch)->GetLeaf(input_branch_name);
-	class_name = leaf->GetTypeName();
-      }
-      TStnNode* node = fgEvent->FindNode(input_branch_name);
-
-					// preserve split level
-
-      output_branch = tree->Branch(input_branch_name,class_name,
-				   node->GetDataBlockAddress(),
-				   input_branch->GetBasketSize(),
-				   input_branch->GetSplitLevel());
-
-      output_branch->SetCompressionLevel(input_branch->GetCompressionLevel());
-      output_branch->SetAutoDelete(kFALSE);
-
-					// and also redefine branch in the node
-      node->SetBranch(output_branch);
-					// store calib consts for the last event
-      ProcessNewRun(anEvent.run());
-    }
-					// close the old file
-    old_file->Write();
-    delete old_file;
-					// redefine the static variables
-    THistModule::fgTree = tree;
-
-    THistModule::fgOpenNextFile = 0;
-  }
-					// and finally fill the tree
-					// this is the first entry in the 
-					// new file
-  fgTree->Fill();
-  old_rs = run_section;
+  fgEventPool->SetReady(ev);
+  CommitEvents(0);
 
   THistModule::afterEvent(anEvent);
-
 }
 
 } // end namespace mu2e
@@ -23,6 +23,7 @@
 #include "art/Framework/Core/ModuleMacros.h"
 #include "art/Framework/Principal/Event.h"
 #include "art/Framework/Principal/Handle.h"
+#include "art/Utilities/Globals.h"
 
 #include "Stntuple/obj/TStnDBManager.hh"
 
@@ -39,6 +40,7 @@
 // class TObjArray;
 
 #include "Stntuple/mod/StntupleModule.hh"
+#include "Stntuple/mod/StntupleEventPool.hh"
 
 namespace mu2e {
 class InitStntuple : public StntupleModule {
@@ -51,6 +53,10 @@ protected:
   Float_t                  fSumInstLum; //! avg inst lum for evaluating
   Int_t                    fnLum;       //! exe speed
   Float_t                  fCpuSpeed;   //! MHz of CPU
+					// several schedules: number of 
+					// ready events waiting for an older
+					// one still in flight
+  int                      fReorderWindow;
 
 //------------------------------------------------------------------------------
 // function members
@@ -92,6 +98,7 @@ InitStntuple::InitStntuple(fhicl::ParameterSet const& Pset):
   THistModule::fgMakeSubdirs = 0;
 
   fLastRun      = -1;
+  fReorderWindow = Pset.get<int>("reorderWindow",16);
 }
 
 
@@ -113,6 +120,9 @@ void InitStntuple::beginJob() {
   fgTree      = new TTree("STNTUPLE", "STNTUPLE");
   fnLum       = 0;
   fSumInstLum = 0.0;
+					// one STNTUPLE block set per schedule
+					// plus the reorder window
+  fgEventPool->SetNSchedules(art::Globals::instance()->nschedules(),fReorderWindow);
 
   FILE* pipe;
   pipe = gSystem->OpenPipe(
@@ -230,6 +240,8 @@ void InitStntuple::analyze(const AbsEvent& AnEvent) {
   // assume that InitStntuple is executed before any other STNTUPLE-related
   // module
   // it decides whether we are about to close the file and to open a new one
+  // with several schedules, each event in flight gets its own set of blocks,
+  // FillStntuple finds it by the event ID
 
   THistModule::beforeEvent(AnEvent);
 //-----------------------------------------------------------------------------
@@ -246,13 +258,15 @@ void InitStntuple::analyze(const AbsEvent& AnEvent) {
 //-----------------------------------------------------------------------------
 // initialization
 //-----------------------------------------------------------------------------
+  TStnEvent* ev = fgEventPool->Acquire(AnEvent.run(),AnEvent.subRun(),AnEvent.event());
+
   unsigned long etime = (unsigned long)(gSystem->Now());
-  Event()->Init((AbsEvent*) &AnEvent,0);
+  ev->Init((AbsEvent*) &AnEvent,0);
   etime = (unsigned long)(gSystem->Now()) - etime;
 
   //compute avg inst lum
   TStnHeaderBlock* fHeaderBlock = 
-    (TStnHeaderBlock*) Event()->GetDataBlock("HeaderBlock");
+    (TStnHeaderBlock*) ev->GetDataBlock("HeaderBlock");
   if(fHeaderBlock) {
     float ilum = fHeaderBlock->InstLum()*1.0e-30;
     if(ilum>0.1 && ilum < 10000.0) {
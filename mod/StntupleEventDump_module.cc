@@ -73,6 +73,11 @@ namespace mu2e {
     std::string        _processName;
 
     std::string        _producerName;
+					// TAnaDump output, <0 or "": keep the
+					// TAnaDump configuration
+    int                _holdOutput;	// 1: write once per event
+    int                _columnar;
+    std::string        _outputFile;
 //-----------------------------------------------------------------------------
 // end of input parameters
 // Options to control the display
@@ -93,6 +98,7 @@ namespace mu2e {
     virtual void     beginJob();
     virtual void     beginRun(const art::Run& aRun);
     virtual void     analyze (const art::Event& Evt);
+    virtual void     endJob  ();
   };
 
 
@@ -100,7 +106,10 @@ namespace mu2e {
   StntupleEventDump::StntupleEventDump(fhicl::ParameterSet const& pset) :
     TModule(pset, "StntupleEventDump"),
     _moduleLabel(pset.get<std::string>("module_label")),
-    _processName(pset.get<string>("processName", ""))
+    _processName(pset.get<string>("processName", "")),
+    _holdOutput (pset.get<int>   ("holdOutput" , -1)),
+    _columnar   (pset.get<int>   ("columnar"   , -1)),
+    _outputFile (pset.get<string>("outputFile" , ""))
   {
     fApplication = 0;
   }
@@ -120,6 +129,10 @@ namespace mu2e {
     if (!gApplication) {
       fApplication = new TApplication("StntupleEventDump_module", &tmp_argc, tmp_argv);
     }
+
+    if (_holdOutput >= 0 ) fDump->SetHold      (_holdOutput);
+    if (_columnar   >= 0 ) fDump->SetColumnar  (_columnar);
+    if (_outputFile != "") fDump->SetOutputFile(_outputFile.data());
   }
 
 //-----------------------------------------------------------------------------
@@ -138,10 +151,19 @@ namespace mu2e {
   void StntupleEventDump::analyze(const art::Event& Evt) {
     //    const char* oname = "StntupleEventDump::filter";
 //-----------------------------------------------------------------------------
+// the held output of the previous event goes out here
+//-----------------------------------------------------------------------------
+    fDump->SetEvent(&Evt);
+//-----------------------------------------------------------------------------
 // go into interactive mode, till '.q' is pressed
 //-----------------------------------------------------------------------------
     TModule::analyze(Evt);
   } 
+
+//-----------------------------------------------------------------------------
+  void StntupleEventDump::endJob() {
+    fDump->Flush();
+  }
 }
 
 using mu2e::StntupleEventDump;
@@ -0,0 +1,317 @@
+//-----------------------------------------------------------------------------
+// per-event STNTUPLE block sets, see the header
+//-----------------------------------------------------------------------------
+#include <cstdio>
+
+#include "TObjArray.h"
+
+#include "Stntuple/obj/TStnNode.hh"
+#include "Stntuple/obj/TStnEvent.hh"
+#include "Stntuple/obj/TStnDataBlock.hh"
+
+#include "Stntuple/mod/StntupleEventPool.hh"
+
+//-----------------------------------------------------------------------------
+StntupleEventPool::StntupleEventPool(TStnEvent* Master) {
+  fMaster           = Master;
+  fAttached         = 0;
+  fNextSeq          = 0;
+  fNSchedules       = 1;
+  fMaxSlots         = 1;
+
+  fStat.fNAcquired  = 0;
+  fStat.fNCommitted = 0;
+  fStat.fNDropped   = 0;
+  fStat.fNUnordered = 0;
+  fStat.fMaxPending = 0;
+
+  Slot_t s;
+  s.fEvent = Master;
+  s.fState = kFree;
+  s.fSeq   = -1;
+  fSlot.push_back(s);
+}
+
+//-----------------------------------------------------------------------------
+// the init blocks are owned by the master blocks
+//-----------------------------------------------------------------------------
+StntupleEventPool::~StntupleEventPool() {
+  Detach();
+
+  int ns = fSlot.size();
+  for (int i=1; i<ns; i++) {
+    TStnEvent* ev = fSlot[i].fEvent;
+    TIter it(ev->GetListOfNodes());
+    while (TStnNode* node = (TStnNode*) it.Next()) {
+      node->GetDataBlock()->SetInitBlock(nullptr);
+    }
+    delete ev;
+  }
+}
+
+//-----------------------------------------------------------------------------
+// replica nodes don't have branches, blocks go in the same order as
+// the master ones
+//-----------------------------------------------------------------------------
+TStnEvent* StntupleEventPool::MakeReplica() {
+  TStnEvent* ev = new TStnEvent();
+
+  TIter it(fMaster->GetListOfNodes());
+  while (TStnNode* node = (TStnNode*) it.Next()) {
+    TStnDataBlock* block = node->GetDataBlock();
+    TStnNode*      rnode = nullptr;
+
+    int rc = ev->AddDataBlock(node->GetName(),block->ClassName(),rnode);
+    if (rc != 0) {
+      printf(" StntupleEventPool::MakeReplica: ERROR: can\'t replicate block %s\n",
+	     node->GetName());
+      continue;
+    }
+    TStnDataBlock* rblock = rnode->GetDataBlock();
+    rblock->CopyConfiguration(block);
+    rblock->SetNode(rnode);
+  }
+  return ev;
+}
+
+//-----------------------------------------------------------------------------
+int StntupleEventPool::FindSlot(TStnEvent* Event) {
+  int ns = fSlot.size();
+  for (int i=0; i<ns; i++) {
+    if (fSlot[i].fEvent == Event) return i;
+  }
+  return -1;
+}
+
+//-----------------------------------------------------------------------------
+int StntupleEventPool::NFree() const {
+  int n  = 0;
+  int ns = fSlot.size();
+  for (int i=0; i<ns; i++) {
+    if (fSlot[i].fState == kFree) n++;
+  }
+  return n;
+}
+
+//-----------------------------------------------------------------------------
+int StntupleEventPool::NFilled() const {
+  int n  = 0;
+  int ns = fSlot.size();
+  for (int i=0; i<ns; i++) {
+    if (fSlot[i].fState == kFilled) n++;
+  }
+  return n;
+}
+
+//-----------------------------------------------------------------------------
+StntupleEventPool::Slot_t* StntupleEventPool::Oldest(int State) {
+  Slot_t* oldest = nullptr;
+
+  int ns = fSlot.size();
+  for (int i=0; i<ns; i++) {
+    Slot_t* s = &fSlot[i];
+    if (s->fState != State) continue;
+    if ((oldest == nullptr) || (s->fSeq < oldest->fSeq)) oldest = s;
+  }
+  return oldest;
+}
+
+//-----------------------------------------------------------------------------
+void StntupleEventPool::SetNSchedules(int N, int Window) {
+  fNSchedules = (N > 0) ? N : 1;
+  fMaxSlots   = fNSchedules;
+  if ((fNSchedules > 1) && (Window > 0)) fMaxSlots += Window;
+}
+
+//-----------------------------------------------------------------------------
+// with a filter in between InitStntuple and FillStntuple that happens for 
+// every rejected event, so only count them - the statistics is printed
+// at the end of the job
+//-----------------------------------------------------------------------------
+void StntupleEventPool::Drop(Slot_t* Slot) {
+  Slot->fState = kFree;
+  fStat.fNDropped++;
+}
+
+//-----------------------------------------------------------------------------
+// the first free slot, so with one schedule only the master slot is used. 
+// The event being acquired is not in the pool yet, so if NSchedules slots 
+// are filled, at least one of them belongs to an event which is not 
+// in flight anymore - assume it is the oldest one
+//-----------------------------------------------------------------------------
+TStnEvent* StntupleEventPool::Acquire(int Run, int Subrun, int Event) {
+  std::lock_guard<std::mutex> lock(fMutex);
+
+  Slot_t* s = nullptr;
+
+  int ns = fSlot.size();
+  for (int i=0; i<ns; i++) {
+    if (fSlot[i].fState == kFree) {
+      s = &fSlot[i];
+      break;
+    }
+  }
+
+  if (s == nullptr) {
+    if (NFilled() >= fNSchedules) {
+      s = Oldest(kFilled);
+      Drop(s);
+    }
+    else {
+      if ((int) fSlot.size() >= fMaxSlots) {
+					// NextCommit should've prevented that
+	printf(" StntupleEventPool::Acquire: WARNING: %i slots busy, add one more\n",
+	       (int) fSlot.size());
+      }
+      Slot_t slot;
+      slot.fEvent = MakeReplica();
+      slot.fState = kFree;
+      slot.fSeq   = -1;
+      fSlot.push_back(slot);
+      s = &fSlot.back();
+    }
+  }
+
+  int npending = fSlot.size()-NFree();	// not counting this one
+
+  s->fState = kFilled;
+  s->fSeq   = fNextSeq++;
+  s->fEvent->SetEventNumber(Run,Event,Subrun);
+
+  fStat.fNAcquired++;
+  if (npending+1 > fStat.fMaxPending) fStat.fMaxPending = npending+1;
+
+  return s->fEvent;
+}
+
+//-----------------------------------------------------------------------------
+TStnEvent* StntupleEventPool::Find(int Run, int Subrun, int Event) {
+  std::lock_guard<std::mutex> lock(fMutex);
+
+  Slot_t* found = nullptr;
+
+  int ns = fSlot.size();
+  for (int i=0; i<ns; i++) {
+    Slot_t* s = &fSlot[i];
+    if (s->fState != kFilled) continue;
+
+    TStnEvent* ev = s->fEvent;
+    if ((ev->RunNumber() == Run) && (ev->SectionNumber() == Subrun) && (ev->EventNumber() == Event)) {
+      if ((found == nullptr) || (s->fSeq < found->fSeq)) found = s;
+    }
+  }
+
+  return (found) ? found->fEvent : nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void StntupleEventPool::SetReady(TStnEvent* Event) {
+  std::lock_guard<std::mutex> lock(fMutex);
+
+  int i = FindSlot(Event);
+  if (i >= 0) fSlot[i].fState = kReady;
+}
+
+//-----------------------------------------------------------------------------
+// the oldest pending slot goes first, the slot stays busy till Release.
+// Called by FillStntuple after SetReady, so at most NSchedules-1 filled 
+// slots can still be in flight
+//-----------------------------------------------------------------------------
+TStnEvent* StntupleEventPool::NextCommit(int Flush) {
+  std::lock_guard<std::mutex> lock(fMutex);
+
+  while (1) {
+    Slot_t* next = nullptr;
+
+    int ns    = fSlot.size();
+    int nfree = 0;
+    for (int i=0; i<ns; i++) {
+      Slot_t* s = &fSlot[i];
+      if (s->fState == kFree) {
+	nfree++;
+	continue;
+      }
+      if ((next == nullptr) || (s->fSeq < next->fSeq)) next = s;
+    }
+
+    if (next == nullptr          ) return nullptr;
+    if (next->fState == kReady   ) return next->fEvent;
+
+    if ((Flush != 0) || (NFilled() >= fNSchedules)) {
+      Drop(next);
+      continue;
+    }
+//-----------------------------------------------------------------------------
+// the oldest event is still in flight. The ready ones wait for it in the 
+// reorder window, once the window is full, don't wait any longer
+//-----------------------------------------------------------------------------
+    if ((nfree == 0) && (ns >= fMaxSlots)) {
+      Slot_t* ready = Oldest(kReady);
+      if (ready) {
+	fStat.fNUnordered++;
+	return ready->fEvent;
+      }
+    }
+    return nullptr;
+  }
+}
+
+//-----------------------------------------------------------------------------
+void StntupleEventPool::Release(TStnEvent* Event) {
+  std::lock_guard<std::mutex> lock(fMutex);
+
+  int i = FindSlot(Event);
+  if (i >= 0) {
+    fSlot[i].fState = kFree;
+    fStat.fNCommitted++;
+  }
+}
+
+//-----------------------------------------------------------------------------
+// the branch addresses are the addresses of the master node block pointers,
+// ROOT picks up the new blocks on the next fill
+//-----------------------------------------------------------------------------
+int StntupleEventPool::Attach(TStnEvent* Event) {
+  if (fAttached) Detach();
+  if (Event == fMaster) return 0;
+
+  TObjArray* mlist = fMaster->GetListOfNodes();
+  TObjArray* rlist = Event->GetListOfNodes();
+
+  int nb = mlist->GetEntriesFast();
+  if (rlist->GetEntriesFast() != nb) {
+    printf(" StntupleEventPool::Attach: ERROR: replica has %i blocks, expected %i\n",
+	   rlist->GetEntriesFast(),nb);
+    return -1;
+  }
+
+  fMasterBlock.resize(nb);
+  for (int i=0; i<nb; i++) {
+    TStnDataBlock** address = ((TStnNode*) mlist->UncheckedAt(i))->GetDataBlockAddress();
+    fMasterBlock[i] = *address;
+    *address        = ((TStnNode*) rlist->UncheckedAt(i))->GetDataBlock();
+  }
+  fAttached = 1;
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+void StntupleEventPool::Detach() {
+  if (fAttached == 0) return;
+
+  TObjArray* mlist = fMaster->GetListOfNodes();
+
+  int nb = fMasterBlock.size();
+  for (int i=0; i<nb; i++) {
+    *((TStnNode*) mlist->UncheckedAt(i))->GetDataBlockAddress() = fMasterBlock[i];
+  }
+  fAttached = 0;
+}
+
+//-----------------------------------------------------------------------------
+void StntupleEventPool::Print(const char* Opt) const {
+  printf(" StntupleEventPool: schedules: %3i slots: %3i (max %3i)  max pending: %3i  acquired: %10li",
+	 fNSchedules,(int) fSlot.size(),fMaxSlots,fStat.fMaxPending,fStat.fNAcquired);
+  printf("  committed: %10li  dropped: %6li  out of order: %6li\n",
+	 fStat.fNCommitted,fStat.fNDropped,fStat.fNUnordered);
+}
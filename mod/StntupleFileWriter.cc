@@ -0,0 +1,188 @@
+//-----------------------------------------------------------------------------
+// 2026-10-18: background writer for the STNTUPLE files, see the header
+//-----------------------------------------------------------------------------
+#include <cstdio>
+
+#include "TFile.h"
+#include "TSystem.h"
+#include "TStopwatch.h"
+
+#include "Stntuple/mod/StntupleFileWriter.hh"
+
+//-----------------------------------------------------------------------------
+StntupleFileWriter::StntupleFileWriter() {
+  fBusy               = 0;
+  fStop               = 0;
+  fNextState          = 0;
+  fNextFile           = nullptr;
+  fStat.fNFiles       = 0;
+  fStat.fNOpened      = 0;
+  fStat.fStallTime    = 0;
+  fStat.fCloseTime    = 0;
+  fStat.fOpenTime     = 0;
+  fStat.fBytesWritten = 0;
+}
+
+//-----------------------------------------------------------------------------
+StntupleFileWriter::~StntupleFileWriter() {
+  Wait();
+  DiscardNext();
+  if (fThread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fStop = 1;
+    }
+    fCondition.notify_all();
+    fThread.join();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void StntupleFileWriter::Start() {
+  if (! fThread.joinable()) {
+    fThread = std::thread(&StntupleFileWriter::Run,this);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void StntupleFileWriter::Submit(TFile* File) {
+  Start();
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fQueue.push_back(File);
+  }
+  fCondition.notify_all();
+}
+
+//-----------------------------------------------------------------------------
+void StntupleFileWriter::Prepare(const char* Name) {
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    if (fNextState != 0) return;
+    fNextName  = Name;
+    fNextState = 1;
+  }
+  Start();
+  fCondition.notify_all();
+}
+
+//-----------------------------------------------------------------------------
+// the caller owns the returned file
+//-----------------------------------------------------------------------------
+TFile* StntupleFileWriter::TakeNext() {
+  std::unique_lock<std::mutex> lock(fMutex);
+  fCondition.wait(lock,[this]{ return fNextState != 1; });
+
+  TFile* f   = fNextFile;
+  fNextFile  = nullptr;
+  fNextState = 0;
+  return f;
+}
+
+//-----------------------------------------------------------------------------
+void StntupleFileWriter::DiscardNext() {
+  TFile* f = TakeNext();
+  if (f) {
+    TString name = f->GetName();
+    delete f;
+    gSystem->Unlink(name.Data());
+  }
+}
+
+//-----------------------------------------------------------------------------
+void StntupleFileWriter::Wait() {
+  std::unique_lock<std::mutex> lock(fMutex);
+  fCondition.wait(lock,[this]{ return fQueue.empty() && (fBusy == 0) && (fNextState != 1); });
+}
+
+//-----------------------------------------------------------------------------
+// gDirectory is thread-local with the thread safety enabled, opening the 
+// file doesn't change the current directory of the event loop
+//-----------------------------------------------------------------------------
+void StntupleFileWriter::Open() {
+  TStopwatch timer;
+  timer.Start();
+
+  TString name;
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    name = fNextName;
+  }
+
+  TFile* f = new TFile(name.Data(),"RECREATE");
+  if (f->IsZombie()) {
+    printf(" StntupleFileWriter::Open: ERROR: failed to open %s\n",name.Data());
+    delete f;
+    f = nullptr;
+  }
+
+  timer.Stop();
+
+  std::lock_guard<std::mutex> lock(fMutex);
+  fNextFile        = f;
+  fNextState       = 2;
+  fStat.fOpenTime += timer.RealTime();
+  if (f) fStat.fNOpened += 1;
+}
+
+//-----------------------------------------------------------------------------
+// the file has its own directory structure, the tree and the histogram 
+// folders written into it by the main thread before the submission
+//-----------------------------------------------------------------------------
+void StntupleFileWriter::Finish(TFile* File) {
+  TStopwatch timer;
+  timer.Start();
+
+  File->Write();
+  File->Close();
+
+  double nbytes = File->GetBytesWritten();
+  delete File;
+
+  timer.Stop();
+
+  std::lock_guard<std::mutex> lock(fMutex);
+  fStat.fNFiles       += 1;
+  fStat.fCloseTime    += timer.RealTime();
+  fStat.fBytesWritten += nbytes;
+}
+
+//-----------------------------------------------------------------------------
+void StntupleFileWriter::Run() {
+  while (1) {
+    TFile* f    = nullptr;
+    int    open = 0;
+    {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fCondition.wait(lock,[this]{ return fStop || (fNextState == 1) || (! fQueue.empty()); });
+//-----------------------------------------------------------------------------
+// the event loop may be waiting for the next file, open it first
+//-----------------------------------------------------------------------------
+      if      (fNextState == 1) open = 1;
+      else if (fQueue.empty() ) break;
+      else {
+	f     = fQueue.front();
+	fQueue.pop_front();
+      }
+      fBusy = 1;
+    }
+
+    if (open) Open();
+    else      Finish(f);
+
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fBusy = 0;
+    }
+    fCondition.notify_all();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void StntupleFileWriter::Print(const char* Opt) const {
+  printf(" StntupleFileWriter: files closed: %5i  bytes: %12.0f  event loop stall: %8.3f s",
+	 fStat.fNFiles,fStat.fBytesWritten,fStat.fStallTime);
+  printf("  background write+close: %8.3f s\n",fStat.fCloseTime);
+  printf(" StntupleFileWriter: files opened ahead of time: %5i  background open: %8.3f s\n",
+	 fStat.fNOpened,fStat.fOpenTime);
+}
@@ -66,6 +66,8 @@
 #include "Stntuple/mod/StntupleUtilities.hh"
 
 #include "Stntuple/base/TNamedHandle.hh"
+#include "Stntuple/base/TStnIOProfile.hh"
+#include "Stntuple/obj/TStnTagTree.hh"
 #include "Stntuple/alg/TStntuple.hh"
 
 #include "Offline/TrkReco/inc/DoubletAmbigResolver.hh"
@@ -355,7 +357,43 @@ StntupleMaker::StntupleMaker(fhicl::ParameterSet const& PSet):
   // fKalDiagHandle        = new TNamedHandle("KalDiagHandle"      ,fKalDiag);
 
   fFolder->Add(fDarHandle);
+//-----------------------------------------------------------------------------
+// per-block I/O profiles, see Stntuple/fcl/prolog.fcl
+// blockIOProfiles: list of "BlockName:ProfileName", "*" - any block
+//-----------------------------------------------------------------------------
+  vector<fhicl::ParameterSet> io_profiles = PSet.get<vector<fhicl::ParameterSet>>("ioProfiles",{});
+
+  for (const fhicl::ParameterSet& ps : io_profiles) {
+    TStnIOProfile* p = new TStnIOProfile(ps.get<string>   ("name"            ).data(),
+					 ps.get<string>   ("algorithm" ,""   ).data(),
+					 ps.get<int>      ("level"     ,1    ),
+					 ps.get<int>      ("basketSize",THistModule::BufferSize()),
+					 ps.get<int>      ("splitLevel",-1   ),
+					 ps.get<long long>("autoFlush" ,0    ));
+    AddIOProfile(p);
+  }
+
+  vector<string> block_profiles = PSet.get<vector<string>>("blockIOProfiles",{});
 
+  for (const string& bp : block_profiles) {
+    size_t loc = bp.find(':');
+    if (loc == string::npos) {
+      printf(" StntupleMaker: wrong blockIOProfiles entry \'%s\', expected \'Block:Profile\', ignore\n",
+	     bp.data());
+      continue;
+    }
+    SetBlockIOProfile(bp.substr(0,loc).data(),bp.substr(loc+1).data());
+  }
+
+  SetIOMeasurement(PSet.get<int>("ioMeasurement",0));
+//-----------------------------------------------------------------------------
+// makeTagTree != 0: write the per-event tag tree STNTAG next to STNTUPLE,
+// the leading tracks are taken from the first track block
+//-----------------------------------------------------------------------------
+  if (PSet.get<int>("makeTagTree",0) != 0) {
+    const char* track_block = (fTrackBlockName.size() > 0) ? fTrackBlockName[0].data() : "TrackBlock";
+    SetTagTree(new TStnTagTree(track_block,"ClusterBlock"));
+  }
 }
 
 
@@ -22,7 +22,10 @@
 #include "Stntuple/obj/TStnEvent.hh"
 #include "Stntuple/obj/TStnErrorLogger.hh"
 #include "Stntuple/obj/TStnDataBlock.hh"
+#include "Stntuple/obj/TStnTagTree.hh"
+#include "Stntuple/base/TStnIOProfile.hh"
 
+#include "Stntuple/mod/StntupleEventPool.hh"
 #include "Stntuple/mod/StntupleModule.hh"
 
 // ClassImp(StntupleModule)
@@ -30,6 +33,12 @@
 TStnEvent*       StntupleModule::fgEvent          = 0;
 TStnErrorLogger* StntupleModule::fgErrorLogger    = 0;
 TFolder*         StntupleModule::fgStntupleFolder = 0;
+
+TObjArray*       StntupleModule::fgListOfIOProfiles      = 0;
+TObjArray*       StntupleModule::fgListOfBlockIOProfiles = 0;
+int              StntupleModule::fgIOMeasurement         = 0;
+TStnTagTree*     StntupleModule::fgTagTree               = 0;
+StntupleEventPool* StntupleModule::fgEventPool           = 0;
 //-----------------------------------------------------------------------------
 // constructors
 //-----------------------------------------------------------------------------
@@ -44,6 +53,11 @@ StntupleModule::StntupleModule(fhicl::ParameterSet const& PSet, const char* Name
 							 "STNTUPLE folder");
     //    fgStntupleFolder->Add(fgErrorLogger);
     THistModule::fgMaxFileSize = 2000;
+
+    fgListOfIOProfiles      = new TObjArray();
+    fgListOfBlockIOProfiles = new TObjArray();
+
+    fgEventPool             = new StntupleEventPool(fgEvent);
   }
 }
 
@@ -52,10 +66,24 @@ StntupleModule::StntupleModule(fhicl::ParameterSet const& PSet, const char* Name
 StntupleModule::~StntupleModule() {
   // folders do not have to be deleted!
   if (fgEvent) {
+    delete fgEventPool;
+    fgEventPool = 0;
+
     delete fgEvent;
     fgEvent = 0;
     //    delete fgErrorLogger;
     fgErrorLogger = 0;
+
+    fgListOfIOProfiles->Delete();
+    delete fgListOfIOProfiles;
+    fgListOfIOProfiles = 0;
+
+    fgListOfBlockIOProfiles->Delete();
+    delete fgListOfBlockIOProfiles;
+    fgListOfBlockIOProfiles = 0;
+
+    delete fgTagTree;
+    fgTagTree = 0;
   }
 }
 
@@ -78,6 +106,84 @@ void StntupleModule::LogError(char* Message)
   printf(">>> StntupleModule::LogError(char* Message): message: %s\n",Message);
 }
 
+//-----------------------------------------------------------------------------
+// I/O profiles
+//-----------------------------------------------------------------------------
+int StntupleModule::AddIOProfile(TStnIOProfile* Profile) {
+  if (GetIOProfile(Profile->GetName())) {
+    printf(" StntupleModule::AddIOProfile: profile %s already defined, ignore\n",
+	   Profile->GetName());
+    delete Profile;
+    return -1;
+  }
+  fgListOfIOProfiles->Add(Profile);
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+TStnIOProfile* StntupleModule::GetIOProfile(const char* ProfileName) {
+  return (TStnIOProfile*) fgListOfIOProfiles->FindObject(ProfileName);
+}
+
+//-----------------------------------------------------------------------------
+void StntupleModule::SetBlockIOProfile(const char* BlockName, const char* ProfileName) {
+  TNamed* n = (TNamed*) fgListOfBlockIOProfiles->FindObject(BlockName);
+  if (n) n->SetTitle(ProfileName);
+  else   fgListOfBlockIOProfiles->Add(new TNamed(BlockName,ProfileName));
+}
+
+//-----------------------------------------------------------------------------
+TStnIOProfile* StntupleModule::GetBlockIOProfile(const char* BlockName) {
+  TNamed* n = (TNamed*) fgListOfBlockIOProfiles->FindObject(BlockName);
+  if (n == 0) n = (TNamed*) fgListOfBlockIOProfiles->FindObject("*");
+  if (n == 0) return 0;
+
+  TStnIOProfile* p = GetIOProfile(n->GetTitle());
+  if (p == 0) {
+    printf(" StntupleModule::GetBlockIOProfile: block %s: profile %s not defined\n",
+	   BlockName,n->GetTitle());
+  }
+  return p;
+}
+
+//-----------------------------------------------------------------------------
+// the block profile, if defined, overrides the defaults passed by the caller
+// the auto-flush cadence is a tree parameter, it is taken from the default 
+// ("*") profile only
+//-----------------------------------------------------------------------------
+TBranch* StntupleModule::CreateBranch(TStnNode*   Node,
+				      const char* ClassName,
+				      Int_t       BufferSize,
+				      Int_t       SplitLevel,
+				      Int_t       Compression) {
+  TBranch*       branch;
+  TStnIOProfile* p = GetBlockIOProfile(Node->GetName());
+
+  int buffer_size = BufferSize;
+  int split       = SplitLevel;
+
+  if (p) {
+    if (p->BasketSize() > 0) buffer_size = p->BasketSize();
+    if (p->SplitLevel() >= 0) split      = p->SplitLevel();
+  }
+
+  branch = fgTree->Branch(Node->GetName(),ClassName,
+			  Node->GetDataBlockAddress(),
+			  buffer_size,
+			  split);
+  if (p) {
+    branch->SetCompressionSettings(p->CompressionSettings());
+
+    TStnIOProfile* def = GetBlockIOProfile("*");
+    if (def && (def->AutoFlush() != 0)) fgTree->SetAutoFlush(def->AutoFlush());
+  }
+  else {
+    branch->SetCompressionLevel(Compression);
+  }
+
+  return branch;
+}
+
 //_____________________________________________________________________________
 TStnDataBlock* StntupleModule::AddDataBlock(const char* branch_name,
 					    const char* class_name,
@@ -88,7 +194,6 @@ TStnDataBlock* StntupleModule::AddDataBlock(const char* branch_name,
 {
   // adds new branch to fgTree and registers a data block corresponding to it
 
-  TBranch*       branch;
   TStnDataBlock* block;
 
   int            rc;
@@ -100,11 +205,7 @@ TStnDataBlock* StntupleModule::AddDataBlock(const char* branch_name,
   if (rc == 0) {
 				// everything is OK
 
-    branch = fgTree->Branch(branch_name,class_name,
-			    node->GetDataBlockAddress(),
-			    buffer_size,
-			    split);
-    branch->SetCompressionLevel(compression);
+    CreateBranch(node,class_name,buffer_size,split,compression);
     block = node->GetDataBlock();
     block->SetExternalInit(f);
     block->SetNode(node);
@@ -140,7 +241,6 @@ TStnDataBlock* StntupleModule::AddDataBlock(const char*        branch_name,
 					    Int_t              compression) 
 {
 
-  TBranch*       branch;
   TStnDataBlock* block;
 
   int            rc;
@@ -152,11 +252,7 @@ TStnDataBlock* StntupleModule::AddDataBlock(const char*        branch_name,
   if (rc == 0) {
 				// everything is OK
 
-    branch = fgTree->Branch(branch_name,class_name,
-			   node->GetDataBlockAddress(),
-			   buffer_size,
-			   split);
-    branch->SetCompressionLevel(compression);
+    CreateBranch(node,class_name,buffer_size,split,compression);
     block = node->GetDataBlock();
     block->SetNode(node);
     block->SetInitBlock(InitBlock);
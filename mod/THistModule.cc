@@ -142,6 +142,34 @@ int THistModule::OpenNewFile(const char* Filename) {
 }
 
 
+//-----------------------------------------------------------------------------
+// the module subdirectories are recreated in the new file, the cached 
+// directories pointing into the old file are redirected
+//-----------------------------------------------------------------------------
+int THistModule::MoveToFile(TFile* NewFile) {
+  TFile* old_file = fgFile;
+
+  int nm = (fgModuleList) ? fgModuleList->GetEntriesFast() : 0;
+  for (int i=0; i<nm; i++) {
+    THistModule* m = (THistModule*) fgModuleList->UncheckedAt(i);
+
+    if (fgMakeSubdirs && (NewFile->GetDirectory(m->fDirName.Data()) == 0)) {
+      NewFile->mkdir(m->fDirName.Data());
+    }
+
+    if (m->fOldDir && old_file && (m->fOldDir->GetFile() == old_file)) {
+      TDirectory* dir = nullptr;
+      if (m->fOldDir != old_file) dir = NewFile->GetDirectory(m->fOldDir->GetName());
+      m->fOldDir = (dir) ? dir : NewFile;
+    }
+  }
+
+  fgFile = NewFile;
+  if (old_file && (gDirectory->GetFile() == old_file)) NewFile->cd();
+
+  return 0;
+}
+
 //______________________________________________________________________________
 int THistModule::beforeBeginJob() {
 
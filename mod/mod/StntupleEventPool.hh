@@ -0,0 +1,119 @@
+//-----------------------------------------------------------------------------
+// StntupleEventPool: per-event STNTUPLE block sets for running the stntuple
+// making chain (InitStntuple ... FillStntuple) with several art schedules
+//
+// - InitStntuple acquires a free block set (slot) for the event and fills it,
+//   FillStntuple finds the slot by the event ID, resolves the links and
+//   marks it ready
+// - ready slots are committed to the tree by FillStntuple, one at a time, in
+//   the order in which the events have been acquired
+// - slot 0 is the master event (StntupleModule::fgEvent), its nodes own the
+//   STNTUPLE branches. The other slots are replicas with the same blocks and
+//   init functions, created when all existing slots are busy. There are
+//   at most MaxSlots = NSchedules+Window slots: one per art schedule for the
+//   events in flight, and a reorder window for the ready events waiting for
+//   an older one. With a single schedule only slot 0 is used, same as before
+// - a replica is committed by pointing the master nodes to its blocks for
+//   the duration of the tree fill (Attach/Detach)
+// - at most NSchedules events can be in between InitStntuple and 
+//   FillStntuple at the same time. If there are more filled slots than that,
+//   the oldest ones belong to events which never reached FillStntuple 
+//   (rejected by a filter placed in between) - such a slot is dropped, 
+//   silently, and reused
+// - the events are committed in order as long as an event is not overtaken
+//   by more than Window later ones. When all MaxSlots slots are busy, the 
+//   oldest ready event is committed ahead of the older one still in flight,
+//   and counted as out of order
+//
+// art runs legacy modules serialized, the mutex protects the slot table in
+// case the caller doesn't
+//-----------------------------------------------------------------------------
+#ifndef Stntuple_mod_StntupleEventPool_hh
+#define Stntuple_mod_StntupleEventPool_hh
+
+#include <mutex>
+#include <vector>
+
+class TStnEvent;
+class TStnDataBlock;
+
+class StntupleEventPool {
+public:
+  enum { kFree = 0, kFilled = 1, kReady = 2 };
+
+  struct Slot_t {
+    TStnEvent*  fEvent;
+    int         fState;
+    long int    fSeq;			// acquisition sequence number
+  };
+
+  struct Stat_t {
+    long int    fNAcquired;
+    long int    fNCommitted;
+    long int    fNDropped;		// never reached FillStntuple
+    long int    fNUnordered;		// committed ahead of an older event
+    int         fMaxPending;		// max number of acquired, not committed events
+  };
+
+protected:
+  TStnEvent*                   fMaster;	// not owned
+  std::vector<Slot_t>          fSlot;
+					// master blocks, restored by Detach
+  std::vector<TStnDataBlock*>  fMasterBlock;
+  int                          fAttached;
+  long int                     fNextSeq;
+  int                          fNSchedules;
+  int                          fMaxSlots;
+  Stat_t                       fStat;
+  std::mutex                   fMutex;
+//-----------------------------------------------------------------------------
+// functions
+//-----------------------------------------------------------------------------
+protected:
+  TStnEvent*  MakeReplica();
+  int         FindSlot   (TStnEvent* Event);
+  int         NFree      () const;
+  int         NFilled    () const;
+					// the oldest slot in a given state,
+					// nullptr if none
+  Slot_t*     Oldest     (int State);
+					// free the slot of an event which
+					// never reached FillStntuple
+  void        Drop       (Slot_t* Slot);
+
+public:
+  StntupleEventPool(TStnEvent* Master);
+  ~StntupleEventPool();
+
+  int         NSlots     () const { return fSlot.size(); }
+  int         MaxSlots   () const { return fMaxSlots;    }
+  int         NSchedules () const { return fNSchedules;  }
+  const Stat_t* GetStat  () const { return &fStat;       }
+
+					// number of art schedules and the 
+					// reorder window, the latter is not
+					// needed with a single schedule
+  void        SetNSchedules(int N, int Window);
+					// slot for a new event, the event
+					// number is stored in the TStnEvent
+  TStnEvent*  Acquire    (int Run, int Subrun, int Event);
+					// slot filled for the event, nullptr
+					// if there is none
+  TStnEvent*  Find       (int Run, int Subrun, int Event);
+
+  void        SetReady   (TStnEvent* Event);
+					// next slot to be committed, nullptr
+					// if the next one is not ready yet.
+					// Flush != 0: drop the not ready ones
+  TStnEvent*  NextCommit (int Flush = 0);
+					// slot committed, free it
+  void        Release    (TStnEvent* Event);
+					// make the master nodes (and branches)
+					// point to the blocks of Event
+  int         Attach     (TStnEvent* Event);
+  void        Detach     ();
+
+  void        Print      (const char* Opt = "") const;
+};
+
+#endif
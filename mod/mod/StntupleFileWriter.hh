@@ -0,0 +1,79 @@
+//-----------------------------------------------------------------------------
+// StntupleFileWriter: takes the file I/O of the STNTUPLE file rotation in
+// FillStntuple off the art event loop, in a background thread
+// - Prepare : opens the next output file ahead of time, TakeNext hands it
+//             over at the rotation
+// - Submit  : finishes (writes, closes and deletes) the full file 
+//
+// a submitted file is owned by the writer and must not be touched by 
+// the caller any more, ROOT has to run with ROOT::EnableThreadSafety()
+//-----------------------------------------------------------------------------
+#ifndef Stntuple_mod_StntupleFileWriter_hh
+#define Stntuple_mod_StntupleFileWriter_hh
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+#include "TString.h"
+
+class TFile;
+
+class StntupleFileWriter {
+public:
+  struct Stat_t {
+    int     fNFiles;			// number of closed files
+    int     fNOpened;			// number of files opened ahead of time
+    double  fStallTime;			// event loop stall time, seconds
+    double  fCloseTime;			// background write+close time, seconds
+    double  fOpenTime;			// background open time, seconds
+    double  fBytesWritten;		// total, for the closed files
+  };
+
+protected:
+  std::thread              fThread;
+  std::mutex               fMutex;
+  std::condition_variable  fCondition;
+  std::deque<TFile*>       fQueue;
+  int                      fBusy;	// 1 while a file is being opened or closed
+  int                      fStop;
+					// next file: 0:none, 1:requested, 2:open
+  int                      fNextState;
+  TString                  fNextName;
+  TFile*                   fNextFile;
+  Stat_t                   fStat;
+//-----------------------------------------------------------------------------
+// functions
+//-----------------------------------------------------------------------------
+protected:
+  void   Run();
+  void   Finish(TFile* File);
+  void   Open  ();
+
+public:
+  StntupleFileWriter();
+  ~StntupleFileWriter();
+					// start the thread, called on the 
+					// first submission
+  void   Start ();
+  void   Submit(TFile* File);
+					// open the next file in the background,
+					// no-op if it has been requested already
+  void   Prepare(const char* Name);
+					// wait for the file requested by Prepare,
+					// nullptr if none or the open failed
+  TFile* TakeNext();
+					// close and remove the file opened ahead
+					// of time, but never used
+  void   DiscardNext();
+					// wait till all submitted files are closed
+  void   Wait  ();
+  void   AddStallTime(double Time) { fStat.fStallTime += Time; }
+
+  const Stat_t* GetStat() const { return &fStat; }
+
+  void   Print(const char* Opt = "") const ;
+};
+
+#endif
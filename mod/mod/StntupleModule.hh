@@ -12,11 +12,16 @@
 #include "Stntuple/mod/THistModule.hh"
 
 class TStnInitDataBlock;
+class TStnIOProfile;
+class TStnNode;
 
+class TBranch;
 class TFolder;
 class TStnEvent;
 class TStnErrorLogger;
 class TStnDataBlock;
+class TStnTagTree;
+class StntupleEventPool;
 
 class StntupleModule : public THistModule {
 //-----------------------------------------------------------------------------
@@ -27,6 +32,24 @@ protected:
   static TStnErrorLogger* fgErrorLogger;
   static TFolder*         fgStntupleFolder;
 //-----------------------------------------------------------------------------
+// per-block I/O profiles: fgListOfBlockIOProfiles contains TNamed's with 
+// name=block name and title=profile name, block name "*" defines the default
+// fgIOMeasurement != 0: FillStntuple times filling of individual branches
+//-----------------------------------------------------------------------------
+  static TObjArray*       fgListOfIOProfiles;
+  static TObjArray*       fgListOfBlockIOProfiles;
+  static int              fgIOMeasurement;
+//-----------------------------------------------------------------------------
+// optional per-event tag tree (see TStnTagTree.hh), created by StntupleMaker,
+// filled and written out by FillStntuple
+//-----------------------------------------------------------------------------
+  static TStnTagTree*     fgTagTree;
+//-----------------------------------------------------------------------------
+// per-event block sets, one per event in flight (see StntupleEventPool.hh),
+// fgEvent is the first one and owns the branches
+//-----------------------------------------------------------------------------
+  static StntupleEventPool* fgEventPool;
+//-----------------------------------------------------------------------------
 // function members
 //-----------------------------------------------------------------------------
 public:
@@ -57,9 +80,35 @@ public:
 				      Int_t              split_level,
 				      Int_t              compression);
 
+  static int             AddIOProfile     (TStnIOProfile* Profile);
+  static TStnIOProfile*  GetIOProfile     (const char* ProfileName);
+  static void            SetBlockIOProfile(const char* BlockName, const char* ProfileName);
+
+					// profile to be used for a given block,
+					// nullptr if not defined
+  static TStnIOProfile*  GetBlockIOProfile(const char* BlockName);
+
+  static int             IOMeasurement   () { return fgIOMeasurement; }
+  static void            SetIOMeasurement(int Flag) { fgIOMeasurement = Flag; }
+
+  static StntupleEventPool* EventPool() { return fgEventPool; }
+
+  static TStnTagTree*    TagTree   () { return fgTagTree; }
+  static void            SetTagTree(TStnTagTree* Tree) { fgTagTree = Tree; }
+
   static Int_t SetResolveLinksMethod(const char* BlockName, 
 				     Int_t      (*f)(TStnDataBlock*,AbsEvent*,Int_t));
 
+protected:
+					// create branch for a new node, apply 
+					// the block I/O profile, if any
+  static TBranch*        CreateBranch(TStnNode*   Node,
+				      const char* ClassName,
+				      Int_t       BufferSize,
+				      Int_t       SplitLevel,
+				      Int_t       Compression);
+public:
+
   void      LogError(const char* Message);
   void      LogError(char* Message);
 
@@ -94,6 +94,13 @@ public:
 //-----------------------------------------------------------------------------
   int        SetFileName    (const char* Filename);
   int        OpenNewFile    (const char* Filename);
+//-----------------------------------------------------------------------------
+// file rotation: all modules move from the directories of the current 
+// file to the same directories of NewFile, which becomes the current file.
+// After the call the old file is not referenced by the modules any more
+// and can be closed
+//-----------------------------------------------------------------------------
+  static int MoveToFile     (TFile* NewFile);
 
 					// ****** overloaded methods of the 
 					// base class
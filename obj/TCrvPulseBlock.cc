@@ -34,9 +34,11 @@ ClassImp(TCrvPulseBlock)
 TCrvPulseBlock::TCrvPulseBlock() {
   fListOfPulses = new TClonesArray("TCrvRecoPulse",1000);
   fListOfPulses->BypassStreamer(kFALSE);
+  RegisterArray(fListOfPulses);
 
   fListOfCoincidences = new TClonesArray("TCrvCoincidence",100);
   fListOfCoincidences->BypassStreamer(kFALSE);
+  RegisterArray(fListOfCoincidences);
 
   fCoincidencePulseLinks = new TStnLinkBlock();
 
@@ -78,6 +78,7 @@ TGenpBlock::TGenpBlock() {
 
   fListOfParticles = new TClonesArray("TGenParticle",100);
   fListOfParticles->BypassStreamer(kFALSE);
+  RegisterArray(fListOfParticles);
 }
 
 
@@ -115,9 +116,7 @@ TGenpBlock::NewParticle(Int_t PdgCode, Int_t GeneratorID,
   // assume that this is the last particle (not necessarily!) and it is 
   // added to the last primary interaction
 
-  TGenParticle* p;
-
-  p = new ((*fListOfParticles)[fNParticles]) TGenParticle();
+  TGenParticle* p = (TGenParticle*) NewObject(fListOfParticles,fNParticles);
 
   p->Init(fNParticles,PdgCode,GeneratorID,m1,m2,d1,d2,
 	  px,py,pz,e,vx,vy,vz,t,ProperTime);
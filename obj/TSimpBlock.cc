@@ -20,6 +20,7 @@ void TSimpBlock::Streamer(TBuffer &R__b)
     for (int i=0; i<fNParticles; i++) {
       Particle(i)->SetNumber(i);
     }
+    fIndexInitialized = 0;
   } 
   else {
     R__b.WriteVersion(TSimpBlock::IsA());
@@ -34,6 +35,8 @@ TSimpBlock::TSimpBlock() {
   fNParticles      = 0;
   fListOfParticles = new TClonesArray("TSimParticle",10);
   fListOfParticles->BypassStreamer(kFALSE);
+  RegisterArray(fListOfParticles);
+  fIndexInitialized = 0;
 }
 
 
@@ -49,6 +52,7 @@ void TSimpBlock::Clear(const char* opt) {
   fNParticles    = 0;
 					// don't modify cut values at run time
   fListOfParticles->Clear(opt);
+  fIndexInitialized = 0;
 
   f_EventNumber       = -1;
   f_RunNumber         = -1;
@@ -58,20 +62,84 @@ void TSimpBlock::Clear(const char* opt) {
 
 
 //-----------------------------------------------------------------------------
-// find TSimParticle with given ID
+// build SimParticle ID --> index map and the daughter lists (CSR-like: 
+// offsets + indices), the cost is O(N), after that FindParticle is O(1)
+// if the same ID is stored twice, the first occurence wins - same as 
+// the linear search used before
 //-----------------------------------------------------------------------------
-TSimParticle* TSimpBlock::FindParticle(int ID) {
-  TSimParticle* par(NULL);
+int TSimpBlock::BuildIndex() {
+
+  fIndex.clear();
+  fIndex.reserve(2*fNParticles);
 
   for (int i=0; i<fNParticles; i++) {
-    TSimParticle* p = Particle(i);
-    int id = p->GetUniqueID();
-    if ( id == ID) {
-      par = p;
-      break;
+    int id = Particle(i)->GetUniqueID();
+    fIndex.emplace(id,i);
+  }
+
+  fDaughterOffset.assign(fNParticles+1,0);
+  fDaughterIndex.resize(fNParticles);
+
+  std::vector<int> parent(fNParticles,-1);
+
+  for (int i=0; i<fNParticles; i++) {
+    std::unordered_map<int,int>::const_iterator it = fIndex.find(Particle(i)->ParentID());
+    if ((it != fIndex.end()) && (it->second != i)) {
+      parent[i] = it->second;
+      fDaughterOffset[it->second+1] += 1;
     }
   }
-  return par;
+
+  for (int i=0; i<fNParticles; i++) fDaughterOffset[i+1] += fDaughterOffset[i];
+
+  std::vector<int> loc(fDaughterOffset.begin(),fDaughterOffset.end()-1);
+  for (int i=0; i<fNParticles; i++) {
+    if (parent[i] >= 0) {
+      fDaughterIndex[loc[parent[i]]] = i;
+      loc[parent[i]] += 1;
+    }
+  }
+
+  fIndexInitialized = 1;
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+// walk up the parent chain, protect against loops in corrupted records
+//-----------------------------------------------------------------------------
+int TSimpBlock::GetParentChain(TSimParticle* P, std::vector<TSimParticle*>* Chain) {
+  Chain->clear();
+
+  TSimParticle* p = P;
+  while (p && ((int) Chain->size() <= fNParticles)) {
+    Chain->push_back(p);
+    p = Parent(p);
+  }
+  return Chain->size();
+}
+
+//-----------------------------------------------------------------------------
+// breadth-first traversal of the daughter lists
+//-----------------------------------------------------------------------------
+int TSimpBlock::GetDescendants(TSimParticle* P, std::vector<TSimParticle*>* List) {
+  List->clear();
+
+  int i0 = ParticleIndex(P->GetUniqueID());
+  if (i0 < 0) return 0;
+
+  std::vector<int> queue;
+  queue.push_back(i0);
+
+  for (size_t k=0; (k<queue.size()) && ((int) queue.size() <= fNParticles); k++) {
+    int i  = queue[k];
+    int nd = NDaughters(i);
+    for (int j=0; j<nd; j++) {
+      int ind = fDaughterIndex[fDaughterOffset[i]+j];
+      queue.push_back(ind);
+      List->push_back(Particle(ind));
+    }
+  }
+  return List->size();
 }
 
 //_____________________________________________________________________________
@@ -84,13 +152,14 @@ TSimParticle* TSimpBlock::NewParticle(int ID, int ParentID, int PdgCode,
   // assume that this is the last particle (not necessarily!) and it is 
   // added to the last primary interaction
 
-  TSimParticle* p;
-
-  p = new ((*fListOfParticles)[fNParticles]) 
-            TSimParticle(ID,ParentID, PdgCode,CreationCode,TerminationCode,
-			 StartVolumeIndex,EndVolumeIndex,GenProcessID);
+  TSimParticle* p = (TSimParticle*) NewObject(fListOfParticles,fNParticles);
+					// a reused particle may own fShid
+  p->Clear();
+  p->Init(ID,ParentID, PdgCode,CreationCode,TerminationCode,
+	  StartVolumeIndex,EndVolumeIndex,GenProcessID);
 
-  fNParticles += 1;
+  fNParticles      += 1;
+  fIndexInitialized = 0;
 
   return p;
 }
@@ -106,10 +106,28 @@ TStepPointMC::TStepPointMC(int VolumeID    , int GenIndex      ,
 			   float EDepTot   , float EDepNio     , 
 			   float Time      , float ProperTime  ,
 			   float StepLength,
-			   float X, float Y, float Z, float Px, float Py, float Pz):
-  fPos( X, Y, Z),
-  fMom(Px,Py,Pz)
+			   float X, float Y, float Z, float Px, float Py, float Pz)
 {
+  Set(VolumeID,GenIndex,SimID,PDGCode,ParentSimID,ParentPDGCode,
+      CreationCode,EndProcessCode,EDepTot,EDepNio,Time,ProperTime,StepLength,
+      X,Y,Z,Px,Py,Pz);
+}
+
+//-----------------------------------------------------------------------------
+// also used to refill an object reused by TStepPointMCBlock
+//-----------------------------------------------------------------------------
+void TStepPointMC::Set(int VolumeID    , int GenIndex      , 
+		       int SimID       , int PDGCode       ,
+		       int ParentSimID , int ParentPDGCode , 
+		       int CreationCode, int EndProcessCode, 
+		       float EDepTot   , float EDepNio     , 
+		       float Time      , float ProperTime  ,
+		       float StepLength,
+		       float X, float Y, float Z, float Px, float Py, float Pz)
+{
+  fPos.SetXYZ( X, Y, Z);
+  fMom.SetXYZ(Px,Py,Pz);
+
   fVolumeID       = VolumeID;
   fGenIndex       = GenIndex;
   fSimID          = SimID;
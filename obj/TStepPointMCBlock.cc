@@ -48,6 +48,7 @@ void TStepPointMCBlock::Streamer(TBuffer &R__b) {
       R__b >> fG4RealTime;		// added in V2
       fListOfStepPoints->Streamer(R__b);
     }
+    fVolumeIndex.Invalidate();
   } 
   else {
     R__b.WriteVersion(TStepPointMCBlock::IsA());
@@ -77,6 +78,7 @@ TStepPointMCBlock::TStepPointMCBlock() {
   
   fListOfStepPoints = new TClonesArray("TStepPointMC",10);
   fListOfStepPoints->BypassStreamer(kFALSE);
+  RegisterArray(fListOfStepPoints);
 }
 
 
@@ -87,6 +89,12 @@ TStepPointMCBlock::~TStepPointMCBlock() {
 }
 
 
+//_____________________________________________________________________________
+void TStepPointMCBlock::CopyConfiguration(const TStnDataBlock* Block) {
+  TStnDataBlock::CopyConfiguration(Block);
+  fGenProcessID = ((const TStepPointMCBlock*) Block)->fGenProcessID;
+}
+
 //_____________________________________________________________________________
 void TStepPointMCBlock::Clear(const char* opt) {
   fNStepPoints      = 0;
@@ -99,6 +107,7 @@ void TStepPointMCBlock::Clear(const char* opt) {
   fG4RealTime       = -1;
 					// don't modify cut values at run time
   fListOfStepPoints->Clear(opt);
+  fVolumeIndex.Invalidate();
 
   f_EventNumber       = -1;
   f_RunNumber         = -1;
@@ -122,21 +131,31 @@ TStepPointMCBlock::NewStepPointMC(int VolumeID, int GenIndex,
   // assume that this is the last particle (not necessarily!) and it is 
   // added to the last primary interaction
 
-  TStepPointMC* sp;
+  TStepPointMC* sp = (TStepPointMC*) NewObject(fListOfStepPoints,fNStepPoints);
 
-  sp = new ((*fListOfStepPoints)[fNStepPoints]) TStepPointMC(VolumeID,GenIndex,
-							     SimID, PDGCode,
-							     ParentSimID, ParentPDGCode,
-							     CreationCode, EndProcessCode,
-							     EDepTot,EDepNio,
-							     Time,ProperTime,StepLength,
-							     X,Y,Z,Px,Py,Pz);
+  sp->Set(VolumeID,GenIndex,
+	  SimID, PDGCode,
+	  ParentSimID, ParentPDGCode,
+	  CreationCode, EndProcessCode,
+	  EDepTot,EDepNio,
+	  Time,ProperTime,StepLength,
+	  X,Y,Z,Px,Py,Pz);
   fNStepPoints += 1;
+  fVolumeIndex.Invalidate();
 
   return sp;
 }
 
 
+//_____________________________________________________________________________
+int TStepPointMCBlock::BuildVolumeIndex() {
+  fStepVolumeID.resize(fNStepPoints);
+  for (int i=0; i<fNStepPoints; i++) {
+    fStepVolumeID[i] = StepPointMC(i)->VolumeID();
+  }
+  return fVolumeIndex.Build(fStepVolumeID.data(),fNStepPoints);
+}
+
 //_____________________________________________________________________________
 void TStepPointMCBlock::Print(const char* Opt) const {
   // opt: /c : comment lines only, useful for printing the hard interaction only
@@ -132,7 +132,11 @@ TStnCluster::~TStnCluster() {
 
 //-----------------------------------------------------------------------------
 void TStnCluster::Clear(Option_t* opt) {
-  Error("Print", "Not implemented yet");
+  // reset the transient part, the persistent data are overwritten when the
+  // cluster is filled
+  fNumber       = -1;
+  fCaloCluster  = 0;
+  fClosestTrack = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -29,6 +29,7 @@ TStnClusterBlock::TStnClusterBlock() {
   fNClusters   = 0;
   fListOfClusters = new TClonesArray("TStnCluster",100);
   fListOfClusters->BypassStreamer(kFALSE);
+  RegisterArray(fListOfClusters);
   fCollName  = "default";
 }
 
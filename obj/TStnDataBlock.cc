@@ -18,6 +18,7 @@
 #include <iostream>
 
 #include "TClass.h"
+#include "TClonesArray.h"
 #include "Stntuple/obj/TStnDataBlock.hh"
 #include "Stntuple/obj/TStnNode.hh"
 #include "Stntuple/obj/TStnEvent.hh"
@@ -46,6 +47,7 @@ TStnDataBlock::TStnDataBlock():
   f_SubrunNumber      = -1;
   fListOfCollNames    = new TObjArray();
   fInitBlock          = nullptr;
+  fNAllocated         = 0;
 }
 
 
@@ -103,7 +105,77 @@ Int_t TStnDataBlock::GetEntry(Int_t TreeEntry) {
   if (fCurrentEntry == current_entry) return 1;
   fCurrentEntry = current_entry;
 
-  return fNode->GetEntry(TreeEntry);
+  int nb = fNode->GetEntry(TreeEntry);
+  if (fListOfArrays.size() > 0) UpdateAllocations();
+  return nb;
+}
+
+//_____________________________________________________________________________
+void TStnDataBlock::RegisterArray(TClonesArray* List) {
+  fListOfArrays.push_back(List);
+  fHighWaterMark.push_back(0);
+}
+
+//_____________________________________________________________________________
+TObject* TStnDataBlock::NewObject(TClonesArray* List, Int_t I) {
+
+  int n = fListOfArrays.size();
+  for (int i=0; i<n; i++) {
+    if (fListOfArrays[i] != List) continue;
+    if (I >= fHighWaterMark[i]) {
+      fNAllocated      += I+1-fHighWaterMark[i];
+      fHighWaterMark[i] = I+1;
+    }
+    break;
+  }
+  return List->ConstructedAt(I);
+}
+
+//-----------------------------------------------------------------------------
+// the objects constructed here stay in the arrays after Clear() and are
+// reused by the streamer and by NewObject, they are not counted as allocated
+//-----------------------------------------------------------------------------
+Int_t TStnDataBlock::Reserve(Int_t N) {
+
+  int n = fListOfArrays.size();
+  for (int i=0; i<n; i++) {
+    if (N <= fHighWaterMark[i]) continue;
+    TClonesArray* list = fListOfArrays[i];
+    for (int k=0; k<N; k++) list->ConstructedAt(k);
+    list->Clear();
+    fHighWaterMark[i] = N;
+  }
+  return 0;
+}
+
+//_____________________________________________________________________________
+void TStnDataBlock::UpdateAllocations() {
+
+  int n = fListOfArrays.size();
+  for (int i=0; i<n; i++) {
+    int nobj = fListOfArrays[i]->GetEntriesFast();
+    if (nobj > fHighWaterMark[i]) {
+      fNAllocated      += nobj-fHighWaterMark[i];
+      fHighWaterMark[i] = nobj;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+// used to make a replica of an output block, the replica is filled with the 
+// same init functions, but doesn't own neither the init block nor the 
+// collection names - the caller has to reset fInitBlock before deleting it
+//-----------------------------------------------------------------------------
+void TStnDataBlock::CopyConfiguration(const TStnDataBlock* Block) {
+  fUserInitialization = Block->fUserInitialization;
+  fExternalInit       = Block->fExternalInit;
+  fResolveLinks       = Block->fResolveLinks;
+  fInitMode           = Block->fInitMode;
+  fCollName           = Block->fCollName;
+  fInitBlock          = Block->fInitBlock;
+
+  fListOfCollNames->Clear();
+  fListOfCollNames->AddAll(Block->fListOfCollNames);
 }
 
 //_____________________________________________________________________________
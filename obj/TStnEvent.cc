@@ -35,7 +35,12 @@ TStnEvent::TStnEvent() {
 
   fListOfUnusedNodes = new TObjArray(10);
 
-  fLastNumber = -1;
+  fLastNumber          = -1;
+
+  fNIndexedNodes       = 0;
+  fNIndexedOutputNodes = 0;
+  fDebugNameLookups    = 0;
+  fNNameLookups        = 0;
 }
 
 
@@ -53,12 +58,14 @@ TStnEvent::~TStnEvent()
 //-----------------------------------------------------------------------------
   //printf(" TStnEvent: nodes.\n"); fflush(stdout); fflush(stderr);
   fListOfNodes->Clear();             // These are a subset of fListOfInputNodes
+  fNIndexedNodes = -1;
   delete fListOfNodes;
 //-----------------------------------------------------------------------------
 //  output nodes are owned by the event itself
 //-----------------------------------------------------------------------------
   //printf(" TStnEvent: output nodes.\n"); fflush(stdout); fflush(stderr);
   fListOfOutputNodes->Clear();            // These are a subset of fListOfNodes
+  fNIndexedOutputNodes = -1;
   delete fListOfOutputNodes;
 //-----------------------------------------------------------------------------
 //  list of unused nodes has to be deleted (not used as far as I see!)
@@ -134,7 +141,7 @@ Int_t TStnEvent::AddDataBlock(const char* branch_name,
 					// make sure there is no branch with 
 					// the same name 
 
-  node = (TStnNode*)  fListOfNodes->FindObject(branch_name);
+  node = FindNode(branch_name);
   if (node) {
 					// node already exists, generate 
 					// warning
@@ -143,7 +150,7 @@ Int_t TStnEvent::AddDataBlock(const char* branch_name,
 					// everything is OK, create new node
 
   node = new TStnNode(branch_name,cl,this);
-  fListOfNodes->Add(node);
+  AddNode(node);
 
   return 0;
 }
@@ -156,7 +163,7 @@ Int_t TStnEvent::AddOutputBlock(const char* BranchName, TStnDataBlock* Block) {
   Int_t    rc = 0;
 					// make sure there is no branch with 
 					// the same name 
-  node = (TStnNode*)  fListOfOutputNodes->FindObject(BranchName);
+  node = FindOutputNode(BranchName);
   if (node) {
 					// node already exists, report an error
     Error("AddDataBlock","block %s already registered",BranchName);
@@ -167,22 +174,83 @@ Int_t TStnEvent::AddOutputBlock(const char* BranchName, TStnDataBlock* Block) {
 					// not to the list of active input 
 					// nodes
   node = new TStnNode(BranchName,Block,this);
-  fListOfOutputNodes->Add(node);
+  AddOutputNode(node);
 
   return rc;
 }
 
 
+//_____________________________________________________________________________
+void TStnEvent::AddNode(TStnNode* Node) {
+  fListOfNodes->Add(Node);
+  fNIndexedNodes = -1;
+}
+
+//_____________________________________________________________________________
+void TStnEvent::AddOutputNode(TStnNode* Node) {
+  fListOfOutputNodes->Add(Node);
+  fNIndexedOutputNodes = -1;
+}
+
+//-----------------------------------------------------------------------------
+// the index is rebuilt after it has been invalidated; the check of the 
+// number of nodes only catches additions made bypassing AddNode.
+// In case of duplicate names the first node wins, same as for FindObject
+//-----------------------------------------------------------------------------
+void TStnEvent::UpdateNodeIndex(TObjArray* List, 
+				std::unordered_map<std::string,TStnNode*>* Index,
+				Int_t* NIndexed) {
+  int n = List->GetEntriesFast();
+
+  if (n == *NIndexed) return;
+
+  if ((*NIndexed < 0) || (n < *NIndexed)) {
+					// start over
+    Index->clear();
+    *NIndexed = 0;
+  }
+
+  for (int i=*NIndexed; i<n; i++) {
+    TStnNode* node = (TStnNode*) List->UncheckedAt(i);
+    if (node) Index->emplace(node->GetName(),node);
+  }
+  *NIndexed = n;
+}
+
+//_____________________________________________________________________________
+TStnNode* TStnEvent::FindNode(const char* name) { 
+  UpdateNodeIndex(fListOfNodes,&fNodeIndex,&fNIndexedNodes);
+
+  std::unordered_map<std::string,TStnNode*>::const_iterator it = fNodeIndex.find(name);
+  return (it != fNodeIndex.end()) ? it->second : nullptr;
+}
+
+//_____________________________________________________________________________
+TStnNode* TStnEvent::FindOutputNode(const char* name) { 
+  UpdateNodeIndex(fListOfOutputNodes,&fOutputNodeIndex,&fNIndexedOutputNodes);
+
+  std::unordered_map<std::string,TStnNode*>::const_iterator it = fOutputNodeIndex.find(name);
+  return (it != fOutputNodeIndex.end()) ? it->second : nullptr;
+}
+
+//_____________________________________________________________________________
+TStnNode* TStnEvent::GetBlockNode(const char* branch_name) {
+  // try the list of input nodes first, then - the list of output nodes
+
+  TStnNode* node = FindNode(branch_name);
+  if (!node) node = FindOutputNode(branch_name);
+
+  return node;
+}
+
 //_____________________________________________________________________________
 TStnDataBlock* TStnEvent::GetDataBlock(const char* branch_name) {
   // return pointer to the data block corresponding to branch `branch_name'
+  // modules calling it on every event are better off with TStnBlockHandle
 
-  TStnNode* node = (TStnNode*) fListOfNodes->FindObject(branch_name);
-  				// try to find the block in the list of output
-				// nodes 
+  if (fDebugNameLookups) fNNameLookups++;
 
-  if (!node)
-    node = (TStnNode*) fListOfOutputNodes->FindObject(branch_name);
+  TStnNode* node = GetBlockNode(branch_name);
 
   if (!node)
     return NULL;
@@ -205,10 +273,10 @@ TStnDataBlock* TStnEvent::UnpackDataBlock(const char* branch_name) {
 
 //_____________________________________________________________________________
 TStnDataBlock** TStnEvent::GetDataBlockAddress(const char* branch_name) {
-  TStnNode* node = (TStnNode*) fListOfNodes->FindObject(branch_name);
-  
-  if (!node)
-    node = (TStnNode*) fListOfOutputNodes->FindObject(branch_name);
+
+  if (fDebugNameLookups) fNNameLookups++;
+
+  TStnNode* node = GetBlockNode(branch_name);
 
   if (!node)
     return NULL;
@@ -0,0 +1,143 @@
+///////////////////////////////////////////////////////////////////////////////
+// per-file summary of the STNTUPLE contents, see TStnFileSummary.hh
+///////////////////////////////////////////////////////////////////////////////
+#include <cstdio>
+
+#include "TFile.h"
+
+#include "Stntuple/obj/TStnFileSummary.hh"
+
+ClassImp(TStnFileSummary)
+
+//_____________________________________________________________________________
+TStnFileSummary::TStnFileSummary() {
+  fNEvents = 0;
+}
+
+//_____________________________________________________________________________
+TStnFileSummary::~TStnFileSummary() {
+}
+
+//_____________________________________________________________________________
+void TStnFileSummary::AddEvent(int Run, int Section, int Event) {
+
+  RunFill_t& r = fFill[Run];
+
+  if (r.fNEvents == 0) {
+    r.fLoEvent = Event;
+    r.fHiEvent = Event;
+  }
+  else if (Event < r.fLoEvent) r.fLoEvent = Event;
+  else if (Event > r.fHiEvent) r.fHiEvent = Event;
+
+  r.fNEvents++;
+  r.fSections.insert(Section);
+
+  fNEvents++;
+}
+
+//-----------------------------------------------------------------------------
+// convert the fill records into the persistent arrays, the run sections of
+// a run are stored as ranges of consecutive numbers
+//-----------------------------------------------------------------------------
+void TStnFileSummary::Pack() {
+
+  fRunData.clear();
+  fRange.clear();
+  fFirstRange.clear();
+
+  for (const auto& x : fFill) {
+    const RunFill_t& r = x.second;
+
+    fFirstRange.push_back(fRange.size()/2);
+
+    int nranges = 0;
+    for (int s : r.fSections) {
+      if ((nranges > 0) && (s == fRange.back()+1)) fRange.back() = s;
+      else {
+	fRange.push_back(s);
+	fRange.push_back(s);
+	nranges++;
+      }
+    }
+
+    fRunData.push_back(x.first);
+    fRunData.push_back(r.fNEvents);
+    fRunData.push_back(r.fLoEvent);
+    fRunData.push_back(r.fHiEvent);
+    fRunData.push_back(nranges);
+  }
+}
+
+//_____________________________________________________________________________
+TStnFileSummary* TStnFileSummary::Read(TFile* File) {
+  TStnFileSummary* s = (TStnFileSummary*) File->Get("FileSummary");
+  if ((s != 0) && (s->IsA() != TStnFileSummary::Class())) s = 0;
+  return s;
+}
+
+//_____________________________________________________________________________
+void TStnFileSummary::Streamer(TBuffer &R__b) {
+  // Stream an object of class TStnFileSummary
+
+  UInt_t R__s, R__c;
+  int    nw, nr;
+
+  if (R__b.IsReading()) {
+    Version_t R__v = R__b.ReadVersion(&R__s, &R__c); if (R__v) { }
+    TObject::Streamer(R__b);
+    R__b >> fNEvents;
+    R__b >> nw;
+    R__b >> nr;
+    fRunData.resize(nw);
+    fRange.resize(nr);
+    R__b.ReadFastArray(fRunData.data(),nw);
+    R__b.ReadFastArray(fRange.data()  ,nr);
+    R__b.CheckByteCount(R__s, R__c, TStnFileSummary::IsA());
+					// restore the range index
+    fFirstRange.clear();
+    int first = 0;
+    for (int i=0; i<NRuns(); i++) {
+      fFirstRange.push_back(first);
+      first += NRanges(i);
+    }
+    fFill.clear();
+  }
+  else {
+    if (! fFill.empty()) Pack();
+
+    R__c = R__b.WriteVersion(TStnFileSummary::IsA(), kTRUE);
+    TObject::Streamer(R__b);
+    nw = fRunData.size();
+    nr = fRange.size();
+    R__b << fNEvents;
+    R__b << nw;
+    R__b << nr;
+    R__b.WriteFastArray(fRunData.data(),nw);
+    R__b.WriteFastArray(fRange.data()  ,nr);
+    R__b.SetByteCount(R__c, kTRUE);
+  }
+}
+
+//_____________________________________________________________________________
+void TStnFileSummary::Clear(Option_t* Opt) {
+  fNEvents = 0;
+  fRunData.clear();
+  fRange.clear();
+  fFirstRange.clear();
+  fFill.clear();
+}
+
+//_____________________________________________________________________________
+void TStnFileSummary::Print(Option_t* Opt) const {
+  printf(" ---- TStnFileSummary: nevents: %i nruns: %i\n",fNEvents,NRuns());
+
+  for (int i=0; i<NRuns(); i++) {
+    printf(" run %7i nev: %8i events: %9i - %9i sections:",
+	   RunNumber(i),RunNEvents(i),LoEvent(i),HiEvent(i));
+    for (int j=0; j<NRanges(i); j++) {
+      printf(" %i:%i",LoSection(i,j),HiSection(i,j));
+    }
+    printf("\n");
+  }
+}
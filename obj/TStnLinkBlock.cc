@@ -24,40 +24,142 @@
 //    int icl = cpr_links->Index(i,j);
 //    ............ 
 //  }
+//
+//  the reverse lookup - loop over the electrons matching the CPR cluster `k':
+//
+//  for (int j=0; j<cpr_links->NReverseLinks(k); j++) {
+//    int iele = cpr_links->ReverseIndex(k,j);
+//    ............ 
+//  }
+//
+//  the reverse index is built on the first reverse query, O(NLinksTotal)
+//
+//  starting from V3 the links are written packed: per source element - the
+//  number of links followed by the zigzag-encoded differences between the
+//  consecutive link indices, all stored as base-128 varints
 //_____________________________________________________________________________
+#include <cstring>
+
 #include "TClass.h"
 #include <Stntuple/obj/TStnLinkBlock.hh>
 
 ClassImp(TStnLinkBlock)
+
+namespace {
+  inline void PutVarint(std::vector<unsigned char>& Buf, unsigned int X) {
+    while (X >= 0x80) {
+      Buf.push_back((X & 0x7f) | 0x80);
+      X >>= 7;
+    }
+    Buf.push_back(X);
+  }
+					// returns 0 on buffer overrun
+  inline int GetVarint(const unsigned char*& P, const unsigned char* End, unsigned int& X) {
+    X = 0;
+    for (int shift=0; (P < End) && (shift < 35); shift += 7) {
+      unsigned int b = *P++;
+      X |= (b & 0x7f) << shift;
+      if ((b & 0x80) == 0)                                  return 1;
+    }
+    return 0;
+  }
+
+  inline unsigned int ZigZag  (int X         ) { return (((unsigned int) X) << 1) ^ (unsigned int) (X >> 31); }
+  inline int          UnZigZag(unsigned int X) { return ((int) (X >> 1)) ^ -((int) (X & 1)); }
+}
+
+//-----------------------------------------------------------------------------
+// V1 and V2: plain int arrays
+//-----------------------------------------------------------------------------
+void TStnLinkBlock::ReadV2(TBuffer& R__b) {
+
+  int nw;
+
+  R__b >> nw;
+  fLast = nw-2;
+  if (fLast >= 0) {
+
+    if (nw > fOffset.fN) {
+      fOffset.Set(nw);
+    }
+    R__b.ReadStaticArray(fOffset.fArray);
+
+    R__b >> fNLinksTotal;
+    if (fNLinksTotal > fIndex.fN) {
+      fIndex.Set(fNLinksTotal);
+    }
+    R__b.ReadStaticArray(fIndex.fArray);
+  } 
+  else {
+//-----------------------------------------------------------------------------
+//  as we're not reading anything, make sure link list looks empty
+//-----------------------------------------------------------------------------
+    memset(fOffset.fArray,0,fOffset.fN*sizeof(Int_t));
+    fNLinksTotal = 0;
+  }
+}
+
 //_____________________________________________________________________________
 void TStnLinkBlock::Streamer(TBuffer& R__b) {
    // Stream an object of class TStnLinkBlock as fast as possible
 
-  int nw;
+  int nw, nb;
 
   if (R__b.IsReading()) {
-    Version_t R__v = R__b.ReadVersion(); if (R__v) { }
+    Version_t R__v = R__b.ReadVersion(); 
+    fReverseValid  = 0;
+    fBuffer.clear();
+
+    if (R__v < 3) {
+      ReadV2(R__b);
+      return;
+    }
+
     R__b >> nw;
     fLast = nw-2;
     if (fLast >= 0) {
-
       if (nw > fOffset.fN) {
 	fOffset.Set(nw);
       }
-      R__b.ReadStaticArray(fOffset.fArray);
-
       R__b >> fNLinksTotal;
       if (fNLinksTotal > fIndex.fN) {
 	fIndex.Set(fNLinksTotal);
       }
-      R__b.ReadStaticArray(fIndex.fArray);
-      
-    } 
-    else {
+      R__b >> nb;
+      fBuffer.resize(nb);
+      R__b.ReadFastArray(fBuffer.data(),nb);
 //-----------------------------------------------------------------------------
-//  as we're not reading anything, make sure link list looks empty
+// unpack
 //-----------------------------------------------------------------------------
+      const unsigned char* p   = fBuffer.data();
+      const unsigned char* end = p+nb;
+      unsigned int         x;
+      int                  loc = 0;
+
+      fOffset.fArray[0] = 0;
+      for (int i=0; i<=fLast; i++) {
+	if (! GetVarint(p,end,x) || (loc+(int) x > fNLinksTotal)) goto CORRUPTED;
+	int nl = x;
+	int prev = 0;
+	for (int j=0; j<nl; j++) {
+	  if (! GetVarint(p,end,x))                          goto CORRUPTED;
+	  prev                   += UnZigZag(x);
+	  fIndex.fArray[loc+j]    = prev;
+	}
+	loc                  += nl;
+	fOffset.fArray[i+1]   = loc;
+      }
+      if (loc == fNLinksTotal)                                return;
+
+    CORRUPTED:;
+      Error("Streamer","corrupted link block, %i links expected",fNLinksTotal);
+      fLast        = -1;
+      fNLinksTotal = 0;
+      memset(fOffset.fArray,0,fOffset.fN*sizeof(Int_t));
+    } 
+    else {
       memset(fOffset.fArray,0,fOffset.fN*sizeof(Int_t));
+      fNLinksTotal = 0;
     }
   }
   else {
@@ -66,9 +168,21 @@ void TStnLinkBlock::Streamer(TBuffer& R__b) {
     nw = fLast+2;
     R__b << nw;
     if (fLast >= 0) {
-      R__b.WriteArray(fOffset.fArray,nw);
+      fBuffer.clear();
+      for (int i=0; i<=fLast; i++) {
+	int nl   = NLinks(i);
+	int prev = 0;
+	PutVarint(fBuffer,nl);
+	for (int j=0; j<nl; j++) {
+	  int ind = Index(i,j);
+	  PutVarint(fBuffer,ZigZag(ind-prev));
+	  prev = ind;
+	}
+      }
+      nb = fBuffer.size();
       R__b << fNLinksTotal;
-      R__b.WriteArray(fIndex.fArray,fNLinksTotal);
+      R__b << nb;
+      R__b.WriteFastArray(fBuffer.data(),nb);
     }
   }
 }
@@ -76,8 +190,9 @@ void TStnLinkBlock::Streamer(TBuffer& R__b) {
 
 //_____________________________________________________________________________
 TStnLinkBlock::TStnLinkBlock() {
-  fLast        = -1;
-  fNLinksTotal = 0;
+  fLast         = -1;
+  fNLinksTotal  = 0;
+  fReverseValid = 0;
 
   fOffset.Set(10);
   fOffset.fArray[0] = 0;
@@ -99,6 +214,8 @@ Int_t TStnLinkBlock::InitLinks(Int_t i) {
 
   int loc;
 
+  fReverseValid = 0;
+
   if (i != fLast) {
     if (fOffset.fN <= i+1) {
       fOffset.Set(2*i+1);
@@ -127,6 +244,8 @@ Int_t TStnLinkBlock::Add(Int_t i, Int_t match) {
 
   int loc;
 
+  fReverseValid = 0;
+
   if (i != fLast) {
     if (fOffset.fN <= i+1) {
       fOffset.Set(2*i+1);
@@ -157,6 +276,15 @@ Int_t TStnLinkBlock::Add(Int_t i, Int_t match) {
 
 //_____________________________________________________________________________
 void TStnLinkBlock::Print(Option_t* option) const {
+
+  if (strcmp(option,"stat") == 0) {
+    Stat_t s;
+    ((TStnLinkBlock*) this)->GetStat(&s);
+    printf(" %s: sources: %6i links: %7i (max %4i) targets: %6i (max %4i links) packed: %8i bytes\n",
+	   GetName(),s.fNSources,s.fNLinks,s.fMaxLinks,s.fNTargets,s.fMaxReverse,s.fNBytes);
+    return;
+  }
+
   if (fLast < 0) {
     printf("%s->Print(): empty link block\n",GetName());
     return;
@@ -182,6 +310,7 @@ void TStnLinkBlock::Clear(Option_t* option) {
   fLast             = -1;
   fNLinksTotal      = 0;
   fOffset.fArray[0] = 0;
+  fReverseValid     = 0;
 }
 
 //_____________________________________________________________________________
@@ -189,6 +318,7 @@ Int_t TStnLinkBlock::Init(Int_t N) {
   // initialize link block for N objects
   fLast             = -1;
   fNLinksTotal      = 0;
+  fReverseValid     = 0;
 
   if (fOffset.fN <= N+1) {
     fOffset.Set(2*N+1);
@@ -200,4 +330,60 @@ Int_t TStnLinkBlock::Init(Int_t N) {
   return 0;
 }
 
+//-----------------------------------------------------------------------------
+// counting sort of the links by target: count, prefix sum, fill using the
+// offsets as the running positions, shift the offsets back
+//-----------------------------------------------------------------------------
+Int_t TStnLinkBlock::BuildReverseIndex() {
+
+  int nt = 0;
+  for (int k=0; k<fNLinksTotal; k++) {
+    if (fIndex.fArray[k] >= nt) nt = fIndex.fArray[k]+1;
+  }
+
+  fReverseOffset.assign(nt+1,0);
+  fReverseIndex.resize(fNLinksTotal);
 
+  for (int k=0; k<fNLinksTotal; k++) {
+    int it = fIndex.fArray[k];
+    if (it >= 0) fReverseOffset[it+1] += 1;
+  }
+
+  for (int it=0; it<nt; it++) fReverseOffset[it+1] += fReverseOffset[it];
+
+  for (int i=0; i<=fLast; i++) {
+    int nl = NLinks(i);
+    for (int j=0; j<nl; j++) {
+      int it = Index(i,j);
+      if (it >= 0) fReverseIndex[fReverseOffset[it]++] = i;
+    }
+  }
+
+  for (int it=nt; it>0; it--) fReverseOffset[it] = fReverseOffset[it-1];
+  fReverseOffset[0] = 0;
+					// negative (undefined) links are not
+					// in the reverse index
+  fReverseIndex.resize(fReverseOffset[nt]);
+  fReverseValid = 1;
+
+  return 0;
+}
+
+//_____________________________________________________________________________
+void TStnLinkBlock::GetStat(Stat_t* Stat) {
+
+  Stat->fNSources   = fLast+1;
+  Stat->fNLinks     = fNLinksTotal;
+  Stat->fMaxLinks   = 0;
+  Stat->fMaxReverse = 0;
+  Stat->fNBytes     = fBuffer.size();
+
+  for (int i=0; i<=fLast; i++) {
+    if (NLinks(i) > Stat->fMaxLinks) Stat->fMaxLinks = NLinks(i);
+  }
+
+  Stat->fNTargets = NTargets();
+  for (int k=0; k<Stat->fNTargets; k++) {
+    if (NReverseLinks(k) > Stat->fMaxReverse) Stat->fMaxReverse = NReverseLinks(k);
+  }
+}
@@ -12,6 +12,8 @@
 
 ClassImp(TStnNode)
 
+TStnNode::ReadMonitor_t TStnNode::fgReadMonitor = NULL;
+
 //_____________________________________________________________________________
 TStnNode::TStnNode() {
   fObject       = 0;
@@ -84,6 +86,13 @@ TStnNode::~TStnNode() {
 Int_t TStnNode::GetEntry(Int_t Ientry) {
   // fBranch = 0 means that this node is unused
 
+  if (fgReadMonitor && fBranch && (! fFunc)) {
+    fgReadMonitor(this,-1);
+    Int_t nb = fBranch->GetEntry(Ientry);
+    fgReadMonitor(this,(nb > 0) ? nb : 0);
+    return nb;
+  }
+
   if (fFunc) {
     return fFunc(fObject,fEvent,0);
   }
@@ -0,0 +1,184 @@
+///////////////////////////////////////////////////////////////////////////////
+// per-event tag tree, see TStnTagTree.hh
+///////////////////////////////////////////////////////////////////////////////
+#include <cstdio>
+
+#include "TTree.h"
+#include "TDirectory.h"
+
+#include "Stntuple/base/TBitset.hh"
+#include "Stntuple/obj/TStnEvent.hh"
+#include "Stntuple/obj/TStnHeaderBlock.hh"
+#include "Stntuple/obj/TStnTrackBlock.hh"
+#include "Stntuple/obj/TStnTrack.hh"
+#include "Stntuple/obj/TStnClusterBlock.hh"
+#include "Stntuple/obj/TStnCluster.hh"
+#include "Stntuple/obj/TStnTriggerBlock.hh"
+#include "Stntuple/obj/TStnTagTree.hh"
+
+ClassImp(TStnTagTree)
+
+//_____________________________________________________________________________
+TStnTagTree::TStnTagTree(const char* TrackBlockName, const char* ClusterBlockName):
+  TNamed("STNTAG","STNTUPLE event tags")
+{
+  fTrackBlockName   = TrackBlockName;
+  fClusterBlockName = ClusterBlockName;
+  fTree             = 0;
+  fEvent            = 0;
+  Clear();
+}
+
+//_____________________________________________________________________________
+TStnTagTree::~TStnTagTree() {
+}
+
+//-----------------------------------------------------------------------------
+// the tag branches are small, one basket covers many events
+//-----------------------------------------------------------------------------
+int TStnTagTree::MakeTree(TDirectory* Dir) {
+
+  TDirectory* olddir = gDirectory;
+  Dir->cd();
+
+  fTree = new TTree("STNTAG","STNTUPLE event tags");
+
+  const int bsize = 32000;
+
+  fTree->Branch("run"   ,&fTag.fRun        ,"run/I"   ,bsize);
+  fTree->Branch("subrun",&fTag.fSubrun     ,"subrun/I",bsize);
+  fTree->Branch("event" ,&fTag.fEvent      ,"event/I" ,bsize);
+  fTree->Branch("mcflag",&fTag.fMcFlag     ,"mcflag/I",bsize);
+  fTree->Branch("nsh"   ,&fTag.fNStrawHits ,"nsh/I"   ,bsize);
+  fTree->Branch("nch"   ,&fTag.fNComboHits ,"nch/I"   ,bsize);
+  fTree->Branch("ncalo" ,&fTag.fNCaloHits  ,"ncalo/I" ,bsize);
+  fTree->Branch("ncrv"  ,&fTag.fNCrvHits   ,"ncrv/I"  ,bsize);
+  fTree->Branch("ntrk"  ,&fTag.fNTracks    ,"ntrk/I"  ,bsize);
+  fTree->Branch("trkp0" ,&fTag.fTrkP [0]   ,"trkp0/F" ,bsize);
+  fTree->Branch("trkpt0",&fTag.fTrkPt[0]   ,"trkpt0/F",bsize);
+  fTree->Branch("trkq0" ,&fTag.fTrkQ0      ,"trkq0/I" ,bsize);
+  fTree->Branch("trkp1" ,&fTag.fTrkP [1]   ,"trkp1/F" ,bsize);
+  fTree->Branch("trkpt1",&fTag.fTrkPt[1]   ,"trkpt1/F",bsize);
+  fTree->Branch("ncl"   ,&fTag.fNClusters  ,"ncl/I"   ,bsize);
+  fTree->Branch("cle0"  ,&fTag.fClE  [0]   ,"cle0/F"  ,bsize);
+  fTree->Branch("cle1"  ,&fTag.fClE  [1]   ,"cle1/F"  ,bsize);
+  fTree->Branch("ntrig" ,&fTag.fNTrig      ,"ntrig/I" ,bsize);
+
+  for (int i=0; i<kNTrigWords; i++) {
+    fTree->Branch(Form("trig%i",i),&fTag.fTrig[i],Form("trig%i/i",i),bsize);
+  }
+
+  olddir->cd();
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+// to be called after all the blocks of the event have been filled
+//-----------------------------------------------------------------------------
+int TStnTagTree::Fill(TStnEvent* Event) {
+
+  if (Event != fEvent) {
+    fHeaderBlock  = Event->GetBlockHandle<TStnHeaderBlock> ("HeaderBlock");
+    fTrackBlock   = Event->GetBlockHandle<TStnTrackBlock>  (fTrackBlockName.Data());
+    fClusterBlock = Event->GetBlockHandle<TStnClusterBlock>(fClusterBlockName.Data());
+    fTriggerBlock = Event->GetBlockHandle<TStnTriggerBlock>("TriggerBlock");
+    fEvent        = Event;
+  }
+
+  Clear();
+
+  TStnHeaderBlock* hb = fHeaderBlock;
+  if (hb) {
+    fTag.fRun        = hb->RunNumber    ();
+    fTag.fSubrun     = hb->SectionNumber();
+    fTag.fEvent      = hb->EventNumber  ();
+    fTag.fMcFlag     = hb->McFlag       ();
+    fTag.fNStrawHits = hb->NStrawHits   ();
+    fTag.fNComboHits = hb->NComboHits   ();
+    fTag.fNCaloHits  = hb->NCaloHits    ();
+    fTag.fNCrvHits   = hb->NCRVHits     ();
+  }
+//-----------------------------------------------------------------------------
+// two leading tracks, by momentum
+//-----------------------------------------------------------------------------
+  TStnTrackBlock* tb = fTrackBlock;
+  if (tb) {
+    int ntrk      = tb->NTracks();
+    fTag.fNTracks = ntrk;
+
+    TStnTrack* t0 = 0;
+    TStnTrack* t1 = 0;
+    for (int i=0; i<ntrk; i++) {
+      TStnTrack* t = tb->Track(i);
+      if      ((t0 == 0) || (t->P() > t0->P())) { t1 = t0; t0 = t; }
+      else if ((t1 == 0) || (t->P() > t1->P())) { t1 = t; }
+    }
+
+    if (t0) {
+      fTag.fTrkP [0] = t0->P ();
+      fTag.fTrkPt[0] = t0->Pt();
+      fTag.fTrkQ0    = (int) t0->Charge();
+    }
+    if (t1) {
+      fTag.fTrkP [1] = t1->P ();
+      fTag.fTrkPt[1] = t1->Pt();
+    }
+  }
+//-----------------------------------------------------------------------------
+// two highest energy clusters
+//-----------------------------------------------------------------------------
+  TStnClusterBlock* cb = fClusterBlock;
+  if (cb) {
+    int ncl         = cb->NClusters();
+    fTag.fNClusters = ncl;
+
+    for (int i=0; i<ncl; i++) {
+      float e = cb->Cluster(i)->Energy();
+      if      (e > fTag.fClE[0]) { fTag.fClE[1] = fTag.fClE[0]; fTag.fClE[0] = e; }
+      else if (e > fTag.fClE[1]) { fTag.fClE[1] = e; }
+    }
+  }
+
+  TStnTriggerBlock* trb = fTriggerBlock;
+  if (trb) {
+    const TBitset* paths = trb->Paths();
+    fTag.fNTrig = paths->CountBits();
+
+    int nw = paths->GetNWords();
+    if (nw > kNTrigWords) nw = kNTrigWords;
+    for (int i=0; i<nw; i++) fTag.fTrig[i] = (UInt_t) paths->GetWords()[i];
+  }
+
+  return fTree->Fill();
+}
+
+//_____________________________________________________________________________
+void TStnTagTree::Clear(Option_t* Opt) {
+  fTag.fRun        = -1;
+  fTag.fSubrun     = -1;
+  fTag.fEvent      = -1;
+  fTag.fMcFlag     = -1;
+  fTag.fNStrawHits = -1;
+  fTag.fNComboHits = -1;
+  fTag.fNCaloHits  = -1;
+  fTag.fNCrvHits   = -1;
+  fTag.fNTracks    =  0;
+  fTag.fTrkQ0      =  0;
+  fTag.fNClusters  =  0;
+  fTag.fNTrig      =  0;
+
+  for (int i=0; i<2; i++) {
+    fTag.fTrkP [i] = 0;
+    fTag.fTrkPt[i] = 0;
+    fTag.fClE  [i] = 0;
+  }
+
+  for (int i=0; i<kNTrigWords; i++) fTag.fTrig[i] = 0;
+}
+
+//_____________________________________________________________________________
+void TStnTagTree::Print(Option_t* Opt) const {
+  printf(" ---- TStnTagTree: track block: %s cluster block: %s entries: %lld\n",
+	 fTrackBlockName.Data(),fClusterBlockName.Data(),
+	 (fTree) ? fTree->GetEntries() : 0LL);
+}
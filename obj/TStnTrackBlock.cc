@@ -30,6 +30,7 @@ TStnTrackBlock::TStnTrackBlock() {
   fNTracks   = 0;
   fListOfTracks = new TClonesArray("TStnTrack",100);
   fListOfTracks->BypassStreamer(kFALSE);
+  RegisterArray(fListOfTracks);
   fCollName     = "default";
 }
 
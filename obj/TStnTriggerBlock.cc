@@ -50,41 +50,27 @@ Int_t TStnTriggerBlock::GetListOfPassedTriggers(const TStnTriggerTable* Table,
 {
   // assume that trigger table has been already initialized
   // if Name=0 include all passed triggers
+  // the triggers are stored in the table at their bit positions, skip the
+  // unused bits. For selecting events, use TStnTriggerTable::MakeMask and 
+  // Passed(Mask) instead
 
   if (List == 0) return -1;
 
   List->Clear();
 
-//-----------------------------------------------------------------------------
-//  
-//-----------------------------------------------------------------------------
-  for (int i=0; i<fNPaths; i++) {
+  int nt = Table->NTriggers();
+  for (int i=0; i<nt; i++) {
     const TStnTrigger* trig = Table->GetTrigger(i);
+    if ((trig == nullptr) || (PathPassed(trig->Bit()) == 0)) continue;
+
     if ((Name == 0) || (strstr(trig->GetName(),Name) != 0)) {
       List->Add((TObject*)trig);
     }
-    else {
-      Warning("GetListOfTriggers","doesn't exist!\n");
-    }
   }
 
   return List->GetEntriesFast();
 }
 
-
-
-//_____________________________________________________________________________
-int TStnTriggerBlock::NPassedPaths() {
-
-  int nbits = fPaths.GetNBits();
-  int n_passed(0);
-
-  for (int i=0; i<nbits; i++) {
-    n_passed += fPaths.GetBit(i);
-  }
-  return n_passed;
-}
-
 //_____________________________________________________________________________
 void TStnTriggerBlock::Clear(Option_t* opt) {
   fNPaths   = -1;
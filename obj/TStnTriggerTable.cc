@@ -5,7 +5,10 @@
 //  Date:      Oct 15 2001
 ///////////////////////////////////////////////////////////////////////////////
 #include <cstdlib>
+#include "TObjString.h"
+
 #include "obj/TStnTriggerTable.hh"
+#include "base/TBitset.hh"
 
 
 ClassImp(TStnTriggerTable)
@@ -68,6 +71,51 @@ void TStnTriggerTable::GetListOfTriggers(const char* Pattern,
   }
 }
 
+//_____________________________________________________________________________
+int TStnTriggerTable::MakeMask(const char* Pattern, TBitset* Mask) const {
+  int nt = NTriggers();
+  int nbits = 0;
+
+  for (int i=0; i<nt; i++) {
+    const TStnTrigger* t = GetTrigger(i);
+    if (t && (t->Bit() >= nbits)) nbits = t->Bit()+1;
+  }
+
+  Mask->Init(nbits);
+
+  TString pat(Pattern);
+  pat.ToUpper();
+
+  TObjArray* list = pat.Tokenize("|");
+  int nmatched    = 0;
+
+  TString trigger_name;
+  for (int i=0; i<nt; i++) {
+    const TStnTrigger* t = GetTrigger(i);
+    if (t == nullptr)                                        continue;
+
+    trigger_name = t->Name();
+    trigger_name.ToUpper();
+
+    int np    = list->GetEntriesFast();
+    int match = (pat == "*") || (np == 0);
+    for (int ip=0; (ip<np) && (! match); ip++) {
+      TString& p = ((TObjString*) list->UncheckedAt(ip))->String();
+      match = (trigger_name.Index(p) >= 0);
+    }
+
+    if (match) {
+      Mask->SetBit(t->Bit());
+      nmatched++;
+    }
+  }
+
+  list->Delete();
+  delete list;
+
+  return nmatched;
+}
+
 //_____________________________________________________________________________
 void TStnTriggerTable::Delete(Option_t* Opt) {
   fListOfTriggers->Delete();
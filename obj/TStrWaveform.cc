@@ -18,12 +18,13 @@ void TStrWaveform::Streamer(TBuffer &R__b) {
 //-----------------------------------------------------------------------------
     int nw;
     R__b >> nw;
+    fPool = nullptr;
     if (fData == nullptr) {
       fNWords = nw;
       fData = new ushort[fNWords];
     }
     else if (nw != fNWords) {
-      delete fData;
+      delete [] fData;
       fNWords = nw;
       fData = new ushort[fNWords];
     }
@@ -32,7 +33,7 @@ void TStrWaveform::Streamer(TBuffer &R__b) {
   else {
     R__b.WriteVersion(TStrWaveform::IsA());
     R__b << fNWords;
-    R__b.WriteFastArray(fData,fNWords);
+    R__b.WriteFastArray(Samples(),fNWords);
   } 
 }
 
@@ -42,19 +43,40 @@ TStrWaveform::TStrWaveform(int ID): TObject() {
   SetUniqueID(ID);
   fNWords = 0;
   fData   = nullptr;
+  fOffset = 0;
+  fPool   = nullptr;
 }
 
 //_____________________________________________________________________________
 TStrWaveform::~TStrWaveform() {
-  if (fData) delete fData;
+  if (fData) delete [] fData;
+}
+
+//_____________________________________________________________________________
+void TStrWaveform::Reset(int ID) {
+  SetUniqueID(ID);
+  if (fData) {
+    delete [] fData;
+    fData = nullptr;
+  }
+  fNWords = 0;
+  fOffset = 0;
+  fPool   = nullptr;
 }
 
 //_____________________________________________________________________________
 // init
 //-----------------------------------------------------------------------------
 void TStrWaveform::Set(int NWords, const ushort* Data) {
+  if (fPool) {
+    fOffset = fPool->size();
+    fNWords = NWords;
+    fPool->insert(fPool->end(),Data,Data+NWords);
+    return;
+  }
+
   if (NWords != fNWords) {
-    if (fData) delete fData;
+    if (fData) delete [] fData;
     fNWords = NWords;
     fData   = new ushort[fNWords];
   }
@@ -84,8 +106,9 @@ void TStrWaveform::Print(Option_t* Option) const {
 
   printf("%3i",fNWords);
 
+  const ushort* data = Samples();
   for (int i=0; i<fNWords; i++) {
-    printf(" %5i",fData[i]);
+    printf(" %5i",data[i]);
   }
   
   printf("\n");
@@ -6,6 +6,17 @@
 
 ClassImp(TStrawHitBlock)
 
+namespace {
+					// zigzag: small differences of either
+					// sign -> small unsigned numbers
+  inline UInt_t zigzag_encode(int X) {
+    return (X >= 0) ? (UInt_t(X) << 1) : ((UInt_t(-X) << 1) - 1);
+  }
+
+  inline int zigzag_decode(UInt_t Z) {
+    return (Z & 1) ? -int((Z+1) >> 1) : int(Z >> 1);
+  }
+}
 
 //-----------------------------------------------------------------------------
 void TStrawHitBlock::ReadV1(TBuffer& R__b) {
@@ -15,6 +26,141 @@ void TStrawHitBlock::ReadV1(TBuffer& R__b) {
   // fListOfWaveforms = nullptr;
 }
 
+//-----------------------------------------------------------------------------
+// V2: waveforms streamed one by one, each owns its samples
+//-----------------------------------------------------------------------------
+void TStrawHitBlock::ReadV2(TBuffer& R__b) {
+  R__b >> fNHits;
+  R__b >> fNWaveforms;
+  fListOfHits->Streamer(R__b);
+  fListOfWaveforms->Streamer(R__b);
+}
+
+//-----------------------------------------------------------------------------
+// V3 waveform record:
+//   IDs[nwf], NWords[nwf], first samples[nwf], NBits[nwf],
+//   N(packed words), packed words: for each waveform NWords-1 zigzag-encoded
+//   differences of consecutive samples, NBits each, no padding between
+//   the waveforms
+//-----------------------------------------------------------------------------
+void TStrawHitBlock::WriteWaveforms(TBuffer& R__b) {
+  int nwf = fNWaveforms;
+
+  fWfID    .resize(nwf);
+  fWfNWords.resize(nwf);
+  fWfFirst .resize(nwf);
+  fWfNBits .resize(nwf);
+  fPacked  .clear();
+
+  ULong64_t acc  = 0;
+  int       nacc = 0;
+
+  for (int i=0; i<nwf; i++) {
+    TStrWaveform* wf = Waveform(i);
+    const ushort* d  = wf->Samples();
+    int           n  = wf->NWords();
+
+    fWfID    [i] = wf->GetUniqueID();
+    fWfNWords[i] = n;
+    fWfFirst [i] = (n > 0) ? d[0] : 0;
+
+    UInt_t zmax = 0;
+    for (int k=1; k<n; k++) zmax |= zigzag_encode(int(d[k])-int(d[k-1]));
+
+    int nb = 0;
+    while ((zmax >> nb) != 0) nb++;
+    fWfNBits[i] = nb;
+
+    if (nb == 0)                                             continue;
+
+    for (int k=1; k<n; k++) {
+      acc  |= ULong64_t(zigzag_encode(int(d[k])-int(d[k-1]))) << nacc;
+      nacc += nb;
+      if (nacc >= 32) {
+	fPacked.push_back(UInt_t(acc));
+	acc  >>= 32;
+	nacc  -= 32;
+      }
+    }
+  }
+
+  if (nacc > 0) fPacked.push_back(UInt_t(acc));
+
+  int np = fPacked.size();
+
+  R__b.WriteFastArray(fWfID.data()    ,nwf);
+  R__b.WriteFastArray(fWfNWords.data(),nwf);
+  R__b.WriteFastArray(fWfFirst.data() ,nwf);
+  R__b.WriteFastArray(fWfNBits.data() ,nwf);
+  R__b << np;
+  R__b.WriteFastArray(fPacked.data()  ,np);
+}
+
+//-----------------------------------------------------------------------------
+// decode all waveforms into fSamples, waveform objects refer to it
+//-----------------------------------------------------------------------------
+void TStrawHitBlock::ReadWaveforms(TBuffer& R__b) {
+  int nwf = fNWaveforms;
+  int np;
+
+  fWfID    .resize(nwf);
+  fWfNWords.resize(nwf);
+  fWfFirst .resize(nwf);
+  fWfNBits .resize(nwf);
+
+  R__b.ReadFastArray(fWfID.data()    ,nwf);
+  R__b.ReadFastArray(fWfNWords.data(),nwf);
+  R__b.ReadFastArray(fWfFirst.data() ,nwf);
+  R__b.ReadFastArray(fWfNBits.data() ,nwf);
+  R__b >> np;
+  fPacked.resize(np);
+  R__b.ReadFastArray(fPacked.data()  ,np);
+
+  int nsamples = 0;
+  for (int i=0; i<nwf; i++) nsamples += fWfNWords[i];
+  fSamples.resize(nsamples);
+
+  const UInt_t* p      = fPacked.data();
+  ushort*       out    = fSamples.data();
+  ULong64_t     acc    = 0;
+  int           nacc   = 0;
+  int           ip     = 0;
+  int           offset = 0;
+
+  for (int i=0; i<nwf; i++) {
+    int n  = fWfNWords[i];
+    int nb = fWfNBits [i];
+
+					// reused slot may own the samples
+					// of a V2 waveform, reset it
+    TStrWaveform* wf = (TStrWaveform*) fListOfWaveforms->ConstructedAt(i);
+    wf->Reset(fWfID[i]);
+    wf->SetPooled(&fSamples,offset,n);
+
+    if (n > 0) {
+      ULong64_t mask = (1ULL << nb)-1;
+      int       x    = fWfFirst[i];
+      out[offset]    = x;
+      for (int k=1; k<n; k++) {
+	while (nacc < nb) {
+	  if (ip >= np) {
+	    Error("ReadWaveforms","corrupted waveform record, waveform %i",i);
+	    fNWaveforms = i+1;
+	    return;
+	  }
+	  acc  |= ULong64_t(p[ip++]) << nacc;
+	  nacc += 32;
+	}
+	x             += zigzag_decode(UInt_t(acc & mask));
+	acc          >>= nb;
+	nacc          -= nb;
+	out[offset+k]  = x;
+      }
+    }
+    offset += n;
+  }
+}
+
 
 //-----------------------------------------------------------------------------
 // R_v is so far unused
@@ -22,23 +168,24 @@ void TStrawHitBlock::ReadV1(TBuffer& R__b) {
   void TStrawHitBlock::Streamer(TBuffer &R__b) {
   if(R__b.IsReading()) {
     Version_t R__v = R__b.ReadVersion();
-    if (R__v == 1) ReadV1(R__b);
+    if      (R__v == 1) ReadV1(R__b);
+    else if (R__v == 2) ReadV2(R__b);
     else {
       R__b >> fNHits;
       R__b >> fNWaveforms;
       fListOfHits->Streamer(R__b);
-      fListOfWaveforms->Streamer(R__b);
+      ReadWaveforms(R__b);
     }
   }
   else {
 //-----------------------------------------------------------------------------
-// current version = 2
+// current version = 3
 //-----------------------------------------------------------------------------
     R__b.WriteVersion(TStrawHitBlock::IsA());
     R__b << fNHits;
     R__b << fNWaveforms;
     fListOfHits->Streamer(R__b);
-    fListOfWaveforms->Streamer(R__b);
+    WriteWaveforms(R__b);
   }
 }
 
@@ -66,6 +213,7 @@ TStrawHitBlock::~TStrawHitBlock() {
 void TStrawHitBlock::Clear(Option_t* opt) {
   fListOfHits->Clear();
   if (fListOfWaveforms) fListOfWaveforms->Clear();
+  fSamples.clear();			// keeps the capacity
   fNHits      = 0;
   fNWaveforms = 0;
 
@@ -15,6 +15,7 @@ ClassImp(TVDetDataBlock)
     R__b.ReadVersion();
     R__b >> fNHits;
     fListOfHits->Streamer(R__b);
+    fVolumeIndex.Invalidate();
   }
   else {
     R__b.WriteVersion(TVDetDataBlock::IsA());
@@ -40,6 +41,7 @@ TVDetDataBlock::~TVDetDataBlock() {
 void TVDetDataBlock::Clear(Option_t* opt) {
   fListOfHits->Clear();
   fNHits=0;
+  fVolumeIndex.Invalidate();
 
   f_EventNumber       = -1;
   f_RunNumber         = -1;
@@ -47,6 +49,15 @@ void TVDetDataBlock::Clear(Option_t* opt) {
   fLinksInitialized   =  0;
 }
 
+//______________________________________________________________________________
+int TVDetDataBlock::BuildVolumeIndex() {
+  fHitVolumeID.resize(fNHits);
+  for (int i=0; i<fNHits; i++) {
+    fHitVolumeID[i] = Hit(i)->Index();
+  }
+  return fVolumeIndex.Build(fHitVolumeID.data(),fNHits);
+}
+
 //______________________________________________________________________________
 void TVDetDataBlock::Print(Option_t* Option) const {
   // print all hits in the virtual detectors
@@ -45,11 +45,15 @@ public:
 // modifiers
 //-----------------------------------------------------------------------------
   TCrvRecoPulse*          NewPulse() { 
-    return new ((*fListOfPulses)[fNPulses++]) TCrvRecoPulse();
+    TCrvRecoPulse* p = (TCrvRecoPulse*) NewObject(fListOfPulses,fNPulses++);
+    p->Clear();
+    return p;
   }
 
   TCrvCoincidence*        NewCoincidence() { 
-    return new ((*fListOfCoincidences)[fNCoincidences++]) TCrvCoincidence(); 
+    TCrvCoincidence* c = (TCrvCoincidence*) NewObject(fListOfCoincidences,fNCoincidences++);
+    c->Clear();
+    return c;
   }
 
 //-----------------------------------------------------------------------------
@@ -13,6 +13,9 @@
 //  around TClonesArray seems to be a reasonable compromise here
 //-----------------------------------------------------------------------------
 
+#include <vector>
+#include <unordered_map>
+
 #include "TArrayI.h"
 #include "TClonesArray.h"
 
@@ -37,6 +40,16 @@ protected:
 //-----------------------------------------------------------------------------
   int            fGenProcessID;         //! don't save, generated process ID
 //-----------------------------------------------------------------------------
+// transient lookup tables, built on first use after reading in / filling,
+// invalidated by Clear and NewParticle
+// fDaughterOffset/fDaughterIndex: daughters of particle 'i' are 
+// fDaughterIndex[fDaughterOffset[i]..fDaughterOffset[i+1]-1]
+//-----------------------------------------------------------------------------
+  int                          fIndexInitialized; //!
+  std::unordered_map<int,int>  fIndex;            //! SimParticle ID --> index in the list
+  std::vector<int>             fDaughterOffset;   //!
+  std::vector<int>             fDaughterIndex;    //!
+//-----------------------------------------------------------------------------
 //  functions
 //-----------------------------------------------------------------------------
 public:
@@ -53,7 +66,43 @@ public:
     return (TSimParticle*) fListOfParticles->UncheckedAt(i); 
   }
 
-  TSimParticle*   FindParticle(int ID);
+					// index of the particle with a given ID,
+					// -1 if not found
+  int             ParticleIndex(int ID) {
+    if (fIndexInitialized == 0) BuildIndex();
+    std::unordered_map<int,int>::const_iterator it = fIndex.find(ID);
+    return (it != fIndex.end()) ? it->second : -1;
+  }
+
+  TSimParticle*   FindParticle(int ID) {
+    int i = ParticleIndex(ID);
+    return (i >= 0) ? Particle(i) : nullptr;
+  }
+					// parent of a given particle, nullptr 
+					// for primaries and for particles with 
+					// parents not stored in the block
+  TSimParticle*   Parent(const TSimParticle* P) {
+    return FindParticle(P->ParentID());
+  }
+					// daughters of the i-th particle
+  int             NDaughters(int I) {
+    if (fIndexInitialized == 0) BuildIndex();
+    return fDaughterOffset[I+1]-fDaughterOffset[I];
+  }
+
+  TSimParticle*   Daughter(int I, int J) {
+    return Particle(fDaughterIndex[fDaughterOffset[I]+J]);
+  }
+					// Chain[0] = P, Chain[1] = parent(P), etc
+					// returns number of particles in the chain
+  int             GetParentChain(TSimParticle* P, std::vector<TSimParticle*>* Chain);
+					// all descendants of P (not including P)
+  int             GetDescendants(TSimParticle* P, std::vector<TSimParticle*>* List);
+//-----------------------------------------------------------------------------
+// (re)build the ID lookup table and the list of daughters, is called on
+// the first lookup, so normally there is no need to call it explicitly
+//-----------------------------------------------------------------------------
+  int             BuildIndex();
 //-----------------------------------------------------------------------------
 //  modifiers
 //-----------------------------------------------------------------------------
@@ -50,6 +50,14 @@ public:
 //-----------------------------------------------------------------------------
 // init methods
 //-----------------------------------------------------------------------------
+  void   Set(int VolumeID    , int GenIndex      ,  
+	     int SimID       , int PDGCode       , 
+	     int ParentSimID , int ParentPDGCode , 
+	     int CreationCode, int EndProcessCode,
+	     float EDepTot   , float EDepNio     , 
+	     float Time      , float ProperTime  , 
+	     float StepLength,
+	     float X, float Y, float Z, float Px, float Py, float Pz   );
 //-----------------------------------------------------------------------------
 // accessors
 //-----------------------------------------------------------------------------
@@ -17,6 +17,7 @@
 #include "TClonesArray.h"
 
 #include "Stntuple/base/TStnArrayI.hh"
+#include "Stntuple/base/TVolumeIndex.hh"
 #include "Stntuple/obj/TStepPointMC.hh"
 #include "Stntuple/obj/TStnDataBlock.hh"
 
@@ -44,6 +45,10 @@ protected:
 // transients - parameters (temp solution)
 //-----------------------------------------------------------------------------
   int            fGenProcessID;         //! don't save, generated process ID
+					// step points by volume ID, built
+					// on the first request in the event
+  TVolumeIndex     fVolumeIndex;        //!
+  std::vector<int> fStepVolumeID;       //! work array
 //-----------------------------------------------------------------------------
 //  functions
 //-----------------------------------------------------------------------------
@@ -68,6 +73,14 @@ public:
   TStepPointMC*   StepPointMC(int i) { 
     return (TStepPointMC*) fListOfStepPoints->UncheckedAt(i); 
   }
+					// step points of the K-th volume:
+					// StepPointMC(vi->Object(K,0..))
+  TVolumeIndex*   VolumeIndex() {
+    if (! fVolumeIndex.Valid()) BuildVolumeIndex();
+    return &fVolumeIndex;
+  }
+
+  int             BuildVolumeIndex();
 //-----------------------------------------------------------------------------
 //  modifiers
 //-----------------------------------------------------------------------------
@@ -81,6 +94,8 @@ public:
 				float   Px, float     Py, float         Pz);
 
   void           SetGenProcessID(int ID) { fGenProcessID = ID; }
+
+  virtual void   CopyConfiguration(const TStnDataBlock* Block);
 //-----------------------------------------------------------------------------
 // overloaded functions of TObject
 //-----------------------------------------------------------------------------
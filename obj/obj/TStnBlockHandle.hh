@@ -0,0 +1,36 @@
+#ifndef STNTUPLE_TStnBlockHandle
+#define STNTUPLE_TStnBlockHandle
+//-----------------------------------------------------------------------------
+//  typed handle to the data block, holds a pointer to the TStnNode, 
+//  which stays valid for the lifetime of the event
+//
+//  get the handle once (in BeginJob) and use it in Event() instead of 
+//  looking the block up by name on every event:
+//
+//    fHelixBlock = GetEvent()->GetBlockHandle<TStnHelixBlock>("HelixBlock");
+//    ...
+//    int nh = fHelixBlock->NHelices();
+//-----------------------------------------------------------------------------
+
+#include "Stntuple/obj/TStnNode.hh"
+#include "Stntuple/obj/TStnDataBlock.hh"
+
+template <class T> class TStnBlockHandle {
+protected:
+  TStnNode*  fNode;
+public:
+  TStnBlockHandle(TStnNode* Node = nullptr) : fNode(Node) {}
+
+  TStnNode*  GetNode () const { return fNode; }
+  int        IsValid () const { return (fNode != nullptr); }
+
+  T*         get     () const { 
+    return (fNode != nullptr) ? static_cast<T*>(fNode->GetDataBlock()) : nullptr;
+  }
+
+  T*         operator->() const { return get(); }
+  T&         operator* () const { return *get(); }
+             operator T*() const { return get(); }
+};
+
+#endif
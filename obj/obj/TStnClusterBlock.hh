@@ -28,7 +28,9 @@ public:
   virtual ~TStnClusterBlock();
 
   TStnCluster* NewCluster() {
-    TStnCluster* cl = new ((*fListOfClusters)[fNClusters]) TStnCluster(fNClusters);
+    TStnCluster* cl = (TStnCluster*) NewObject(fListOfClusters,fNClusters);
+    cl->Clear();
+    cl->SetNumber(fNClusters);
     fNClusters++;
     return cl;
   }
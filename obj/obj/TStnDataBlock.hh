@@ -8,6 +8,8 @@
 //  base class for STNTUPLE data block
 //-----------------------------------------------------------------------------
 
+#include <vector>
+
 #include "Stntuple/obj/AbsEvent.hh"
 #include "Stntuple/obj/TStnInitDataBlock.hh"
 
@@ -18,6 +20,7 @@
 
 class TStnNode;
 class TStnEvent;
+class TClonesArray;
 
 class TStnDataBlock: public TObject {
 public:
@@ -60,6 +63,16 @@ protected:
 
   TStnInitDataBlock*  fInitBlock;       // ! coming replacement for fExternalInit
 //-----------------------------------------------------------------------------
+// object lifecycle: the TClonesArrays registered with RegisterArray keep
+// their objects between the events. Clear() resets the arrays in place, the
+// next event (streamer or NewObject) reuses the already constructed objects,
+// a new object is allocated only when an array grows above its high water
+// mark. fNAllocated counts these allocations, preallocated objects excluded
+//-----------------------------------------------------------------------------
+  std::vector<TClonesArray*> fListOfArrays;	// ! not owned
+  std::vector<Int_t>         fHighWaterMark;	// ! per registered array
+  Int_t                      fNAllocated;	// !
+//-----------------------------------------------------------------------------
 //  functions
 //-----------------------------------------------------------------------------
 protected:
@@ -68,6 +81,13 @@ protected:
 
   virtual Int_t fOverloadedInit(AbsEvent* event, Int_t mode) { return 0; }
 
+					// to be called in the constructor
+  void      RegisterArray(TClonesArray* List);
+					// I-th object of List, constructed
+					// only if not there yet. The object is
+					// not reset, that is up to the caller
+  TObject*  NewObject    (TClonesArray* List, Int_t I);
+
 public:
 					// ****** constructors and destructor
   TStnDataBlock();
@@ -111,6 +131,10 @@ public:
   Int_t       EventNumber       () { return f_EventNumber;       }
   Int_t       RunNumber         () { return f_RunNumber;         }
 
+  Int_t       NAllocated        () const { return fNAllocated;   }
+  Int_t       NArrays           () const { return fListOfArrays.size(); }
+  Int_t       HighWaterMark     (int I) const { return fHighWaterMark[I]; }
+
   void GetCollTag    (const char* CollectionClassName, char* CollTag    );
   void GetModuleLabel(const char* CollectionClassName, char* ModuleLabel);
   void GetDescription(const char* CollectionClassName, char* Description);
@@ -152,6 +176,18 @@ public:
   }
 
   virtual Int_t GetEntry(Int_t ientry);
+					// preallocate N objects in each
+					// registered array, to be called
+					// before the event loop
+  virtual Int_t Reserve (Int_t N);
+					// account for the objects constructed
+					// by the TClonesArray streamer
+  void          UpdateAllocations();
+					// take over the initialization setup
+					// (init functions, collection names)
+					// of Block, the init block is shared,
+					// not owned
+  virtual void  CopyConfiguration(const TStnDataBlock* Block);
 					// ****** overloaded functions of 
 					// TObject
   void Print(Option_t* opt="") const;
@@ -1,7 +1,11 @@
 #ifndef TStnEvent_hh
 #define TStnEvent_hh
 
+#include <string>
+#include <unordered_map>
+
 #include "Stntuple/obj/AbsEvent.hh"
+#include "Stntuple/obj/TStnBlockHandle.hh"
 
 class TStnNode;
 class TStnDataBlock;
@@ -27,6 +31,21 @@ public:
   Int_t             fEventNumber ;      // !
   Int_t             fRunNumber   ;      // !
   Int_t             fSectionNumber;     // !
+//-----------------------------------------------------------------------------
+// hashed name --> node indices of fListOfNodes and fListOfOutputNodes
+// nodes are added with AddNode/AddOutputNode, which keep the indices up to
+// date. Code changing the lists directly (removing, clearing, replacing 
+// nodes) has to call InvalidateNodeIndex, the index is then rebuilt on 
+// the next lookup. NIndexed < 0: index invalid
+//-----------------------------------------------------------------------------
+  std::unordered_map<std::string,TStnNode*> fNodeIndex;         // !
+  std::unordered_map<std::string,TStnNode*> fOutputNodeIndex;   // !
+  Int_t             fNIndexedNodes;       // !
+  Int_t             fNIndexedOutputNodes; // !
+					// number of lookups by the branch name, 
+					// counted only if fDebugNameLookups != 0
+  Int_t             fDebugNameLookups;    // !
+  Int_t             fNNameLookups;        // !
 //------------------------------------------------------------------------------
 //  function members
 //------------------------------------------------------------------------------
@@ -76,10 +95,21 @@ public:
 
   TStnDataBlock**  GetDataBlockAddress(const char* branch_name);
 
-  TStnNode*   FindNode(const char* name) { 
-    return (TStnNode*) fListOfNodes->FindObject(name);
+  TStnNode*   FindNode      (const char* name);
+  TStnNode*   FindOutputNode(const char* name);
+
+				// node for input or output branch, intended
+				// to be called once, in BeginJob
+
+  TStnNode*   GetBlockNode  (const char* branch_name);
+
+  template <class T> TStnBlockHandle<T> GetBlockHandle(const char* branch_name) {
+    return TStnBlockHandle<T>(GetBlockNode(branch_name));
   }
 
+  Int_t       GetDebugNameLookups() { return fDebugNameLookups; }
+  Int_t       NNameLookups       () { return fNNameLookups;     }
+
   virtual TObject*   FindObject(const char* name) const { 
     return fListOfObjects->FindObject(name);
   }
@@ -96,6 +126,7 @@ public:
   void SetErrorLogger(TStnErrorLogger* Logger) { fErrorLogger  = Logger; }
   void SetCurrentEntry(Int_t             Entry) { fCurrentEntry = Entry ; }
   void SetCurrentTreeEntry(Int_t         Entry) { fCurrentTreeEntry = Entry ; }
+  void SetDebugNameLookups(Int_t         Flag ) { fDebugNameLookups = Flag  ; }
 
   Int_t AddDataBlock(const char* branch_name, 
 		     const char* class_name,
@@ -104,6 +135,18 @@ public:
   Int_t AddOutputBlock(const char* BranchName, TStnDataBlock* Block);
 
   void  AddObject(TObject* obj) { fListOfObjects->Add(obj); }
+					// add an existing node to the list of
+					// (output) nodes
+  void  AddNode      (TStnNode* Node);
+  void  AddOutputNode(TStnNode* Node);
+					// after a direct change of the lists
+  void  InvalidateNodeIndex() { fNIndexedNodes = -1; fNIndexedOutputNodes = -1; }
+
+protected:
+  void  UpdateNodeIndex(TObjArray* List, 
+			std::unordered_map<std::string,TStnNode*>* Index,
+			Int_t* NIndexed);
+public:
 //-----------------------------------------------------------------------------
 // overloaded methods of TObject
 //-----------------------------------------------------------------------------
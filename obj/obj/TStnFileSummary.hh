@@ -0,0 +1,70 @@
+#ifndef STNTUPLE_TStnFileSummary
+#define STNTUPLE_TStnFileSummary
+//-----------------------------------------------------------------------------
+// per-file summary of the STNTUPLE contents, written by FillStntuple into
+// the top directory of each output file under the name "FileSummary":
+// number of events and, for each run, the number of events, the event
+// number range and the list of run section ranges.
+// TDFCModule uses it to catalog a file without reading the events
+//-----------------------------------------------------------------------------
+#include <map>
+#include <set>
+#include <vector>
+
+#include "TObject.h"
+#include "TBuffer.h"
+
+class TFile;
+
+class TStnFileSummary : public TObject {
+public:
+  enum { kNRunWords = 5 };		// run, nevents, loevt, hievt, nranges
+
+  struct RunFill_t {
+    int            fNEvents;
+    int            fLoEvent;
+    int            fHiEvent;
+    std::set<int>  fSections;
+  };
+
+protected:
+  Int_t                     fNEvents;
+  std::vector<int>          fRunData;	// kNRunWords words per run, ordered
+  std::vector<int>          fRange;	// section ranges: [lo,hi] pairs
+  std::vector<int>          fFirstRange;// ! index of the first range of run I
+  std::map<int,RunFill_t>   fFill;	// ! filled by AddEvent, packed by Pack
+//-----------------------------------------------------------------------------
+//  methods
+//-----------------------------------------------------------------------------
+public:
+  TStnFileSummary();
+  virtual ~TStnFileSummary();
+//-----------------------------------------------------------------------------
+// accessors, valid after Pack (or after reading)
+//-----------------------------------------------------------------------------
+  Int_t    NEvents       ()      const { return fNEvents;                        }
+  Int_t    NRuns         ()      const { return fRunData.size()/kNRunWords;      }
+  Int_t    RunNumber     (int I) const { return fRunData[I*kNRunWords  ];        }
+  Int_t    RunNEvents    (int I) const { return fRunData[I*kNRunWords+1];        }
+  Int_t    LoEvent       (int I) const { return fRunData[I*kNRunWords+2];        }
+  Int_t    HiEvent       (int I) const { return fRunData[I*kNRunWords+3];        }
+  Int_t    NRanges       (int I) const { return fRunData[I*kNRunWords+4];        }
+  Int_t    LoSection(int I, int J) const { return fRange[2*(fFirstRange[I]+J)  ]; }
+  Int_t    HiSection(int I, int J) const { return fRange[2*(fFirstRange[I]+J)+1]; }
+//-----------------------------------------------------------------------------
+// modifiers
+//-----------------------------------------------------------------------------
+  void     AddEvent(int Run, int Section, int Event);
+  void     Pack    ();
+					// returns 0 if there is no summary
+  static TStnFileSummary* Read(TFile* File);
+//-----------------------------------------------------------------------------
+// overloaded methods of TObject
+//-----------------------------------------------------------------------------
+  void     Clear(Option_t* Opt = "");
+  void     Print(Option_t* Opt = "") const;
+
+  ClassDef(TStnFileSummary,1)
+};
+
+#endif
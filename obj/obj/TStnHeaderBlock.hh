@@ -69,6 +69,8 @@ public:
   int    NTracks      () const { return fNTracks;       }
   int    NStrawHits   () const { return fNStrawHits;    }
   int    NComboHits   () const { return fNComboHits;    }
+  int    NCaloHits    () const { return fNCaloHits;     }
+  int    NCRVHits     () const { return fNCRVHits;      }
 
   float InstLum       () const { return fInstLum;       }
   float MeanLum       () const { return fMeanLum;       }
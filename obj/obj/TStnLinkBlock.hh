@@ -6,11 +6,22 @@
 //  Date:      Nov 10 2000
 // 
 //-----------------------------------------------------------------------------
+#include <vector>
+
 #include "TArrayI.h"
 #include "Stntuple/obj/TStnDataBlock.hh"
 
 class TStnLinkBlock: public TStnDataBlock {
 public:
+					// per-block link statistics
+  struct Stat_t {
+    Int_t  fNSources;			// number of source elements
+    Int_t  fNLinks;			// total number of links
+    Int_t  fMaxLinks;			// max number of links per source
+    Int_t  fNTargets;			// highest target index + 1
+    Int_t  fMaxReverse;			// max number of links per target
+    Int_t  fNBytes;			// packed size, last read or write
+  };
 //-----------------------------------------------------------------------------
 //  data members
 //-----------------------------------------------------------------------------
@@ -20,6 +31,18 @@ public:
   TArrayI          fOffset;		//
   TArrayI          fIndex;		//
 //-----------------------------------------------------------------------------
+// reverse index, target --> sources, same layout as fOffset/fIndex:
+// the sources linked to the target 'k' are
+// fReverseIndex[fReverseOffset[k]..fReverseOffset[k+1]-1]
+// built on the first reverse query, invalidated when the links change
+//-----------------------------------------------------------------------------
+  Int_t                      fReverseValid;	// !
+  std::vector<int>           fReverseOffset;	// !
+  std::vector<int>           fReverseIndex;	// !
+					// I/O buffer for the packed links,
+					// keeps its capacity
+  std::vector<unsigned char> fBuffer;		// !
+//-----------------------------------------------------------------------------
 //  functions
 //-----------------------------------------------------------------------------
 					// ****** constructors and destructor
@@ -49,18 +72,43 @@ public:
 
     return fIndex.fArray[fOffset.fArray[i]+j]; 
   }
+//-----------------------------------------------------------------------------
+// reverse lookup: number of sources linked to the target 'k' and the index
+// of the j-th of them, sources come in increasing order
+//-----------------------------------------------------------------------------
+  Int_t  NTargets() {
+    if (! fReverseValid) BuildReverseIndex();
+    return fReverseOffset.size()-1;
+  }
+
+  Int_t  NReverseLinks(Int_t k) {
+    if (! fReverseValid) BuildReverseIndex();
+    if (k+1 >= (int) fReverseOffset.size())                 return 0;
+    return fReverseOffset[k+1]-fReverseOffset[k];
+  }
+
+  Int_t  ReverseIndex(Int_t k, Int_t j) {
+    if (! fReverseValid) BuildReverseIndex();
+    return fReverseIndex[fReverseOffset[k]+j];
+  }
+
+  Int_t  BuildReverseIndex();
+  void   GetStat          (Stat_t* Stat);
 					// ****** setters
   Int_t  Add(Int_t i, Int_t match);
 					// ****** overloaded functions of 
 					// TObject
+					// option "stat": statistics only
   void Print(Option_t* option = "") const;
   void Clear(Option_t* option = "");
 					// ****** schema evolution
+  void ReadV2(TBuffer& R__b);
 					// nothing has changed I/O-wise between
 					// versions 1 and 2, just a member 
 					// function has been added and a data 
-					// member has been renamed
-  ClassDef(TStnLinkBlock,2)
+					// member has been renamed.
+					// V3: packed links, see Streamer
+  ClassDef(TStnLinkBlock,3)
 };
 
 #endif
@@ -13,6 +13,10 @@ class TStnDataBlock;
 class TStnEvent;
 
 class TStnNode: public TNamed {
+public:
+					// profiling hook: called before
+					// (NBytes=-1) and after the read
+  typedef void (*ReadMonitor_t)(TStnNode* Node, Int_t NBytes);
 protected:
 //------------------------------------------------------------------------------
 //  data members
@@ -22,6 +26,8 @@ protected:
   TStnEvent*      fEvent;
   Int_t           (*fFunc)(TStnDataBlock *, TStnEvent *, Int_t);
   Int_t           fDeleteObject;	// ! 
+
+  static ReadMonitor_t fgReadMonitor;	// NULL by default
 //------------------------------------------------------------------------------
 //  functions
 //------------------------------------------------------------------------------
@@ -60,6 +66,8 @@ public:
 
   void             SetBranch(TBranch*   b    ) { fBranch = b;     }
 
+  static void      SetReadMonitor(ReadMonitor_t F) { fgReadMonitor = F; }
+
 					// ****** overloaded functions of 
 					// TObject
 
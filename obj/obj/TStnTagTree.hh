@@ -0,0 +1,94 @@
+#ifndef STNTUPLE_TStnTagTree
+#define STNTUPLE_TStnTagTree
+//-----------------------------------------------------------------------------
+// per-event tag tree "STNTAG": a few fixed-width summary columns per event,
+// written next to STNTUPLE (same file, one tag entry per STNTUPLE entry),
+// one branch per column.
+// The columns are taken from the header, track, cluster and trigger blocks
+// already filled for the event, blocks missing in the event leave the
+// corresponding columns at their defaults (0 or -1)
+//
+// columns:
+//   run, subrun, event, mcflag      : from the header block
+//   nsh, nch, ncalo, ncrv           : hit multiplicities (header block)
+//   ntrk                            : number of tracks
+//   trkp0, trkpt0, trkq0            : leading (highest P) track
+//   trkp1, trkpt1                   : next-to-leading track
+//   ncl                             : number of calorimeter clusters
+//   cle0, cle1                      : two highest cluster energies
+//   ntrig                           : number of passed trigger paths
+//   trig0 .. trig3                  : trigger path bits 0-127 (32 per word)
+//
+// TStnAna::SetTagSelection uses the same column names
+//-----------------------------------------------------------------------------
+#include "TNamed.h"
+#include "TString.h"
+
+#include "Stntuple/obj/TStnBlockHandle.hh"
+
+class TTree;
+class TDirectory;
+class TStnEvent;
+class TStnHeaderBlock;
+class TStnTrackBlock;
+class TStnClusterBlock;
+class TStnTriggerBlock;
+
+class TStnTagTree : public TNamed {
+public:
+  enum { kNTrigWords = 4 };
+
+  struct Tag_t {
+    Int_t    fRun;
+    Int_t    fSubrun;
+    Int_t    fEvent;
+    Int_t    fMcFlag;
+    Int_t    fNStrawHits;
+    Int_t    fNComboHits;
+    Int_t    fNCaloHits;
+    Int_t    fNCrvHits;
+    Int_t    fNTracks;
+    Float_t  fTrkP [2];
+    Float_t  fTrkPt[2];
+    Int_t    fTrkQ0;
+    Int_t    fNClusters;
+    Float_t  fClE  [2];
+    Int_t    fNTrig;
+    UInt_t   fTrig [kNTrigWords];
+  };
+
+protected:
+  TString    fTrackBlockName;
+  TString    fClusterBlockName;
+  TTree*     fTree;			// ! owned by the output file
+  Tag_t      fTag;			// !
+					// block handles, resolved on the first
+					// call to Fill
+  TStnEvent*                          fEvent;        // !
+  TStnBlockHandle<TStnHeaderBlock>    fHeaderBlock;  // !
+  TStnBlockHandle<TStnTrackBlock>     fTrackBlock;   // !
+  TStnBlockHandle<TStnClusterBlock>   fClusterBlock; // !
+  TStnBlockHandle<TStnTriggerBlock>   fTriggerBlock; // !
+//-----------------------------------------------------------------------------
+//  methods
+//-----------------------------------------------------------------------------
+public:
+  TStnTagTree(const char* TrackBlockName   = "TrackBlock",
+	      const char* ClusterBlockName = "ClusterBlock");
+  virtual ~TStnTagTree();
+
+  TTree*        GetTree() { return fTree; }
+  const Tag_t*  GetTag () { return &fTag; }
+//-----------------------------------------------------------------------------
+// create a new tree in Dir, the previous tree stays with its file
+//-----------------------------------------------------------------------------
+  int           MakeTree(TDirectory* Dir);
+  int           Fill    (TStnEvent* Event);
+
+  void          Clear(Option_t* Opt = "");
+  void          Print(Option_t* Opt = "") const;
+
+  ClassDef(TStnTagTree,0)
+};
+
+#endif
@@ -55,7 +55,9 @@ public:
 // modifiers
 //-----------------------------------------------------------------------------
   TStnTrack* NewTrack() {
-    TStnTrack* t = new ((*fListOfTracks)[fNTracks]) TStnTrack(fNTracks);
+    TStnTrack* t = (TStnTrack*) NewObject(fListOfTracks,fNTracks);
+    t->Clear();
+    t->SetNumber(fNTracks);
     fNTracks++;
     return t;
   }
@@ -52,10 +52,12 @@ public:
 
   Int_t    PathPassed(Int_t I) { return (fPaths.GetNBits() > I) ? fPaths.GetBit(I) : 0 ; }
 
+  Int_t    NPassedPaths() { return fPaths.CountBits(); }
 //-----------------------------------------------------------------------------
-// this could be precalculated
+// Mask: see TStnTriggerTable::MakeMask, 1 if any of the masked paths passed
 //-----------------------------------------------------------------------------
-  Int_t    NPassedPaths();
+  Int_t    Passed      (const TBitset* Mask) const { return fPaths.Intersects (Mask); }
+  Int_t    NPassed     (const TBitset* Mask) const { return fPaths.CountCommon(Mask); }
 					// ****** modifiers
 
   void     SetExecVersion(Int_t Version) { fExecVersion = Version; }
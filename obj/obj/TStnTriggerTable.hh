@@ -10,6 +10,8 @@
 #include "TObjArray.h"
 #include "Stntuple/obj/TStnTrigger.hh"
 
+class TBitset;
+
 class TStnTriggerTable: public TObject {
 protected:
   TString    fObjName;                  //! name of this for list searching
@@ -39,6 +41,13 @@ public:
 					// match given pattern
 
   void GetListOfTriggers(const char* Pattern, TObjArray* List);
+//-----------------------------------------------------------------------------
+// set bits of the triggers which names match any of the '|'-separated,
+// case-insensitive patterns (i.e. "cpr|apr"), "*" - all triggers. To be done
+// once per table, the mask is tested with TStnTriggerBlock::Passed.
+// Returns number of matched triggers
+//-----------------------------------------------------------------------------
+  int  MakeMask(const char* Pattern, TBitset* Mask) const;
 
 					// ****** modifiers
 
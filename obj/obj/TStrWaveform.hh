@@ -5,6 +5,7 @@
 #define TStrWaveform_hh
 
 #include <math.h>
+#include <vector>
 #include "TMath.h"
 #include "TObject.h"
 #include "TBuffer.h"
@@ -13,7 +14,11 @@ class TStrWaveform : public TObject {
 public:
 					// data
   int     fNWords;
-  ushort* fData;                        // [fNWords] array of fNWords shorts
+  ushort* fData;                        // [fNWords] owned, used only w/o a pool
+					// V3: samples stored in the pool of
+					// the straw hit block
+  int                  fOffset;		//! offset in the pool
+  std::vector<ushort>* fPool;		//! not owned
 
   float   fBaseline;	                //! baseline (based on first 5 samples)
   float   fQn;                          //! nsamples used to calculate the charge
@@ -28,23 +33,44 @@ public:
 // accessors
 //-----------------------------------------------------------------------------
   int     NWords   () { return fNWords ; }
-  ushort  Data(int I) { return fData[I]; }
-  ushort* Data()      { return fData   ; }
+  ushort  Data(int I) { return Samples()[I]; }
+  ushort* Data()      { return Samples()   ; }
+
+  ushort* Samples() const {
+    return (fPool) ? fPool->data()+fOffset : fData;
+  }
 //-----------------------------------------------------------------------------
 // modifiers
 //-----------------------------------------------------------------------------
   void    Set(int NWords, const ushort* Data);
 //-----------------------------------------------------------------------------
+// pooled waveforms: Set appends the samples to the pool, SetPooled refers
+// to the samples already there
+//-----------------------------------------------------------------------------
+  void    SetPool  (std::vector<ushort>* Pool) { fPool = Pool; fOffset = 0; }
+  void    SetPooled(std::vector<ushort>* Pool, int Offset, int NWords) {
+    fPool   = Pool;
+    fOffset = Offset;
+    fNWords = NWords;
+  }
+//-----------------------------------------------------------------------------
+// reused TClonesArray slot (ConstructedAt): back to the state of a newly 
+// constructed waveform, the samples owned from a V2 read are released
+//-----------------------------------------------------------------------------
+  void    Reset    (int ID);
+//-----------------------------------------------------------------------------
 // overloaded methods of TObject
 //-----------------------------------------------------------------------------
   void Clear(Option_t* opt = "");
   void Print(Option_t* opt = "") const;
 //-----------------------------------------------------------------------------
-// schema evolution - no I/O changes from v1 to v2, only transient variables added
+// schema evolution - no I/O changes from v1 to v2, only transient variables
+// added. V3: only transient variables added, the block V3 doesn't stream
+// the waveforms with this streamer
 //-----------------------------------------------------------------------------
 //  void ReadV1(TBuffer &R__b);
 
-  ClassDef (TStrWaveform,2)
+  ClassDef (TStrWaveform,3)
 };
 
 #endif
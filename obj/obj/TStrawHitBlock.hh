@@ -1,6 +1,8 @@
 #ifndef STNTUPLE_TStrawHitBlock
 #define STNTUPLE_TStrawHitBlock
 
+#include <vector>
+
 #include "TClonesArray.h"
 
 #include "Stntuple/obj/TStnDataBlock.hh"
@@ -19,6 +21,17 @@ public:
   TClonesArray*  fListOfHits;		// list of hits
   TClonesArray*  fListOfWaveforms;      // added in V2, list of waveforms, 
 //-----------------------------------------------------------------------------
+// V3: samples of all waveforms of the event in one buffer, reused from event
+// to event. On disk - first sample and zigzag-encoded differences of the
+// consecutive samples, bit-packed with a per-waveform number of bits
+//-----------------------------------------------------------------------------
+  std::vector<ushort>  fSamples;	//! waveform samples
+  std::vector<UInt_t>  fPacked;		//! I/O buffers
+  std::vector<int>     fWfID;		//!
+  std::vector<int>     fWfNWords;	//!
+  std::vector<ushort>  fWfFirst;	//!
+  std::vector<UChar_t> fWfNBits;	//!
+//-----------------------------------------------------------------------------
 //  functions
 //-----------------------------------------------------------------------------
 public:
@@ -41,18 +54,31 @@ public:
                                         //Create hit, increse number of hits
 
   TStrawHit*    NewHit     (int I) { return new ((*fListOfHits)[fNHits++])           TStrawHit   (I); } 
-  TStrWaveform* NewWaveform(int I) { return new ((*fListOfWaveforms)[fNWaveforms++]) TStrWaveform(I); } 
+					// the slot may hold a waveform from 
+					// the previous event, reset it
+  TStrWaveform* NewWaveform(int I) { 
+    TStrWaveform* wf = (TStrWaveform*) fListOfWaveforms->ConstructedAt(fNWaveforms++);
+    wf->Reset(I);
+    wf->SetPool(&fSamples);
+    return wf;
+  } 
+
+  std::vector<ushort>* GetSamples() { return &fSamples; }
 //-----------------------------------------------------------------------------
 // schema evolution
 //-----------------------------------------------------------------------------
   void ReadV1(TBuffer& R__b);
+  void ReadV2(TBuffer& R__b);
+
+  void WriteWaveforms(TBuffer& R__b);
+  void ReadWaveforms (TBuffer& R__b);
 //-----------------------------------------------------------------------------
 // overloaded methods of TObject
 //-----------------------------------------------------------------------------
   void Clear(Option_t* opt="");
   void Print(Option_t* opt="") const;
 
-  ClassDef(TStrawHitBlock,2)	// straw hit data block
+  ClassDef(TStrawHitBlock,3)	// straw hit data block
 };
 
 
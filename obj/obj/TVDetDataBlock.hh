@@ -1,8 +1,12 @@
 #ifndef STNTUPLE_TVDetDataBlock
 #define STNTUPLE_TVDetDataBlock
 
+#include <vector>
+
 #include "TClonesArray.h"
 
+#include "Stntuple/base/TVolumeIndex.hh"
+
 #include "Stntuple/obj/TStnDataBlock.hh"
 #include "Stntuple/obj/TVDetHitData.hh"
 
@@ -16,6 +20,10 @@ class TVDetDataBlock: public TStnDataBlock {
 public:
   Int_t          fNHits;	        // number of hits in the virtual detectors
   TClonesArray*  fListOfHits;		// list of hits
+					// hits by VD index, built on the
+					// first request in the event
+  TVolumeIndex     fVolumeIndex;	//!
+  std::vector<int> fHitVolumeID;	//! work array
 //-----------------------------------------------------------------------------
 //  functions
 //-----------------------------------------------------------------------------
@@ -28,12 +36,23 @@ public:
   TVDetHitData* Hit (int i) { return (TVDetHitData*) fListOfHits->UncheckedAt(i); }
   
   TClonesArray* GetListOfHits () { return fListOfHits; }
+					// hits in the K-th VD:
+					// Hit(vi->Object(K,0..))
+  TVolumeIndex* VolumeIndex() {
+    if (! fVolumeIndex.Valid()) BuildVolumeIndex();
+    return &fVolumeIndex;
+  }
+
+  int           BuildVolumeIndex();
 //-----------------------------------------------------------------------------
 // modifiers
 //-----------------------------------------------------------------------------
                                         //Create hit, increse number of hits
 
-  TVDetHitData* NewHit() { return new ((*fListOfHits)[fNHits++]) TVDetHitData(); } 
+  TVDetHitData* NewHit() { 
+    fVolumeIndex.Invalidate();
+    return new ((*fListOfHits)[fNHits++]) TVDetHitData(); 
+  } 
 //-----------------------------------------------------------------------------
 // overloaded methods of TObject
 //-----------------------------------------------------------------------------
@@ -70,12 +70,27 @@
 #include "BTrk/TrkBase/HelixParams.hh"
 #include "BTrk/ProbTools/ChisqConsistency.hh"
 
+#include <cstdarg>
+#include <cstring>
+#include <algorithm>
+#include <iostream>
+#include <unistd.h>
+
 using namespace std;
 
 ClassImp(TAnaDump)
 
 TAnaDump* TAnaDump::fgInstance = 0;
 
+const char* TAnaDump::fgKindName[kNKinds] = { "ch", "hs", "ks", "simp" };
+					// filter parameters used by each kind
+static const char* gKindFilters[TAnaDump::kNKinds] = {
+  " tmin tmax simid ",
+  " pmin tmin tmax ",
+  " pmin tmin tmax ",
+  " pmin tmin tmax simid pdg "
+};
+
 //-----------------------------------------------------------------------------
 // WeightMode = 1 is for XY chi2 , WeightMode = 0 is for Phi-z chi2
 //-----------------------------------------------------------------------------
@@ -138,6 +153,25 @@ TAnaDump::TAnaDump(const fhicl::ParameterSet* PSet) {
   fSdmcCollTag            = "compressDigiMCs";
 
   _printUtils = new mu2e::TrkPrintUtils(PSet->get<fhicl::ParameterSet>("printUtils",fhicl::ParameterSet()));
+//-----------------------------------------------------------------------------
+// output, see TAnaDump.hh
+//-----------------------------------------------------------------------------
+  fNBytes   = 0;
+  fOutput   = stdout;
+  fDepth    = 0;
+  fRowKind  = -1;
+  ResetFormat();
+
+  SetBufferSize(PSet->get<int>        ("bufferSize",1024*1024));
+  SetOutputFile(PSet->get<std::string>("outputFile",""     ).data());
+  fHold     = PSet->get<int>          ("holdOutput",0);
+  fColumnar = PSet->get<int>          ("columnar"  ,0);
+
+  std::vector<std::string> fields  = PSet->get<std::vector<std::string>>("fields" ,std::vector<std::string>());
+  std::vector<std::string> filters = PSet->get<std::vector<std::string>>("filters",std::vector<std::string>());
+
+  for (const std::string& f : fields ) SetFields(f.data());
+  for (const std::string& f : filters) SetFilter(f.data());
 }
 
 // //-----------------------------------------------------------------------------
@@ -161,6 +195,9 @@ TAnaDump* TAnaDump::Instance(const fhicl::ParameterSet* PSet) {
 
 //______________________________________________________________________________
 TAnaDump::~TAnaDump() {
+  Flush();
+  if (fOutput != stdout) fclose(fOutput);
+
   fListOfObjects->Delete();
   delete fListOfObjects;
   delete _printUtils;
@@ -179,6 +216,278 @@ TAnaDump::Cleaner::Cleaner() {
   }
 
 
+//-----------------------------------------------------------------------------
+TAnaDump::OutputScope::OutputScope(TAnaDump* Dump) {
+  fDump = Dump;
+  fDump->fDepth++;
+}
+
+//-----------------------------------------------------------------------------
+TAnaDump::OutputScope::~OutputScope() {
+  fDump->fDepth--;
+  if ((fDump->fDepth == 0) && (fDump->fHold == 0)) fDump->Flush();
+}
+
+//-----------------------------------------------------------------------------
+// held output of the previous event goes out before the next one starts
+//-----------------------------------------------------------------------------
+void TAnaDump::SetEvent(const art::Event* Evt) {
+  Flush();
+  fEvent = Evt;
+}
+
+//-----------------------------------------------------------------------------
+// if the formatted string doesn't fit, flush the buffer and format again,
+// a string longer than the buffer itself makes the buffer grow
+//-----------------------------------------------------------------------------
+int TAnaDump::Out(const char* Format, ...) {
+  va_list ap;
+
+  int nfree = fBuffer.size()-fNBytes;
+
+  va_start(ap,Format);
+  int n = vsnprintf(fBuffer.data()+fNBytes,nfree,Format,ap);
+  va_end(ap);
+
+  if (n < 0) return n;
+
+  if (n >= nfree) {
+    Flush(0);
+    if (n >= (int) fBuffer.size()) fBuffer.resize(2*n);
+
+    va_start(ap,Format);
+    vsnprintf(fBuffer.data(),fBuffer.size(),Format,ap);
+    va_end(ap);
+  }
+
+  fNBytes += n;
+
+  if ((fDepth == 0) && (fHold == 0)) Flush(0);
+
+  return n;
+}
+
+//-----------------------------------------------------------------------------
+// goes through the stdio buffer of fOutput, so the order with respect to 
+// direct printf's is preserved. A per-object printout outside of
+// print*Collection calls it with Sync=0, so it costs no system call
+// unless the stdio buffer is full
+//-----------------------------------------------------------------------------
+void TAnaDump::Flush(int Sync) {
+  if (fNBytes > 0) {
+    fwrite(fBuffer.data(),1,fNBytes,fOutput);
+    fNBytes = 0;
+  }
+  if (Sync) fflush(fOutput);
+}
+
+//-----------------------------------------------------------------------------
+// "" or "stdout": standard output
+//-----------------------------------------------------------------------------
+int TAnaDump::SetOutputFile(const char* Filename) {
+  Flush();
+  if (fOutput != stdout) fclose(fOutput);
+  fOutput = stdout;
+
+  if ((Filename[0] == 0) || (strcmp(Filename,"stdout") == 0)) return 0;
+
+  FILE* f = fopen(Filename,"w");
+  if (f == nullptr) {
+    printf(" TAnaDump::SetOutputFile: ERROR: can\'t open %s, use stdout\n",Filename);
+    return -1;
+  }
+  fOutput = f;
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+void TAnaDump::SetBufferSize(int Size) {
+  Flush();
+  if (Size < 1024) Size = 1024;
+  fBuffer.resize(Size);
+}
+
+//-----------------------------------------------------------------------------
+int TAnaDump::GetKind(const char* Name) {
+  for (int i=0; i<kNKinds; i++) {
+    if (strcmp(Name,fgKindName[i]) == 0) return i;
+  }
+  return -1;
+}
+
+//-----------------------------------------------------------------------------
+void TAnaDump::ResetFormat() {
+  for (int i=0; i<kNKinds; i++) {
+    Format_t* f = &fFormat[i];
+    f->fFields.clear();
+    f->fPMin          = -1.;
+    f->fTMin          = -1.e12;
+    f->fTMax          =  1.e12;
+    f->fSimID         = -1;
+    f->fPdgID         =  0;
+    f->fHeaderPrinted =  0;
+  }
+  fTrackHits.clear();
+}
+
+//-----------------------------------------------------------------------------
+// Fields: comma-separated column names, "" - all columns
+//-----------------------------------------------------------------------------
+int TAnaDump::SetFields(const char* Kind, const char* Fields) {
+  int k = GetKind(Kind);
+  if (k < 0) {
+    printf(" TAnaDump::SetFields: ERROR: unknown kind \'%s\'\n",Kind);
+    return -1;
+  }
+
+  std::vector<std::string>* list = &fFormat[k].fFields;
+  list->clear();
+
+  std::string fields(Fields);
+  size_t      loc = 0;
+  while (loc < fields.size()) {
+    size_t next = fields.find(',',loc);
+    if (next == std::string::npos) next = fields.size();
+    if (next > loc) list->push_back(fields.substr(loc,next-loc));
+    loc = next+1;
+  }
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+int TAnaDump::SetFields(const char* Spec) {
+  const char* c = strchr(Spec,':');
+  if (c == nullptr) {
+    printf(" TAnaDump::SetFields: ERROR: wrong spec \'%s\', expected \'kind:f1,f2,...\'\n",Spec);
+    return -1;
+  }
+  std::string kind(Spec,c-Spec);
+  return SetFields(kind.data(),c+1);
+}
+
+//-----------------------------------------------------------------------------
+int TAnaDump::SetFilter(const char* Kind, const char* Par, double Value) {
+  int k = GetKind(Kind);
+  if (k < 0) {
+    printf(" TAnaDump::SetFilter: ERROR: unknown kind \'%s\'\n",Kind);
+    return -1;
+  }
+
+  Format_t* f = &fFormat[k];
+
+  std::string par = std::string(" ")+Par+" ";
+  if (strstr(gKindFilters[k],par.data()) == nullptr) {
+    printf(" TAnaDump::SetFilter: ERROR: parameter '%s' is not used for kind '%s', use one of:%s\n",
+	   Par,Kind,gKindFilters[k]);
+    return -1;
+  }
+
+  if      (strcmp(Par,"pmin" ) == 0) f->fPMin  = Value;
+  else if (strcmp(Par,"tmin" ) == 0) f->fTMin  = Value;
+  else if (strcmp(Par,"tmax" ) == 0) f->fTMax  = Value;
+  else if (strcmp(Par,"simid") == 0) f->fSimID = (int) Value;
+  else if (strcmp(Par,"pdg"  ) == 0) f->fPdgID = (int) Value;
+  else {
+    printf(" TAnaDump::SetFilter: ERROR: unknown parameter \'%s\'\n",Par);
+    return -1;
+  }
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+int TAnaDump::SetFilter(const char* Spec) {
+  const char* c  = strchr(Spec,':');
+  const char* eq = (c) ? strchr(c,'=') : nullptr;
+  if (eq == nullptr) {
+    printf(" TAnaDump::SetFilter: ERROR: wrong spec \'%s\', expected \'kind:par=value\'\n",Spec);
+    return -1;
+  }
+  std::string kind(Spec,c-Spec);
+  std::string par (c+1 ,eq-c-1);
+  return SetFilter(kind.data(),par.data(),atof(eq+1));
+}
+
+//-----------------------------------------------------------------------------
+void TAnaDump::SelectTrackHits(const mu2e::KalSeed* KSeed) {
+  fTrackHits.clear();
+  if (KSeed == nullptr) return;
+
+  for (const mu2e::TrkStrawHitSeed& hit : KSeed->hits()) fTrackHits.push_back(hit.index());
+  std::sort(fTrackHits.begin(),fTrackHits.end());
+}
+
+//-----------------------------------------------------------------------------
+// columnar output: the header line is made of the same column names as 
+// the first row of the table
+//-----------------------------------------------------------------------------
+void TAnaDump::BeginRow(int Kind) {
+  fRowKind = Kind;
+  fRow.clear();
+  fRowHeader.clear();
+}
+
+//-----------------------------------------------------------------------------
+void TAnaDump::Col(const char* Name, const char* Format, ...) {
+  const std::vector<std::string>& fields = fFormat[fRowKind].fFields;
+
+  if (fields.size() > 0) {
+    if (std::find(fields.begin(),fields.end(),Name) == fields.end()) return;
+  }
+
+  char    buf[100];
+  va_list ap;
+
+  va_start(ap,Format);
+  vsnprintf(buf,sizeof(buf),Format,ap);
+  va_end(ap);
+
+  fRow += ' ';
+  fRow += buf;
+
+  if (fFormat[fRowKind].fHeaderPrinted == 0) {
+    fRowHeader += ' ';
+    fRowHeader += Name;
+  }
+}
+
+//-----------------------------------------------------------------------------
+void TAnaDump::EndRow() {
+  const char* kind = fgKindName[fRowKind];
+
+  if (fFormat[fRowKind].fHeaderPrinted == 0) {
+    Out("#%s run event%s\n",kind,fRowHeader.data());
+    fFormat[fRowKind].fHeaderPrinted = 1;
+  }
+
+  int run   = (fEvent) ? (int) fEvent->run  () : -1;
+  int event = (fEvent) ? (int) fEvent->event() : -1;
+
+  Out("%s %i %i%s\n",kind,run,event,fRow.data());
+}
+
+//-----------------------------------------------------------------------------
+int TAnaDump::PassHit(int Index, double Time, int SimID) const {
+  const Format_t* f = &fFormat[kComboHit];
+
+  if ((Time < f->fTMin) || (Time > f->fTMax))                                return 0;
+  if ((f->fSimID >= 0) && (SimID != f->fSimID))                              return 0;
+  if ((fTrackHits.size() > 0) &&
+      (! std::binary_search(fTrackHits.begin(),fTrackHits.end(),Index)))     return 0;
+
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+int TAnaDump::PassParticle(double P, int SimID, int PdgID) const {
+  const Format_t* f = &fFormat[kSimParticle];
+
+  if (P < f->fPMin)                                return 0;
+  if ((f->fSimID >= 0) && (SimID != f->fSimID))    return 0;
+  if ((f->fPdgID != 0) && (PdgID != f->fPdgID))    return 0;
+
+  return 1;
+}
+
 //-----------------------------------------------------------------------------
 void TAnaDump::AddObject(const char* Name, void* Object) {
   TNamedHandle* h = new TNamedHandle(Name,Object);
@@ -210,12 +519,12 @@ void TAnaDump::printCaloCluster(const mu2e::CaloCluster* Cl,
   Hep3Vector        gpos, tpos;
 
   if ((opt == "") || (opt.Index("banner") >= 0)) {
-    printf("-----------------------------------------------------------------------------------------------");
-    printf("-------------------------------\n");
-    printf(" Row Col Address        Disk Parent  NC   Energy   Time       X(loc)     Y(loc)   Z(loc)");
-    printf("        X          Y          Z\n");
-    printf("-----------------------------------------------------------------------------------------------");
-    printf("-------------------------------\n");
+    Out("-----------------------------------------------------------------------------------------------");
+    Out("-------------------------------\n");
+    Out(" Row Col Address        Disk Parent  NC   Energy   Time       X(loc)     Y(loc)   Z(loc)");
+    Out("        X          Y          Z\n");
+    Out("-----------------------------------------------------------------------------------------------");
+    Out("-------------------------------\n");
   }
  
   if ((opt == "") || (opt.Index("data") >= 0)) {
@@ -233,7 +542,7 @@ void TAnaDump::printCaloCluster(const mu2e::CaloCluster* Cl,
     gpos = cal->geomUtil().diskToMu2e(Cl->diskID(),Cl->cog3Vector());
     tpos = cal->geomUtil().mu2eToTracker(gpos);
 
-    printf(" %3i %3i %-16p %2i %6i %3i %8.3f %8.3f %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f\n",
+    Out(" %3i %3i %-16p %2i %6i %3i %8.3f %8.3f %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f\n",
 	   row, col,
 	   static_cast<const void*>(Cl),
 	   Cl->diskID(),
@@ -263,11 +572,11 @@ void TAnaDump::printCaloCluster(const mu2e::CaloCluster* Cl,
     
     //    mu2e::Calorimeter const & calo = *(mu2e::GeomHandle<mu2e::Calorimeter>());
 
-    printf("-----------------------------------------------------------------------------------------------");
-    printf("-------------------------------\n");
-    printf("    Id       time      Gen-Code     ID   PDG  PDG(M)      energy       X(loc)     Y(loc)   Z(loc)    energy-MC     nSimP\n");
-    printf("-----------------------------------------------------------------------------------------------");
-    printf("-------------------------------\n");
+    Out("-----------------------------------------------------------------------------------------------");
+    Out("-------------------------------\n");
+    Out("    Id       time      Gen-Code     ID   PDG  PDG(M)      energy       X(loc)     Y(loc)   Z(loc)    energy-MC     nSimP\n");
+    Out("-----------------------------------------------------------------------------------------------");
+    Out("-------------------------------\n");
    
     for (int i=0; i<nh; i++) {
       const mu2e::CaloHit* hit = &(*caloClusterHits.at(i));
@@ -277,7 +586,7 @@ void TAnaDump::printCaloCluster(const mu2e::CaloCluster* Cl,
 
       pos = &cr->localPosition();
   
-      printf("TAnaDump::printCaloCluster ERROR: CrystalContentMC is gone, FIXIT\n");
+      Out("TAnaDump::printCaloCluster ERROR: CrystalContentMC is gone, FIXIT\n");
 
       //      mu2e::CrystalContentMC contentMC(calo, *CaloHitTruth, *hit);
       double                 simMaxEdep(0);
@@ -306,7 +615,7 @@ void TAnaDump::printCaloCluster(const mu2e::CaloCluster* Cl,
       // 	++nSimPart;
       // }
       
-      printf("%6i   %10.3f %8i %8i %5i %5i    %10.3f   %10.3f %10.3f %10.3f %10.3f %8i\n",
+      Out("%6i   %10.3f %8i %8i %5i %5i    %10.3f   %10.3f %10.3f %10.3f %10.3f %8i\n",
 	     id,
 	     hit->time(),
 	     simCreationCode, simID,simPDGId,simPDGM,
@@ -330,8 +639,9 @@ void TAnaDump::printCaloClusterCollection(const char* ModuleLabel,
 					  double      Emin,
 					  int         HitOpt,
 					  const char* MCModuleLabel) {
+  OutputScope scope(this);
 
-  printf(">>>> ModuleLabel = %s\n",ModuleLabel);
+  Out(">>>> ModuleLabel = %s\n",ModuleLabel);
 
   //data about hits in the calorimeter crystals
 
@@ -364,8 +674,8 @@ void TAnaDump::printCaloClusterCollection(const char* ModuleLabel,
 // make sure collection exists
 //-----------------------------------------------------------------------------
   if (! handle.isValid()) {
-    printf("TAnaDump::printCaloClusterCollection: no CaloClusterCollection ");
-    printf("for module %s and ProductName=%s found, BAIL OUT\n",
+    Out("TAnaDump::printCaloClusterCollection: no CaloClusterCollection ");
+    Out("for module %s and ProductName=%s found, BAIL OUT\n",
 	   ModuleLabel,ProductName);
     return;
   }
@@ -415,9 +725,9 @@ void TAnaDump::printCaloProtoCluster(const mu2e::CaloProtoCluster* Cluster, cons
   cal = cg.get();
 
   if ((opt == "") || (opt == "banner")) {
-    printf("-----------------------------------------------------------------------------------------------------\n");
-    printf("       Address  SectionID  IsSplit  NC    Time    Energy      \n");
-    printf("-----------------------------------------------------------------------------------------------------\n");
+    Out("-----------------------------------------------------------------------------------------------------\n");
+    Out("       Address  SectionID  IsSplit  NC    Time    Energy      \n");
+    Out("-----------------------------------------------------------------------------------------------------\n");
   }
  
   const mu2e::CaloHitPtrVector caloClusterHits = Cluster->caloHitsPtrVector();
@@ -425,7 +735,7 @@ void TAnaDump::printCaloProtoCluster(const mu2e::CaloProtoCluster* Cluster, cons
 
   if ((opt == "") || (opt.Index("data") >= 0)) {
 
-    printf("%16p  %3i %5i %5i %10.3f %10.3f\n",
+    Out("%16p  %3i %5i %5i %10.3f %10.3f\n",
 	   static_cast<const void*>(Cluster),
 	   section_id,
 	   nh,
@@ -448,7 +758,7 @@ void TAnaDump::printCaloProtoCluster(const mu2e::CaloProtoCluster* Cluster, cons
       iz  = -1;
       ir  = -1;
       
-      printf("%6i     %10.3f %5i %5i %8.3f %10.3f %10.3f %10.3f %10.3f\n",
+      Out("%6i     %10.3f %5i %5i %8.3f %10.3f %10.3f %10.3f %10.3f\n",
 	     id,
 	     hit->time(),
 	     iz,ir,
@@ -467,6 +777,7 @@ void TAnaDump::printCaloProtoCluster(const mu2e::CaloProtoCluster* Cluster, cons
 void TAnaDump::printCaloProtoClusterCollection(const char* ModuleLabel, 
 					       const char* ProductName,
 					       const char* ProcessName) {
+  OutputScope scope(this);
 
   art::Handle<mu2e::CaloProtoClusterCollection> handle;
   const mu2e::CaloProtoClusterCollection       *coll;
@@ -489,8 +800,8 @@ void TAnaDump::printCaloProtoClusterCollection(const char* ModuleLabel,
 // make sure collection exists
 //-----------------------------------------------------------------------------
   if (! handle.isValid()) {
-    printf("TAnaDump::printCaloProtoClusterCollection: no CaloProtoClusterCollection ");
-    printf("for module %s and ProductName=%s found, BAIL OUT\n",
+    Out("TAnaDump::printCaloProtoClusterCollection: no CaloProtoClusterCollection ");
+    Out("for module %s and ProductName=%s found, BAIL OUT\n",
 	   ModuleLabel,ProductName);
     return;
   }
@@ -520,8 +831,8 @@ void TAnaDump::printCrvCoincidence(const mu2e::CrvCoincidence* Coin,
   int sector      = Coin->GetCrvSectorType();
   int np          = list_of_pulses->size();
 
-  printf("---------------------------------------------------------------------\n");
-  printf("Coinc Addr: %-16p Sector: %5i N(pulses): %5i\n",static_cast<const void*>(Coin), sector, np);
+  Out("---------------------------------------------------------------------\n");
+  Out("Coinc Addr: %-16p Sector: %5i N(pulses): %5i\n",static_cast<const void*>(Coin), sector, np);
 
   const mu2e::CrvRecoPulse* pulse(NULL);
   printCrvRecoPulse(pulse, "banner");
@@ -538,6 +849,7 @@ void TAnaDump::printCrvCoincidence(const mu2e::CrvCoincidence* Coin,
 void TAnaDump::printCrvCoincidenceCollection(const char* ModuleLabel, 
 					     const char* ProductName,
 					     const char* ProcessName) {
+  OutputScope scope(this);
 
   art::Handle<mu2e::CrvCoincidenceCollection> handle;
   const mu2e::CrvCoincidenceCollection*       coinColl;
@@ -557,8 +869,8 @@ void TAnaDump::printCrvCoincidenceCollection(const char* ModuleLabel,
 // make sure collection exists
 //-----------------------------------------------------------------------------
   if (! handle.isValid()) {
-    printf("TAnaDump::printCrvCoincidenceCollection: no CrvCoincidenceCollection ");
-    printf("for module %s and ProductName=%s found, BAIL OUT\n",
+    Out("TAnaDump::printCrvCoincidenceCollection: no CrvCoincidenceCollection ");
+    Out("for module %s and ProductName=%s found, BAIL OUT\n",
 	   ModuleLabel,ProductName);
     return;
   }
@@ -567,7 +879,7 @@ void TAnaDump::printCrvCoincidenceCollection(const char* ModuleLabel,
 
   int ncoin = coinColl->size();
 
-  printf(">>>> ModuleLabel = %s N(coincidences) = %5i\n",ModuleLabel,ncoin);
+  Out(">>>> ModuleLabel = %s N(coincidences) = %5i\n",ModuleLabel,ncoin);
 
   const mu2e::CrvCoincidence* coin;
 
@@ -591,9 +903,9 @@ void TAnaDump::printCrvCoincidenceCluster(const mu2e::CrvCoincidenceCluster* CCl
   TString opt = Opt;
 
   if ((opt == "") || (opt.Index("banner") >= 0)) {
-    printf("--------------------------------------------------------------------------------------\n");
-    printf("CC Address         Sect   Np   NPe     Tstart      Tend        X          Y          Z\n");
-    printf("--------------------------------------------------------------------------------------\n");
+    Out("--------------------------------------------------------------------------------------\n");
+    Out("CC Address         Sect   Np   NPe     Tstart      Tend        X          Y          Z\n");
+    Out("--------------------------------------------------------------------------------------\n");
   }
  
   if ((opt == "") || (opt.Index("data") >= 0)) {
@@ -610,7 +922,7 @@ void TAnaDump::printCrvCoincidenceCluster(const mu2e::CrvCoincidenceCluster* CCl
     float t2        = CCl->GetEndTime();
     int   npe       = CCl->GetPEs();
 
-    printf("%-16p %5i %5i %5i %10.3f %10.3f %10.3f %10.3f %10.3f\n",static_cast<const void*>(CCl),sector,np,npe,t1,t2,x,y,z);
+    Out("%-16p %5i %5i %5i %10.3f %10.3f %10.3f %10.3f %10.3f\n",static_cast<const void*>(CCl),sector,np,npe,t1,t2,x,y,z);
 
     const mu2e::CrvRecoPulse* pulse(NULL);
     const mu2e::CrvRecoPulse* otherpulse1(NULL);
@@ -673,9 +985,9 @@ void TAnaDump::printCrvCoincidenceCluster(const mu2e::CrvCoincidenceCluster* CCl
     }
 
     // now print everything
-    printf("---------------------------------------------------------------------\n");
-    printf("BarIndex       bar_length       Tcorrected(MD)     Xcorrected(MD)    \n");
-    printf("---------------------------------------------------------------------\n");
+    Out("---------------------------------------------------------------------\n");
+    Out("BarIndex       bar_length       Tcorrected(MD)     Xcorrected(MD)    \n");
+    Out("---------------------------------------------------------------------\n");
     float totaltimeavg(0),totalxavg(0);
     float nbars = 0;
     int   twoendbars   = 0;
@@ -722,7 +1034,7 @@ void TAnaDump::printCrvCoincidenceCluster(const mu2e::CrvCoincidenceCluster* CCl
 	totalxavg    += xcorrected;
 	nbars        += 1;
 
-	printf("%8i %14.2f %16.2f %14.3f\n",bar,bar_length, tcorrected,xcorrected);
+	Out("%8i %14.2f %16.2f %14.3f\n",bar,bar_length, tcorrected,xcorrected);
 
 	// printf("totaltimeavg, totalxavg, nbars: %10.3f %10.3f %2i\n",totaltimeavg, totalxavg,nbars);
     }
@@ -754,7 +1066,7 @@ void TAnaDump::printCrvCoincidenceCluster(const mu2e::CrvCoincidenceCluster* CCl
     //   printf("%8i %9f %9f\n",bar,tcorrected,xcorrected);
     // }
     // totaltimeavg /= nbars;
-    printf("total coincidence corrected time average: %8f\n", totaltimeavg);
+    Out("total coincidence corrected time average: %8f\n", totaltimeavg);
   }
   
   if (opt.Index("hits") >= 0) {
@@ -767,6 +1079,7 @@ void TAnaDump::printCrvCoincidenceCluster(const mu2e::CrvCoincidenceCluster* CCl
 void TAnaDump::printCrvCoincidenceClusterCollection(const char* ModuleLabel, 
 						    const char* ProductName,
 						    const char* ProcessName) {
+  OutputScope scope(this);
 
   art::Handle<mu2e::CrvCoincidenceClusterCollection> handle;
   const mu2e::CrvCoincidenceClusterCollection*       ccColl;
@@ -786,8 +1099,8 @@ void TAnaDump::printCrvCoincidenceClusterCollection(const char* ModuleLabel,
 // make sure collection exists
 //-----------------------------------------------------------------------------
   if (! handle.isValid()) {
-    printf("TAnaDump::printCrvCoincidenceClusterCollection: no CrvCoincidenceClusterCollection ");
-    printf("for module %s and ProductName=%s found, BAIL OUT\n",
+    Out("TAnaDump::printCrvCoincidenceClusterCollection: no CrvCoincidenceClusterCollection ");
+    Out("for module %s and ProductName=%s found, BAIL OUT\n",
 	   ModuleLabel,ProductName);
     return;
   }
@@ -796,7 +1109,7 @@ void TAnaDump::printCrvCoincidenceClusterCollection(const char* ModuleLabel,
 
   int ncc = ccColl->size();
 
-  printf(">>>> ModuleLabel = %s N(coincidence clusters) = %5i\n",ModuleLabel,ncc);
+  Out(">>>> ModuleLabel = %s N(coincidence clusters) = %5i\n",ModuleLabel,ncc);
 
   const mu2e::CrvCoincidenceCluster* cc;
 
@@ -821,9 +1134,9 @@ void TAnaDump::printCrvRecoPulse(const mu2e::CrvRecoPulse* Pulse,
   TString opt = Opt;
 
   if ((opt == "") || (opt.Index("banner") >= 0)) {
-    printf("-------------------------------------------------------------------------------------------------------\n");
-    printf("Pulse Addr         NPE   HPE    Time    Height    Width     Chi2    LeTime   Bar   Sipm  NInd   Indices\n");
-    printf("-------------------------------------------------------------------------------------------------------\n");
+    Out("-------------------------------------------------------------------------------------------------------\n");
+    Out("Pulse Addr         NPE   HPE    Time    Height    Width     Chi2    LeTime   Bar   Sipm  NInd   Indices\n");
+    Out("-------------------------------------------------------------------------------------------------------\n");
   }
  
   if ((opt == "") || (opt.Index("data") >= 0)) {
@@ -840,7 +1153,7 @@ void TAnaDump::printCrvRecoPulse(const mu2e::CrvRecoPulse* Pulse,
     int bar         = Pulse->GetScintillatorBarIndex().asInt();
     int sipm_number = Pulse->GetSiPMNumber();
 
-    printf("%-16p %5i %5i %8.3f %8.3f %8.3f %10.3f %8.3f %5i %5i %5i",
+    Out("%-16p %5i %5i %8.3f %8.3f %8.3f %10.3f %8.3f %5i %5i %5i",
      	   static_cast<const void*>(Pulse),
 	   npes,
 	   npes_height,
@@ -855,9 +1168,9 @@ void TAnaDump::printCrvRecoPulse(const mu2e::CrvRecoPulse* Pulse,
 
     for (int i=0; i<nind; i++) {
       int ind =  Pulse->GetWaveformIndices().at(i);
-      printf("%5i",ind);
+      Out("%5i",ind);
     }
-    printf("\n");
+    Out("\n");
   }
   
   if (opt.Index("hits") >= 0) {
@@ -872,9 +1185,9 @@ void TAnaDump::printCrvDigi(const mu2e::CrvDigi* Digi,
   TString opt = Opt;
 
   if ((opt == "") || (opt.Index("banner") >= 0)) {
-    printf("-------------------------------------------------------------------------------------------------------\n");
-    printf(" ADC0   ADC1   ADC2   ADC3   ADC4   ADC5   ADC6   ADC7   StartTDC  BarIndex  SiPM#\n");
-    printf("-------------------------------------------------------------------------------------------------------\n");
+    Out("-------------------------------------------------------------------------------------------------------\n");
+    Out(" ADC0   ADC1   ADC2   ADC3   ADC4   ADC5   ADC6   ADC7   StartTDC  BarIndex  SiPM#\n");
+    Out("-------------------------------------------------------------------------------------------------------\n");
   }
  
   if ((opt == "") || (opt.Index("data") >= 0)) {
@@ -892,7 +1205,7 @@ void TAnaDump::printCrvDigi(const mu2e::CrvDigi* Digi,
     int bar         = Digi->GetScintillatorBarIndex().asInt();
     int sipm_number = Digi->GetSiPMNumber();
 
-    printf("%5i %6i %6i %6i %6i %6i %6i %6i %9.2f %7i %8i",
+    Out("%5i %6i %6i %6i %6i %6i %6i %6i %9.2f %7i %8i",
 	   adc0,
 	   adc1,
 	   adc2,
@@ -905,7 +1218,7 @@ void TAnaDump::printCrvDigi(const mu2e::CrvDigi* Digi,
 	   bar,
 	   sipm_number);
 
-    printf("\n");
+    Out("\n");
   }
   
   if (opt.Index("hits") >= 0) {
@@ -919,6 +1232,7 @@ void TAnaDump::printCrvDigi(const mu2e::CrvDigi* Digi,
 void TAnaDump::printCrvDigiCollection(const char* ModuleLabel, 
 					   const char* ProductName,
 					   const char* ProcessName) {
+  OutputScope scope(this);
 
   art::Handle<mu2e::CrvDigiCollection> handle;
   const mu2e::CrvDigiCollection*       crpColl;
@@ -947,8 +1261,8 @@ void TAnaDump::printCrvDigiCollection(const char* ModuleLabel,
 // make sure collection exists
 //-----------------------------------------------------------------------------
   if (! handle.isValid()) {
-    printf("TAnaDump::printCrvDigiCollection: no CrvDigiCollection ");
-    printf("for module %s and ProductName=%s found, BAIL OUT\n",
+    Out("TAnaDump::printCrvDigiCollection: no CrvDigiCollection ");
+    Out("for module %s and ProductName=%s found, BAIL OUT\n",
 	   ModuleLabel,ProductName);
     return;
   }
@@ -957,7 +1271,7 @@ void TAnaDump::printCrvDigiCollection(const char* ModuleLabel,
 
   int npulses = crpColl->size();
 
-  printf(">>>> ModuleLabel = %s N(reco pulses) = %5i\n",ModuleLabel,npulses);
+  Out(">>>> ModuleLabel = %s N(reco pulses) = %5i\n",ModuleLabel,npulses);
 
   //  if (caloHitTruthHandle.isValid()) caloHitTruth = caloHitTruthHandle.product();
 
@@ -984,6 +1298,7 @@ void TAnaDump::printCrvDigiCollection(const char* ModuleLabel,
 void TAnaDump::printCrvRecoPulseCollection(const char* ModuleLabel, 
 					   const char* ProductName,
 					   const char* ProcessName) {
+  OutputScope scope(this);
 
   art::Handle<mu2e::CrvRecoPulseCollection> handle;
   const mu2e::CrvRecoPulseCollection*       crpColl;
@@ -1012,8 +1327,8 @@ void TAnaDump::printCrvRecoPulseCollection(const char* ModuleLabel,
 // make sure collection exists
 //-----------------------------------------------------------------------------
   if (! handle.isValid()) {
-    printf("TAnaDump::printCrvRecoPulseCollection: no CrvRecoPulseCollection ");
-    printf("for module %s and ProductName=%s found, BAIL OUT\n",
+    Out("TAnaDump::printCrvRecoPulseCollection: no CrvRecoPulseCollection ");
+    Out("for module %s and ProductName=%s found, BAIL OUT\n",
 	   ModuleLabel,ProductName);
     return;
   }
@@ -1022,7 +1337,7 @@ void TAnaDump::printCrvRecoPulseCollection(const char* ModuleLabel,
 
   int npulses = crpColl->size();
 
-  printf(">>>> ModuleLabel = %s N(reco pulses) = %5i\n",ModuleLabel,npulses);
+  Out(">>>> ModuleLabel = %s N(reco pulses) = %5i\n",ModuleLabel,npulses);
 
   //  if (caloHitTruthHandle.isValid()) caloHitTruth = caloHitTruthHandle.product();
 
@@ -1046,7 +1361,7 @@ void TAnaDump::printCrvRecoPulseCollection(const char* ModuleLabel,
 //-----------------------------------------------------------------------------
 void TAnaDump::printEventHeader() {
 
-  printf(" Run / Subrun / Event : %10i / %10i / %10i\n",
+  Out(" Run / Subrun / Event : %10i / %10i / %10i\n",
 	 fEvent->run(),
 	 fEvent->subRun(),
 	 fEvent->event());
@@ -1057,7 +1372,7 @@ void TAnaDump::printTrkCaloHit(const KalRep* Krep, mu2e::TrkCaloHit* CaloHit){
   double    len  = CaloHit->fltLen();
   HepPoint  plen = Krep->position(len);
   
-  printf("%3i %5i 0x%08x %1i %9.3f %8.3f %8.3f %9.3f %8.3f %7.3f",
+  Out("%3i %5i 0x%08x %1i %9.3f %8.3f %8.3f %9.3f %8.3f %7.3f",
 	 -1,//++i,
 	 0, //straw->index().asInt(), 
 	 CaloHit->hitFlag(),
@@ -1069,14 +1384,14 @@ void TAnaDump::printTrkCaloHit(const KalRep* Krep, mu2e::TrkCaloHit* CaloHit){
 	 CaloHit->time(), -1.//sh->dt()
 	 );
 
-  printf(" %2i %2i %2i %2i",
+  Out(" %2i %2i %2i %2i",
 	 -1,//straw->id().getPlane(),
 	 -1,//straw->id().getPanel(),
 	 -1,//straw->id().getLayer(),
 	 -1//straw->id().getStraw()
 	 );
 
-  printf(" %8.3f",CaloHit->hitT0().t0());
+  Out(" %8.3f",CaloHit->hitT0().t0());
   
   double res, sigres;
   CaloHit->resid(res, sigres, true);
@@ -1084,7 +1399,7 @@ void TAnaDump::printTrkCaloHit(const KalRep* Krep, mu2e::TrkCaloHit* CaloHit){
   CLHEP::Hep3Vector  pos;
   CaloHit->hitPosition(pos);
 
-  printf("%8.3f %8.3f %9.3f %7.3f %7.3f",
+  Out("%8.3f %8.3f %9.3f %7.3f %7.3f",
 	 pos.x(),
 	 pos.y(),
 	 pos.z(),
@@ -1092,15 +1407,15 @@ void TAnaDump::printTrkCaloHit(const KalRep* Krep, mu2e::TrkCaloHit* CaloHit){
 	 sigres
 	 );
       
-  printf("   %6.3f", -1.);//CaloHit->driftRadius());
+  Out("   %6.3f", -1.);//CaloHit->driftRadius());
   
 	  
 
-  printf("  %7.3f",-1.);
+  Out("  %7.3f",-1.);
 
   double exterr = CaloHit->temperature();//*CaloHit->driftVelocity();
 
-  printf(" %6.3f %6.3f %6.3f %6.3f %6.3f",		 
+  Out(" %6.3f %6.3f %6.3f %6.3f %6.3f",		 
 	 -1.,//CaloHit->totalErr(),
 	 CaloHit->hitErr(),
 	 CaloHit->hitT0().t0Err(),
@@ -1113,7 +1428,7 @@ void TAnaDump::printTrkCaloHit(const KalRep* Krep, mu2e::TrkCaloHit* CaloHit){
   //       Test_000(Krep,hit);
   //       printf(" %7.3f",fTmp[0]);
 
-  printf("\n");
+  Out("\n");
 
 }
 
@@ -1127,13 +1442,33 @@ void TAnaDump::printKalRep(const KalRep* Krep, const char* Opt, const char* Pref
 
   //  TString opt = Opt;
 
+  Flush();
+//-----------------------------------------------------------------------------
+// TrkPrintUtils prints to the standard output, with the output redirected 
+// to a file point the stdout descriptor to it for the duration of the call
+//-----------------------------------------------------------------------------
+  int saved_fd = -1;
+  if (fOutput != stdout) {
+    fflush(stdout);
+    saved_fd = dup(fileno(stdout));
+    if (saved_fd >= 0) dup2(fileno(fOutput),fileno(stdout));
+  }
+
   _printUtils->printTrack(fEvent,Krep,Opt,Prefix);
+
+  if (saved_fd >= 0) {
+    std::cout.flush();
+    fflush(stdout);
+    dup2(saved_fd,fileno(stdout));
+    close(saved_fd);
+  }
 }
 
 //-----------------------------------------------------------------------------
 void TAnaDump::printKalRepCollection(const char* KalRepCollTag     , 
 				     int         hitOpt            ,
 				     const char* StrawDigiMCCollTag) {
+  OutputScope scope(this);
 
   art::InputTag                          krepCollTag(KalRepCollTag);
   art::Handle<mu2e::KalRepPtrCollection> krepsHandle; 
@@ -1142,8 +1477,8 @@ void TAnaDump::printKalRepCollection(const char* KalRepCollTag     ,
 //-----------------------------------------------------------------------------
   fEvent->getByLabel(krepCollTag,krepsHandle);
   if (! krepsHandle.isValid()) {
-    printf("TAnaDump::printKalRepCollection: no KalRepPtrCollection tag=%s, BAIL OUT\n", KalRepCollTag);
-    printf(" available ones are:\n");
+    Out("TAnaDump::printKalRepCollection: no KalRepPtrCollection tag=%s, BAIL OUT\n", KalRepCollTag);
+    Out(" available ones are:\n");
     print_kalrep_colls();
     return;
   }
@@ -1158,7 +1493,7 @@ void TAnaDump::printKalRepCollection(const char* KalRepCollTag     ,
   else                  _mcdigis = nullptr;
 
   if (_mcdigis == nullptr) {
-    printf(">>> ERROR in TAnaDump::printKalRepCollection: failed to locate StepPointMCCollection:: by %s\n",
+    Out(">>> ERROR in TAnaDump::printKalRepCollection: failed to locate StepPointMCCollection:: by %s\n",
            sdmc_tag.encode().data());
   }
 
@@ -1190,9 +1525,9 @@ void TAnaDump::printGenParticle(const mu2e::GenParticle* P, const char* Opt) {
   TString opt = Opt;
   
   if ((opt == "") || (opt == "banner")) {
-    printf("------------------------------------------------------------------------------------\n");
-    printf("Index                 generator     PDG      Time      Momentum       Pt       CosTh\n");
-    printf("------------------------------------------------------------------------------------\n");
+    Out("------------------------------------------------------------------------------------\n");
+    Out("Index                 generator     PDG      Time      Momentum       Pt       CosTh\n");
+    Out("------------------------------------------------------------------------------------\n");
   }
   
   if ((opt == "") || (opt == "data")) {
@@ -1205,7 +1540,7 @@ void TAnaDump::printGenParticle(const mu2e::GenParticle* P, const char* Opt) {
     double pt    = P->momentum().vect().perp();
     double costh = P->momentum().vect().cosTheta();
     
-    printf("%5i %2i:%-26s %3i %10.3f %10.3f %10.3f %10.3f\n",
+    Out("%5i %2i:%-26s %3i %10.3f %10.3f %10.3f %10.3f\n",
 	   -1,gen_code,gen_name.data(),pdg_code,time,mom,pt,costh);
   }
 }
@@ -1214,6 +1549,8 @@ void TAnaDump::printGenParticle(const mu2e::GenParticle* P, const char* Opt) {
 // there could be multiple collections in the event
 //-----------------------------------------------------------------------------
 void TAnaDump::printGenParticleCollections() {
+  OutputScope scope(this);
+
   
   vector<art::Handle<mu2e::GenParticleCollection>> list_of_gp;
 
@@ -1238,7 +1575,7 @@ void TAnaDump::printGenParticleCollections() {
       coll = handle->product();
       prov = handle->provenance();
 
-      printf("moduleLabel = %-20s, producedClassname = %-30s, productInstanceName = %-20s\n",
+      Out("moduleLabel = %-20s, producedClassname = %-30s, productInstanceName = %-20s\n",
 	     prov->moduleLabel().data(),
 	     prov->producedClassName().data(),
 	     prov->productInstanceName().data());
@@ -1257,8 +1594,8 @@ void TAnaDump::printGenParticleCollections() {
       
     }
     else {
-      printf(">>> ERROR in TAnaDump::printStepPointMCCollection: failed to locate collection");
-      printf(". BAIL OUT. \n");
+      Out(">>> ERROR in TAnaDump::printStepPointMCCollection: failed to locate collection");
+      Out(". BAIL OUT. \n");
       return;
     }
   }
@@ -1290,7 +1627,7 @@ void TAnaDump::printCaloHits(const char* ModuleLabel,
 			     const char* ProductName, 
 			     const char* ProcessName) {
 
-  printf(">>>> ModuleLabel = %s\n",ModuleLabel);
+  Out(">>>> ModuleLabel = %s\n",ModuleLabel);
 
   //data about hits in the calorimeter crystals
 
@@ -1310,13 +1647,13 @@ void TAnaDump::printCaloHits(const char* ModuleLabel,
 
   const mu2e::CaloHit* hit;
 
-  printf("--------------------------------------\n");
-  printf("RID      Time   Energy                \n");
-  printf("--------------------------------------\n");
+  Out("--------------------------------------\n");
+  Out("RID      Time   Energy                \n");
+  Out("--------------------------------------\n");
 
   for (int ic=0; ic<nhits; ic++) {
     hit  = &caloHits->at(ic);
-    printf("%7i  %10.3f %10.3f \n",
+    Out("%7i  %10.3f %10.3f \n",
 	   hit->crystalID(),
 	   hit->time(),
 	   hit->energyDep()); 
@@ -1336,20 +1673,20 @@ void TAnaDump::printCalorimeter() {
     cal = dc.operator->();
   }
   else {
-    printf(">>> ERROR: disk calorimeter not found.\n");
+    Out(">>> ERROR: disk calorimeter not found.\n");
     return;
   }
 
   int nd = cal->nDisk();
-  printf(" ndisks = %i\n", nd);
-  printf(" crystal size  : %10.3f\n", cal->caloInfo().getDouble("crystalXYLength"));
-  printf(" crystal length: %10.3f\n", cal->caloInfo().getDouble("crystalZLength"));
+  Out(" ndisks = %i\n", nd);
+  Out(" crystal size  : %10.3f\n", cal->caloInfo().getDouble("crystalXYLength"));
+  Out(" crystal length: %10.3f\n", cal->caloInfo().getDouble("crystalZLength"));
 
   for (int i=0; i<nd; i++) {
     disk = &cal->disk(i);
-    printf(" ---- disk # %i\n",i);
-    printf(" Rin  : %10.3f  Rout : %10.3f\n", disk->innerRadius(),disk->outerRadius());
-    printf(" X : %12.3f Y : %12.3f Z : %12.3f\n",
+    Out(" ---- disk # %i\n",i);
+    Out(" Rin  : %10.3f  Rout : %10.3f\n", disk->innerRadius(),disk->outerRadius());
+    Out(" X : %12.3f Y : %12.3f Z : %12.3f\n",
 	   disk->geomInfo().origin().x(),
 	   disk->geomInfo().origin().y(),
 	   disk->geomInfo().origin().z());
@@ -1383,14 +1720,14 @@ void TAnaDump::printCaloCrystalHits(const char* ModuleLabel,
 
   const mu2e::CaloHit* hit;
 
-  printf("----------------------------------------------------------------\n");
-  printf("CrystalID      Time   Energy    EnergyTot  NSiPMs               \n");
-  printf("----------------------------------------------------------------\n");
+  Out("----------------------------------------------------------------\n");
+  Out("CrystalID      Time   Energy    EnergyTot  NSiPMs               \n");
+  Out("----------------------------------------------------------------\n");
 
   for (int ic=0; ic<nhits; ic++) {
     hit  = &caloCrystalHits->at(ic);
 
-    printf("%7i  %10.3f %10.3f %10.3f %5i\n",
+    Out("%7i  %10.3f %10.3f %10.3f %5i\n",
 	   hit->crystalID(),
 	   hit->time(),
 	   hit->energyDep(),
@@ -1403,6 +1740,7 @@ void TAnaDump::printCaloCrystalHits(const char* ModuleLabel,
 void TAnaDump::printCaloDigiCollection(const char* ModuleLabel, 
 				       const char* ProductName,
 				       const char* ProcessName) {
+  OutputScope scope(this);
 
   art::Selector  selector(art::ProductInstanceNameSelector(ProductName) &&
 			  art::ProcessNameSelector(ProcessName)         && 
@@ -1420,15 +1758,15 @@ void TAnaDump::printCaloDigiCollection(const char* ModuleLabel,
 
   const mu2e::CaloDigi* hit;
 
-  printf("----------------------------------------------------------------\n");
-  printf("ReadoutID      Time      NSamples               \n");
-  printf("----------------------------------------------------------------\n");
+  Out("----------------------------------------------------------------\n");
+  Out("ReadoutID      Time      NSamples               \n");
+  Out("----------------------------------------------------------------\n");
 
   for (int ic=0; ic<nhits; ic++) {
     hit  = &calodigis->at(ic);
     int pulse_size =  hit->waveform().size();
 
-    printf("%7i  %5i %5i\n",
+    Out("%7i  %5i %5i\n",
 	   hit->SiPMID(),
 	   hit->t0(),
 	   pulse_size);
@@ -1440,6 +1778,7 @@ void TAnaDump::printCaloDigiCollection(const char* ModuleLabel,
 void TAnaDump::printCaloRecoDigiCollection(const char* ModuleLabel, 
 				       const char* ProductName,
 				       const char* ProcessName) {
+  OutputScope scope(this);
 
   art::Selector  selector(art::ProductInstanceNameSelector(ProductName) &&
 			  art::ProcessNameSelector(ProcessName)         && 
@@ -1457,14 +1796,14 @@ void TAnaDump::printCaloRecoDigiCollection(const char* ModuleLabel,
 
   const mu2e::CaloRecoDigi* hit;
 
-  printf("-----------------------------------------------------------------------------------\n");
-  printf("ReadoutID      Time      Time-Chi2     Energy     Amplitude      PSD               \n");
-  printf("-----------------------------------------------------------------------------------\n");
+  Out("-----------------------------------------------------------------------------------\n");
+  Out("ReadoutID      Time      Time-Chi2     Energy     Amplitude      PSD               \n");
+  Out("-----------------------------------------------------------------------------------\n");
 
   for (int ic=0; ic<nhits; ic++) {
     hit  = &recocalodigis->at(ic);
 
-    printf("%7i  %10.3f   %10.3f   %10.3f   %10.3f   %10.3f\n",
+    Out("%7i  %10.3f   %10.3f   %10.3f   %10.3f   %10.3f\n",
 	   hit->SiPMID(),
 	   hit->time(),
 	   hit->chi2(), 
@@ -1481,16 +1820,16 @@ void TAnaDump::printTrkToCaloExtrapol(const mu2e::TrkToCaloExtrapol* trkToCalo,
  TString opt = Opt;
 
   if ((opt == "") || (opt == "banner")) {
-    printf("-------------------------------------------------------------------------------------------------------\n");
-    printf("sectionId      Time     ExtPath     Ds       FitCon      t0          X           Y        Z          Mom  \n");
-    printf("-------------------------------------------------------------------------------------------------------\n");
+    Out("-------------------------------------------------------------------------------------------------------\n");
+    Out("sectionId      Time     ExtPath     Ds       FitCon      t0          X           Y        Z          Mom  \n");
+    Out("-------------------------------------------------------------------------------------------------------\n");
   }
   
   if ((opt == "") || (opt.Index("data") >= 0)) {
 
     double ds = trkToCalo->pathLengthExit()-trkToCalo->pathLengthEntrance();
   
-    printf("%6i %10.3f %10.3f %8.3f %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f \n",
+    Out("%6i %10.3f %10.3f %8.3f %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f \n",
 	   trkToCalo->diskId(),
 	   trkToCalo->time(),
 	   trkToCalo->pathLengthEntrance(),
@@ -1510,8 +1849,9 @@ void TAnaDump::printTrkToCaloExtrapol(const mu2e::TrkToCaloExtrapol* trkToCalo,
 void TAnaDump::printTrkToCaloExtrapolCollection(const char* ModuleLabel, 
 						const char* ProductName,
 						const char* ProcessName) {
+  OutputScope scope(this);
 
-  printf(">>>> ModuleLabel = %s\n",ModuleLabel);
+  Out(">>>> ModuleLabel = %s\n",ModuleLabel);
 
   //data about hits in the calorimeter crystals
 
@@ -1556,12 +1896,12 @@ void TAnaDump::printStrawHit(const mu2e::StrawHit* Hit, const mu2e::StrawGasStep
   opt.ToLower();
 
   if ((opt == "") || (opt.Index("banner") >= 0)) {
-    printf("#--------------------------------------------------------------------------");
-    printf("------------------------------------------------------------\n");
-    printf("#   I   SID    Flags  Pln   Pnl  Lay   Str     Time          dt       eDep ");
-    printf("           PDG       PDG(M)   Generator      SimpID      p  \n");
-    printf("#--------------------------------------------------------------------------");
-    printf("------------------------------------------------------------\n");
+    Out("#--------------------------------------------------------------------------");
+    Out("------------------------------------------------------------\n");
+    Out("#   I   SID    Flags  Pln   Pnl  Lay   Str     Time          dt       eDep ");
+    Out("           PDG       PDG(M)   Generator      SimpID      p  \n");
+    Out("#--------------------------------------------------------------------------");
+    Out("------------------------------------------------------------\n");
   }
 
   if (opt == "banner") return;
@@ -1597,14 +1937,14 @@ void TAnaDump::printStrawHit(const mu2e::StrawHit* Hit, const mu2e::StrawGasStep
   }
     
   if ((opt == "") || (opt.Index("data") >= 0)) {
-    if (IHit  >= 0) printf("%5i " ,IHit);
-    else            printf("    ");
+    if (IHit  >= 0) Out("%5i " ,IHit);
+    else            Out("    ");
     
-    printf("%5i",Hit->strawId().asUint16());
+    Out("%5i",Hit->strawId().asUint16());
 
-    if (Flags >= 0) printf(" %08x",Flags);
-    else            printf("        ");
-    printf(" %3i %3i %3i %3i %8.2f %6.2f %6.2f %9.6f   %10i   %10i  %10i  %10i %8.3f\n",
+    if (Flags >= 0) Out(" %08x",Flags);
+    else            Out("        ");
+    Out(" %3i %3i %3i %3i %8.2f %6.2f %6.2f %9.6f   %10i   %10i  %10i  %10i %8.3f\n",
 	   straw->id().getPlane(),
 	   straw->id().getPanel(),
 	   straw->id().getLayer(),
@@ -1625,6 +1965,7 @@ void TAnaDump::printStrawHit(const mu2e::StrawHit* Hit, const mu2e::StrawGasStep
 void TAnaDump::printStrawHitCollection(const char* StrawHitCollTag   , 
 				       const char* StrawDigiMCCollTag, 
 				       double TMin, double TMax) {
+  OutputScope scope(this);
 
   const char* oname = "TAnaDump::printStrawHitCollection";
 
@@ -1639,7 +1980,7 @@ void TAnaDump::printStrawHitCollection(const char* StrawHitCollTag   ,
   bool ok = fEvent->getByLabel(StrawHitCollTag, shcH);
   if (ok) shc = shcH.product();
   else {
-    printf(">>> ERROR in %s: Straw Hit Collection by \"%s\" doesn't exist. Bail Out.\n",
+    Out(">>> ERROR in %s: Straw Hit Collection by \"%s\" doesn't exist. Bail Out.\n",
 	   oname,StrawHitCollTag);
     return;
   }
@@ -1647,7 +1988,7 @@ void TAnaDump::printStrawHitCollection(const char* StrawHitCollTag   ,
   ok = fEvent->getByLabel(StrawHitCollTag, chcH);
   if (ok) chc = chcH.product();
   else {
-    printf(">>> ERROR in %s: ComboHitCollection \"%s\" doesn't exist. Bail Out.\n",
+    Out(">>> ERROR in %s: ComboHitCollection \"%s\" doesn't exist. Bail Out.\n",
 	   oname,StrawHitCollTag);
     return;
   }
@@ -1662,7 +2003,7 @@ void TAnaDump::printStrawHitCollection(const char* StrawHitCollTag   ,
   else                _mcdigis = nullptr;
 
   if (_mcdigis == nullptr) {
-    printf(">>> ERROR in %s: failed to locate StrawDigiMCCollection with tag=%s, BAIL OUT.\n",
+    Out(">>> ERROR in %s: failed to locate StrawDigiMCCollection with tag=%s, BAIL OUT.\n",
 	   oname,fSdmcCollTag.encode().data());
     return;
   }
@@ -1697,13 +2038,13 @@ void TAnaDump::printStrawGasStep(const mu2e::StrawGasStep* Step, const char* Opt
   opt.ToLower();
 
   if ((opt == "") || (opt.Index("banner") >= 0)) {
-    printf("----------------------------------------------------------------------------------------------------------------------");
-    printf("---------------------------------------------------------------------------------------------\n");
-    printf("    I   SID  Plane  Panel   Layer   Straw   Stype     EIon   PathLen    Width");
-    printf("       Time        PDG      PDG(M)       GenID       SimID   X0          Y0          Z0        ");
-    printf("X1         Y1          Z1           Mom\n");
-    printf("----------------------------------------------------------------------------------------------------------------------");
-    printf("---------------------------------------------------------------------------------------------\n");
+    Out("----------------------------------------------------------------------------------------------------------------------");
+    Out("---------------------------------------------------------------------------------------------\n");
+    Out("    I   SID  Plane  Panel   Layer   Straw   Stype     EIon   PathLen    Width");
+    Out("       Time        PDG      PDG(M)       GenID       SimID   X0          Y0          Z0        ");
+    Out("X1         Y1          Z1           Mom\n");
+    Out("----------------------------------------------------------------------------------------------------------------------");
+    Out("---------------------------------------------------------------------------------------------\n");
   }
 
   if (opt == "banner") return;
@@ -1737,12 +2078,12 @@ void TAnaDump::printStrawGasStep(const mu2e::StrawGasStep* Step, const char* Opt
   mc_mom        = Step->momvec().mag();
     
   if ((opt == "") || (opt == "data")) {
-    if (IStep  >= 0) printf("%5i " ,IStep);
-    else             printf("    ");
+    if (IStep  >= 0) Out("%5i " ,IStep);
+    else             Out("    ");
     
-    printf("%5i",Step->strawId().asUint16());
+    Out("%5i",Step->strawId().asUint16());
 
-    printf("  %5i  %5i   %5i   %5i   %5i",
+    Out("  %5i  %5i   %5i   %5i   %5i",
 	   straw->id().getPlane(),
 	   straw->id().getPanel(),
 	   straw->id().getLayer(),
@@ -1753,7 +2094,7 @@ void TAnaDump::printStrawGasStep(const mu2e::StrawGasStep* Step, const char* Opt
 
     stepTime = Step->time();
 
-    printf(" %8.3f  %8.3f %8.3f  %9.3f %10i  %10i  %10i  %10i",
+    Out(" %8.3f  %8.3f %8.3f  %9.3f %10i  %10i  %10i  %10i",
 	   Step->ionizingEdep(),
 	   Step->stepLength(),
 	   Step->width(),
@@ -1763,7 +2104,7 @@ void TAnaDump::printStrawGasStep(const mu2e::StrawGasStep* Step, const char* Opt
 	   generator_id,
 	   simp_id);
 
-    printf(" %8.3f   %8.3f   %9.3f  %8.3f   %8.3f   %9.3f   %8.3f\n",
+    Out(" %8.3f   %8.3f   %9.3f  %8.3f   %8.3f   %9.3f   %8.3f\n",
 	   Step->startPosition().x(),
 	   Step->startPosition().y(),
 	   Step->startPosition().z(),
@@ -1780,6 +2121,7 @@ void TAnaDump::printStrawGasStep(const mu2e::StrawGasStep* Step, const char* Opt
 void TAnaDump::printStrawGasStepCollection(const char* CollTag, 
 					   double      TMin   , 
 					   double      TMax)  {
+  OutputScope scope(this);
 
   //  const char* oname = "TAnaDump::printStrawGasStepCollection";
 //-----------------------------------------------------------------------------
@@ -1791,7 +2133,7 @@ void TAnaDump::printStrawGasStepCollection(const char* CollTag,
 
   if (sgscH.isValid()) sgsc = sgscH.product();
   else {
-    printf("ERROR: cant find StrawHitCollection tag=%s, print available, EXIT\n",CollTag);
+    Out("ERROR: cant find StrawHitCollection tag=%s, print available, EXIT\n",CollTag);
 
     // vector<art::Handle<mu2e::StrawGasStepCollection>> vcoll;
     art::Selector  selector(art::ProductInstanceNameSelector(""));
@@ -1802,7 +2144,7 @@ void TAnaDump::printStrawGasStepCollection(const char* CollTag,
       if (handle->isValid()) {
 	const art::Provenance* prov = handle->provenance();
 	
-	printf("moduleLabel: %-20s, productInstanceName: %-20s, processName:= %-30s\n" ,
+	Out("moduleLabel: %-20s, productInstanceName: %-20s, processName:= %-30s\n" ,
 	       prov->moduleLabel().data(),
 	       prov->productInstanceName().data(),
 	       prov->processName().data()
@@ -1837,16 +2179,16 @@ void TAnaDump::printSimParticle(const mu2e::SimParticle* P, const char* Opt, con
 
     TString opt = Opt;
 
-    if ((opt == "") || (opt.Index("banner") >= 0)) {
-      printf("-----------------------------------------------------------------------------------------");
-      printf("-----------------------------------------");
-      printf("---------------------------------------------------------------------------------------\n");
-      printf("Index Primary     ID Parent     GenpID        PDG      X0          Y0         Z0         ");
-      printf("T0       Px0       Py0      Pz0        E0 ");
-      printf("        X1         Y1           Z1        T1         Px1       Py1      Pz1        E1  \n");
-      printf("-----------------------------------------------------------------------------------------");
-      printf("------------------------------------------");
-      printf("---------------------------------------------------------------------------------------\n");
+    if ((fColumnar == 0) && ((opt == "") || (opt.Index("banner") >= 0))) {
+      Out("-----------------------------------------------------------------------------------------");
+      Out("-----------------------------------------");
+      Out("---------------------------------------------------------------------------------------\n");
+      Out("Index Primary     ID Parent     GenpID        PDG      X0          Y0         Z0         ");
+      Out("T0       Px0       Py0      Pz0        E0 ");
+      Out("        X1         Y1           Z1        T1         Px1       Py1      Pz1        E1  \n");
+      Out("-----------------------------------------------------------------------------------------");
+      Out("------------------------------------------");
+      Out("---------------------------------------------------------------------------------------\n");
     }
  
     if ((opt == "") || (opt.Index("data") >= 0)) {
@@ -1863,11 +2205,39 @@ void TAnaDump::printSimParticle(const mu2e::SimParticle* P, const char* Opt, con
       int index (-1.);
       if (PrintData) index = *((int*) PrintData);
 
-      printf("%5i %7i %6i %6i %10i %10i",
+      if (fColumnar) {
+	BeginRow(kSimParticle);
+	Col("i"      ,"%i"   ,index);
+	Col("primary","%i"   ,primary);
+	Col("id"     ,"%i"   ,id);
+	Col("parent" ,"%i"   ,parent_id);
+	Col("genidx" ,"%i"   ,(int) P->generatorIndex());
+	Col("pdg"    ,"%i"   ,pdg_id);
+	Col("x0"     ,"%.3f" ,P->startPosition().x());
+	Col("y0"     ,"%.3f" ,P->startPosition().y());
+	Col("z0"     ,"%.3f" ,P->startPosition().z());
+	Col("t0"     ,"%.3f" ,P->startGlobalTime());
+	Col("px0"    ,"%.3f" ,P->startMomentum().x());
+	Col("py0"    ,"%.3f" ,P->startMomentum().y());
+	Col("pz0"    ,"%.3f" ,P->startMomentum().z());
+	Col("e0"     ,"%.3f" ,P->startMomentum().e());
+	Col("x1"     ,"%.3f" ,P->endPosition().x());
+	Col("y1"     ,"%.3f" ,P->endPosition().y());
+	Col("z1"     ,"%.3f" ,P->endPosition().z());
+	Col("t1"     ,"%.3f" ,P->endGlobalTime());
+	Col("px1"    ,"%.3f" ,P->endMomentum().x());
+	Col("py1"    ,"%.3f" ,P->endMomentum().y());
+	Col("pz1"    ,"%.3f" ,P->endMomentum().z());
+	Col("e1"     ,"%.3f" ,P->endMomentum().e());
+	EndRow();
+	return;
+      }
+
+      Out("%5i %7i %6i %6i %10i %10i",
 	     index, primary, id, parent_id, 
 	     P->generatorIndex(), pdg_id);
 
-      printf(" %10.3f %10.3f %10.3f %9.3f %9.3f %9.3f %9.3f %9.3f",
+      Out(" %10.3f %10.3f %10.3f %9.3f %9.3f %9.3f %9.3f %9.3f",
 	     P->startPosition().x(),
 	     P->startPosition().y(),
 	     P->startPosition().z(),
@@ -1877,7 +2247,7 @@ void TAnaDump::printSimParticle(const mu2e::SimParticle* P, const char* Opt, con
 	     P->startMomentum().z(),
 	     P->startMomentum().e());
 
-      printf(" %10.3f %10.3f %10.3f %10.3f %9.3f %9.3f %9.3f %9.3f\n",
+      Out(" %10.3f %10.3f %10.3f %10.3f %9.3f %9.3f %9.3f %9.3f\n",
 	     P->endPosition().x(),
 	     P->endPosition().y(),
 	     P->endPosition().z(),
@@ -1895,6 +2265,7 @@ void TAnaDump::printSimParticle(const mu2e::SimParticle* P, const char* Opt, con
 void TAnaDump::printSimParticleCollection(const char* ModuleLabel, 
 					  const char* ProductName, 
 					  const char* ProcessName) {
+  OutputScope scope(this);
 
   art::Handle<mu2e::SimParticleCollection> handle;
   const mu2e::SimParticleCollection*       coll(0);
@@ -1914,8 +2285,8 @@ void TAnaDump::printSimParticleCollection(const char* ModuleLabel,
 
   if (handle.isValid()) coll = handle.product();
   else {
-    printf(">>> ERROR in TAnaDump::printSimParticleCollection: failed to locate collection");
-    printf(". BAIL OUT. \n");
+    Out(">>> ERROR in TAnaDump::printSimParticleCollection: failed to locate collection");
+    Out(". BAIL OUT. \n");
     return;
   }
 
@@ -1923,20 +2294,26 @@ void TAnaDump::printSimParticleCollection(const char* ModuleLabel,
 
   int np = coll->size();
 
+  BeginTable(kSimParticle);
+
   int i = 0;
   for ( mu2e::SimParticleCollection::const_iterator j=coll->begin(); j != coll->end(); ++j) {
     simp = &j->second;
 
-    if (banner_printed == 0) {
-      printSimParticle(simp,"banner",&i);
-      banner_printed = 1;
+    double p = simp->startMomentum().vect().mag();
+    if (PassParticle(p,simp->id().asInt(),simp->pdgId()) &&
+	PassTime(kSimParticle,simp->startGlobalTime())      ) {
+      if (banner_printed == 0) {
+	printSimParticle(simp,"banner",&i);
+	banner_printed = 1;
+      }
+      printSimParticle(simp,"data",&i);
     }
-    printSimParticle(simp,"data",&i);
     i++;
   }
 
   if (i != np) {
-    printf(" inconsistency in TAnaDump::printSimParticleCollection\n");
+    Out(" inconsistency in TAnaDump::printSimParticleCollection\n");
   }
 }
 
@@ -1947,15 +2324,15 @@ void TAnaDump::printStepPointMC(const mu2e::StepPointMC* Step, const char* Detec
     TString opt = Opt;
 
     if ((opt == "") || (opt.Index("banner") >= 0)) {
-      printf("---------------------------------------------------------------------------------------------");
-      printf("----------------------------");
-      printf("--------------------------------------------------------------------------------------------------------------------\n");
-      printf("  Vol          PDG    ID GenIndex PPdg ParentID      X          Y          Z          T      ");
-      printf("  X0          Y0         Z0 ");
-      printf("  Edep(Tot) Edep(NI)  Edep(I)    Step  EndCode  Energy    EKin     Mom       Pt    doca   Creation       StopProc   \n");
-      printf("---------------------------------------------------------------------------------------------");
-      printf("----------------------------");
-      printf("--------------------------------------------------------------------------------------------------------------------\n");
+      Out("---------------------------------------------------------------------------------------------");
+      Out("----------------------------");
+      Out("--------------------------------------------------------------------------------------------------------------------\n");
+      Out("  Vol          PDG    ID GenIndex PPdg ParentID      X          Y          Z          T      ");
+      Out("  X0          Y0         Z0 ");
+      Out("  Edep(Tot) Edep(NI)  Edep(I)    Step  EndCode  Energy    EKin     Mom       Pt    doca   Creation       StopProc   \n");
+      Out("---------------------------------------------------------------------------------------------");
+      Out("----------------------------");
+      Out("--------------------------------------------------------------------------------------------------------------------\n");
     }
 
     mu2e::GeomHandle<mu2e::Tracker> ttHandle;
@@ -1964,7 +2341,7 @@ void TAnaDump::printStepPointMC(const mu2e::StepPointMC* Step, const char* Detec
     art::Ptr<mu2e::SimParticle> const& simptr = Step->simParticle();
     const mu2e::SimParticle* sim  = simptr.operator ->();
     if (sim == NULL) {
-      printf(">>> ERROR: %s sim == NULL\n",oname);
+      Out(">>> ERROR: %s sim == NULL\n",oname);
     }
 
     art::Ptr<mu2e::SimParticle> const& parentptr = sim->parent();
@@ -2021,7 +2398,7 @@ void TAnaDump::printStepPointMC(const mu2e::StepPointMC* Step, const char* Detec
     //    const mu2e::PhysicalVolumeInfo& pvinfo = volumes->at(Step->volumeId()); - sometimes crashes..
 
     if ((opt == "") || (opt.Index("data") >= 0)) {
-      printf("%5i %12i %6i %5i %5i %7i %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f %8.2f %8.2f %8.2f %8.3f %4i %10.3f %8.3f %8.3f %8.3f %7.2f %-12s %-s\n",
+      Out("%5i %12i %6i %5i %5i %7i %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f %8.2f %8.2f %8.2f %8.3f %4i %10.3f %8.3f %8.3f %8.3f %7.2f %-12s %-s\n",
 	     (int) Step->volumeId(),
 	     //	     pvinfo.name().data(), // smth is wrong with the name defined by volumeId()....
 	     (int) sim->pdgId(),
@@ -2056,6 +2433,7 @@ void TAnaDump::printStepPointMC(const mu2e::StepPointMC* Step, const char* Detec
 void TAnaDump::printStepPointMCCollection(const char* ModuleLabel, 
 					  const char* ProductName,
 					  const char* ProcessName) {
+  OutputScope scope(this);
 
   art::Handle<mu2e::StepPointMCCollection> handle;
   const mu2e::StepPointMCCollection*       coll(0);
@@ -2074,8 +2452,8 @@ void TAnaDump::printStepPointMCCollection(const char* ModuleLabel,
 
   if (handle.isValid()) coll = handle.product();
   else {
-    printf(">>> ERROR in TAnaDump::printStepPointMCCollection: failed to locate collection");
-    printf(". BAIL OUT. \n");
+    Out(">>> ERROR in TAnaDump::printStepPointMCCollection: failed to locate collection");
+    Out(". BAIL OUT. \n");
     return;
   }
 
@@ -2160,9 +2538,9 @@ void TAnaDump::printTrackClusterMatch(const mu2e::TrackClusterMatch* Tcm, const
   TString opt = Opt;
   
   if ((opt == "") || (opt == "banner")) {
-    printf("--------------------------------------------------------------------------------------\n");
-    printf("  Disk         Cluster          Track         chi2     du        dv       dt       E/P\n");
-    printf("--------------------------------------------------------------------------------------\n");
+    Out("--------------------------------------------------------------------------------------\n");
+    Out("  Disk         Cluster          Track         chi2     du        dv       dt       E/P\n");
+    Out("--------------------------------------------------------------------------------------\n");
   }
 
   if ((opt == "") || (opt == "data")) {
@@ -2173,7 +2551,7 @@ void TAnaDump::printTrackClusterMatch(const mu2e::TrackClusterMatch* Tcm, const
     int disk     = cl->diskID();
     double chi2  = Tcm->chi2();
 
-    printf("%5i %16p  %16p  %8.3f %8.3f %8.3f %8.3f %8.3f\n",
+    Out("%5i %16p  %16p  %8.3f %8.3f %8.3f %8.3f %8.3f\n",
 	   disk,  static_cast<const void*>(cl),  static_cast<const void*>(tex),  chi2,Tcm->du(),Tcm->dv(),Tcm->dt(),Tcm->ep());
   }
 }
@@ -2184,8 +2562,9 @@ void TAnaDump::printTrackClusterMatch(const mu2e::TrackClusterMatch* Tcm, const
 void TAnaDump::printTrackClusterMatchCollection(const char* ModuleLabel, 
 						const char* ProductName,
 						const char* ProcessName) {
+  OutputScope scope(this);
 
-  printf(">>>> ModuleLabel = %s\n",ModuleLabel);
+  Out(">>>> ModuleLabel = %s\n",ModuleLabel);
 
   art::Handle<mu2e::TrackClusterMatchCollection> handle;
   const mu2e::TrackClusterMatchCollection*       coll;
@@ -2198,16 +2577,16 @@ void TAnaDump::printTrackClusterMatchCollection(const char* ModuleLabel,
 
   if (handle.isValid()) coll = handle.product();
   else {
-    printf(">>> ERROR in TAnaDump::printTrackClusterMatchCollection: failed to locate requested collection. Available:");
+    Out(">>> ERROR in TAnaDump::printTrackClusterMatchCollection: failed to locate requested collection. Available:");
 
     // vector<art::Handle<mu2e::TrackClusterMatchCollection>> list_of_handles;
     auto list_of_handles = fEvent->getMany<mu2e::TrackClusterMatchCollection>();
 
     for (auto ih=list_of_handles.begin(); ih<list_of_handles.end(); ih++) {
-      printf("%s\n", ih->provenance()->moduleLabel().data());
+      Out("%s\n", ih->provenance()->moduleLabel().data());
     }
 
-    printf(". BAIL OUT. \n");
+    Out(". BAIL OUT. \n");
     return;
   }
 
@@ -17,13 +17,13 @@ void TAnaDump::printComboHit(const mu2e::ComboHit* Hit, const mu2e::StrawGasStep
   TString opt = Opt;
   opt.ToLower();
 
-  if ((opt == "") || (opt.Index("banner") >= 0)) {
-    printf("#-----------------------------------------------------------------------------------------------");
-    printf("--------------------------------------------------------------------------------------------\n");
-    printf("#   I nsh   SID   Flags  Stn:Pln:Pnl:Str     X       Y       Z      Phi    Time   TCorr     eDep");
-    printf("   DrTime  PrTime TRes    WDist     WRes simID       p        pz        PDG     PDG(M) GenID\n");
-    printf("#-----------------------------------------------------------------------------------------------");
-    printf("--------------------------------------------------------------------------------------------\n");
+  if ((fColumnar == 0) && ((opt == "") || (opt.Index("banner") >= 0))) {
+    Out("#-----------------------------------------------------------------------------------------------");
+    Out("--------------------------------------------------------------------------------------------\n");
+    Out("#   I nsh   SID   Flags  Stn:Pln:Pnl:Str     X       Y       Z      Phi    Time   TCorr     eDep");
+    Out("   DrTime  PrTime TRes    WDist     WRes simID       p        pz        PDG     PDG(M) GenID\n");
+    Out("#-----------------------------------------------------------------------------------------------");
+    Out("--------------------------------------------------------------------------------------------\n");
   }
 
   if (opt == "banner") return;
@@ -55,17 +55,44 @@ void TAnaDump::printComboHit(const mu2e::ComboHit* Hit, const mu2e::StrawGasStep
     mc_mom_z      = Step->momvec().z();
   }
     
+  if (fColumnar) {
+    if ((opt == "") || (opt.Index("data") >= 0)) {
+      BeginRow(kComboHit);
+      Col("i"     ,"%i"   ,IHit);
+      Col("nsh"   ,"%i"   ,Hit->nStrawHits());
+      Col("sid"   ,"%u"   ,Hit->strawId().asUint16());
+      Col("flags" ,"0x%08x",Flags);
+      Col("x"     ,"%.2f" ,Hit->pos().x());
+      Col("y"     ,"%.2f" ,Hit->pos().y());
+      Col("z"     ,"%.2f" ,Hit->pos().z());
+      Col("phi"   ,"%.3f" ,Hit->pos().phi());
+      Col("time"  ,"%.2f" ,Hit->time());
+      Col("tcorr" ,"%.2f" ,Hit->correctedTime());
+      Col("edep"  ,"%.5f" ,Hit->energyDep());
+      Col("wdist" ,"%.3f" ,Hit->wireDist());
+      Col("wres"  ,"%.3f" ,Hit->wireRes());
+      Col("simid" ,"%i"   ,sim_id);
+      Col("p"     ,"%.3f" ,mc_mom);
+      Col("pz"    ,"%.3f" ,mc_mom_z);
+      Col("pdg"   ,"%i"   ,pdg_id);
+      Col("mpdg"  ,"%i"   ,mother_pdg_id);
+      Col("genid" ,"%i"   ,generator_id);
+      EndRow();
+    }
+    return;
+  }
+
   if ((opt == "") || (opt.Index("data") >= 0)) {
-    if (IHit  >= 0) printf("%5i " ,IHit);
-    else            printf("      ");
+    if (IHit  >= 0) Out("%5i " ,IHit);
+    else            Out("      ");
 
-    printf("%3i ",Hit->nStrawHits());
+    Out("%3i ",Hit->nStrawHits());
 
-    printf("%5u",Hit->strawId().asUint16());
+    Out("%5u",Hit->strawId().asUint16());
 
-    printf(" %08x",Flags);
+    Out(" %08x",Flags);
 
-    printf(" %3i %3i %3i %3i %7.2f %7.2f %8.2f %5.2f %7.2f %7.2f %8.5f %7.2f %7.2f %5.2f %8.3f %8.3f %5i %8.3f %8.3f %10i %10i %5i\n",
+    Out(" %3i %3i %3i %3i %7.2f %7.2f %8.2f %5.2f %7.2f %7.2f %8.5f %7.2f %7.2f %5.2f %8.3f %8.3f %5i %8.3f %8.3f %10i %10i %5i\n",
 	   Hit->strawId().station(),
 	   Hit->strawId().plane(),
 	   Hit->strawId().panel(),
@@ -100,6 +127,7 @@ void TAnaDump::printComboHit(const mu2e::ComboHit* Hit, const mu2e::StrawGasStep
 void TAnaDump::printComboHitCollection(const char* StrawHitCollTag   , 
 				       const char* StrawDigiMCCollTag,
 				       double TMin, double TMax) {
+  OutputScope scope(this);
 
   //  const char* oname = "TAnaDump::printComboHitCollection";
 //-----------------------------------------------------------------------------
@@ -111,7 +139,7 @@ void TAnaDump::printComboHitCollection(const char* StrawHitCollTag   ,
 
   if (shcH.isValid()) shc = shcH.product();
   else {
-    printf("ERROR: cant find StrawHitCollection tag=%s, EXIT\n",StrawHitCollTag);
+    Out("ERROR: cant find StrawHitCollection tag=%s, EXIT\n",StrawHitCollTag);
     print_sh_colls();
     return;
   }
@@ -135,7 +163,7 @@ void TAnaDump::printComboHitCollection(const char* StrawHitCollTag   ,
   const mu2e::StrawDigiMCCollection*  mcdigis(nullptr);
   if (mcdH.isValid())   mcdigis = mcdH.product();
   else {
-    printf("ERROR: cant find StrawDigiMCCollection tag=%s, EXIT\n",sdmc_tag.encode().data());
+    Out("ERROR: cant find StrawDigiMCCollection tag=%s, EXIT\n",sdmc_tag.encode().data());
     print_sdmc_colls();
     return;
   }
@@ -148,6 +176,8 @@ void TAnaDump::printComboHitCollection(const char* StrawHitCollTag   ,
   
   //  const mu2e::ComboHit* hit0 = &shc->at(0);
  
+  BeginTable(kComboHit);
+
   int banner_printed = 0;
   for (int i=0; i<nhits; i++) {
     hit         = &shc->at(i);
@@ -167,7 +197,9 @@ void TAnaDump::printComboHitCollection(const char* StrawHitCollTag   ,
       printComboHit(hit, step, "banner");
       banner_printed = 1;
     }
-    if ((hit->time() >= TMin) && (hit->time() <= TMax)) {
+    int sim_id = (step) ? step->simParticle()->id().asInt() : -1;
+
+    if ((hit->time() >= TMin) && (hit->time() <= TMax) && PassHit(i,hit->time(),sim_id)) {
       printComboHit(hit, step, "data", i, flags);
     }
   }
@@ -92,12 +92,12 @@ void TAnaDump::printHelixHit(const mu2e::HelixHit*    HelHit, const mu2e::ComboH
   opt.ToLower();
 
   if ((opt == "") || (opt.Index("banner") >= 0)) {
-    printf("----------------------------------------------------------------------------------------");
-    printf("------------------------------------------------------------------\n");
-    printf("   I NSH  SHID   Flags  Pl Pn L  S      x         y         z       phi    Time    eDep ");
-    printf("       PDG     PDG(M)  GenID      SimID      p       pT         pZ\n");
-    printf("----------------------------------------------------------------------------------------");
-    printf("------------------------------------------------------------------\n");
+    Out("----------------------------------------------------------------------------------------");
+    Out("------------------------------------------------------------------\n");
+    Out("   I NSH  SHID   Flags  Pl Pn L  S      x         y         z       phi    Time    eDep ");
+    Out("       PDG     PDG(M)  GenID      SimID      p       pT         pZ\n");
+    Out("----------------------------------------------------------------------------------------");
+    Out("------------------------------------------------------------------\n");
   }
 
   if (opt == "banner") return;
@@ -144,16 +144,16 @@ void TAnaDump::printHelixHit(const mu2e::HelixHit*    HelHit, const mu2e::ComboH
   }
   
   if ((opt == "") || (opt == "data")) {
-    if (IHit  >= 0) printf("%5i " ,IHit);
-    else            printf("    ");
+    if (IHit  >= 0) Out("%5i " ,IHit);
+    else            Out("    ");
     
-    printf(" %3i ",HelHit->nStrawHits());
+    Out(" %3i ",HelHit->nStrawHits());
     
-    printf("%5i",Hit->strawId().asUint16());
+    Out("%5i",Hit->strawId().asUint16());
     
-    if (Flags >= 0) printf(" %08x",Flags);
-    else            printf("        ");
-    printf(" %2i %2i %1i %2i  %8.3f  %8.3f %9.3f %6.3f %8.3f %6.3f %10i %10i %6i %10i %8.3f %8.3f %8.3f\n",
+    if (Flags >= 0) Out(" %08x",Flags);
+    else            Out("        ");
+    Out(" %2i %2i %1i %2i  %8.3f  %8.3f %9.3f %6.3f %8.3f %6.3f %10i %10i %6i %10i %8.3f %8.3f %8.3f\n",
 	   straw->id().getPlane(),
 	   straw->id().getPanel(),
 	   straw->id().getLayer(),
@@ -178,13 +178,13 @@ void TAnaDump::printHelixSeed(const mu2e::HelixSeed* Helix          ,
 			      const char*            Opt                ) {
   TString opt(Opt);
   
-  if ((opt == "") || (opt == "banner")) {
-    printf("------------------------------------------------------------------");
-    printf("--------------------------------------------------------------------------------------\n");
-    printf("  HelID   Address    N nL nCln     P        pT      T0     T0err  ");
-    printf("    D0      FZ0      X0       Y0    Lambda    radius   ECal   chi2XY  chi2ZPhi    flag\n");
-    printf("------------------------------------------------------------------");
-    printf("--------------------------------------------------------------------------------------\n");
+  if ((fColumnar == 0) && ((opt == "") || (opt == "banner"))) {
+    Out("------------------------------------------------------------------");
+    Out("--------------------------------------------------------------------------------------\n");
+    Out("  HelID   Address    N nL nCln     P        pT      T0     T0err  ");
+    Out("    D0      FZ0      X0       Y0    Lambda    radius   ECal   chi2XY  chi2ZPhi    flag\n");
+    Out("------------------------------------------------------------------");
+    Out("--------------------------------------------------------------------------------------\n");
   }
  
   if ((opt == "") || (opt.Index("data") >= 0)) {
@@ -219,19 +219,43 @@ void TAnaDump::printHelixSeed(const mu2e::HelixSeed* Helix          ,
       const mu2e::CaloCluster*cluster = Helix->caloCluster().get();
       double clusterEnergy(-1);
       if (cluster != 0) clusterEnergy = cluster->energyDep();
-      printf("%5i %12p %3i %2i %4i %8.3f %8.3f %7.3f %7.3f",
-	     -1,
-	     static_cast<const void*>(Helix),
-	     nhits,
-	     nLoops, 
-	     nhitsLoopChecked,
-	     mom, pt, t0, t0err );
 
       float chi2xy   = robustHel->chi2dXY();
       float chi2zphi = robustHel->chi2dZPhi();
 
-      printf(" %8.3f %8.3f %8.3f %8.3f %8.3f %8.3f %7.3f %8.3f %8.3f %08x\n",
-	     d0,fz0,x0,y0,lambda,radius,clusterEnergy,chi2xy,chi2zphi, flag);
+      if (fColumnar) {
+	BeginRow(kHelixSeed);
+	Col("nhits"   ,"%i"   ,nhits);
+	Col("nloops"  ,"%i"   ,nLoops);
+	Col("nhloop"  ,"%i"   ,nhitsLoopChecked);
+	Col("p"       ,"%.3f" ,mom);
+	Col("pt"      ,"%.3f" ,pt);
+	Col("t0"      ,"%.3f" ,t0);
+	Col("t0err"   ,"%.3f" ,t0err);
+	Col("d0"      ,"%.3f" ,d0);
+	Col("fz0"     ,"%.3f" ,fz0);
+	Col("x0"      ,"%.3f" ,x0);
+	Col("y0"      ,"%.3f" ,y0);
+	Col("lambda"  ,"%.3f" ,lambda);
+	Col("radius"  ,"%.3f" ,radius);
+	Col("ecl"     ,"%.3f" ,clusterEnergy);
+	Col("chi2xy"  ,"%.3f" ,chi2xy);
+	Col("chi2zphi","%.3f" ,chi2zphi);
+	Col("flag"    ,"0x%08x",flag);
+	EndRow();
+      }
+      else {
+	Out("%5i %12p %3i %2i %4i %8.3f %8.3f %7.3f %7.3f",
+	    -1,
+	    static_cast<const void*>(Helix),
+	    nhits,
+	    nLoops, 
+	    nhitsLoopChecked,
+	    mom, pt, t0, t0err );
+
+	Out(" %8.3f %8.3f %8.3f %8.3f %8.3f %8.3f %7.3f %8.3f %8.3f %08x\n",
+	    d0,fz0,x0,y0,lambda,radius,clusterEnergy,chi2xy,chi2zphi, flag);
+      }
     }
 
     if ((opt == "") || (opt.Index("hits") >= 0) ){
@@ -250,14 +274,14 @@ void TAnaDump::printHelixSeed(const mu2e::HelixSeed* Helix          ,
       fEvent->getByLabel(StrawDigiMCCollTag, mcdH);
       if (mcdH.isValid()) mcdigis = mcdH.product();
       else {
-	printf("ERROR in TAnaDump::printHelixSeed : no StrawDigiMCCollection tag=%s, BAIL OUT\n",StrawDigiMCCollTag);
+	Out("ERROR in TAnaDump::printHelixSeed : no StrawDigiMCCollection tag=%s, BAIL OUT\n",StrawDigiMCCollTag);
 	return;
       }
 
       fEvent->getByLabel(StrawHitCollTag,shcHandle);
       if (shcHandle.isValid()) shcol = shcHandle.product();
       else {
-	printf("ERROR in TAnaDump::printHelixSeed : no StrawHitCollection tag=%s, BAIL OUT\n",StrawHitCollTag);
+	Out("ERROR in TAnaDump::printHelixSeed : no StrawHitCollection tag=%s, BAIL OUT\n",StrawHitCollTag);
 	return;
       }
 
@@ -274,6 +298,11 @@ void TAnaDump::printHelixSeed(const mu2e::HelixSeed* Helix          ,
         int ind = hit->index(0);
  	const mu2e::StrawDigiMC*  sdmc = &mcdigis->at(ind);
 	const mu2e::StrawGasStep* step = sdmc->earlyStrawGasStep().get();
+					// columnar mode: "ch" rows
+	if (fColumnar) {
+	  printComboHit(helHit, step, "data", hitIndex, *((int*) &helHit->flag()));
+	  continue;
+	}
 
 	if (banner_printed == 0) {
 	  printHelixHit(helHit, hit, step, "banner", -1, 0);
@@ -290,6 +319,8 @@ void TAnaDump::printHelixSeedCollection(const char* HelixSeedCollTag,
 					int         PrintHits       ,
 					const char* StrawHitCollTag ,
 					const char* StrawDigiMCCollTag) {
+  OutputScope scope(this);
+
   
   const mu2e::HelixSeedCollection*       list_of_helixSeeds;
   art::Handle<mu2e::HelixSeedCollection> hsH;
@@ -298,7 +329,7 @@ void TAnaDump::printHelixSeedCollection(const char* HelixSeedCollTag,
 
   if (hsH.isValid()) list_of_helixSeeds = hsH.product();
   else {
-    printf("ERROR: cant find HelixSeedCollection tag=%s, avalable collections are:\n",HelixSeedCollTag);
+    Out("ERROR: cant find HelixSeedCollection tag=%s, avalable collections are:\n",HelixSeedCollTag);
     print_helix_seed_colls();
     return;
   }
@@ -316,8 +347,14 @@ void TAnaDump::printHelixSeedCollection(const char* HelixSeedCollTag,
   art::InputTag sdmc_coll_tag = StrawDigiMCCollTag;
   if (sdmc_coll_tag == nullptr) sdmc_coll_tag = fSdmcCollTag;
 
+  BeginTable(kHelixSeed);
+
   for (int i=0; i<nhelices; i++) {
     helix = &list_of_helixSeeds->at(i);
+
+    double p = helix->helix().momentum()*0.3;
+    if ((p < fFormat[kHelixSeed].fPMin) || (PassTime(kHelixSeed,helix->t0()._t0) == 0)) continue;
+
     if (banner_printed == 0) {
       printHelixSeed(helix,StrawHitCollTag,sdmc_coll_tag.encode().data(),"banner"); 
       banner_printed = 1;
@@ -22,13 +22,13 @@ void TAnaDump::printKalSeed(const mu2e::KalSeed* KalSeed           ,
 			    const char*          StrawDigiMCCollTag) {
   TString opt = Opt;
   
-  if ((opt == "") || (opt == "banner")) {
-    printf("------------------------------------------------------------------------------");
-    printf("----------------------------------------------------------------------------\n");
-    printf("  TrkID       Address    N  Q       P      pT       T0     T0err    fmin      fmax");
-    printf("       D0       Z0     Phi0   TanDip    radius      Ecl      chi2   FitCon  \n");
-    printf("------------------------------------------------------------------------------");
-    printf("----------------------------------------------------------------------------\n");
+  if ((fColumnar == 0) && ((opt == "") || (opt == "banner"))) {
+    Out("------------------------------------------------------------------------------");
+    Out("----------------------------------------------------------------------------\n");
+    Out("  TrkID       Address    N  Q       P      pT       T0     T0err    fmin      fmax");
+    Out("       D0       Z0     Phi0   TanDip    radius      Ecl      chi2   FitCon  \n");
+    Out("------------------------------------------------------------------------------");
+    Out("----------------------------------------------------------------------------\n");
   }
 
   if ((opt == "") || (opt.Index("data") >= 0)) {
@@ -53,16 +53,38 @@ void TAnaDump::printKalSeed(const mu2e::KalSeed* KalSeed           ,
       const mu2e::CaloCluster*cluster = KalSeed->caloCluster().get();
       double clusterEnergy(-1);
       if (cluster != 0) clusterEnergy = cluster->energyDep();
-      printf("%5i %16p %3i %2.0f %8.3f %8.5f %7.3f %6.3f %9.3f %9.3f",
+      float chi2    = KalSeed->chisquared()/double(nhits - 5.);
+      float fitCons = KalSeed->fitConsistency();
+
+      if (fColumnar) {
+	BeginRow(kKalSeed);
+	Col("nhits" ,"%i"   ,nhits);
+	Col("q"     ,"%.0f" ,q);
+	Col("p"     ,"%.3f" ,mom);
+	Col("pt"    ,"%.5f" ,pt);
+	Col("t0"    ,"%.3f" ,t0);
+	Col("t0err" ,"%.3f" ,t0err);
+	Col("fmin"  ,"%.3f" ,kalSeg.fmin());
+	Col("fmax"  ,"%.3f" ,kalSeg.fmax());
+	Col("d0"    ,"%.3f" ,d0);
+	Col("z0"    ,"%.3f" ,z0);
+	Col("phi0"  ,"%.3f" ,phi0);
+	Col("tandip","%.4f" ,tandip);
+	Col("radius","%.4f" ,radius);
+	Col("ecl"   ,"%.3f" ,clusterEnergy);
+	Col("chi2"  ,"%.3f" ,chi2);
+	Col("fitcon","%.3e" ,fitCons);
+	EndRow();
+	continue;
+      }
+
+      Out("%5i %16p %3i %2.0f %8.3f %8.5f %7.3f %6.3f %9.3f %9.3f",
 	     -1,
 	     static_cast<const void*>(KalSeed),
 	     nhits,q,
 	     mom, pt, t0, t0err, kalSeg.fmin(), kalSeg.fmax() );
 
-      float chi2    = KalSeed->chisquared()/double(nhits - 5.);
-      float fitCons = KalSeed->fitConsistency();
-      
-      printf(" %8.3f %9.3f %6.3f %8.4f %10.4f %8.3f %8.3f %10.3e\n",
+      Out(" %8.3f %9.3f %6.3f %8.4f %10.4f %8.3f %8.3f %10.3e\n",
 	     d0,z0,phi0,tandip,radius,clusterEnergy,chi2,fitCons);
     }
   }
@@ -78,7 +100,7 @@ void TAnaDump::printKalSeed(const mu2e::KalSeed* KalSeed           ,
     fEvent->getByLabel<mu2e::ComboHitCollection>(art::InputTag(StrawHitCollTag),shcolH);
     if (shcolH.isValid()) shcol = shcolH.product();
     else {
-      printf("ERROR in TAnaDump::printTrackSeed: no ComboHitCollection with tag=%s, BAIL OUT\n",StrawHitCollTag);
+      Out("ERROR in TAnaDump::printTrackSeed: no ComboHitCollection with tag=%s, BAIL OUT\n",StrawHitCollTag);
       return;
     }
 
@@ -89,14 +111,14 @@ void TAnaDump::printKalSeed(const mu2e::KalSeed* KalSeed           ,
     if      (StrawDigiMCCollTag != nullptr) tag = StrawDigiMCCollTag;
     else if (fSdmcCollTag       != ""     ) tag = fSdmcCollTag;
     else {
-      printf("ERROR in TAnaDump::printTrackSeed: no StrawDigiMCCollTag specified, BAIL OUT\n");
+      Out("ERROR in TAnaDump::printTrackSeed: no StrawDigiMCCollTag specified, BAIL OUT\n");
       return;
     }
     fEvent->getByLabel(tag,sdmccH);
     if (sdmccH.isValid()) sdmcc = sdmccH.product();
     else {
-      printf("ERROR in TAnaDump::printTrackSeed: no StrawDigiMCCollection with tag=%s,",tag.encode().data());
-      printf(" available collections are:\n");
+      Out("ERROR in TAnaDump::printTrackSeed: no StrawDigiMCCollection with tag=%s,",tag.encode().data());
+      Out(" available collections are:\n");
  
       vector<art::Handle<mu2e::StrawDigiMCCollection>> list;
       const  art::Handle<mu2e::StrawDigiMCCollection>*  handle;
@@ -109,7 +131,7 @@ void TAnaDump::printKalSeed(const mu2e::KalSeed* KalSeed           ,
 	if (handle->isValid()) {
 	  prov = handle->provenance();
 	
-	  printf("moduleLabel: %-20s, productInstanceName: %-20s, processName: %-30s nHelices: %3li\n" ,
+	  Out("moduleLabel: %-20s, productInstanceName: %-20s, processName: %-30s nHelices: %3li\n" ,
 		 prov->moduleLabel().data(),
 		 prov->productInstanceName().data(),
 		 prov->processName().data(),
@@ -146,7 +168,7 @@ void TAnaDump::printKalSeed(const mu2e::KalSeed* KalSeed           ,
 	}
       }
 
-      if (banner_printed == 0){
+      if ((banner_printed == 0) && (fColumnar == 0)) {
 	printComboHit(hit, step, "banner", -1, straw_hit_flag);
 	banner_printed = 1;
       } 
@@ -164,6 +186,7 @@ void TAnaDump::printKalSeedCollection(const char* KalSeedCollTag    ,
 				      int         hitOpt            ,
 				      const char* StrawHitCollTag   ,
 				      const char* StrawDigiMCCollTag) {
+  OutputScope scope(this);
 
   art::Handle<mu2e::KalSeedCollection> kseedHandle;
   
@@ -172,7 +195,7 @@ void TAnaDump::printKalSeedCollection(const char* KalSeedCollTag    ,
 // make sure collection exists
 //-----------------------------------------------------------------------------
   if (! ok) {
-    printf("ERROR in TAnaDump::printKalSeedCollection: no KalSeedCollection tag=%s\n",KalSeedCollTag);
+    Out("ERROR in TAnaDump::printKalSeedCollection: no KalSeedCollection tag=%s\n",KalSeedCollTag);
     print_kalseed_colls();
     return;
   }
@@ -185,7 +208,7 @@ void TAnaDump::printKalSeedCollection(const char* KalSeedCollTag    ,
     fSdmcCollTag = StrawDigiMCCollTag;
   }
   else {
-    printf("ERROR in TAnaDump::printKalSeedCollection: no StrawDigiMCCollection tag=%s, available are\n",StrawDigiMCCollTag);
+    Out("ERROR in TAnaDump::printKalSeedCollection: no StrawDigiMCCollection tag=%s, available are\n",StrawDigiMCCollTag);
     print_sdmc_colls();
     _mcdigis = nullptr;
   }
@@ -197,9 +220,15 @@ void TAnaDump::printKalSeedCollection(const char* KalSeedCollTag    ,
 
   const mu2e::KalSeed *ks;
 
+  BeginTable(kKalSeed);
+
   int banner_printed = 0;
   for (int i=0; i<nks; i++) {
     ks = &list_of_kseeds->at(i);
+					// P of the first segment
+    double p = (ks->segments().size() > 0) ? ks->segments().front().mom() : -1.;
+    if ((p < fFormat[kKalSeed].fPMin) || (PassTime(kKalSeed,ks->t0()._t0) == 0)) continue;
+
     if (banner_printed == 0) {
       printKalSeed(ks,"banner");
       banner_printed = 1;
@@ -38,9 +38,9 @@ void TAnaDump::printTimeCluster(const mu2e::TimeCluster*            TimeCluster,
   opt.ToLower();
 
   if ((opt == "") || (opt.Index("banner") >= 0)) {
-    printf("-------------------------------------------------------------------\n");
-    printf("    Energy       X          Y          Z        T0       NCH   NSH \n");
-    printf("-------------------------------------------------------------------\n");
+    Out("-------------------------------------------------------------------\n");
+    Out("    Energy       X          Y          Z        T0       NCH   NSH \n");
+    Out("-------------------------------------------------------------------\n");
   }
   double caloClusterEnergy(-1);
   if (TimeCluster->caloCluster().get()!=0)  caloClusterEnergy = TimeCluster->caloCluster()->energyDep();
@@ -69,7 +69,7 @@ void TAnaDump::printTimeCluster(const mu2e::TimeCluster*            TimeCluster,
     std::sort(v.begin(),v.end(),
               [](const ComboHit* a, const ComboHit* b) { return a->pos().z() < b->pos().z(); });
     
-    printf("%10.3f %10.3f %10.3f %10.3f %10.3f %5i %5i\n",
+    Out("%10.3f %10.3f %10.3f %10.3f %10.3f %5i %5i\n",
 	   caloClusterEnergy, 
 	   TimeCluster->position().x(),
 	   TimeCluster->position().y(),
@@ -83,7 +83,7 @@ void TAnaDump::printTimeCluster(const mu2e::TimeCluster*            TimeCluster,
 // print straw hits in the list
 //-----------------------------------------------------------------------------
       if (opt.Index("debug") < 0) printComboHit(0,nullptr,"banner",0,0);
-      else                        printf("i  index(in SH)\n--------------\n");
+      else                        Out("i  index(in SH)\n--------------\n");
 
       int  nhits = TimeCluster->nhits();
 
@@ -110,7 +110,7 @@ void TAnaDump::printTimeCluster(const mu2e::TimeCluster*            TimeCluster,
 //-----------------------------------------------------------------------------
 // debug mode: print only an index and a location of the hit
 //-----------------------------------------------------------------------------
-	  printf("%5i %5i\n",i,loc);
+	  Out("%5i %5i\n",i,loc);
 	}
       }
     }
@@ -123,6 +123,7 @@ void TAnaDump::printTimeClusterCollection(const char* TcCollTag  ,
 					  const char* ChfCollTag ,
 					  int         hitOpt     ,
 					  const char* SdmcCollTag) {
+  OutputScope scope(this);
 
   art::Handle<mu2e::TimeClusterCollection>  tccH;
   const mu2e::TimeClusterCollection*        tcc(0);
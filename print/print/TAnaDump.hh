@@ -2,6 +2,10 @@
 #ifndef __murat_inc_TAnaDump_hh__
 #define __murat_inc_TAnaDump_hh__
 
+#include <cstdio>
+#include <string>
+#include <vector>
+
 #include "TObject.h"
 #include "TObjArray.h"
 #include "TString.h"
@@ -66,9 +70,64 @@ namespace mu2e {
 }
 
 class KalRep;
-
+//-----------------------------------------------------------------------------
+// output: the print* methods format into a reusable buffer (Out), which is 
+// written out (Flush)
+// - when it is full
+// - at the end of each print*Collection call (OutputScope), unless the
+//   output is held (SetHold(1), batch dumps) - then at the next SetEvent
+//   and at the end of the job
+// - after each Out call made outside of any print*Collection, so the
+//   interactive output is not delayed. This goes into the stdio buffer of
+//   the output stream only, the stream itself is flushed (fflush) at the
+//   end of print*Collection, at SetEvent and when the output is redirected
+//
+// columnar mode (SetColumnar(1)), implemented for the combo hits, helices,
+// tracks and sim particles: one line per object, space-separated:
+//   <kind> <run> <event> <values>
+// each table starts from the line "#<kind> run event <column names>"
+// SetFields(kind,"name1,name2,...") selects the columns to print, by
+// default all of them
+//
+// filters, applied by the print*Collection methods, in all modes:
+//   SetFilter(kind,"pmin" ,value)  : particles, helices, tracks with P >= value
+//   SetFilter(kind,"tmin" ,value)  : hit times / T0 in [tmin,tmax]
+//   SetFilter(kind,"tmax" ,value)
+//   SetFilter(kind,"simid",value)  : hits made by / the particle with this ID
+//   SetFilter(kind,"pdg"  ,value)  : particles with this PDG code
+// a parameter not used for the kind ("simid" for tracks etc) is rejected
+//   SelectTrackHits(KalSeed)       : only the combo hits of this track
+// kind: "ch" (combo hits), "hs" (helix seeds), "ks" (kal seeds), 
+//       "simp" (sim particles)
+//-----------------------------------------------------------------------------
 class TAnaDump : public TObject {
 public:
+  enum { kComboHit    = 0,
+	 kHelixSeed   = 1,
+	 kKalSeed     = 2,
+	 kSimParticle = 3,
+	 kNKinds      = 4 
+  };
+
+  struct Format_t {
+    std::vector<std::string>  fFields;	// selected columns, empty: all
+    double    fPMin;
+    double    fTMin;
+    double    fTMax;
+    int       fSimID;			// < 0: any
+    int       fPdgID;			//   0: any
+    int       fHeaderPrinted;		// columnar mode, per table
+  };
+					// output of a print*Collection call
+					// goes out in one piece
+  class OutputScope {
+    TAnaDump* fDump;
+  public:
+    OutputScope(TAnaDump* Dump);
+    ~OutputScope();
+  };
+
+  static const char*                 fgKindName[kNKinds];
 
 #ifndef __CINT__
   struct Config {
@@ -89,6 +148,22 @@ public:
   double                             fTmp[100];  // for testing
 
   mu2e::TrkPrintUtils*               _printUtils;
+//-----------------------------------------------------------------------------
+// output buffer and formatting
+//-----------------------------------------------------------------------------
+  std::vector<char>                  fBuffer;      //!
+  int                                fNBytes;      //! used part of the buffer
+  FILE*                              fOutput;      //! stdout by default
+  int                                fHold;        //!
+  int                                fDepth;       //! OutputScope nesting level
+  int                                fColumnar;    //!
+  Format_t                           fFormat[kNKinds]; //!
+					// sorted indices of the selected track hits
+  std::vector<int>                   fTrackHits;   //!
+					// columnar mode: current row and header
+  int                                fRowKind;     //!
+  std::string                        fRow;         //!
+  std::string                        fRowHeader;   //!
 
 private:
 
@@ -120,7 +195,7 @@ public:
   void   AddObject      (const char* Name, void* Object);
   void*  FindNamedObject(const char* Name);
 
-  void   SetEvent(const art::Event* Evt) { fEvent = Evt; }
+  void   SetEvent(const art::Event* Evt);
 
   void   SetFlagBgrHitsModuleLabel(const char*    Tag) { fFlagBgrHitsModuleLabel = Tag; }
   void   SetStrawDigiMCCollTag    (art::InputTag& Tag) { fSdmcCollTag            = Tag; }
@@ -138,6 +213,46 @@ public:
 
   void   printEventHeader();
 //-----------------------------------------------------------------------------
+// buffered output, see above
+//-----------------------------------------------------------------------------
+  int    Out    (const char* Format, ...) __attribute__ ((format (printf, 2, 3)));
+					// Sync=0: don't fflush the output stream
+  void   Flush  (int Sync = 1);
+
+  int    SetOutputFile(const char* Filename);
+  void   SetBufferSize(int Size);
+  void   SetHold      (int Hold) { fHold     = Hold; if (Hold == 0) Flush(); }
+  void   SetColumnar  (int Mode) { fColumnar = Mode; }
+
+  int    Columnar     () const   { return fColumnar; }
+					// kind index by name, -1 if unknown
+  static int GetKind  (const char* Name);
+
+  int    SetFields    (const char* Kind, const char* Fields);
+  int    SetFilter    (const char* Kind, const char* Par, double Value);
+					// "kind:par=value" or "kind:f1,f2,..."
+  int    SetFilter    (const char* Spec);
+  int    SetFields    (const char* Spec);
+					// nullptr: any hits
+  void   SelectTrackHits(const mu2e::KalSeed* KSeed);
+
+  void   ResetFormat  ();
+//-----------------------------------------------------------------------------
+// columnar output helpers
+//-----------------------------------------------------------------------------
+  void   BeginTable   (int Kind) { fFormat[Kind].fHeaderPrinted = 0; }
+  void   BeginRow     (int Kind);
+  void   Col          (const char* Name, const char* Format, ...) __attribute__ ((format (printf, 3, 4)));
+  void   EndRow       ();
+//-----------------------------------------------------------------------------
+// filters
+//-----------------------------------------------------------------------------
+  int    PassTime     (int Kind, double Time) const {
+    return ((Time >= fFormat[Kind].fTMin) && (Time <= fFormat[Kind].fTMax));
+  }
+  int    PassHit      (int Index, double Time, int SimID) const;
+  int    PassParticle (double P, int SimID, int PdgID) const;
+//-----------------------------------------------------------------------------
 // calorimeter
 //-----------------------------------------------------------------------------
   void printCalorimeter();
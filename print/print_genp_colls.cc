@@ -9,7 +9,7 @@
 // print all GenParticleCollection's in the event
 //-----------------------------------------------------------------------------
 void print_genp_colls() {
-  printf("Available GenParticle collections: \n");
+  TAnaDump::Instance()->Out("Available GenParticle collections: \n");
 
   const art::Event* event = TAnaDump::Instance()->Event();
 
@@ -20,7 +20,7 @@ void print_genp_colls() {
     if (handle->isValid()) {
       const art::Provenance* prov = handle->provenance();
       
-      printf("moduleLabel: %-20s, productInstanceName: %-20s, processName:= %-30s\n" ,
+      TAnaDump::Instance()->Out("moduleLabel: %-20s, productInstanceName: %-20s, processName:= %-30s\n" ,
 	     prov->moduleLabel().data(),
 	     prov->productInstanceName().data(),
 	     prov->processName().data()
@@ -7,7 +7,7 @@
 #include "Stntuple/print/Stntuple_print_functions.hh"
 //--------------------------------------------------------------------------------------------------------------
 void print_kalrep_colls() {
-  printf("Available KalRepPtrCollections: \n");
+  TAnaDump::Instance()->Out("Available KalRepPtrCollections: \n");
 
   const art::Event* event = TAnaDump::Instance()->Event();
 
@@ -20,7 +20,7 @@ void print_kalrep_colls() {
     if (handle->isValid()) {
       const art::Provenance* prov = handle->provenance();
       
-      printf("moduleLabel: %-20s, productInstanceName: %-20s, processName:= %-30s\n" ,
+      TAnaDump::Instance()->Out("moduleLabel: %-20s, productInstanceName: %-20s, processName:= %-30s\n" ,
 	     prov->moduleLabel().data(),
 	     prov->productInstanceName().data(),
 	     prov->processName().data()
@@ -10,7 +10,7 @@
 //-----------------------------------------------------------------------------
 void print_kalseed_colls() {
 
-  printf("--------------------------- Available mu2e::KalSeedCollection\'s: \n");
+  TAnaDump::Instance()->Out("--------------------------- Available mu2e::KalSeedCollection\'s: \n");
 
   const art::Event* event = TAnaDump::Instance()->Event();
 
@@ -23,7 +23,7 @@ void print_kalseed_colls() {
     if (handle->isValid()) {
       const art::Provenance* prov = handle->provenance();
       
-      printf("moduleLabel: %-20s, productInstanceName: %-20s, processName:= %-30s\n" ,
+      TAnaDump::Instance()->Out("moduleLabel: %-20s, productInstanceName: %-20s, processName:= %-30s\n" ,
 	     prov->moduleLabel().data(),
 	     prov->productInstanceName().data(),
 	     prov->processName().data()
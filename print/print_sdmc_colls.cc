@@ -9,7 +9,7 @@
 // print all StrawDigiCollection's in the event
 //-----------------------------------------------------------------------------
 void print_sdmc_colls() {
-  printf("Available StrawDigiMCCollections: \n");
+  TAnaDump::Instance()->Out("Available StrawDigiMCCollections: \n");
 
   const art::Event* event = TAnaDump::Instance()->Event();
 
@@ -21,7 +21,7 @@ void print_sdmc_colls() {
     if (handle->isValid()) {
       const art::Provenance* prov = handle->provenance();
       
-      printf("moduleLabel: %-20s, productInstanceName: %-20s, processName:= %-30s\n" ,
+      TAnaDump::Instance()->Out("moduleLabel: %-20s, productInstanceName: %-20s, processName:= %-30s\n" ,
 	     prov->moduleLabel().data(),
 	     prov->productInstanceName().data(),
 	     prov->processName().data()
@@ -12,7 +12,7 @@
 //-----------------------------------------------------------------------------
 void print_sh_colls() {
 
-  printf("Available StrawHitCollections: \n");
+  TAnaDump::Instance()->Out("Available StrawHitCollections: \n");
 
   const art::Event* event = TAnaDump::Instance()->Event();
 
@@ -23,7 +23,7 @@ void print_sh_colls() {
     if (handle->isValid()) {
       const art::Provenance* prov = handle->provenance();
       
-      printf("moduleLabel: %-20s, productInstanceName: %-20s, processName:= %-30s\n" ,
+      TAnaDump::Instance()->Out("moduleLabel: %-20s, productInstanceName: %-20s, processName:= %-30s\n" ,
 	     prov->moduleLabel().data(),
 	     prov->productInstanceName().data(),
 	     prov->processName().data()
@@ -14,7 +14,7 @@
 //-----------------------------------------------------------------------------
 void print_shf_colls() {
 
-  printf("Available StrawHitFlagsCollections: \n");
+  TAnaDump::Instance()->Out("Available StrawHitFlagsCollections: \n");
 
   const art::Event* event = TAnaDump::Instance()->Event();
 
@@ -25,7 +25,7 @@ void print_shf_colls() {
     if (handle->isValid()) {
       const art::Provenance* prov = handle->provenance();
       
-      printf("moduleLabel: %-20s, productInstanceName: %-20s, processName:= %-30s\n" ,
+      TAnaDump::Instance()->Out("moduleLabel: %-20s, productInstanceName: %-20s, processName:= %-30s\n" ,
 	     prov->moduleLabel().data(),
 	     prov->productInstanceName().data(),
 	     prov->processName().data()
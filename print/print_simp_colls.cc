@@ -9,7 +9,7 @@
 // print all SimParticleCollection's in the event
 //-----------------------------------------------------------------------------
 void print_simp_colls() {
-  printf("Available SimParticle collections: \n");
+  TAnaDump::Instance()->Out("Available SimParticle collections: \n");
 
   const art::Event* event = TAnaDump::Instance()->Event();
 
@@ -20,7 +20,7 @@ void print_simp_colls() {
     if (handle->isValid()) {
       const art::Provenance* prov = handle->provenance();
       
-      printf("moduleLabel: %-20s, productInstanceName: %-20s, processName:= %-30s\n" ,
+      TAnaDump::Instance()->Out("moduleLabel: %-20s, productInstanceName: %-20s, processName:= %-30s\n" ,
 	     prov->moduleLabel().data(),
 	     prov->productInstanceName().data(),
 	     prov->processName().data()
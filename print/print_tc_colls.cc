@@ -12,7 +12,7 @@
 //-----------------------------------------------------------------------------
 void print_tc_colls() {
 
-  printf("Available TimeClusterCollections: \n");
+  TAnaDump::Instance()->Out("Available TimeClusterCollections: \n");
 
   const art::Event* event = TAnaDump::Instance()->Event();
 
@@ -24,7 +24,7 @@ void print_tc_colls() {
     if (handle->isValid()) {
       const art::Provenance* prov = handle->provenance();
       
-      printf("moduleLabel: %-20s, productInstanceName: %-20s, processName:= %-30s\n" ,
+      TAnaDump::Instance()->Out("moduleLabel: %-20s, productInstanceName: %-20s, processName:= %-30s\n" ,
 	     prov->moduleLabel().data(),
 	     prov->productInstanceName().data(),
 	     prov->processName().data()
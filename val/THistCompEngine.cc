@@ -0,0 +1,364 @@
+//-----------------------------------------------------------------------------
+// parallel, incremental histogram comparison, see THistCompEngine.hh
+//
+// cache file: one line per compared pair - "hash1:hash2:flag:minprob prob"
+//-----------------------------------------------------------------------------
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "TROOT.h"
+#include "TEnv.h"
+#include "TSystem.h"
+#include "TH1.h"
+#include "TObjArray.h"
+#include "TCanvas.h"
+
+#include "Stntuple/val/THistComp.hh"
+#include "Stntuple/val/THistCompEngine.hh"
+#include "Stntuple/val/stntuple_val_functions.hh"
+
+ClassImp(THistCompEngine)
+
+THistCompEngine* THistCompEngine::fgActive = 0;
+
+namespace {
+					// FNV-1a
+  void hash_bytes(ULong64_t& H, const void* Data, size_t N) {
+    const unsigned char* p = (const unsigned char*) Data;
+    for (size_t i=0; i<N; i++) {
+      H ^= p[i];
+      H *= 1099511628211ULL;
+    }
+  }
+
+  void hash_axis(ULong64_t& H, const TAxis* Axis) {
+    int    nb   = Axis->GetNbins();
+    double xmin = Axis->GetXmin();
+    double xmax = Axis->GetXmax();
+    hash_bytes(H,&nb  ,sizeof(int));
+    hash_bytes(H,&xmin,sizeof(double));
+    hash_bytes(H,&xmax,sizeof(double));
+
+    const TArrayD* xb = Axis->GetXbins();
+    if (xb->GetSize() > 0) hash_bytes(H,xb->GetArray(),xb->GetSize()*sizeof(double));
+  }
+}
+
+//_____________________________________________________________________________
+THistCompEngine::THistCompEngine(Double_t MinProb, Int_t Flag) :
+  TNamed("HistCompEngine","parallel histogram comparison") {
+  fMinProb   = MinProb;
+  fFlag      = Flag;
+  fNThreads  = gEnv->GetValue("Stntuple.HistComp.NThreads" ,0 );
+  fCacheFile = gEnv->GetValue("Stntuple.HistComp.CacheFile","");
+  fNCached   = 0;
+}
+
+//_____________________________________________________________________________
+THistCompEngine::~THistCompEngine() {
+  if (fgActive == this) fgActive = 0;
+  Clear();
+}
+
+//_____________________________________________________________________________
+void THistCompEngine::Activate() {
+  fgActive = this;
+}
+
+//_____________________________________________________________________________
+void THistCompEngine::Deactivate() {
+  if (fgActive == this) fgActive = 0;
+}
+
+//_____________________________________________________________________________
+ULong64_t THistCompEngine::HistHash(const TH1* Hist) {
+  ULong64_t h = 14695981039346656037ULL;
+
+  hash_bytes(h,Hist->ClassName(),strlen(Hist->ClassName()));
+  hash_axis (h,Hist->GetXaxis());
+  hash_axis (h,Hist->GetYaxis());
+  hash_axis (h,Hist->GetZaxis());
+
+  double entries = Hist->GetEntries();
+  hash_bytes(h,&entries,sizeof(double));
+
+  int ncells = Hist->GetNcells();
+  for (int i=0; i<ncells; i++) {
+    double x = Hist->GetBinContent(i);
+    hash_bytes(h,&x,sizeof(double));
+  }
+
+  const TArrayD* sumw2 = Hist->GetSumw2();
+  if (sumw2->GetSize() > 0) {
+    hash_bytes(h,sumw2->GetArray(),sumw2->GetSize()*sizeof(double));
+  }
+
+  return h;
+}
+
+//-----------------------------------------------------------------------------
+// the plot shows the history and the histogram names and titles, which are 
+// not a part of the content hash
+//-----------------------------------------------------------------------------
+TString THistCompEngine::PlotKey(THistComp* Comp) {
+  ULong64_t h = 14695981039346656037ULL;
+
+  TString s = Comp->GetHistory();
+  TH1* h1   = Comp->GetHist1();
+  TH1* h2   = Comp->GetHist2();
+  if (h1) { s += "|"; s += h1->GetName(); s += "|"; s += h1->GetTitle(); }
+  if (h2) { s += "|"; s += h2->GetName(); s += "|"; s += h2->GetTitle(); }
+  hash_bytes(h,s.Data(),s.Length());
+
+  return Form("%s:%016llx",Comp->GetKey(),h);
+}
+
+//_____________________________________________________________________________
+std::string THistCompEngine::Key(const Job_t* Job) const {
+  return Form("%016llx:%016llx:%i:%g",Job->fHash1,Job->fHash2,fFlag,fMinProb);
+}
+
+//_____________________________________________________________________________
+int THistCompEngine::AddJob(TH1* Hist1, TH1* Hist2, TObjArray* Array,
+			    const char* History, int Strict) {
+  Job_t job;
+
+  job.fHist1   = Hist1;
+  job.fHist2   = Hist2;
+  job.fArray   = Array;
+  job.fHistory = History;
+  job.fStrict  = Strict;
+  job.fHash1   = 0;
+  job.fHash2   = 0;
+  job.fProb    = 0;
+  job.fCached  = 0;
+					// placeholder, replaced by Run
+  Array->Add(new THistComp(Hist1,Hist2,0));
+  job.fIndex   = Array->GetLast();
+
+  fJob.push_back(job);
+  return fJob.size()-1;
+}
+
+//-----------------------------------------------------------------------------
+// worker thread: the jobs are taken one by one, histograms are only read
+//-----------------------------------------------------------------------------
+void THistCompEngine::ProcessJobs(std::atomic<int>* Next) {
+  int njobs = fJob.size();
+
+  while (1) {
+    int i = (*Next)++;
+    if (i >= njobs) break;
+
+    Job_t* job = &fJob[i];
+    if (job->fCached) continue;
+
+    job->fProb = compare_histograms(job->fHist1,job->fHist2,fMinProb,fFlag);
+  }
+}
+
+//_____________________________________________________________________________
+int THistCompEngine::Run() {
+  int njobs = fJob.size();
+//-----------------------------------------------------------------------------
+// hashes and cache lookups - serial, they are cheap compared to the KS test
+//-----------------------------------------------------------------------------
+  if (fCacheFile != "") ReadCache();
+
+  fNCached = 0;
+  for (Job_t& job : fJob) {
+    job.fHash1 = HistHash(job.fHist1);
+    job.fHash2 = (job.fHist2) ? HistHash(job.fHist2) : 0;
+
+    auto it = fCache.find(Key(&job));
+    if (it != fCache.end()) {
+      job.fProb   = it->second;
+      job.fCached = 1;
+      fNCached++;
+    }
+  }
+//-----------------------------------------------------------------------------
+// thread pool
+//-----------------------------------------------------------------------------
+  int nthreads = fNThreads;
+  if (nthreads <= 0) nthreads = std::thread::hardware_concurrency();
+  if (nthreads <= 0) nthreads = 1;
+
+  int ntodo = njobs-fNCached;
+  if (nthreads > ntodo) nthreads = (ntodo > 0) ? ntodo : 1;
+
+  std::atomic<int> next(0);
+
+  if (nthreads == 1) {
+    ProcessJobs(&next);
+  }
+  else {
+    ROOT::EnableThreadSafety();
+
+    std::vector<std::thread> pool;
+    for (int i=0; i<nthreads; i++) {
+      pool.push_back(std::thread(&THistCompEngine::ProcessJobs,this,&next));
+    }
+    for (std::thread& t : pool) t.join();
+  }
+//-----------------------------------------------------------------------------
+// results, in the order of the queued jobs - same printout as the serial code
+//-----------------------------------------------------------------------------
+  for (Job_t& job : fJob) {
+    double     prob = job.fProb;
+    int        bad  = (prob < fMinProb) || (job.fStrict && (fMinProb < 0) && (prob < 1.0));
+    THistComp* hc;
+
+    if (bad) {
+      printf("%-30s %-20s histogram, KS(prob) = %10.5f \n",
+	     job.fHist1->GetName(),job.fHist1->ClassName(),prob);
+      hc = new TBadHistComp(job.fHist1,job.fHist2,prob);
+      hc->SetHistory(job.fHistory);
+    }
+    else {
+      hc = new TGoodHistComp(job.fHist1,job.fHist2,prob);
+    }
+    std::string key = Key(&job);
+
+    hc->SetChanged(! job.fCached);
+    hc->SetKey(key.data());
+
+    delete job.fArray->At(job.fIndex);
+    job.fArray->AddAt(hc,job.fIndex);
+
+    fCache[key] = prob;
+    fSeen.insert(key);
+  }
+
+  printf(" >>> THistCompEngine::Run: %i comparisons, %i from the cache, %i threads\n",
+	 njobs,fNCached,nthreads);
+
+  if (fCacheFile != "") WriteCache();
+
+  fJob.clear();
+  return 0;
+}
+
+//_____________________________________________________________________________
+int THistCompEngine::ReadCache() {
+  FILE* f = fopen(fCacheFile.Data(),"r");
+  if (f == 0)                                                return -1;
+
+  char   key[200];
+  double prob;
+
+  while (fscanf(f,"%199s %lf",key,&prob) == 2) {
+    fCache[key] = prob;
+  }
+
+  fclose(f);
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+// the entries not seen in this job are dropped, so the file doesn't grow
+//-----------------------------------------------------------------------------
+int THistCompEngine::WriteCache() const {
+  TString tmp = fCacheFile+".tmp";
+
+  FILE* f = fopen(tmp.Data(),"w");
+  if (f == 0) {
+    Error("WriteCache","can\'t open %s",tmp.Data());
+    return -1;
+  }
+
+  for (const auto& x : fCache) {
+    if (fSeen.find(x.first) == fSeen.end()) continue;
+    fprintf(f,"%s %.17g\n",x.first.c_str(),x.second);
+  }
+
+  fclose(f);
+  return gSystem->Rename(tmp.Data(),fCacheFile.Data());
+}
+
+//-----------------------------------------------------------------------------
+// ROOT graphics is not thread-safe, so the plots are drawn in forked
+// processes, each process draws every NProcesses-th plot
+//-----------------------------------------------------------------------------
+int THistCompEngine::RenderPlots(std::vector<THistComp*>& Comp,
+				 std::vector<TString>&    Filename,
+				 int                      NProcesses) {
+  int nplots = Comp.size();
+  if (nplots == 0)                                           return 0;
+
+  int nproc = NProcesses;
+  if (nproc <= 0) nproc = gEnv->GetValue("Stntuple.HistComp.NProcesses",0);
+  if (nproc <= 0) nproc = std::thread::hardware_concurrency();
+  if (nproc > nplots) nproc = nplots;
+
+  if (nproc <= 1) {
+    TCanvas* c = new TCanvas("c_hist_comp","c_hist_comp");
+    for (int i=0; i<nplots; i++) {
+      Comp[i]->Draw("e0");
+      c->SaveAs(Filename[i].Data());
+    }
+    delete c;
+    return 0;
+  }
+
+  fflush(stdout);
+  fflush(stderr);
+
+  std::vector<pid_t> pid;
+  for (int ip=0; ip<nproc; ip++) {
+    pid_t p = fork();
+    if (p == 0) {
+      gROOT->SetBatch(kTRUE);
+      TCanvas* c = new TCanvas(Form("c_hist_comp_%i",ip),"c_hist_comp");
+      for (int i=ip; i<nplots; i+=nproc) {
+	Comp[i]->Draw("e0");
+	c->SaveAs(Filename[i].Data());
+      }
+      fflush(stdout);
+      _exit(0);
+    }
+    else if (p < 0) {
+      printf(" >>> ERROR THistCompEngine::RenderPlots: fork failed, draw plots %i.. serially\n",ip);
+      TCanvas* c = new TCanvas("c_hist_comp","c_hist_comp");
+      for (int i=ip; i<nplots; i+=nproc) {
+	Comp[i]->Draw("e0");
+	c->SaveAs(Filename[i].Data());
+      }
+      delete c;
+    }
+    else pid.push_back(p);
+  }
+
+  int nfailed = 0;
+  for (pid_t p : pid) {
+    int status;
+    if ((waitpid(p,&status,0) < 0) || (! WIFEXITED(status)) || (WEXITSTATUS(status) != 0)) {
+      nfailed++;
+    }
+  }
+
+  if (nfailed > 0) {
+    printf(" >>> ERROR THistCompEngine::RenderPlots: %i of %i processes failed\n",
+	   nfailed,(int) pid.size());
+  }
+
+  return nfailed;
+}
+
+//_____________________________________________________________________________
+void THistCompEngine::Clear(Option_t* Opt) {
+  fJob.clear();
+  fCache.clear();
+  fSeen.clear();
+  fNCached = 0;
+}
+
+//_____________________________________________________________________________
+void THistCompEngine::Print(Option_t* Opt) const {
+  printf(" ---- THistCompEngine: MinProb: %g flag: %i threads: %i cache: %s\n",
+	 fMinProb,fFlag,fNThreads,fCacheFile.Data());
+  printf(" queued pairs: %i cached results: %i\n",(int) fJob.size(),(int) fCache.size());
+}
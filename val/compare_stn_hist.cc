@@ -2,6 +2,7 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 #include <map>
+#include <vector>
 #include "TClass.h"
 #include "TSystem.h"
 #include "TROOT.h"
@@ -14,6 +15,7 @@
 #include "TBrowser.h"
 #include "TCanvas.h"
 #include "Stntuple/val/THistComp.hh"
+#include "Stntuple/val/THistCompEngine.hh"
 #include "Stntuple/val/TGoodFolder.hh"
 #include "Stntuple/val/TBadFolder.hh"
 #include "Stntuple/val/stntuple_val_functions.hh"
@@ -217,7 +219,11 @@ int compare_arrays(TObjArray*  Arr1,
   while ((o1 = it1.Next())) {
     o2 = Arr2->FindObject(o1->GetName());
 
-    if (o1->InheritsFrom("TH1")) {
+    if (o1->InheritsFrom("TH1") && THistCompEngine::Active()) {
+      THistCompEngine::Active()->AddJob((TH1*) o1,(TH1*) o2,Results,
+					Form("%s/%s",Arr1->GetName(),o1->GetName()),0);
+    }
+    else if (o1->InheritsFrom("TH1")) {
       h1   = (TH1*) o1;
       h2   = (TH1*) o2;
       prob = compare_histograms(h1,h2,MinProb,flag);
@@ -283,7 +289,14 @@ int compare_folders(TFolder*   Fol1,
   while ((o1 = it1.Next())) {
     o2 = Fol2->FindObject(o1->GetName());
 
-    if (o1->InheritsFrom("TH1")) {
+    if (o1->InheritsFrom("TH1") && THistCompEngine::Active()) {
+//-----------------------------------------------------------------------------
+// parallel mode: queue the pair, THistCompEngine::Run does the comparison
+//-----------------------------------------------------------------------------
+      THistCompEngine::Active()->AddJob((TH1*) o1,(TH1*) o2,array,
+					Form("%s/%s",Fol1->GetName(),o1->GetName()),0);
+    }
+    else if (o1->InheritsFrom("TH1")) {
       h1 = (TH1*) o1;
       h2 = (TH1*) o2;
       prob = compare_histograms(h1,h2,MinProb,flag);
@@ -369,6 +382,15 @@ int compare_directories(TDirectory*   Dir1,
       printf("%-40s directory doesn't exist in the 2nd file\n",
 	     o1->GetName());
     }
+    else if (o1->InheritsFrom("TH1") && THistCompEngine::Active()) {
+      TString temp(Dir1->GetPath());
+      temp.Remove(temp.Index(":"));
+      temp.Append(" vs ");
+      temp.Append(Dir2->GetPath());
+      temp.Append("/");
+      temp.Append(o1->GetName());
+      THistCompEngine::Active()->AddJob((TH1*) o1,(TH1*) o2,array,temp.Data(),1);
+    }
     else if (o1->InheritsFrom("TH1")) {
       h1 = (TH1*) o1;
       h2 = (TH1*) o2;
@@ -493,7 +515,11 @@ void compare_stn_hist(const char* Filename1,
   fol1 = read_folder(Filename1,"Ana");
   fol2 = read_folder(Filename2,"Ana");
 
+  THistCompEngine engine(MinProb,flag);
+  engine.Activate();
   compare_folders(fol1,fol2,MinProb,results,flag);
+  engine.Run();
+  engine.Deactivate();
 //-----------------------------------------------------------------------------
 // presentation part: display the results
 //-----------------------------------------------------------------------------
@@ -530,7 +556,11 @@ void compare_prod_hist(const char* Filename1,
   dir1 = get_file(Filename1);
   dir2 = get_file(Filename2);
 
+  THistCompEngine engine(MinProb,flag);
+  engine.Activate();
   compare_directories(dir1,dir2,MinProb,results,flag);
+  engine.Run();
+  engine.Deactivate();
 //-----------------------------------------------------------------------------
 // presentation part: display the results
 //-----------------------------------------------------------------------------
@@ -563,6 +593,9 @@ int compare_files(const char* Filename1,
   TObjArray*   results = new TObjArray(10);
   results->SetName("HistComparison");
 
+  THistCompEngine engine(MinProb,flag);
+  engine.Activate();
+
   // try folders first
   fol1 = read_folder(Filename1,"Ana");
   fol2 = read_folder(Filename2,"Ana");
@@ -574,6 +607,9 @@ int compare_files(const char* Filename1,
     compare_directories(dir1,dir2,MinProb,results,flag);
   }
 
+  engine.Run();
+  engine.Deactivate();
+
 //-----------------------------------------------------------------------------
 // presentation part: display the results
 //-----------------------------------------------------------------------------
@@ -939,9 +975,6 @@ int write_web_page(const char* wfile, int flag) {
   TObjArray arr;
   arr.Add(fol);
 
-  TCanvas * ccc = new TCanvas();
-  ccc->cd();
-
   TObject* o;
   int ind = 0;
   std::multimap<float,THistComp*> hists;
@@ -1010,6 +1043,29 @@ int write_web_page(const char* wfile, int flag) {
   }
   fprintf(pfile,"</TABLE>\n");
 
+//-----------------------------------------------------------------------------
+// plots are drawn in a separate parallel stage, only for the comparisons
+// which changed since the previous run or don't have a plot yet.
+// <wfile>.plots records the key (THistCompEngine::PlotKey) each plot has 
+// been drawn from, one line per plot: <plot file> <key>. Without the 
+// engine the results have no key and all plots are redrawn
+//-----------------------------------------------------------------------------
+  std::vector<THistComp*> plot_comp;
+  std::vector<TString>    plot_file;
+
+  TString                       kfile = Form("%s.plots",wfile);
+  std::map<TString,TString>     old_key;
+  std::vector<TString>          key_file;
+  std::vector<TString>          key_value;
+  std::vector<int>              key_drawn;
+
+  FILE* kf = fopen(kfile.Data(),"r");
+  if (kf) {
+    char pname[1000], pkey[1000];
+    while (fscanf(kf,"%999s %999s",pname,pkey) == 2) old_key[pname] = pkey;
+    fclose(kf);
+  }
+
   it = hists.begin();
   while(it!=hists.end()) {
     fprintf(pfile,"<BR><BR><BR><HR>\n");
@@ -1028,17 +1084,48 @@ int write_web_page(const char* wfile, int flag) {
     str.Append(".gif");
     fprintf(pfile,"<H2>%s</H2>\n",c->GetHistory().Data());
     fprintf(pfile,"<img src=\"%s\"></img>\n",str.Data());
+
+    TString key  = (c->GetKey()[0] != 0) ? THistCompEngine::PlotKey(c) : TString("");
+    auto    ik   = old_key.find(str);
+    int     draw = (key == "") || (ik == old_key.end()) || (ik->second != key);
+
+    TString pname = str;
     str.Prepend(wdir.Data());
-    c->Draw("e0");
-    ccc->SaveAs(str.Data());
+    if (draw || gSystem->AccessPathName(str.Data())) {
+      draw = 1;
+      plot_comp.push_back(c);
+      plot_file.push_back(str);
+    }
+    if (key != "") {
+      key_file.push_back (pname);
+      key_value.push_back(key);
+      key_drawn.push_back(draw);
+    }
     it++;
   }
 		 
   fprintf(pfile,"</body>");
   fprintf(pfile,"</html>");
   fclose(pfile);
-  ccc->Close();
-  delete ccc;
+
+  printf("write_web_page: %i of %i plots to draw\n",
+	 (int) plot_comp.size(),(int) hists.size());
+
+  int nfailed = THistCompEngine::RenderPlots(plot_comp,plot_file);
+//-----------------------------------------------------------------------------
+// record the keys of the plots on this page only. If some rendering 
+// processes failed, the redrawn plots are not recorded and are drawn again
+// next time
+//-----------------------------------------------------------------------------
+  kf = fopen(kfile.Data(),"w");
+  if (kf) {
+    int nk = key_file.size();
+    for (int i=0; i<nk; i++) {
+      if (key_drawn[i] && (nfailed > 0)) continue;
+      fprintf(kf,"%s %s\n",key_file[i].Data(),key_value[i].Data());
+    }
+    fclose(kf);
+  }
 
   return 0;
 }
@@ -10,6 +10,9 @@ protected:
   Double_t fKsProb;
   Double_t fNorm;
   TString  fHistory;
+  Int_t    fChanged;			// 0: same contents as in a previous
+					// comparison, see THistCompEngine
+  TString  fKey;			//! comparison key, set by THistCompEngine
 public:
 
   THistComp(TH1* Hist1=0, TH1* Hist2=0, Double_t KsProb=0) {
@@ -17,6 +20,7 @@ public:
     fHist2  = Hist2;
     fKsProb = KsProb;
     fNorm = 0.0;
+    fChanged = 1;
   }
 
   ~THistComp() {}
@@ -30,6 +34,11 @@ public:
   TH1*       GetHist2 () { return fHist2;  }
   Double_t   GetKsProb() { return fKsProb; }
   Double_t   GetNorm()   { return fNorm; }
+  Int_t      GetChanged(){ return fChanged; }
+  const char* GetKey   () const { return fKey.Data(); }
+
+  void SetChanged(Int_t C) { fChanged = C; }
+  void SetKey    (const char* Key) { fKey = Key; }
 //-----------------------------------------------------------------------------
 //  overloaded functions of TObject
 //-----------------------------------------------------------------------------
@@ -52,7 +61,7 @@ public:
   void DrawEP() { Draw("ep"); }         // *MENU*;
   virtual void        Dump() const;    // *MENU*
 
-  ClassDef(THistComp,2)
+  ClassDef(THistComp,3)
 };
 
 
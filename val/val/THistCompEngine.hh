@@ -0,0 +1,126 @@
+#ifndef THistCompEngine_hh
+#define THistCompEngine_hh
+//-----------------------------------------------------------------------------
+// parallel, incremental histogram comparison for compare_stn_hist,
+// compare_prod_hist and compare_files
+//
+// while an engine is active, compare_folders/compare_directories/
+// compare_arrays don't compare histograms, they only queue the pairs.
+// Run() then compares the queued pairs on a thread pool and puts
+// TGoodHistComp/TBadHistComp objects in the same places of the result
+// arrays the serial code would use.
+//
+// each pair is keyed by the content hashes of both histograms (binning,
+// bin contents, errors, entries), the comparison flag and MinProb. With
+// a cache file specified, the results of the previous comparisons are read
+// from it and the pairs with a known key are not compared again; such
+// pairs are marked as unchanged (THistComp::GetChanged() = 0). The cache
+// file keeps only the keys seen by the engine in the current job.
+//
+// each result carries its key (THistComp::GetKey()), write_web_page records
+// in the web directory the key and the history each plot has been drawn
+// from, and redraws only the plots for which either has changed
+//
+// configuration (.rootrc):
+//   Stntuple.HistComp.NThreads:   0       # 0: all cores
+//   Stntuple.HistComp.CacheFile:  ""      # "": no cache
+//   Stntuple.HistComp.NProcesses: 0       # plot rendering, 0: all cores
+//-----------------------------------------------------------------------------
+#include <string>
+#include <atomic>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "TNamed.h"
+#include "TString.h"
+
+class TH1;
+class TObjArray;
+class THistComp;
+
+class THistCompEngine : public TNamed {
+public:
+
+  struct Job_t {
+    TH1*        fHist1;
+    TH1*        fHist2;
+    TObjArray*  fArray;			// result array
+    int         fIndex;			// placeholder position in fArray
+    TString     fHistory;
+    int         fStrict;		// 1: MinProb<0 - require identical
+    ULong64_t   fHash1;
+    ULong64_t   fHash2;
+    double      fProb;
+    int         fCached;		// 1: result taken from the cache
+  };
+
+protected:
+  int                                       fNThreads;
+  TString                                   fCacheFile;
+  double                                    fMinProb;
+  int                                       fFlag;
+
+  std::vector<Job_t>                        fJob;
+  std::unordered_map<std::string,double>    fCache;
+					// keys of the pairs compared in this
+					// job, only those are written out
+  std::unordered_set<std::string>           fSeen;
+  int                                       fNCached;
+
+  static THistCompEngine*                   fgActive;
+//-----------------------------------------------------------------------------
+// functions
+//-----------------------------------------------------------------------------
+public:
+  THistCompEngine(Double_t MinProb = 0.001, Int_t Flag = 0);
+  virtual ~THistCompEngine();
+
+  static THistCompEngine* Active() { return fgActive; }
+
+  int          NThreads () const { return fNThreads; }
+  int          NJobs    () const { return fJob.size(); }
+  int          NCached  () const { return fNCached;   }
+  const char*  CacheFile() const { return fCacheFile.Data(); }
+
+  void         SetNThreads (int N)          { fNThreads  = N;  }
+  void         SetCacheFile(const char* Fn) { fCacheFile = Fn; }
+					// make the engine (in)active
+  void         Activate    ();
+  void         Deactivate  ();
+//-----------------------------------------------------------------------------
+// queue a pair, the placeholder is added to Array right away to keep the order
+//-----------------------------------------------------------------------------
+  int          AddJob      (TH1* Hist1, TH1* Hist2, TObjArray* Array,
+			    const char* History, int Strict);
+//-----------------------------------------------------------------------------
+// compare the queued pairs, replace the placeholders, update the cache file
+//-----------------------------------------------------------------------------
+  int          Run         ();
+
+  int          ReadCache   ();
+  int          WriteCache  () const;
+
+  static ULong64_t HistHash(const TH1* Hist);
+					// key of the plot drawn for a result:
+					// comparison key, history, hist titles
+  static TString   PlotKey (THistComp* Comp);
+//-----------------------------------------------------------------------------
+// draw the histogram comparisons into image files in NProcesses forked
+// processes, returns the number of failed processes
+//-----------------------------------------------------------------------------
+  static int   RenderPlots(std::vector<THistComp*>& Comp,
+			   std::vector<TString>&    Filename,
+			   int                      NProcesses = 0);
+
+  void         Clear(Option_t* Opt = "");
+  void         Print(Option_t* Opt = "") const;
+
+protected:
+  std::string  Key        (const Job_t* Job) const;
+  void         ProcessJobs(std::atomic<int>* Next);
+
+  ClassDef(THistCompEngine,0)
+};
+
+#endif